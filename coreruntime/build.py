@@ -26,6 +26,7 @@ def main():
     parser = argparse.ArgumentParser(description="Build nimblenet script.")
     parser.add_argument("-s", "--simulator", action="store_true", required=False, help="Enable Simulation Mode.")
     parser.add_argument("-p", "--testing", action="store_true", help="Enable Testing Mode only for CI build, for local add argument in config.yaml common cmake_args.")
+    parser.add_argument("-q", "--sqlite", action="store_true", required=False, help="Build the SQLite events backend instead of the file based one, with its tests and benchmark when testing.")
     parser.add_argument("-c", "--ci_build", action="store_true", required=False, help="Build simulator whl and install in local environment.")
     parser.add_argument("-g", "--coverage", action="store_true", required=False, help="Generate coverage data.")
     parser.add_argument(
@@ -55,6 +56,9 @@ def main():
     if args.testing:
         cmake_args += " -DTESTING=1 "
 
+    if args.sqlite:
+        cmake_args = cmake_args.replace("-DNOSQL=1", "-DNOSQL=0")
+
     if args.coverage:
         CMAKE_CXX_FLAGS += " --coverage "
 
@@ -10,6 +10,7 @@ from delitepy.nimblenet.eventstore import *
 from delitepy.nimblenet.tensor import *
 from delitepy.nimblenet.utils import *
 from delitepy.nimblenet.llm import *
+from delitepy.nimblenet.vector_index import *
 
 def get_config()->dict:
     """
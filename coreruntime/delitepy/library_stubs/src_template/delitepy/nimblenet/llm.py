@@ -260,4 +260,29 @@ class LLM:
         """
         pass
 
+    def set_session(self, name: str) -> None:
+        """Switch to a named session with its own conversation history.
+
+        A session is created empty the first time its name is used. Prompts,
+        ``add_context``, ``cancel`` and ``clear_context`` apply to the current
+        session only. Sessions share the cached model state, so a prompt
+        starting with the same context as an earlier one, e.g. a common
+        system prompt, does not process that context again. Only supported by
+        custom ONNX models.
+
+        Parameters
+        ----------
+        name : str
+            Name of the session to switch to.
+
+        Examples
+        --------
+        >>> llm.set_session("support")
+        >>> llm.add_context(systemPrompt)
+        >>> llm.prompt("How do I reset my password?")
+        >>> llm.set_session("summary")  # Separate conversation
+        >>> llm.prompt("Summarize this article: ...")
+        """
+        pass
+
 __all__ = ["LLM"]
\ No newline at end of file
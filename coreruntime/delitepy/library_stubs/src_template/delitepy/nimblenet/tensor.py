@@ -3,6 +3,14 @@
 # SPDX-License-Identifier: Apache-2.0
 
 class Tensor:
+    """
+    Multi-dimensional array of a single data type.
+
+    Numeric tensors support element-wise `+`, `-`, `*`, `/`, `**` and `%` with other numeric
+    tensors or with int/float values. Operands with different shapes are broadcast following
+    NumPy rules, and mixing int and float operands promotes the result to the wider type.
+    """
+
     def shape(self)->list[int]:
         """
         Returns the shape of the tensor.
@@ -76,44 +76,144 @@ def is_string(s : object) -> bool:
         true if object passed is an string, false otherwise
     """
 
-def min(tensor : Tensor) -> int|float:
+def min(tensor : Tensor, axis : int = None) -> int|float|Tensor:
     """
-    Returns the minimum element in the tensor
+    Returns the minimum element in the tensor, or the minimum along an axis.
+
+    Parameters
+    ----------
+    tensor : Tensor
+        Numeric tensor to reduce.
+    axis : int
+        Axis along which to reduce, negative values count from the last axis. If not given the
+        minimum of all the elements is returned.
+
+    Returns
+    ----------
+    result : int|float|Tensor
+        Minimum element in the tensor, or a tensor with the axis removed.
+    """
+
+def max(tensor : Tensor, axis : int = None) -> int|float|Tensor:
+    """
+    Returns the maximum element in the tensor, or the maximum along an axis.
+
+    Parameters
+    ----------
+    tensor : Tensor
+        Numeric tensor to reduce.
+    axis : int
+        Axis along which to reduce, negative values count from the last axis. If not given the
+        maximum of all the elements is returned.
+
+    Returns
+    ----------
+    result : int|float|Tensor
+        Maximum element in the tensor, or a tensor with the axis removed.
+    """
+
+def sum(tensor: Tensor, axis : int = None) -> int|float|Tensor:
+    """
+    Returns the sum of all elements of the tensor, or the sum along an axis.
+
+    Parameters
+    ----------
+    tensor : Tensor
+        Numeric tensor to reduce.
+    axis : int
+        Axis along which to reduce, negative values count from the last axis.
+
+    Returns
+    ----------
+    result : int|float|Tensor
+        Sum of all elements of the tensor, or a tensor with the axis removed.
+    """
+
+def mean(tensor: Tensor, axis : int = None) -> float|Tensor:
+    """
+    Returns the mean of all elements of the tensor, or the mean along an axis.
+
+    Parameters
+    ----------
+    tensor : Tensor
+        Numeric tensor to reduce.
+    axis : int
+        Axis along which to reduce, negative values count from the last axis.
+
+    Returns
+    ----------
+    result : float|Tensor
+        Mean of all elements of the tensor, or a double tensor with the axis removed.
+    """
+
+def argmin(tensor: Tensor, axis : int = None) -> int|Tensor:
+    """
+    Returns the index of the minimum element. Without an axis the index is into the flattened
+    tensor.
+
+    Parameters
+    ----------
+    tensor : Tensor
+        Numeric tensor to reduce.
+    axis : int
+        Axis along which to find the minimum.
 
     Returns
     ----------
-    result : int|float
-        Minimum element in the tensor
+    result : int|Tensor
+        Index of the first occurrence of the minimum, or an int64 tensor with the axis removed.
     """
 
-def max(tensor : Tensor) -> int|float:
+def argmax(tensor: Tensor, axis : int = None) -> int|Tensor:
     """
-    Returns the maximum element in the tensor
+    Returns the index of the maximum element. Without an axis the index is into the flattened
+    tensor.
+
+    Parameters
+    ----------
+    tensor : Tensor
+        Numeric tensor to reduce.
+    axis : int
+        Axis along which to find the maximum.
 
     Returns
     ----------
-    result : int|float
-        Maximum element in the tensor
+    result : int|Tensor
+        Index of the first occurrence of the maximum, or an int64 tensor with the axis removed.
     """
 
-def sum(tensor: Tensor) -> int|float:
+def softmax(tensor: Tensor, axis : int = -1) -> Tensor:
     """
-    Returns the sum of all elements of the tensor
+    Computes the softmax of the tensor along an axis.
+
+    Parameters
+    ----------
+    tensor : Tensor
+        Numeric tensor, integer tensors are computed as float.
+    axis : int
+        Axis along which to normalize, defaults to the last axis.
 
     Returns
     ----------
-    result : int|float
-        Sum of all elements of the tensor
+    result : Tensor
+        Tensor of the same shape whose values along the axis sum to 1.
     """
 
-def mean(tensor: Tensor) -> int|float:
+def log_softmax(tensor: Tensor, axis : int = -1) -> Tensor:
     """
-    Returns the mean of all elements of the tensor
+    Computes the logarithm of the softmax of the tensor along an axis in a numerically stable way.
+
+    Parameters
+    ----------
+    tensor : Tensor
+        Numeric tensor, integer tensors are computed as float.
+    axis : int
+        Axis along which to normalize, defaults to the last axis.
 
     Returns
     ----------
-    result : int|float
-        Mean of all elements of the tensor
+    result : Tensor
+        Tensor of the same shape as the input.
     """
 
 def parse_json(s : str) -> dict:
@@ -0,0 +1,94 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Type stubs for delitepy.nimblenet.vector_index module."""
+
+from typing import Any, Dict, List, Tuple, Union
+
+from delitepy.nimblenet.tensor import Tensor
+
+
+class VectorIndex:
+    """In-process index of embedding vectors, searched for the vectors most similar to a query.
+
+    A VectorIndex can be passed to Retriever in place of the embedding store model, the ids of its
+    vectors being the indices of the documents in the document store.
+    """
+
+    def __init__(self, config: Dict[str, Any]) -> None:
+        """Create an empty index, or load it from its path if it was saved before.
+
+        Parameters
+        ----------
+        config : Dict[str, Any]
+            Configuration dictionary. Must include 'dim', the number of dimensions of the vectors.
+            May include:
+            'type': "flat" for exact search (default) or "hnsw" for approximate search on large
+            indexes,
+            'metric': "cosine" (default) or "dot",
+            'quantization': "fp32" (default) or "int8" to store vectors in a quarter of the memory,
+            'M', 'efConstruction' and 'efSearch': HNSW parameters, 16, 200 and 64 by default,
+            'path': file, relative to the SDK home directory, the index is saved to and loaded from.
+
+        Examples
+        --------
+        >>> index = nm.VectorIndex({"dim": 384, "type": "hnsw", "path": "faq_index.bin"})
+        """
+
+    def add(self, ids: Union[int, List[int]], vectors: Tensor) -> None:
+        """Add vectors, replacing the vectors already added with the same ids.
+
+        Parameters
+        ----------
+        ids : Union[int, List[int]]
+            Id of the vector, or ids of the vectors.
+        vectors : Tensor
+            Float or double tensor of one vector, or of one vector per id.
+
+        Examples
+        --------
+        >>> index.add(0, embedding)
+        >>> index.add([1, 2, 3], embeddings)  # embeddings of shape [3, dim]
+        """
+        pass
+
+    def remove(self, id: int) -> bool:
+        """Remove a vector.
+
+        Parameters
+        ----------
+        id : int
+            Id of the vector.
+
+        Returns
+        -------
+        bool
+            False if there was no vector with this id.
+        """
+        pass
+
+    def topk(self, query: Tensor, k: int) -> Tuple[List[float], List[int]]:
+        """Find the vectors most similar to a query.
+
+        Parameters
+        ----------
+        query : Tensor
+            Float or double tensor of dim elements.
+        k : int
+            Maximum number of results.
+
+        Returns
+        -------
+        Tuple[List[float], List[int]]
+            Scores and ids of the results, most similar first.
+        """
+        pass
+
+    def save(self) -> None:
+        """Write the index to the path of its configuration, replacing the file atomically.
+
+        The saved file is memory mapped when the index is loaded, so loading does not read it
+        whole.
+        """
+        pass
@@ -164,16 +164,17 @@ NimbleNetStatus* CommandCenter::run_task(const char* taskName, const char* funct
     // Store MapDataVariable, so as to deallocate later
     // Note that this is always stored so that the frontend can always access even in case of error.
     // This can be used by the script to return more information to the frontend
-    _outputs[_outputIndex] = outputDataVariable;
     // Set outputIndex in CTensors, which will be used to call deallocate_output_memory2 function
     {
+      // Tasks can run concurrently from multiple threads, so the index is reserved under the lock
       std::lock_guard<std::mutex> locker(_tensorStoreMutex);
+      _outputs[_outputIndex] = outputDataVariable;
       outputs->outputIndex = _outputIndex;
+      _outputIndex++;
     }
 
     outputs->numTensors = 0;
     outputs->tensors = nullptr;
-    _outputIndex++;
 
     _task->operate(functionName, inputTensor, outputDataVariable);
 
@@ -70,6 +70,18 @@ class Config {
   /** Debug flag to enable verbose logging or diagnostic behavior. */
   bool debug = false;
 
+  /** Run script functions on the bytecode interpreter instead of walking the AST. Opt-in. */
+  bool bytecodeInterpreter = false;
+
+  /**
+   * Let script functions that do not write state shared between their calls hold the script lock
+   * in shared mode, so that run_method calls of such functions from different threads execute in
+   * parallel. A function writes shared state if it assigns module variables or variables of an
+   * enclosing function, sets an element or attribute of an object, or calls a member function
+   * modifying its object, such as append. Such functions keep holding the lock exclusively.
+   */
+  bool scriptConcurrency = false;
+
   /**
    * @brief Maximum number of inputs to persist.
    *
@@ -83,6 +95,12 @@ class Config {
   /** Maximum size of event logs in kilobytes. */
   float maxEventsSizeKBs = loggerconstants::MaxEventsSizeKBs;
 
+  /**
+   * Write every event to disk as it is added, instead of in groups written out by size or after a
+   * delay. Trades add_event throughput for not losing the latest events on a crash.
+   */
+  bool flushEveryRecord = false;
+
   /** List of cohort identifiers where this configuration will be used. */
   nlohmann::json cohortIds = nlohmann::json::array();
 
@@ -45,6 +45,12 @@ void Config::init(const nlohmann::json& j) {
   if (j.find("online") != j.end()) {
     j.at("online").get_to(online);
   }
+  if (j.find("bytecodeInterpreter") != j.end()) {
+    j.at("bytecodeInterpreter").get_to(bytecodeInterpreter);
+  }
+  if (j.find("scriptConcurrency") != j.end()) {
+    j.at("scriptConcurrency").get_to(scriptConcurrency);
+  }
 
   if (j.find("maxDBSizeKBs") != j.end()) {
     j.at("maxDBSizeKBs").get_to(maxDBSizeKBs);
@@ -52,6 +58,9 @@ void Config::init(const nlohmann::json& j) {
   if (j.find("maxEventsSizeKBs") != j.end()) {
     j.at("maxEventsSizeKBs").get_to(maxEventsSizeKBs);
   }
+  if (j.find("flushEveryRecord") != j.end()) {
+    j.at("flushEveryRecord").get_to(flushEveryRecord);
+  }
   if (online) {
     j.at("compatibilityTag").get_to(compatibilityTag);
   } else {
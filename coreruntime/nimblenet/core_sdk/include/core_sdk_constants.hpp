@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include <cstddef>
+#include <cstdint>
 #include <string>
 
 /**
@@ -81,9 +81,26 @@ static inline const std::string SessionFilePath = "/session.txt";
 static inline const std::string DefaultCompatibilityTag = "DEFAULT-TAG";
 
 /**
- * @brief Maximum number of jobs the job scheduler can hold.
+ * @brief Default number of worker threads of the job scheduler.
  */
-static inline constexpr std::size_t JobSchedulerCapacity = 10;
+static inline const int DefaultJobSchedulerWorkers = 3;
+
+/**
+ * @brief Delay (in microseconds) before the first retry of a job returning RETRY.
+ *
+ * The delay doubles on every retry of the same job, up to JobRetryMaxDelayMicros.
+ */
+static inline const int64_t JobRetryInitialDelayMicros = 100000;
+
+/**
+ * @brief Maximum delay (in microseconds) between two retries of a job.
+ */
+static inline const int64_t JobRetryMaxDelayMicros = LongRunningThreadSleepUTime;
+
+/**
+ * @brief Granularity (in microseconds) of the timer wheel holding jobs waiting to be retried.
+ */
+static inline const int64_t JobRetryTimerTickMicros = 50000;
 
 #ifdef SIMULATION_MODE
 /**
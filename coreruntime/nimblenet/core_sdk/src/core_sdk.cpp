@@ -49,6 +49,9 @@ std::shared_ptr<Logger> logger = std::make_shared<Logger>(LogWritingConfig());
 
 void CoreSDK::thread_initializer() {
   _threadRunning = true;
+  // Jobs are performed by the workers as soon as they are ready, instead of on every pass of the
+  // long running thread
+  _jobScheduler->start_workers(_deviceConfiguration.jobSchedulerWorkers);
   _cmdThread = thread(&CoreSDK::perform_long_running_tasks, this);
 }
 
@@ -83,7 +86,7 @@ void CoreSDK::initialize_coreSDK() {
 
   _logSender = new LogSender(serverAPI(), _config, logger,
                              _deviceConfiguration.nimbleLoggerConfig.senderConfig);
-  _jobScheduler = std::make_shared<JobScheduler>(coresdkconstants::JobSchedulerCapacity);
+  _jobScheduler = std::make_shared<JobScheduler>();
 
   auto deployment = load_deployment_offline();
 
@@ -225,12 +228,15 @@ void CoreSDK::replace_command_center(const Deployment& deployment) {
 
   _commandCenterReady.store(false);
 
-  _database = new Database(&_metricsAgent);
+  // Jobs of the previous command center must not be running on a worker while it is replaced
+  _jobScheduler->pause_workers();
+  _database = new Database(&_metricsAgent, _config->flushEveryRecord);
   auto commandCenter =
       std::make_shared<CommandCenter>(serverAPI(), get_config(), &_metricsAgent, _database,
                                       _jobScheduler, externalLogger(), true, deployment);
 
   std::atomic_store(&_atomicCommandCenter, commandCenter);
+  _jobScheduler->resume_workers();
 
   _commandCenterReady.store(true);
   util::save_deployment_on_device(deployment, _config->compatibilityTag);
@@ -291,7 +297,6 @@ void CoreSDK::perform_long_running_tasks() {
   while (_threadRunning) {
     auto start = Time::get_high_resolution_clock_time();
     achieve_state();
-    _jobScheduler->do_jobs();
 
     util::delete_extra_files(nativeinterface::HOMEDIR, _deviceConfiguration.fileDeleteTimeInDays);
 
@@ -643,6 +648,7 @@ CoreSDK::~CoreSDK() {
     _threadRunning = false;
     _cmdThread.join();
   }
+  if (_jobScheduler) _jobScheduler->stop_workers();
   delete _logSender;
   delete _database;
 }
@@ -113,6 +113,7 @@ enum FileDownloadStatus {
 #define MODELTYPE "model"
 #define SCRIPTTYPE "script"
 #define INTERNALSTORAGEMETRICS "internalStorage"
+#define LLMINFERENCEMETRIC "llmInference"
 ///@}
 
 /**
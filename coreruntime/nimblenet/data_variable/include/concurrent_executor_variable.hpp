@@ -96,6 +96,8 @@ class ConcurrentExecutorVariable final : public DataVariable {
   OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
                              CallStack& stack) override;
 
+  bool is_mutating_member(int memberFuncIndex) const override;
+
   /**
    * @brief Reset the thread pool
    * @details Destroys the current thread pool instance
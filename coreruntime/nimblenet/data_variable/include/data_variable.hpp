@@ -203,6 +203,18 @@ class DataVariable : public std::enable_shared_from_this<DataVariable> {
   virtual OpReturnType call_function(int memberFuncIndex,
                                      const std::vector<OpReturnType>& arguments, CallStack& stack);
 
+  /**
+   * @brief Whether a member function modifies the variable
+   *
+   * Script functions only reading shared state run concurrently with each other, a member
+   * modifying its variable is run with the script lock held exclusively. Implementations of
+   * call_function list their members that only read the variable, or guard themselves, and defer
+   * the others to the class they extend. Members not listed are treated as modifying.
+   * @param memberFuncIndex The index of the member function
+   * @return false if the member can run concurrently with other readers of the variable
+   */
+  virtual bool is_mutating_member(int memberFuncIndex) const;
+
   virtual OpReturnType unary_sub() { THROW_UNSUPPORTED("unary_sub"); }
 
   virtual bool in(const OpReturnType& elem) { THROW_UNSUPPORTED("in"); }
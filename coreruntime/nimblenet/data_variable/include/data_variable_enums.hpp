@@ -130,5 +130,14 @@ enum MemberFuncType {
   CLEAR_CONTEXT,
   ADD_CONTEXT,
   LIST_COMPATIBLE_LLMS,
+  ARGMIN,
+  ARGMAX,
+  SOFTMAX,
+  LOG_SOFTMAX,
+  SET_SESSION,
+  VECTOR_INDEX,
+  ADD,
+  REMOVE,
+  SAVE,
   LASTTYPE,  // should be last
 };
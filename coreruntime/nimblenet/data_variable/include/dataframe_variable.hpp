@@ -15,8 +15,9 @@ class CommandCenter;
 class TableEventDataVariable final : public DataVariable {
   int get_containerType() const override { return CONTAINERTYPE::SINGLE; }
 
-  TableEvent* const _eventPtr;
-  std::map<std::string, int>* const _headerMapPtr;
+  // Events are only appended, so the index stays valid as long as the table is alive
+  const TableData* const _tableData;
+  const int _eventIndex;
 
   bool get_bool() override { return true; }
 
@@ -29,8 +30,8 @@ class TableEventDataVariable final : public DataVariable {
   nlohmann::json to_json() const override { return "[TableEvent]"; }
 
  public:
-  TableEventDataVariable(TableEvent* event, std::map<std::string, int>* headerMapPtr)
-      : _eventPtr(event), _headerMapPtr(headerMapPtr) {}
+  TableEventDataVariable(const TableData* tableData, int eventIndex)
+      : _tableData(tableData), _eventIndex(eventIndex) {}
 };
 
 class FilteredDataframeVariable final : public DataVariable {
@@ -83,4 +83,12 @@ class LLMDataVariable final : public DataVariable {
    * @return NoneVariable indicating successful context addition
    */
   OpReturnType add_context(const std::vector<OpReturnType>& arguments, CallStack& stack);
+
+  /**
+   * @brief Switches the LLM to a named session with its own context
+   * @param arguments Vector containing the session name as the first argument
+   * @param stack Current call stack for execution context
+   * @return NoneVariable indicating successful switch
+   */
+  OpReturnType set_session(const std::vector<OpReturnType>& arguments, CallStack& stack);
 };
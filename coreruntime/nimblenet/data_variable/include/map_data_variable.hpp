@@ -72,6 +72,8 @@ class MapDataVariable final : public DataVariable {
   OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
                              CallStack& stack) override;
 
+  bool is_mutating_member(int memberFuncIndex) const override;
+
  public:
   OpReturnType get_string_subscript(const std::string& key) override;
 
@@ -43,6 +43,8 @@ class MatchObjectDataVariable : public DataVariable {
   OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
                              CallStack& stack) override;
 
+  bool is_mutating_member(int memberFuncIndex) const override;
+
   nlohmann::json to_json() const override { return "[RegexMatchObject]"; }
 
  public:
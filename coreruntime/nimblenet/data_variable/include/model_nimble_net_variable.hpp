@@ -109,6 +109,17 @@ class ModelNimbleNetVariable final : public DataVariable {
           DataVariable::get_member_func_string(memberFuncIndex));
   }
 
+  bool is_mutating_member(int memberFuncIndex) const override {
+    switch (memberFuncIndex) {
+      // The model guards inference with its own mutex
+      case MemberFuncType::RUNMODEL:
+      case MemberFuncType::GETMODELSTATUS:
+        return false;
+      default:
+        return DataVariable::is_mutating_member(memberFuncIndex);
+    }
+  }
+
   nlohmann::json to_json() const override { return "[Model]"; }
 
  public:
@@ -35,7 +35,8 @@ class CommandCenter;
  * The class implements a comprehensive set of operations including:
  * - Tensor creation and manipulation
  * - Model and LLM loading with async support
- * - Mathematical functions (exp, pow, min, max, sum, mean, log)
+ * - Mathematical functions (exp, pow, log) and tensor reductions (min, max, sum, mean, argmin,
+ *   argmax, softmax, log_softmax) optionally along an axis
  * - Data storage and retrieval (raw events, dataframes)
  * - System utilities (time, configuration access)
  * - Concurrent execution support
@@ -97,10 +98,20 @@ def zeros(shape: list[int], dtype: str) -> Tensor:
 
   OpReturnType mean(const std::vector<OpReturnType>& args);
 
+  OpReturnType argmin(const std::vector<OpReturnType>& args);
+
+  OpReturnType argmax(const std::vector<OpReturnType>& args);
+
+  OpReturnType softmax(const std::vector<OpReturnType>& args);
+
+  OpReturnType log_softmax(const std::vector<OpReturnType>& args);
+
   OpReturnType log(const std::vector<OpReturnType>& args);
 
   OpReturnType create_retriever(const std::vector<OpReturnType>& arguments, CallStack& stack);
 
+  OpReturnType create_vector_index(const std::vector<OpReturnType>& arguments);
+
   OpReturnType create_json_document(const std::vector<OpReturnType>& arguments, CallStack& stack) {
     THROW("%s", "Currently not supporting loading JSON document directly");
   }
@@ -116,6 +127,8 @@ def zeros(shape: list[int], dtype: str) -> Tensor:
   OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
                              CallStack& stack) override;
 
+  bool is_mutating_member(int memberFuncIndex) const override;
+
   nlohmann::json to_json() const override { return "[NimbleNet]"; }
 
  public:
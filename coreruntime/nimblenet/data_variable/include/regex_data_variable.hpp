@@ -115,6 +115,8 @@ class RegexDataVariable : public DataVariable {
   OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
                              CallStack& stack) override;
 
+  bool is_mutating_member(int memberFuncIndex) const override;
+
  public:
   RegexDataVariable() {}
 
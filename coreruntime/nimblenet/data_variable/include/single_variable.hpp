@@ -143,6 +143,8 @@ class SingleVariable<std::string> final : public BaseSingleVariable {
   OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
                              CallStack& stack) override;
 
+  bool is_mutating_member(int memberFuncIndex) const override;
+
   // Override get_subscript to handle both integer indices and slice objects
   OpReturnType get_subscript(const OpReturnType& subscriptVal) override;
 
@@ -28,6 +28,9 @@ class Task;
 class StreamDataVariable : public DataVariable {
   OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
                              CallStack& stack) final;
+
+  // Members run without the script lock and hold the stream push lock of the task instead
+  bool is_mutating_member(int memberFuncIndex) const final { return false; }
   virtual OpReturnType execute_member_function(int memberFuncIndex,
                                                const std::vector<OpReturnType>& arguments,
                                                CallStack& stack) = 0;
@@ -0,0 +1,226 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "util.hpp"
+
+/**
+ * @file tensor_reduction_kernels.hpp
+ * @brief Typed reduction kernels operating directly on raw tensor buffers
+ *
+ * A reduction along an axis views a row-major tensor as [outer, axisLen, inner] where outer is the
+ * product of the dimensions before the axis and inner the product of the dimensions after it.
+ * Kernels walk the axis in the middle loop and the contiguous inner dimension in the innermost
+ * loop, so that the hot loops are unit-stride and auto-vectorizable. Whole tensor reductions are
+ * the special case outer = inner = 1 and use multiple independent accumulators to break the
+ * floating point dependency chain.
+ */
+
+namespace ne {
+
+/**
+ * @brief Decomposition of a tensor shape around the axis being reduced
+ */
+struct ReductionShape {
+  int64_t outer = 1;              /**< Product of dimensions before the axis */
+  int64_t axisLen = 1;            /**< Length of the reduced axis */
+  int64_t inner = 1;              /**< Product of dimensions after the axis */
+  std::vector<int64_t> outShape;  /**< Shape of the result with the axis removed */
+};
+
+/**
+ * @brief Computes the reduction decomposition of a shape for the given axis
+ *
+ * @param shape Shape of the input tensor.
+ * @param axis Axis to reduce, negative values count from the last dimension.
+ * @return Decomposition of the shape around the axis.
+ * @throws If the axis is out of range or the axis is empty.
+ */
+inline ReductionShape get_reduction_shape(const std::vector<int64_t>& shape, int axis) {
+  const int rank = shape.size();
+  if (axis < 0) {
+    axis += rank;
+  }
+  if (axis < 0 || axis >= rank) {
+    THROW("axis %d is out of bounds for tensor of dimension %d", axis, rank);
+  }
+  ReductionShape reductionShape;
+  for (int i = 0; i < rank; i++) {
+    if (i < axis) {
+      reductionShape.outer *= shape[i];
+    } else if (i > axis) {
+      reductionShape.inner *= shape[i];
+    }
+    if (i != axis) {
+      reductionShape.outShape.push_back(shape[i]);
+    }
+  }
+  reductionShape.axisLen = shape[axis];
+  if (reductionShape.axisLen <= 0) {
+    THROW("%s", "Expected a non-empty tensor");
+  }
+  return reductionShape;
+}
+
+/**
+ * @brief Accumulator type used for sums, wide enough to avoid overflow for integers
+ */
+template <typename T>
+using SumAccumulator = std::conditional_t<std::is_integral_v<T>, int64_t, T>;
+
+struct MinReducer {
+  template <typename T>
+  static T apply(T a, T b) {
+    return b < a ? b : a;
+  }
+};
+
+struct MaxReducer {
+  template <typename T>
+  static T apply(T a, T b) {
+    return b > a ? b : a;
+  }
+};
+
+struct SumReducer {
+  template <typename T>
+  static T apply(T a, T b) {
+    return a + b;
+  }
+};
+
+/**
+ * @brief Reduces a contiguous buffer to a single value
+ *
+ * Uses 8 independent accumulators so that the compiler can keep them in a vector register.
+ */
+template <typename Reducer, typename Acc, typename T>
+Acc reduce_contiguous(const T* data, int64_t n, Acc init) {
+  constexpr int kLanes = 8;
+  Acc lanes[kLanes];
+  for (int l = 0; l < kLanes; l++) {
+    lanes[l] = init;
+  }
+  int64_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    for (int l = 0; l < kLanes; l++) {
+      lanes[l] = Reducer::apply(lanes[l], static_cast<Acc>(data[i + l]));
+    }
+  }
+  Acc result = init;
+  for (int l = 0; l < kLanes; l++) {
+    result = Reducer::apply(result, lanes[l]);
+  }
+  for (; i < n; i++) {
+    result = Reducer::apply(result, static_cast<Acc>(data[i]));
+  }
+  return result;
+}
+
+/**
+ * @brief Reduces a tensor along an axis into out, which should hold outer * inner elements
+ *
+ * For min/max the first slice along the axis is used as the initial value, for sum the output is
+ * initialized with zero.
+ */
+template <typename Reducer, typename Acc, typename T>
+void reduce_axis(const T* data, const ReductionShape& rs, Acc* out, bool initWithFirst) {
+  for (int64_t o = 0; o < rs.outer; o++) {
+    const T* block = data + o * rs.axisLen * rs.inner;
+    Acc* outRow = out + o * rs.inner;
+    if (rs.inner == 1) {
+      Acc init = initWithFirst ? static_cast<Acc>(block[0]) : Acc{0};
+      outRow[0] = reduce_contiguous<Reducer, Acc>(block, rs.axisLen, init);
+      continue;
+    }
+    for (int64_t j = 0; j < rs.inner; j++) {
+      outRow[j] = initWithFirst ? static_cast<Acc>(block[j]) : Acc{0};
+    }
+    for (int64_t k = initWithFirst ? 1 : 0; k < rs.axisLen; k++) {
+      const T* row = block + k * rs.inner;
+      for (int64_t j = 0; j < rs.inner; j++) {
+        outRow[j] = Reducer::apply(outRow[j], static_cast<Acc>(row[j]));
+      }
+    }
+  }
+}
+
+/**
+ * @brief Writes the index of the first minimum (or maximum) element along an axis into out
+ */
+template <bool IsMax, typename T>
+void arg_reduce_axis(const T* data, const ReductionShape& rs, int64_t* out) {
+  std::vector<T> best(rs.inner);
+  for (int64_t o = 0; o < rs.outer; o++) {
+    const T* block = data + o * rs.axisLen * rs.inner;
+    int64_t* outRow = out + o * rs.inner;
+    for (int64_t j = 0; j < rs.inner; j++) {
+      best[j] = block[j];
+      outRow[j] = 0;
+    }
+    for (int64_t k = 1; k < rs.axisLen; k++) {
+      const T* row = block + k * rs.inner;
+      for (int64_t j = 0; j < rs.inner; j++) {
+        bool better = IsMax ? row[j] > best[j] : row[j] < best[j];
+        best[j] = better ? row[j] : best[j];
+        outRow[j] = better ? k : outRow[j];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Numerically stable softmax (or log-softmax) along an axis
+ *
+ * The output has the same shape as the input. The maximum along the axis is subtracted before
+ * exponentiation to avoid overflow.
+ */
+template <bool IsLog, typename T>
+void softmax_axis(const T* data, const ReductionShape& rs, T* out) {
+  static_assert(std::is_floating_point_v<T>, "softmax requires a floating point type");
+  std::vector<T> maxRow(rs.inner), sumRow(rs.inner);
+  for (int64_t o = 0; o < rs.outer; o++) {
+    const T* block = data + o * rs.axisLen * rs.inner;
+    T* outBlock = out + o * rs.axisLen * rs.inner;
+    for (int64_t j = 0; j < rs.inner; j++) {
+      maxRow[j] = block[j];
+      sumRow[j] = 0;
+    }
+    for (int64_t k = 1; k < rs.axisLen; k++) {
+      const T* row = block + k * rs.inner;
+      for (int64_t j = 0; j < rs.inner; j++) {
+        maxRow[j] = row[j] > maxRow[j] ? row[j] : maxRow[j];
+      }
+    }
+    for (int64_t k = 0; k < rs.axisLen; k++) {
+      const T* row = block + k * rs.inner;
+      T* outRow = outBlock + k * rs.inner;
+      for (int64_t j = 0; j < rs.inner; j++) {
+        outRow[j] = row[j] - maxRow[j];
+        sumRow[j] += std::exp(outRow[j]);
+      }
+    }
+    for (int64_t k = 0; k < rs.axisLen; k++) {
+      T* outRow = outBlock + k * rs.inner;
+      for (int64_t j = 0; j < rs.inner; j++) {
+        if constexpr (IsLog) {
+          outRow[j] -= std::log(sumRow[j]);
+        } else {
+          outRow[j] = std::exp(outRow[j]) / sumRow[j];
+        }
+      }
+    }
+  }
+}
+
+}  // namespace ne
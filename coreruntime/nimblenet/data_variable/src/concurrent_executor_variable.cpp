@@ -6,8 +6,6 @@
 
 #include "concurrent_executor_variable.hpp"
 
-#include <optional>
-
 std::unique_ptr<ThreadPool> ConcurrentExecutorVariable::_threadpool = nullptr;
 
 /**
@@ -71,50 +69,25 @@ OpReturnType ConcurrentExecutorVariable::run_parallel(const std::vector<OpReturn
   }
   auto functionDataVariable = arguments[0];
   auto iteratableArg = arguments[1];
-  std::vector<OpReturnType> remainingArgs(arguments.begin() + 1, arguments.end());
-
-  std::vector<std::future<OpReturnType>> returnVals;
   int totalParallelCalls = iteratableArg->get_size();
-
-  // using atomic variable to early cancel other tasks if thread is complete.
-  std::shared_ptr<std::atomic<bool>> toCancel = std::make_shared<std::atomic<bool>>(false);
+  std::vector<OpReturnType> items(totalParallelCalls);
   for (int i = 0; i < totalParallelCalls; i++) {
-    // set 1st argument of the remaining args with item in the iteratable
-    remainingArgs[0] = iteratableArg->get_int_subscript(i);
-
-    auto lambdaFunc = [func = functionDataVariable, args = remainingArgs, &stack,
-                       cancel = toCancel]() -> OpReturnType {
-      if (*cancel) {
-        return nullptr;
-      }
-      // TODO: when we change script lock, ensure that newStack is captured by value in lambda
-      auto newStack = stack.create_copy_with_deferred_lock();
-      return func->execute_function(args, newStack);
-    };
-    returnVals.emplace_back(_threadpool->enqueue(lambdaFunc));
+    items[i] = iteratableArg->get_int_subscript(i);
   }
-  std::vector<OpReturnType> returnList;
-  std::optional<std::runtime_error> firstError;
-  for (int i = 0; i < totalParallelCalls; i++) {
-    OpReturnType ret;
-    std::future_status status;
-    while ((status = returnVals[i].wait_for(std::chrono::milliseconds(0))) !=
-           std::future_status::ready) {
-      _threadpool->run_threadpool_task();
-    }
-    try {
-      ret = returnVals[i].get();
-    } catch (std::runtime_error& e) {
-      *toCancel = true;
-      if (!firstError) {
-        firstError = e;  // Store only the first exception
-      }
+
+  // Items are split into a few ranges shared by the workers and this thread, instead of one task
+  // per item. A range stops at the first error and ranges not started yet are skipped.
+  std::vector<OpReturnType> returnList(totalParallelCalls);
+  _threadpool->parallel_for(0, totalParallelCalls, [&](int begin, int end) {
+    std::vector<OpReturnType> args(arguments.begin() + 1, arguments.end());
+    // TODO: when we change script lock, ensure that newStack is captured by value in lambda
+    auto newStack = stack.create_copy_with_deferred_lock();
+    for (int i = begin; i < end; i++) {
+      // set 1st argument of the remaining args with item in the iteratable
+      args[0] = items[i];
+      returnList[i] = functionDataVariable->execute_function(args, newStack);
     }
-    returnList.push_back(ret);
-  }
-  if (firstError) {
-    throw *firstError;
-  }
+  });
   return std::make_shared<ListDataVariable>(std::move(returnList));
 }
 
@@ -129,3 +102,14 @@ OpReturnType ConcurrentExecutorVariable::call_function(int memberFuncIndex,
   }
   THROW("%s not implemented for nimblenet", DataVariable::get_member_func_string(memberFuncIndex));
 }
+
+bool ConcurrentExecutorVariable::is_mutating_member(int memberFuncIndex) const {
+  switch (memberFuncIndex) {
+    // The functions run take the script lock themselves, sync is serialized by _mutex
+    case MemberFuncType::SYNC:
+    case MemberFuncType::RUNPARALLEL:
+      return false;
+    default:
+      return DataVariable::is_mutating_member(memberFuncIndex);
+  }
+}
@@ -103,6 +103,15 @@ std::map<std::string, int> DataVariable::_memberFuncMap = {
     {"clear_context", MemberFuncType::CLEAR_CONTEXT},
     {"add_context", MemberFuncType::ADD_CONTEXT},
     {"list_compatible_llms", MemberFuncType::LIST_COMPATIBLE_LLMS},
+    {"argmin", MemberFuncType::ARGMIN},
+    {"argmax", MemberFuncType::ARGMAX},
+    {"softmax", MemberFuncType::SOFTMAX},
+    {"log_softmax", MemberFuncType::LOG_SOFTMAX},
+    {"set_session", MemberFuncType::SET_SESSION},
+    {"VectorIndex", MemberFuncType::VECTOR_INDEX},
+    {"add", MemberFuncType::ADD},
+    {"remove", MemberFuncType::REMOVE},
+    {"save", MemberFuncType::SAVE},
 };
 
 std::map<int, std::string> DataVariable::_inverseMemberFuncMap = {
@@ -191,6 +200,15 @@ std::map<int, std::string> DataVariable::_inverseMemberFuncMap = {
     {MemberFuncType::CLEAR_CONTEXT, "clear_context"},
     {MemberFuncType::ADD_CONTEXT, "add_context"},
     {MemberFuncType::LIST_COMPATIBLE_LLMS, "list_compatible_llms"},
+    {MemberFuncType::ARGMIN, "argmin"},
+    {MemberFuncType::ARGMAX, "argmax"},
+    {MemberFuncType::SOFTMAX, "softmax"},
+    {MemberFuncType::LOG_SOFTMAX, "log_softmax"},
+    {MemberFuncType::SET_SESSION, "set_session"},
+    {MemberFuncType::VECTOR_INDEX, "VectorIndex"},
+    {MemberFuncType::ADD, "add"},
+    {MemberFuncType::REMOVE, "remove"},
+    {MemberFuncType::SAVE, "save"},
 };
 
 int DataVariable::add_and_get_member_func_index(const std::string& memberFuncString) {
@@ -447,6 +465,22 @@ OpReturnType DataVariable::call_function(int memberFuncIndex,
         get_containerType_string(), util::get_string_from_enum(get_dataType_enum()));
 }
 
+bool DataVariable::is_mutating_member(int memberFuncIndex) const {
+  switch (memberFuncIndex) {
+    case MemberFuncType::GETSHAPE:
+    case MemberFuncType::ARGSORT:
+    case MemberFuncType::TOPK:
+    case MemberFuncType::ARRANGE:
+    case MemberFuncType::ISINTEGER:
+    case MemberFuncType::ISFLOAT:
+    case MemberFuncType::ISSTRING:
+      return false;
+    default:
+      // reshape, append and sort work in place
+      return true;
+  }
+}
+
 OpReturnType DataVariable::create_tensor(const CTensor& c, CreateTensorType type) {
   std::vector<int64_t> shape(c.shape, c.shape + c.shapeLength);
   switch (c.dataType) {
@@ -14,13 +14,13 @@
 
 OpReturnType TableEventDataVariable::get_string_subscript(const std::string& key) {
   if (key == "timestamp" || key == "TIMESTAMP") {
-    return OpReturnType(new SingleVariable<int64_t>(_eventPtr->timestamp));
+    return OpReturnType(new SingleVariable<int64_t>(_tableData->timestamps[_eventIndex]));
   }
-  if (_headerMapPtr->find(key) == _headerMapPtr->end()) {
+  auto it = _tableData->columnToIdMap.find(key);
+  if (it == _tableData->columnToIdMap.end()) {
     THROW("key=%s not found in event", key.c_str());
   }
-  int index = _headerMapPtr->at(key);
-  return _eventPtr->row[index];
+  return _tableData->columnValues[it->second].get_variable(_eventIndex);
 }
 
 OpReturnType DataframeVariable::filter_all(const std::vector<OpReturnType>& arguments) {
@@ -43,9 +43,7 @@ OpReturnType FilteredDataframeVariable::filter_by_function(
 
   std::vector<int> selectedIndices;
   for (const int i : _selectedIndices) {
-    auto& event = _tableData->allEvents.at(i);
-    OpReturnType eventVariable =
-        OpReturnType(new TableEventDataVariable(&event, &_tableData->columnToIdMap));
+    OpReturnType eventVariable = OpReturnType(new TableEventDataVariable(_tableData.get(), i));
     OpReturnType functionReturn = arguments[0]->execute_function({eventVariable}, stack);
     if (functionReturn->get_bool()) {
       selectedIndices.push_back(i);
@@ -57,7 +55,7 @@ OpReturnType FilteredDataframeVariable::filter_by_function(
 }
 
 OpReturnType FilteredDataframeVariable::all_events(std::shared_ptr<TableData> tableData) {
-  std::vector<int> selectedIndices(tableData->allEvents.size());
+  std::vector<int> selectedIndices(tableData->num_events());
   std::iota(selectedIndices.begin(), selectedIndices.end(), 0);
   return std::shared_ptr<FilteredDataframeVariable>(
       new FilteredDataframeVariable(tableData, std::move(selectedIndices)));
@@ -66,10 +64,8 @@ OpReturnType FilteredDataframeVariable::all_events(std::shared_ptr<TableData> ta
 OpReturnType FilteredDataframeVariable::events_filtered_by_function(
     std::shared_ptr<TableData> tableData, OpReturnType func, CallStack& stack) {
   std::vector<int> selectedIndices;
-  for (int i = 0; i < tableData->allEvents.size(); i++) {
-    auto& event = tableData->allEvents.at(i);
-    OpReturnType eventVariable =
-        OpReturnType(new TableEventDataVariable(&event, &tableData->columnToIdMap));
+  for (int i = 0; i < tableData->num_events(); i++) {
+    OpReturnType eventVariable = OpReturnType(new TableEventDataVariable(tableData.get(), i));
     OpReturnType functionReturn = func->execute_function({eventVariable}, stack);
     if (functionReturn->get_bool()) {
       selectedIndices.push_back(i);
@@ -92,35 +88,31 @@ OpReturnType FilteredDataframeVariable::feature_fetch(const std::vector<OpReturn
   if (_selectedIndices.size() == 0) {
     THROW("%s", "Either no events filtered or filtering returned 0 events");
   }
-  int rowIndex = _tableData->columnToIdMap.at(key);
+  const auto& column = _tableData->columnValues[_tableData->columnToIdMap.at(key)];
   if (!util::is_dType_array(type)) {
     auto outputTensor = DataVariable::create_tensor(type, {(long long)_selectedIndices.size()});
     void* tensorPtr = outputTensor->get_raw_ptr();
-    for (int i = 0; i < _selectedIndices.size(); i++) {
-      const TableEvent& data = _tableData->allEvents.at(_selectedIndices[i]);
-      switch (type) {
-        case DATATYPE::INT32:
-          ((int32_t*)tensorPtr)[i] = data.row[rowIndex]->get_int32();
-          break;
-        case DATATYPE::FLOAT:
-          ((float*)tensorPtr)[i] = data.row[rowIndex]->get_float();
-          break;
-        case DATATYPE::INT64:
-          ((int64_t*)tensorPtr)[i] = data.row[rowIndex]->get_int64();
-          break;
-        case DATATYPE::DOUBLE:
-          ((double*)tensorPtr)[i] = data.row[rowIndex]->get_double();
-          break;
-        case DATATYPE::STRING:
-          ((std::string*)tensorPtr)[i] = data.row[rowIndex]->get_string();
-          break;
-        case DATATYPE::BOOLEAN:
-          ((bool*)tensorPtr)[i] = data.row[rowIndex]->get_bool();
-          break;
-        default:
-          THROW("data type %s is not supported from events store.",
-                util::get_string_from_enum(type));
-      }
+    switch (type) {
+      case DATATYPE::INT32:
+        column.gather(_selectedIndices, (int32_t*)tensorPtr);
+        break;
+      case DATATYPE::FLOAT:
+        column.gather(_selectedIndices, (float*)tensorPtr);
+        break;
+      case DATATYPE::INT64:
+        column.gather(_selectedIndices, (int64_t*)tensorPtr);
+        break;
+      case DATATYPE::DOUBLE:
+        column.gather(_selectedIndices, (double*)tensorPtr);
+        break;
+      case DATATYPE::STRING:
+        column.gather(_selectedIndices, (std::string*)tensorPtr);
+        break;
+      case DATATYPE::BOOLEAN:
+        column.gather(_selectedIndices, (bool*)tensorPtr);
+        break;
+      default:
+        THROW("data type %s is not supported from events store.", util::get_string_from_enum(type));
     }
     return outputTensor;
   }
@@ -128,8 +120,7 @@ OpReturnType FilteredDataframeVariable::feature_fetch(const std::vector<OpReturn
   // for each tensor need to cast it to data type given as an argument
   std::vector<OpReturnType> members;
   for (int i = 0; i < _selectedIndices.size(); i++) {
-    const TableEvent& data = _tableData->allEvents.at(_selectedIndices[i]);
-    OpReturnType storedTensor = data.row[rowIndex];
+    OpReturnType storedTensor = column.get_variable(_selectedIndices[i]);
     auto castedTensor = DataVariable::create_tensor(util::get_primitive_dType(type),
                                                     {(long long)storedTensor->get_numElements()});
     void* tensorPtr = castedTensor->get_raw_ptr();
@@ -184,22 +175,22 @@ OpReturnType FilteredDataframeVariable::feature_fetch_timestamp(OpReturnType typ
   auto outputTensor = DataVariable::create_tensor(type, {(long long)_selectedIndices.size()});
   void* tensorPtr = outputTensor->get_raw_ptr();
   for (int i = 0; i < _selectedIndices.size(); i++) {
-    const TableEvent& data = _tableData->allEvents.at(_selectedIndices[i]);
+    int64_t timestamp = _tableData->timestamps[_selectedIndices[i]];
     switch (type) {
       case DATATYPE::INT32:
-        ((int32_t*)tensorPtr)[i] = (int32_t)data.timestamp;
+        ((int32_t*)tensorPtr)[i] = (int32_t)timestamp;
         break;
       case DATATYPE::FLOAT:
-        ((float*)tensorPtr)[i] = (float)data.timestamp;
+        ((float*)tensorPtr)[i] = (float)timestamp;
         break;
       case DATATYPE::INT64:
-        ((int64_t*)tensorPtr)[i] = (int64_t)data.timestamp;
+        ((int64_t*)tensorPtr)[i] = (int64_t)timestamp;
         break;
       case DATATYPE::DOUBLE:
-        ((double*)tensorPtr)[i] = (double)data.timestamp;
+        ((double*)tensorPtr)[i] = (double)timestamp;
         break;
       case DATATYPE::STRING:
-        ((std::string*)tensorPtr)[i] = std::to_string(data.timestamp);
+        ((std::string*)tensorPtr)[i] = std::to_string(timestamp);
         break;
       default:
         THROW("data type %s is not supported for fetching TIMESTAMP from events store.",
@@ -92,6 +92,8 @@ OpReturnType LLMDataVariable::call_function(int memberFuncIndex,
       return cancel_generation(arguments, stack);
     case CLEAR_CONTEXT:
       return _llmExecutor->clear_context();
+    case SET_SESSION:
+      return set_session(arguments, stack);
   }
   THROW("%s not implemented for llm", DataVariable::get_member_func_string(memberFuncIndex));
 }
@@ -154,3 +156,12 @@ OpReturnType LLMDataVariable::add_context(const std::vector<OpReturnType>& argum
   _llmExecutor->add_prompt(prompt);
   return std::make_shared<NoneVariable>();
 }
+
+OpReturnType LLMDataVariable::set_session(const std::vector<OpReturnType>& arguments,
+                                          CallStack& stack) {
+  THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 1, SET_SESSION);
+  THROW_ARGUMENT_DATATYPE_NOT_MATCH(arguments[0]->get_dataType_enum(), DATATYPE::STRING, 0,
+                                    SET_SESSION);
+  _llmExecutor->set_session(arguments[0]->get_string());
+  return std::make_shared<NoneVariable>();
+}
@@ -104,6 +104,17 @@ OpReturnType MapDataVariable::call_function(int memberFuncIndex,
   THROW("%s not implemented for dict.", DataVariable::get_member_func_string(memberFuncIndex));
 }
 
+bool MapDataVariable::is_mutating_member(int memberFuncIndex) const {
+  switch (memberFuncIndex) {
+    // Guarded by _mutex
+    case MemberFuncType::POP:
+    case MemberFuncType::KEYS:
+      return false;
+    default:
+      return DataVariable::is_mutating_member(memberFuncIndex);
+  }
+}
+
 OpReturnType MapDataVariable::get_string_subscript(const std::string& key) {
   std::shared_lock lock(_mutex);
   if (_map.find(key) == _map.end()) {
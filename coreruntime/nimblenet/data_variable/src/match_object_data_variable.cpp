@@ -160,3 +160,16 @@ OpReturnType MatchObjectDataVariable::call_function(int memberFuncIndex,
             DataVariable::get_member_func_string(memberFuncIndex));
   }
 }
+
+bool MatchObjectDataVariable::is_mutating_member(int memberFuncIndex) const {
+  switch (memberFuncIndex) {
+    case MemberFuncType::REGEX_MATCHOBJECT_GROUP:
+    case MemberFuncType::REGEX_MATCHOBJECT_GROUPS:
+    case MemberFuncType::REGEX_MATCHOBJECT_START:
+    case MemberFuncType::REGEX_MATCHOBJECT_END:
+    case MemberFuncType::REGEX_MATCHOBJECT_SPAN:
+      return false;
+    default:
+      return DataVariable::is_mutating_member(memberFuncIndex);
+  }
+}
@@ -18,11 +18,13 @@
 #include "nlohmann/json_fwd.hpp"
 #include "pre_processor_nimble_net_variable.hpp"
 #include "raw_event_store_data_variable.hpp"
+#include "tensor_reduction_kernels.hpp"
 
 #ifdef GENAI
 #include "llm_data_variable.hpp"
 #include "llm_utils.hpp"
 #include "retriever.hpp"
+#include "vector_index_data_variable.hpp"
 #endif  // GENAI
 
 OpReturnType NimbleNetDataVariable::create_tensor(const std::vector<OpReturnType>& arguments) {
@@ -124,97 +126,265 @@ OpReturnType NimbleNetDataVariable::get_dataframe(const std::vector<OpReturnType
   return OpReturnType(new DataframeVariable(_commandCenter, schema));
 }
 
-OpReturnType NimbleNetDataVariable::min(const std::vector<OpReturnType>& args) {
-  THROW_ARGUMENTS_NOT_MATCH(args.size(), 1, MemberFuncType::MIN);
+/**
+ * @brief Returns the numeric typed tensor a reduction operates on, throws for other variables
+ */
+static std::shared_ptr<BaseTypedTensorVariable> get_reduction_tensor(const OpReturnType& arg,
+                                                                     const char* funcName) {
+  auto typedTensor = std::dynamic_pointer_cast<BaseTypedTensorVariable>(arg);
+  if (!typedTensor) {
+    THROW("%s expected a tensor, got %s", funcName, arg->get_containerType_string());
+  }
+  if (typedTensor->get_numElements() == 0) {
+    THROW("%s", "Expected a non-empty tensor");
+  }
+  return typedTensor;
+}
 
-  auto findMin = [tensor = args[0]](auto typeObj) -> OpReturnType {
-    using T = decltype(typeObj);
-    auto typedTensor = std::dynamic_pointer_cast<BaseTypedTensorVariable>(tensor);
-    if (!typedTensor) {
-      THROW("min expected a tensor, got %s", tensor->get_containerType_string());
-    }
+/**
+ * @brief Reads the optional axis argument of a reduction
+ *
+ * @return false if no axis is given or it is None, i.e. the reduction is over all elements.
+ */
+static bool get_axis_argument(const std::vector<OpReturnType>& args, int& axis) {
+  if (args.size() < 2 || args[1]->is_none()) {
+    return false;
+  }
+  if (!args[1]->is_integer()) {
+    THROW("axis should be an integer, given %s",
+          util::get_string_from_enum(args[1]->get_dataType_enum()));
+  }
+  axis = args[1]->get_int32();
+  return true;
+}
 
-    const auto resultIt = std::min_element(typedTensor->begin<T>(), typedTensor->end<T>());
-    if (resultIt == typedTensor->end<T>()) {
-      THROW("%s", "Expected a non-empty tensor");
-    }
-    auto result = *resultIt;
-    return std::make_shared<SingleVariable<decltype(result)>>(result);
-  };
+/**
+ * @brief Wraps a reduction output buffer into a tensor, or a single variable for 0-d results
+ */
+template <typename T>
+static OpReturnType make_reduction_output(const std::vector<int64_t>& shape, T* data) {
+  if (shape.empty()) {
+    T val = data[0];
+    free(data);
+    return std::make_shared<SingleVariable<T>>(val);
+  }
+  return std::make_shared<TensorVariable>(data, static_cast<DATATYPE>(get_dataType_enum<T>()),
+                                          shape, CreateTensorType::MOVE);
+}
 
-  return util::call_function_for_dataType(findMin,
-                                          static_cast<DATATYPE>(args[0]->get_dataType_enum()));
+/**
+ * @brief Min or max over all elements of a string tensor, comparing the strings lexicographically
+ */
+template <typename Reducer, bool IsSum>
+static OpReturnType reduce_string_tensor(const std::vector<OpReturnType>& args,
+                                         const char* funcName) {
+  int axis = 0;
+  if (IsSum || get_axis_argument(args, axis)) {
+    THROW("%s only supports integral and floating point tensors%s", funcName,
+          IsSum ? "" : " along an axis");
+  }
+  const int n = args[0]->get_numElements();
+  if (n == 0) {
+    THROW("%s", "Expected a non-empty tensor");
+  }
+  const auto* data = static_cast<const std::string*>(args[0]->get_raw_ptr());
+  const auto* result = std::is_same_v<Reducer, ne::MinReducer> ? std::min_element(data, data + n)
+                                                               : std::max_element(data, data + n);
+  return std::make_shared<SingleVariable<std::string>>(*result);
 }
 
-OpReturnType NimbleNetDataVariable::max(const std::vector<OpReturnType>& args) {
-  THROW_ARGUMENTS_NOT_MATCH(args.size(), 1, MemberFuncType::MAX);
+/**
+ * @brief Common implementation of min, max and sum over all elements or along an axis
+ *
+ * The result has the same data type as the tensor. Integer sums are accumulated in 64 bits. String
+ * tensors only support min and max over all elements.
+ */
+template <typename Reducer, bool IsSum>
+static OpReturnType reduce_tensor(const std::vector<OpReturnType>& args, const char* funcName) {
+  if (args[0]->is_string() && args[0]->get_containerType() == CONTAINERTYPE::VECTOR) {
+    return reduce_string_tensor<Reducer, IsSum>(args, funcName);
+  }
+  auto typedTensor = get_reduction_tensor(args[0], funcName);
+  int axis = 0;
+  bool hasAxis = get_axis_argument(args, axis);
 
-  auto findMax = [tensor = args[0]](auto typeObj) -> OpReturnType {
+  auto func = [&](auto typeObj) -> OpReturnType {
     using T = decltype(typeObj);
-    auto typedTensor = std::dynamic_pointer_cast<BaseTypedTensorVariable>(tensor);
-    if (!typedTensor) {
-      THROW("max expected a tensor, got %s", tensor->get_containerType_string());
-    }
+    if constexpr (!std::is_arithmetic_v<T>) {
+      THROW("%s only supports integral and floating point tensors", funcName);
+    } else {
+      using Acc = std::conditional_t<IsSum, ne::SumAccumulator<T>, T>;
+      const T* data = typedTensor->template begin<T>();
+      if (!hasAxis) {
+        Acc init = IsSum ? Acc{0} : static_cast<Acc>(data[0]);
+        T result = static_cast<T>(
+            ne::reduce_contiguous<Reducer, Acc>(data, typedTensor->get_numElements(), init));
+        return std::make_shared<SingleVariable<T>>(result);
+      }
 
-    const auto resultIt = std::max_element(typedTensor->begin<T>(), typedTensor->end<T>());
-    if (resultIt == typedTensor->end<T>()) {
-      THROW("%s", "Expected a non-empty tensor");
+      auto rs = ne::get_reduction_shape(typedTensor->get_shape(), axis);
+      const int64_t outSize = rs.outer * rs.inner;
+      T* out = static_cast<T*>(malloc(sizeof(T) * outSize));
+      if constexpr (std::is_same_v<Acc, T>) {
+        ne::reduce_axis<Reducer, Acc>(data, rs, out, !IsSum);
+      } else {
+        std::vector<Acc> acc(outSize);
+        ne::reduce_axis<Reducer, Acc>(data, rs, acc.data(), !IsSum);
+        for (int64_t i = 0; i < outSize; i++) {
+          out[i] = static_cast<T>(acc[i]);
+        }
+      }
+      return make_reduction_output(rs.outShape, out);
     }
-    auto result = *resultIt;
-    return std::make_shared<SingleVariable<decltype(result)>>(result);
   };
 
-  return util::call_function_for_dataType(findMax,
-                                          static_cast<DATATYPE>(args[0]->get_dataType_enum()));
+  return util::call_function_for_dataType(
+      func, static_cast<DATATYPE>(args[0]->get_dataType_enum()));
+}
+
+OpReturnType NimbleNetDataVariable::min(const std::vector<OpReturnType>& args) {
+  THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(args.size(), 1, 2, MemberFuncType::MIN);
+  return reduce_tensor<ne::MinReducer, false>(args, "min");
+}
+
+OpReturnType NimbleNetDataVariable::max(const std::vector<OpReturnType>& args) {
+  THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(args.size(), 1, 2, MemberFuncType::MAX);
+  return reduce_tensor<ne::MaxReducer, false>(args, "max");
 }
 
 OpReturnType NimbleNetDataVariable::sum(const std::vector<OpReturnType>& args) {
-  THROW_ARGUMENTS_NOT_MATCH(args.size(), 1, MemberFuncType::SUM);
+  THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(args.size(), 1, 2, MemberFuncType::SUM);
+  return reduce_tensor<ne::SumReducer, true>(args, "sum");
+}
 
-  auto findSum = [tensor = args[0]](auto typeObj) -> OpReturnType {
-    using ElementType = decltype(typeObj);
+OpReturnType NimbleNetDataVariable::mean(const std::vector<OpReturnType>& args) {
+  THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(args.size(), 1, 2, MemberFuncType::MEAN);
+  auto typedTensor = get_reduction_tensor(args[0], "mean");
+  int axis = 0;
+  bool hasAxis = get_axis_argument(args, axis);
 
+  auto findMean = [&](auto typeObj) -> OpReturnType {
+    using ElementType = decltype(typeObj);
     if constexpr (!std::is_integral_v<ElementType> && !std::is_floating_point_v<ElementType>) {
-      THROW("%s", "sum only supports integral and floating point tensors");
-    }
+      THROW("%s", "mean only supports integral and floating point tensors");
+    } else {
+      using Acc = ne::SumAccumulator<ElementType>;
+      const ElementType* data = typedTensor->template begin<ElementType>();
+      if (!hasAxis) {
+        const int64_t n = typedTensor->get_numElements();
+        double mean =
+            static_cast<double>(ne::reduce_contiguous<ne::SumReducer, Acc>(data, n, Acc{0})) / n;
+        return std::make_shared<SingleVariable<double>>(mean);
+      }
 
-    auto typedTensor = std::dynamic_pointer_cast<BaseTypedTensorVariable>(tensor);
-    if (!typedTensor) {
-      THROW("sum expected a tensor, got %s", tensor->get_containerType_string());
+      auto rs = ne::get_reduction_shape(typedTensor->get_shape(), axis);
+      const int64_t outSize = rs.outer * rs.inner;
+      std::vector<Acc> acc(outSize);
+      ne::reduce_axis<ne::SumReducer, Acc>(data, rs, acc.data(), false);
+      double* out = static_cast<double*>(malloc(sizeof(double) * outSize));
+      for (int64_t i = 0; i < outSize; i++) {
+        out[i] = static_cast<double>(acc[i]) / rs.axisLen;
+      }
+      return make_reduction_output(rs.outShape, out);
     }
+  };
 
-    auto result = std::accumulate(typedTensor->begin<ElementType>(),
-                                  typedTensor->end<ElementType>(), ElementType{0});
-    return std::make_shared<SingleVariable<decltype(result)>>(result);
+  return util::call_function_for_dataType(
+      findMean, static_cast<DATATYPE>(args[0]->get_dataType_enum()));
+}
+
+/**
+ * @brief Common implementation of argmin and argmax, returns INT64 indices
+ *
+ * Without an axis the index is into the flattened tensor, like NumPy.
+ */
+template <bool IsMax>
+static OpReturnType arg_reduce_tensor(const std::vector<OpReturnType>& args,
+                                      const char* funcName) {
+  auto typedTensor = get_reduction_tensor(args[0], funcName);
+  int axis = 0;
+  bool hasAxis = get_axis_argument(args, axis);
+
+  auto func = [&](auto typeObj) -> OpReturnType {
+    using T = decltype(typeObj);
+    if constexpr (!std::is_arithmetic_v<T>) {
+      THROW("%s only supports integral and floating point tensors", funcName);
+    } else {
+      const T* data = typedTensor->template begin<T>();
+      ne::ReductionShape rs;
+      if (hasAxis) {
+        rs = ne::get_reduction_shape(typedTensor->get_shape(), axis);
+      } else {
+        rs.axisLen = typedTensor->get_numElements();
+      }
+      int64_t* out = static_cast<int64_t*>(malloc(sizeof(int64_t) * rs.outer * rs.inner));
+      ne::arg_reduce_axis<IsMax, T>(data, rs, out);
+      return make_reduction_output(rs.outShape, out);
+    }
   };
 
-  return util::call_function_for_dataType(findSum,
-                                          static_cast<DATATYPE>(args[0]->get_dataType_enum()));
+  return util::call_function_for_dataType(
+      func, static_cast<DATATYPE>(args[0]->get_dataType_enum()));
 }
 
-OpReturnType NimbleNetDataVariable::mean(const std::vector<OpReturnType>& args) {
-  THROW_ARGUMENTS_NOT_MATCH(args.size(), 1, MemberFuncType::MEAN);
+OpReturnType NimbleNetDataVariable::argmin(const std::vector<OpReturnType>& args) {
+  THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(args.size(), 1, 2, MemberFuncType::ARGMIN);
+  return arg_reduce_tensor<false>(args, "argmin");
+}
 
-  auto findMean = [tensor = args[0]](auto typeObj) -> OpReturnType {
-    using ElementType = decltype(typeObj);
-    auto typedTensor = std::dynamic_pointer_cast<BaseTypedTensorVariable>(tensor);
-    if (!typedTensor) {
-      THROW("mean expected a tensor, got %s", tensor->get_containerType_string());
-    }
+OpReturnType NimbleNetDataVariable::argmax(const std::vector<OpReturnType>& args) {
+  THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(args.size(), 1, 2, MemberFuncType::ARGMAX);
+  return arg_reduce_tensor<true>(args, "argmax");
+}
 
-    if constexpr (!std::is_integral_v<ElementType> && !std::is_floating_point_v<ElementType>) {
-      THROW("%s", "mean only supports integral and floating point tensors");
+/**
+ * @brief Common implementation of softmax and log_softmax along an axis (last axis by default)
+ *
+ * FLOAT and DOUBLE tensors keep their data type, integer tensors are computed in FLOAT.
+ */
+template <bool IsLog>
+static OpReturnType softmax_tensor(const std::vector<OpReturnType>& args, const char* funcName) {
+  auto typedTensor = get_reduction_tensor(args[0], funcName);
+  int axis = -1;
+  get_axis_argument(args, axis);
+  auto rs = ne::get_reduction_shape(typedTensor->get_shape(), axis);
+  const int numElements = typedTensor->get_numElements();
+
+  auto func = [&](auto typeObj) -> OpReturnType {
+    using T = decltype(typeObj);
+    if constexpr (!std::is_arithmetic_v<T> || std::is_same_v<T, bool>) {
+      THROW("%s only supports integral and floating point tensors", funcName);
     } else {
-      auto sum = std::accumulate(typedTensor->begin<ElementType>(), typedTensor->end<ElementType>(),
-                                 ElementType{0});
-      double mean = static_cast<double>(sum) / typedTensor->get_numElements();
-
-      return std::make_shared<SingleVariable<decltype(mean)>>(mean);
+      using OutType = std::conditional_t<std::is_floating_point_v<T>, T, float>;
+      const T* data = typedTensor->template begin<T>();
+      std::vector<OutType> converted;
+      const OutType* input = nullptr;
+      if constexpr (std::is_same_v<OutType, T>) {
+        input = data;
+      } else {
+        converted.assign(data, data + numElements);
+        input = converted.data();
+      }
+      OutType* out = static_cast<OutType*>(malloc(sizeof(OutType) * numElements));
+      ne::softmax_axis<IsLog, OutType>(input, rs, out);
+      return std::make_shared<TensorVariable>(
+          out, static_cast<DATATYPE>(get_dataType_enum<OutType>()), typedTensor->get_shape(),
+          CreateTensorType::MOVE);
     }
   };
 
-  return util::call_function_for_dataType(findMean,
-                                          static_cast<DATATYPE>(args[0]->get_dataType_enum()));
+  return util::call_function_for_dataType(
+      func, static_cast<DATATYPE>(args[0]->get_dataType_enum()));
+}
+
+OpReturnType NimbleNetDataVariable::softmax(const std::vector<OpReturnType>& args) {
+  THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(args.size(), 1, 2, MemberFuncType::SOFTMAX);
+  return softmax_tensor<false>(args, "softmax");
+}
+
+OpReturnType NimbleNetDataVariable::log_softmax(const std::vector<OpReturnType>& args) {
+  THROW_OPTIONAL_ARGUMENTS_NOT_MATCH(args.size(), 1, 2, MemberFuncType::LOG_SOFTMAX);
+  return softmax_tensor<true>(args, "log_softmax");
 }
 
 OpReturnType NimbleNetDataVariable::log(const std::vector<OpReturnType>& args) {
@@ -253,6 +423,15 @@ OpReturnType NimbleNetDataVariable::create_retriever(const std::vector<OpReturnT
 #endif  // GENAI
 }
 
+OpReturnType NimbleNetDataVariable::create_vector_index(
+    const std::vector<OpReturnType>& arguments) {
+#ifdef GENAI
+  return std::make_shared<VectorIndexDataVariable>(arguments);
+#else   // GENAI
+  THROW("%s", "Add GENAI flag to build VectorIndex");
+#endif  // GENAI
+}
+
 /*
  * 1. Get device tier
  * 2. Get the LLMs in deployment from asset manager in cloud
@@ -346,6 +525,14 @@ OpReturnType NimbleNetDataVariable::call_function(int memberFuncIndex,
       return sum(arguments);
     case MemberFuncType::MEAN:
       return mean(arguments);
+    case MemberFuncType::ARGMIN:
+      return argmin(arguments);
+    case MemberFuncType::ARGMAX:
+      return argmax(arguments);
+    case MemberFuncType::SOFTMAX:
+      return softmax(arguments);
+    case MemberFuncType::LOG_SOFTMAX:
+      return log_softmax(arguments);
     case MemberFuncType::PARSE_JSON: {
       THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 1, memberFuncIndex);
       nlohmann::json j = nlohmann::json::parse(arguments[0]->get_string());
@@ -358,6 +545,8 @@ OpReturnType NimbleNetDataVariable::call_function(int memberFuncIndex,
       return log(arguments);
     case MemberFuncType::RETRIEVER:
       return create_retriever(arguments, stack);
+    case MemberFuncType::VECTOR_INDEX:
+      return create_vector_index(arguments);
     case MemberFuncType::JSON_DOCUMENT:
       return create_json_document(arguments, stack);
     case MemberFuncType::LIST_COMPATIBLE_LLMS:
@@ -365,3 +554,30 @@ OpReturnType NimbleNetDataVariable::call_function(int memberFuncIndex,
   }
   THROW("%s not implemented for nimblenet", DataVariable::get_member_func_string(memberFuncIndex));
 }
+
+bool NimbleNetDataVariable::is_mutating_member(int memberFuncIndex) const {
+  switch (memberFuncIndex) {
+    // Compute a new value from the arguments
+    case MemberFuncType::CREATETENSOR:
+    case MemberFuncType::GET_TIME:
+    case MemberFuncType::GET_CONFIG:
+    case MemberFuncType::EXP:
+    case MemberFuncType::POW:
+    case MemberFuncType::TO_TENSOR:
+    case MemberFuncType::MIN:
+    case MemberFuncType::MAX:
+    case MemberFuncType::SUM:
+    case MemberFuncType::MEAN:
+    case MemberFuncType::ARGMIN:
+    case MemberFuncType::ARGMAX:
+    case MemberFuncType::SOFTMAX:
+    case MemberFuncType::LOG_SOFTMAX:
+    case MemberFuncType::PARSE_JSON:
+    case MemberFuncType::LOG:
+    case MemberFuncType::LIST_COMPATIBLE_LLMS:
+      return false;
+    default:
+      // Loading models, creating executors or stores and changing the thread count
+      return DataVariable::is_mutating_member(memberFuncIndex);
+  }
+}
@@ -272,4 +272,20 @@ OpReturnType RegexDataVariable::call_function(int memberFuncIndex,
   }
 };
 
+bool RegexDataVariable::is_mutating_member(int memberFuncIndex) const {
+  switch (memberFuncIndex) {
+    case MemberFuncType::REGEX_MATCH:
+    case MemberFuncType::REGEX_SEARCH:
+    case MemberFuncType::REGEX_FULLMATCH:
+    case MemberFuncType::REGEX_SPLIT:
+    case MemberFuncType::REGEX_FINDALL:
+    case MemberFuncType::REGEX_FINDITER:
+    case MemberFuncType::REGEX_SUB:
+    case MemberFuncType::REGEX_SUBN:
+      return false;
+    default:
+      return DataVariable::is_mutating_member(memberFuncIndex);
+  }
+}
+
 #endif  // REGEX_ENABLED
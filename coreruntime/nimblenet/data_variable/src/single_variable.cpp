@@ -104,6 +104,19 @@ OpReturnType SingleVariable<std::string>::call_function(int memberFuncIndex,
   }
 }
 
+bool SingleVariable<std::string>::is_mutating_member(int memberFuncIndex) const {
+  switch (memberFuncIndex) {
+    case MemberFuncType::STRING_UPPER:
+    case MemberFuncType::STRING_LOWER:
+    case MemberFuncType::STRING_STRIP:
+    case MemberFuncType::STRING_JOIN:
+    case MemberFuncType::UNICODE:
+      return false;
+    default:
+      return DataVariable::is_mutating_member(memberFuncIndex);
+  }
+}
+
 void SingleVariable<std::string>::build_char_to_byte_map() {
   // Clear any existing mapping
   char_to_byte_map.clear();
@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
 #include <mutex>
 #include <set>
 #include <string>
 
+#include "event_record.hpp"
 #include "file_store.hpp"
 #include "json.hpp"
 #include "ne_fwd.hpp"
@@ -46,9 +49,15 @@ class Database {
   /** @brief Underlying storage to add/update/delete events data. */
   Store<StoreType::METRICS> _eventsStore;
 
+  /** @brief Encoder of the binary records of every event type, tied to its current file. */
+  std::map<std::string, EventRecordEncoder> _eventEncoders;
+
   /** @brief Flag indicating if the database has reached its full capacity. */
   bool _full = false;
 
+  /** @brief Whether every event is written to disk as it is added, see Config::flushEveryRecord. */
+  bool _flushEveryRecord = false;
+
   /**
    * @brief Checks if a given table name exists in the event types table.
    *
@@ -62,9 +71,11 @@ class Database {
    * @brief Constructs a Database instance with a given metrics agent.
    *
    * @param metricsAgent Pointer to a MetricsAgent for reporting metrics.
+   * @param flushEveryRecord Whether every event is written to disk as it is added.
    */
-  Database(MetricsAgent* metricsAgent) {
+  Database(MetricsAgent* metricsAgent, bool flushEveryRecord = false) {
     _metricsAgent = metricsAgent;
+    _flushEveryRecord = flushEveryRecord;
     database_open();
   }
 
@@ -90,12 +101,25 @@ class Database {
                                         const int64_t expiryValue) const;
 
   /**
-   * @brief Retrieves all events from a specified table.
+   * @brief Function called for every event read from the database.
+   *
+   * Receives the time the event was stored at in seconds and the fields of the event.
+   */
+  using EventCallback =
+      std::function<void(int64_t timestamp, std::map<std::string, OpReturnType>&& event)>;
+
+  /**
+   * @brief Streams all events from a specified table, oldest first.
+   *
+   * Events are decoded one record at a time, without materializing the whole table. Events
+   * stored as JSON lines by older versions are read as well.
    *
    * @param tableName Name of the table to query.
-   * @return Vector of JSON objects representing the events.
+   * @param callback Function called for every event.
+   * @param expiryTime Files holding only events older than this timestamp are skipped.
    */
-  std::vector<nlohmann::json> get_events_from_db(const std::string& tableName) const;
+  void for_each_event(const std::string& tableName, const EventCallback& callback,
+                      int64_t expiryTime = 0);
 
   /**
    * @brief Adds a new event entry to the specified table.
@@ -25,7 +25,7 @@ int Database::get_db_size(int& dbSize) const {
 void Database::database_open() {
   std::lock_guard<std::mutex> lockGuard(_mutex);
   if (_isSimulation) return;
-  _eventsStore.init(nativeinterface::HOMEDIR + "/events/");
+  _eventsStore.init(nativeinterface::HOMEDIR + "/events/", _flushEveryRecord);
   _currentEventTypes = _eventsStore.get_all_types();
   nlohmann::json j;
   j["dbSize"] = _eventsStore.size_in_bytes();
@@ -33,13 +33,36 @@ void Database::database_open() {
   _metricsAgent->save_metrics("DATABASEMETRIC", j);
 }
 
-std::vector<nlohmann::json> Database::get_events_from_db(const std::string& tableName) const {
+void Database::for_each_event(const std::string& tableName, const EventCallback& callback,
+                              int64_t expiryTime) {
   std::lock_guard<std::mutex> lockGuard(_mutex);
   if (this->_isSimulation) {
-    return {};
+    return;
   }
 
-  return _eventsStore.read(tableName.c_str());
+  EventRecordDecoder decoder;
+  int64_t timestamp;
+  std::map<std::string, OpReturnType> event;
+  _eventsStore.read_records(
+      tableName.c_str(),
+      [&](const char* record, size_t size) {
+        if (!decoder.decode(record, size, timestamp, event)) {
+          LOG_TO_ERROR("Skipping corrupted event for eventType=%s", tableName.c_str());
+          return;
+        }
+        callback(timestamp, std::move(event));
+      },
+      [&](nlohmann::json&& eventJson) {
+        // Events written as JSON lines by older versions
+        std::map<std::string, OpReturnType> legacyEvent;
+        for (const auto& column : eventJson.items()) {
+          if (column.key() == usereventconstants::TimestampField) continue;
+          legacyEvent[column.key()] = DataVariable::get_SingleVariableFrom_JSON(column.value());
+        }
+        callback(eventJson[usereventconstants::TimestampField].get<int64_t>(),
+                 std::move(legacyEvent));
+      },
+      expiryTime);
 }
 
 bool Database::delete_old_rows_from_table_in_db(const std::string& tableName,
@@ -79,8 +102,12 @@ bool Database::add_event_in_db(const string& tableName, OpReturnType eventMapTab
     //              tableName.c_str(), dbconstants::EventsTypeTableName.c_str());
     return true;
   }
-  auto eventJsonString = eventMapTable->to_json_str();
-  _eventsStore.write(tableName.c_str(), eventJsonString.c_str());
+  auto& encoder = _eventEncoders[tableName];
+  auto record = encoder.encode(Time::get_time(), eventMapTable->get_map());
+  if (_eventsStore.write_record(tableName.c_str(), record)) {
+    // The file was rotated, the next record starts a new file with its own dictionary
+    encoder.reset();
+  }
   return true;
 }
 
@@ -118,6 +145,7 @@ bool Database::delete_old_entries_from_eventsType_Table() {
     if (_currentEventTypes.find(type) == _currentEventTypes.end()) {
       // EventType not required anymore, deleting
       _eventsStore.delete_type(type.c_str());
+      _eventEncoders.erase(type);
     }
   }
   return true;
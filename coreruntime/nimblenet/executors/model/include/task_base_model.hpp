@@ -15,6 +15,7 @@
 #include "data_variable.hpp"
 #include "executor_structs.h"
 #include "map_data_variable.hpp"
+#include "mapped_file.hpp"
 #include "model_executor_structs.hpp"
 #ifdef ONNX_EXECUTOR
 #include "onnx.hpp"
@@ -30,13 +31,13 @@ class CommandCenter;
  */
 class TaskBaseModel {
  protected:
-  CommandCenter* _commandCenter; /**< Pointer to the command center. */
-  std::string _modelBuffer;      /**< Serialized model data. */
-  nlohmann::json _epConfig;      /**< Execution provider configuration in JSON. */
-  int _epConfigVersion;          /**< Version number of the EP config. */
-  std::string _modelId;          /**< Identifier for the model. */
-  std::mutex _modelMutex;        /**< Mutex to guard model access. */
-  std::string _version;          /**< Version string of the model plan. */
+  CommandCenter* _commandCenter;           /**< Pointer to the command center. */
+  std::unique_ptr<MappedFile> _modelFile; /**< Mapping of the serialized model, used in place. */
+  nlohmann::json _epConfig;               /**< Execution provider configuration in JSON. */
+  int _epConfigVersion;                   /**< Version number of the EP config. */
+  std::string _modelId;                   /**< Identifier for the model. */
+  std::mutex _modelMutex;                 /**< Mutex to guard model access. */
+  std::string _version;                   /**< Version string of the model plan. */
   bool _runDummyInference; /**< Flag indicating whether dummy inference should be run for this model
                               or not. */
 
@@ -29,13 +29,11 @@ TaskBaseModel::TaskBaseModel(const std::string& modelFileName, const std::string
       _modelId(modelId),
       _runDummyInference(runDummyInference) {
   std::lock_guard<std::mutex> locker(_modelMutex);
-  const auto modelBufferOpt =
-      nativeinterface::read_potentially_compressed_file(modelFileName, false);
-  const auto successfulRead = modelBufferOpt.first;
-  if (!successfulRead) {
+  // Mapped instead of read, so that loading a model does not hold a second copy of it in memory
+  _modelFile = nativeinterface::map_potentially_compressed_file(modelFileName, false);
+  if (!_modelFile) {
     THROW("Model file=%s not present", modelFileName.c_str());
   }
-  _modelBuffer = std::move(modelBufferOpt.second);
 }
 
 int TaskBaseModel::get_inference(const std::string& inferId, const std::vector<OpReturnType>& req,
@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "data_variable.hpp"
 #include "nimble_net_util.hpp"
 #include "task_base_model.hpp"
@@ -14,8 +18,32 @@
 /**
  * @brief TaskONNXModel is a specialized implementation of TaskBaseModel
  *        that supports running ONNX models using ONNX Runtime when invoked from delitepy script.
+ *
+ * Models whose outputs all have a fixed shape and a numeric type are run with an IoBinding, writing
+ * into preallocated output arenas. Outputs are handed to the script as views over the arena, which
+ * goes back to a pool once the last of them is released, so that steady state inference does not
+ * allocate output buffers. Other models use the allocating Session::Run.
  */
 class TaskONNXModel : public TaskBaseModel {
+  /**
+   * @brief Preallocated tensors for every output of a run.
+   */
+  struct OutputArena {
+    std::vector<Ort::Value> tensors;
+  };
+
+  /**
+   * @brief Output arenas not referenced by any script variable, ready to be bound to a run. Shared
+   * with the arenas handed out, so that they outlive the model if needed.
+   */
+  struct OutputArenaPool {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<OutputArena>> freeArenas;
+  };
+
+  /** Number of arenas kept in the pool, more can be in use if scripts hold on to outputs */
+  static constexpr std::size_t MaxFreeOutputArenas = 4;
+
  private:
   OrtAllocator* _allocator = nullptr;    /**< Allocator used by ONNX Runtime */
   Ort::SessionOptions _sessionOptions;   /**< Options to configure ONNX session */
@@ -25,12 +53,31 @@ class TaskONNXModel : public TaskBaseModel {
   Ort::Session* _session = nullptr;      /**< ONNX session handle */
   std::vector<const char*> _inputNames;  /**< Cached input names */
   std::vector<const char*> _outputNames; /**< Cached output names */
+  std::vector<std::vector<int64_t>> _outputShapes; /**< Shapes of the outputs, if all fixed */
+  std::vector<ONNXTensorElementDataType> _outputTypes; /**< Types of the outputs, if all fixed */
+  std::shared_ptr<OutputArenaPool> _outputArenaPool; /**< Set if outputs are bound to arenas */
 
   /**
-   * @brief Loads model metadata such as input/output names.
+   * @brief Loads model metadata such as input/output names, and sets up output arenas if all
+   * outputs have a fixed shape and a numeric type.
    */
   void load_model_meta_data();
 
+  /**
+   * @brief Takes an arena from the pool, or allocates one.
+   *
+   * @return Arena returned to the pool when the last reference is dropped.
+   */
+  std::shared_ptr<OutputArena> acquire_output_arena();
+
+  /**
+   * @brief Runs the model with an IoBinding, writing outputs into a pooled arena.
+   *
+   * @param ret Output tuple of views over the arena.
+   * @param inputTensors Prepared input tensors.
+   */
+  void run_with_output_arena(OpReturnType& ret, const std::vector<Ort::Value>& inputTensors);
+
   /**
    * @brief Loads the model from the internal buffer.
    */
@@ -118,6 +165,13 @@ class TaskONNXModel : public TaskBaseModel {
    */
   std::vector<const char*> get_output_names() override { return _outputNames; }
 
+#ifdef TESTING
+  /**
+   * @brief Returns whether outputs are written into pooled arenas.
+   */
+  bool binds_outputs_to_arenas() const { return _outputArenaPool != nullptr; }
+#endif  // TESTING
+
   /**
    * @brief Destructor for TaskONNXModel. Cleans up session.
    */
@@ -129,6 +183,7 @@ class TaskONNXModel : public TaskBaseModel {
  *        as a typed tensor variable compatible with delitepy datavariable.
  */
 class OrtTensorVariable : public BaseTypedTensorVariable {
+  std::shared_ptr<void> _owner;                 /**< Keeps the memory of a view alive */
   Ort::Value _onnxTensor = Ort::Value{nullptr}; /**< Wrapped ONNX tensor */
 
   /**
@@ -147,9 +202,11 @@ class OrtTensorVariable : public BaseTypedTensorVariable {
    *
    * @param onnx_tensor The tensor to wrap.
    * @param dataType The internal data type.
+   * @param owner Owner of the memory, if onnx_tensor is a view over memory it does not own.
    */
-  OrtTensorVariable(Ort::Value&& onnx_tensor, DATATYPE dataType)
-      : BaseTypedTensorVariable(dataType) {
+  OrtTensorVariable(Ort::Value&& onnx_tensor, DATATYPE dataType,
+                    std::shared_ptr<void> owner = nullptr)
+      : BaseTypedTensorVariable(dataType), _owner(std::move(owner)) {
     _onnxTensor = std::move(onnx_tensor);
     std::vector<int64_t> shape = _onnxTensor.GetTensorTypeAndShapeInfo().GetShape();
     int length = 1;
@@ -184,7 +184,7 @@ void ONNXModel::load_model_from_buffer() {
       _sessionOptions = get_session_options_from_json(epConfig);
       _sessionOptions.Add(deliteai_operator_domain);
       _session =
-          new Ort::Session(_myEnv, _modelBuffer.c_str(), _modelBuffer.length(), _sessionOptions);
+          new Ort::Session(_myEnv, _modelFile->data(), _modelFile->size(), _sessionOptions);
       LOG_TO_DEBUG("Created ONNX Model for model=%s, version=%s, with epConfig=%s",
                    _modelId.c_str(), _version.c_str(), epConfigString.c_str());
       return;
@@ -199,10 +199,10 @@ void ONNXModel::load_model_from_buffer() {
   newSessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
   _sessionOptions = std::move(newSessionOptions);
   _sessionOptions.Add(deliteai_operator_domain);
-  _session = new Ort::Session(_myEnv, _modelBuffer.c_str(), _modelBuffer.length(), _sessionOptions);
-  //_modelBuffer is not used anywhere hence clearing (onnx maintains the
+  _session = new Ort::Session(_myEnv, _modelFile->data(), _modelFile->size(), _sessionOptions);
+  //_modelFile is not used anywhere hence unmapping (onnx maintains the
   // buffer by itself)
-  _modelBuffer.clear();
+  _modelFile.reset();
 }
 
 ONNXModel::ONNXModel(const ModelInfo& modelInfo, const std::string& plan,
@@ -6,6 +6,8 @@
 
 #include "task_onnx_model.hpp"
 
+#include <algorithm>
+
 #include "data_variable.hpp"
 #include "nimble_net_util.hpp"
 #include "onnx_operators.hpp"
@@ -21,17 +23,18 @@ int TaskONNXModel::create_input_tensor_and_set_data_ptr(const OpReturnType req,
     if (req->get_dataType_enum() == DATATYPE::STRING) {
       int numOfElements = req->get_numElements();
 
-      // Get char** from std::vector<std::string> stored in StringTensorVariable
+      // Get char** from std::vector<std::string> stored in StringTensorVariable, the array of
+      // pointers is reused across runs on this thread
+      static thread_local std::vector<const char*> strings;
       std::string* s = (std::string*)(req->get_raw_ptr());
-      char** strings = new char*[numOfElements];
+      strings.clear();
       for (int i = 0; i < numOfElements; i++) {
-        strings[i] = (char*)(s[i].c_str());
+        strings.push_back(s[i].c_str());
       }
       inputTensor =
           Ort::Value::CreateTensor(_allocator, req->get_shape().data(), req->get_shape().size(),
                                    ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING);
-      inputTensor.FillStringTensor(strings, numOfElements);
-      delete[] strings;
+      inputTensor.FillStringTensor(strings.data(), numOfElements);
     } else {
       int fieldSize = util::get_field_size_from_data_type(req->get_dataType_enum());
       inputTensor = Ort::Value::CreateTensor(_memoryInfo, req->get_raw_ptr(),
@@ -54,9 +57,70 @@ int TaskONNXModel::create_input_tensor_and_set_data_ptr(const OpReturnType req,
   return TERMINAL_ERROR;
 }
 
+std::shared_ptr<TaskONNXModel::OutputArena> TaskONNXModel::acquire_output_arena() {
+  std::unique_ptr<OutputArena> arena;
+  {
+    std::lock_guard<std::mutex> lock(_outputArenaPool->mutex);
+    if (!_outputArenaPool->freeArenas.empty()) {
+      arena = std::move(_outputArenaPool->freeArenas.back());
+      _outputArenaPool->freeArenas.pop_back();
+    }
+  }
+  if (!arena) {
+    arena = std::make_unique<OutputArena>();
+    for (int i = 0; i < _outputShapes.size(); i++) {
+      arena->tensors.push_back(Ort::Value::CreateTensor(
+          _allocator, _outputShapes[i].data(), _outputShapes[i].size(), _outputTypes[i]));
+    }
+  }
+
+  std::weak_ptr<OutputArenaPool> weakPool = _outputArenaPool;
+  return std::shared_ptr<OutputArena>(arena.release(), [weakPool](OutputArena* released) {
+    std::unique_ptr<OutputArena> arena(released);
+    if (auto pool = weakPool.lock()) {
+      std::lock_guard<std::mutex> lock(pool->mutex);
+      if (pool->freeArenas.size() < MaxFreeOutputArenas) {
+        pool->freeArenas.push_back(std::move(arena));
+      }
+    }
+  });
+}
+
+void TaskONNXModel::run_with_output_arena(OpReturnType& ret,
+                                          const std::vector<Ort::Value>& inputTensors) {
+  auto arena = acquire_output_arena();
+  Ort::IoBinding binding(*_session);
+  for (int i = 0; i < inputTensors.size(); i++) {
+    binding.BindInput(_inputNames[i], inputTensors[i]);
+  }
+  for (int i = 0; i < _outputNames.size(); i++) {
+    binding.BindOutput(_outputNames[i], arena->tensors[i]);
+  }
+  _session->Run(Ort::RunOptions{nullptr}, binding);
+
+  std::vector<OpReturnType> outputs_tensors;
+  for (int i = 0; i < arena->tensors.size(); i++) {
+    const auto& shape = _outputShapes[i];
+    auto dataType = (DATATYPE)_outputTypes[i];
+    size_t numBytes = arena->tensors[i].GetTensorTypeAndShapeInfo().GetElementCount() *
+                      util::get_field_size_from_data_type(dataType);
+    // View over the arena, which is only reused once every output of this run is released
+    Ort::Value view =
+        Ort::Value::CreateTensor(_memoryInfo, arena->tensors[i].GetTensorMutableRawData(),
+                                 numBytes, shape.data(), shape.size(), _outputTypes[i]);
+    outputs_tensors.push_back(
+        OpReturnType(new OrtTensorVariable(std::move(view), dataType, arena)));
+  }
+  ret = std::make_shared<TupleDataVariable>(outputs_tensors);
+}
+
 int TaskONNXModel::invoke_inference(OpReturnType& ret,
                                     const std::vector<Ort::Value>& inputTensors) {
   try {
+    if (_outputArenaPool) {
+      run_with_output_arena(ret, inputTensors);
+      return SUCCESS;
+    }
     std::vector<Ort::Value> output_onnx_tensors =
         _session->Run(Ort::RunOptions{nullptr}, _inputNames.data(), inputTensors.data(),
                       _inputNames.size(), _outputNames.data(), _outputNames.size());
@@ -206,7 +270,7 @@ void TaskONNXModel::load_model_from_buffer() {
       add_common_session_options(_sessionOptions);
       _sessionOptions.Add(deliteai_operator_domain);
       _session =
-          new Ort::Session(_myEnv, _modelBuffer.c_str(), _modelBuffer.length(), _sessionOptions);
+          new Ort::Session(_myEnv, _modelFile->data(), _modelFile->size(), _sessionOptions);
       LOG_TO_DEBUG("Created ONNX Model for model=%s, version=%s, with epConfig=%s",
                    _modelId.c_str(), _version.c_str(), epConfigString.c_str());
       load_model_meta_data();
@@ -223,8 +287,8 @@ void TaskONNXModel::load_model_from_buffer() {
   _sessionOptions = std::move(newSessionOptions);
   _sessionOptions.Add(deliteai_operator_domain);
   add_common_session_options(_sessionOptions);
-  _session = new Ort::Session(_myEnv, _modelBuffer.c_str(), _modelBuffer.length(), _sessionOptions);
-  //_modelBuffer is used directly by ONNX so we have to maintain it as long as the session exists
+  _session = new Ort::Session(_myEnv, _modelFile->data(), _modelFile->size(), _sessionOptions);
+  //_modelFile is used directly by ONNX so we have to maintain it as long as the session exists
   load_model_meta_data();
 }
 
@@ -247,6 +311,31 @@ void TaskONNXModel::load_model_meta_data() {
     outputName[nameSize] = 0;
     _outputNames.push_back(outputName);
   }
+
+  // Outputs can only be written into preallocated arenas if their size is known before running
+  bool fixedOutputs = numOutputs > 0;
+  for (int i = 0; i < numOutputs && fixedOutputs; i++) {
+    Ort::TypeInfo typeInfo = _session->GetOutputTypeInfo(i);
+    if (typeInfo.GetONNXType() != ONNX_TYPE_TENSOR) {
+      fixedOutputs = false;
+      break;
+    }
+    auto tensorInfo = typeInfo.GetTensorTypeAndShapeInfo();
+    std::vector<int64_t> shape = tensorInfo.GetShape();
+    auto dataType = (DATATYPE)tensorInfo.GetElementType();
+    bool numeric = dataType == DATATYPE::FLOAT || dataType == DATATYPE::DOUBLE ||
+                   dataType == DATATYPE::INT32 || dataType == DATATYPE::INT64;
+    fixedOutputs =
+        numeric && std::all_of(shape.begin(), shape.end(), [](int64_t dim) { return dim > 0; });
+    _outputShapes.push_back(std::move(shape));
+    _outputTypes.push_back(tensorInfo.GetElementType());
+  }
+  if (fixedOutputs) {
+    _outputArenaPool = std::make_shared<OutputArenaPool>();
+  } else {
+    _outputShapes.clear();
+    _outputTypes.clear();
+  }
 }
 
 TaskONNXModel::TaskONNXModel(const std::string& plan, const std::string& version,
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -47,6 +48,7 @@ class BaseJob {
   int _numPendingChildJobs = 0;        /**< Counter for unfinished child jobs. */
   std::shared_ptr<BaseJob> _parentJob; /**< Pointer to the parent job (if any). */
   const std::string _name;             /**< Job name for identification/debugging. */
+  int64_t _retryDelayMicros = 0;       /**< Delay before the next retry, 0 until a retry. */
 
   friend class JobScheduler; /**< Grants scheduler internal access to state. */
 
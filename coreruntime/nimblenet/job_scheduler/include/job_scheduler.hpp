@@ -6,38 +6,51 @@
 
 #pragma once
 
-#include <cstddef>
+#include <condition_variable>
+#include <deque>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <thread>
 #include <vector>
 
 #include "job.hpp"
-#include "locked_mpmc_queue.hpp"
+#include "timer_wheel.hpp"
 
 /**
  * @brief Asynchronously perform jobs
- * Add jobs from one thread, which are stored in a SPSCQueue. Another thread can perform jobs by
- * popping them off the queue. Currently all jobs are assumed to be the highest priority and they'll
- * be performed all at once
+ * Jobs whose dependencies are done are kept in a priority and a non-priority ready queue. They are
+ * performed either by a pool of worker threads, woken up as soon as a job becomes ready, or by a
+ * caller draining the non-priority queue with do_all_non_priority_jobs(). Independent jobs, like
+ * the downloads and loads of different assets, run in parallel on the workers. A parent job is run by the thread completing
+ * its last pending child job.
  *
- * We can add many things to this abstraction: Having different priorities for jobs, having a
- * timeout after which we stop doing jobs, etc
+ * Jobs returning RETRY are held in a timer wheel with a per job exponential backoff, instead of
+ * being polled again on every pass.
  */
 class JobScheduler {
-  /**
-   * Queue of non-priority jobs that are ready to run i.e. don't have any pending dependencies
-   * NOTE: This is a MPSC queue so jobs can be added by multiple threads, but only a single thread
-   * can pop jobs from this queue. This works as the job scheduler runs on a single thread
-   */
-  ne::LockedMPSCQueue<std::shared_ptr<BaseJob>> _jobs;
+  /** Protects the ready queues, the retry wheel and the state of the workers */
+  std::mutex _mutex;
+
+  /** Signalled when a job becomes ready and when workers are resumed or stopped */
+  std::condition_variable _workAvailable;
+
+  /** Signalled when no worker is running a job anymore, used by pause_workers() */
+  std::condition_variable _workersIdle;
 
-  /** Jobs that have to be added back to the _jobs queue. Used in do_jobs() function */
-  std::queue<std::shared_ptr<BaseJob>> _attemptedJobs;
+  /** Queue of non-priority jobs that are ready to run i.e. don't have any pending dependencies */
+  std::deque<std::shared_ptr<BaseJob>> _jobs;
 
   /** Queue of priority jobs that are ready to run i.e. don't have any pending dependencies */
-  ne::LockedMPSCQueue<std::shared_ptr<BaseJob>> _priorityJobs;
+  std::deque<std::shared_ptr<BaseJob>> _priorityJobs;
+
+  /** Jobs that returned RETRY, waiting for their backoff delay to elapse */
+  ne::TimerWheel<std::shared_ptr<BaseJob>> _retryJobs;
+
+  std::vector<std::thread> _workers;
+  bool _stopWorkers = false;
+  int _pauseCount = 0;     /**< Workers don't take new jobs while greater than 0 */
+  int _numRunningJobs = 0; /**< Number of jobs being run by workers */
 
   /**
    * Here, producer is the thread on which scheduler runs and consumer will be the
@@ -51,7 +64,39 @@ class JobScheduler {
   std::vector<std::shared_ptr<BaseJob>> _jobsWaitingForInternet;
 
  public:
-  JobScheduler(std::size_t capacity);
+  JobScheduler();
+
+  /**
+   * @brief Stops and joins the worker threads, if started.
+   */
+  ~JobScheduler();
+
+  /**
+   * @brief Starts worker threads performing jobs as soon as they are ready. No-op if the workers
+   * are already running.
+   *
+   * @param numWorkers Number of worker threads, at least one is started.
+   */
+  void start_workers(int numWorkers);
+
+  /**
+   * @brief Stops the worker threads once their current job is done. Jobs left in the non-priority
+   * queue can still be performed with do_all_non_priority_jobs().
+   */
+  void stop_workers();
+
+  /**
+   * @brief Stops workers from taking new jobs and waits for the jobs they are running to finish.
+   * Calls can be nested, every call has to be matched with a resume_workers().
+   *
+   * Jobs run on the calling thread by do_all_non_priority_jobs() are not affected.
+   */
+  void pause_workers();
+
+  /**
+   * @brief Lets workers take jobs again after pause_workers().
+   */
+  void resume_workers();
 
   /**
    * @brief Push jobs waiting for internet back into the queue.
@@ -59,40 +104,64 @@ class JobScheduler {
   void notify_online();
 
   /**
-   * @brief Push job onto the queue. Blocks if the queue is full.
+   * @brief Push job onto the queue.
    */
   template <typename T>
   [[nodiscard]] std::future<T> add_job(std::shared_ptr<Job<T>> job);
 
   /**
-   * @brief Push priority job onto the queue. Blocks if the queue is full.
+   * @brief Push priority job onto the queue.
    */
   template <typename T>
   [[nodiscard]] std::future<T> add_priority_job(std::shared_ptr<Job<T>> job);
 
   /**
-   * @brief Performs all jobs in the queue, exits when the queue is empty
+   * @brief Performs, on the calling thread, the non-priority jobs till the queue is empty
    */
-  void do_jobs();
   void do_all_non_priority_jobs();
 
  private:
   void do_job(std::shared_ptr<BaseJob>&& job, bool isPriority);
   void add_job(std::shared_ptr<BaseJob>&& job, bool isPriority);
   void queue_internet_waiting_job(std::shared_ptr<BaseJob>&& job);
-  void append_jobs_back_to_queue();
+
+  /**
+   * @brief Holds a job that returned RETRY in the retry wheel. Called with the job locked.
+   */
+  void queue_retry_job(std::shared_ptr<BaseJob>&& job);
+
+  /**
+   * @brief Moves the jobs whose retry delay has elapsed to the non-priority queue. Called with
+   * _mutex held.
+   */
+  void requeue_retry_jobs();
+
+  /**
+   * @brief Pops the job at the front of a ready queue.
+   *
+   * @param isPriority Whether to pop from the priority queue.
+   * @param job Output job.
+   * @return false if the queue is empty.
+   */
+  bool pop_job(bool isPriority, std::shared_ptr<BaseJob>& job);
+
+  void worker_thread();
 };
 
 /*************************** Template function implementations ********************************/
 
 template <typename T>
 std::future<T> JobScheduler::add_job(std::shared_ptr<Job<T>> job) {
+  // Taken first as the job can be performed by a worker as soon as it is added
+  auto future = job->_jobPromise.get_future();
   add_job(job, false);
-  return job->_jobPromise.get_future();
+  return future;
 }
 
 template <typename T>
 std::future<T> JobScheduler::add_priority_job(std::shared_ptr<Job<T>> job) {
+  // Taken first as the job can be performed by a worker as soon as it is added
+  auto future = job->_jobPromise.get_future();
   add_job(job, true);
-  return job->_jobPromise.get_future();
+  return future;
 }
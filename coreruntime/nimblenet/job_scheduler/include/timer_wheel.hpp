@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ne {
+
+/**
+ * @brief Hashed timer wheel holding items until a deadline.
+ *
+ * Time is divided into ticks and every item goes to the slot of the first tick starting after its
+ * deadline, modulo the number of slots. Scheduling is O(1) and expiring only looks at the slots of
+ * the ticks elapsed since the last call, a full turn of the wheel at most. Items whose deadline is
+ * more than a turn away stay in their slot until the wheel comes back to it with their deadline
+ * passed.
+ *
+ * Not thread safe, the owner is expected to hold a lock.
+ *
+ * @tparam T Type of the items.
+ */
+template <typename T>
+class TimerWheel {
+  struct Entry {
+    int64_t deadlineMicros;
+    T item;
+  };
+
+  std::vector<std::vector<Entry>> _slots; /**< Items of every slot. */
+  int64_t _tickMicros;                    /**< Duration of a tick. */
+  int64_t _lastTick = -1;                 /**< Last tick expired, -1 before the first call. */
+  std::size_t _size = 0;                  /**< Number of items held. */
+
+ public:
+  /**
+   * @brief Constructs a wheel.
+   *
+   * @param tickMicros Duration of a tick, deadlines are honoured with this granularity.
+   * @param numSlots Number of slots, a turn of the wheel lasts numSlots ticks.
+   */
+  TimerWheel(int64_t tickMicros, std::size_t numSlots)
+      : _slots(numSlots), _tickMicros(tickMicros) {}
+
+  /**
+   * @brief Duration of a tick in microseconds.
+   */
+  int64_t tick_micros() const noexcept { return _tickMicros; }
+
+  /**
+   * @brief Number of items waiting for their deadline.
+   */
+  std::size_t size() const noexcept { return _size; }
+
+  bool empty() const noexcept { return _size == 0; }
+
+  /**
+   * @brief Holds an item until a deadline.
+   *
+   * @param item Item to hold.
+   * @param deadlineMicros Time after which the item is returned by expire().
+   */
+  void schedule(T item, int64_t deadlineMicros) {
+    // Rounded up to the first tick starting after the deadline, so that the item is due when its
+    // slot is expired. A deadline in a tick already expired goes to the next tick to expire.
+    int64_t tick = std::max((deadlineMicros + _tickMicros - 1) / _tickMicros, _lastTick + 1);
+    auto& slot = _slots[tick % _slots.size()];
+    slot.push_back({deadlineMicros, std::move(item)});
+    _size++;
+  }
+
+  /**
+   * @brief Moves out the items whose deadline has passed.
+   *
+   * @param nowMicros Current time.
+   * @param expired Vector the expired items are appended to.
+   */
+  void expire(int64_t nowMicros, std::vector<T>& expired) {
+    int64_t nowTick = nowMicros / _tickMicros;
+    if (_size == 0 || nowTick <= _lastTick) {
+      _lastTick = std::max(_lastTick, nowTick);
+      return;
+    }
+    // Slots are visited at most once even if more than a turn elapsed
+    int64_t numSlots = static_cast<int64_t>(_slots.size());
+    int64_t firstTick = std::max(_lastTick + 1, nowTick - numSlots + 1);
+    for (int64_t tick = firstTick; tick <= nowTick; tick++) {
+      auto& slot = _slots[tick % _slots.size()];
+      for (std::size_t i = 0; i < slot.size();) {
+        if (slot[i].deadlineMicros <= nowMicros) {
+          expired.push_back(std::move(slot[i].item));
+          slot[i] = std::move(slot.back());
+          slot.pop_back();
+          _size--;
+        } else {
+          i++;
+        }
+      }
+    }
+    _lastTick = nowTick;
+  }
+};
+
+}  // namespace ne
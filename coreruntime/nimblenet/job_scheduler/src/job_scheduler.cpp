@@ -6,56 +6,144 @@
 
 #include "job_scheduler.hpp"
 
-#include <cstddef>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <memory>
 #include <mutex>
 
 #include "base_job.hpp"
+#include "core_sdk_constants.hpp"
 #include "logger.hpp"
 
-JobScheduler::JobScheduler(std::size_t capacity)
-    : _jobs(capacity), _priorityJobs(capacity), _jobsWaitingForInternet() {}
+// Retry deadlines use a monotonic clock, unaffected by changes of the device time
+static int64_t now_micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
 
-void JobScheduler::notify_online() {
-  std::lock_guard lockGuard(_internetJobsMutex);
-  for (auto& job : _jobsWaitingForInternet) {
-    _jobs.push(std::move(job));
+JobScheduler::JobScheduler()
+    // Enough slots for the longest backoff to fit in a single turn of the wheel
+    : _retryJobs(coresdkconstants::JobRetryTimerTickMicros,
+                 coresdkconstants::JobRetryMaxDelayMicros /
+                         coresdkconstants::JobRetryTimerTickMicros +
+                     1),
+      _jobsWaitingForInternet() {}
+
+JobScheduler::~JobScheduler() { stop_workers(); }
+
+void JobScheduler::start_workers(int numWorkers) {
+  std::lock_guard lock{_mutex};
+  if (!_workers.empty()) return;
+  _stopWorkers = false;
+  for (int i = 0; i < std::max(numWorkers, 1); i++) {
+    _workers.emplace_back(&JobScheduler::worker_thread, this);
   }
-  _jobsWaitingForInternet.clear();
+  LOG_TO_DEBUG("Started %d job scheduler workers", static_cast<int>(_workers.size()));
 }
 
-// Runs the jobs which are initially present in the queue
-// Useful when called from the background thread
-void JobScheduler::do_jobs() {
-  // NOTE: SPSCQueue returns nullptr when the queue is empty. This is unlike std::queue which would
-  // segfault
-  while (_priorityJobs.front()) {
-    auto job = std::move(*_priorityJobs.front());
-    _priorityJobs.pop();
-    do_job(std::move(job), true);
+void JobScheduler::stop_workers() {
+  std::vector<std::thread> workers;
+  {
+    std::lock_guard lock{_mutex};
+    _stopWorkers = true;
+    workers.swap(_workers);
   }
+  _workAvailable.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
 
-  auto jobsCount = _jobs.size();
-  while (jobsCount > 0) {
-    auto job = std::move(*_jobs.front());
-    _jobs.pop();
-    do_job(std::move(job), false);
-    jobsCount--;
+void JobScheduler::pause_workers() {
+  std::unique_lock lock{_mutex};
+  _pauseCount++;
+  _workersIdle.wait(lock, [this] { return _numRunningJobs == 0; });
+}
+
+void JobScheduler::resume_workers() {
+  {
+    std::lock_guard lock{_mutex};
+    assert(_pauseCount > 0);
+    _pauseCount--;
   }
+  _workAvailable.notify_all();
+}
 
-  append_jobs_back_to_queue();
+void JobScheduler::notify_online() {
+  std::vector<std::shared_ptr<BaseJob>> jobs;
+  {
+    std::lock_guard lockGuard(_internetJobsMutex);
+    jobs.swap(_jobsWaitingForInternet);
+  }
+  if (jobs.empty()) return;
+  {
+    std::lock_guard lock{_mutex};
+    for (auto& job : jobs) {
+      _jobs.push_back(std::move(job));
+    }
+  }
+  _workAvailable.notify_all();
 }
 
 // Runs all the jobs till the queue is empty
 // Useful when trying to load the assets from main thread
 void JobScheduler::do_all_non_priority_jobs() {
-  while (_jobs.size() > 0) {
-    auto job = std::move(*_jobs.front());
-    _jobs.pop();
+  {
+    std::lock_guard lock{_mutex};
+    requeue_retry_jobs();
+  }
+
+  // Jobs returning RETRY go to the retry wheel, so this ends once every job was attempted
+  std::shared_ptr<BaseJob> job;
+  while (pop_job(false, job)) {
     do_job(std::move(job), false);
   }
+}
+
+void JobScheduler::worker_thread() {
+  std::unique_lock lock{_mutex};
+  while (!_stopWorkers) {
+    requeue_retry_jobs();
+    bool hasJob = !_priorityJobs.empty() || !_jobs.empty();
+    if (_pauseCount > 0 || !hasJob) {
+      if (_retryJobs.empty()) {
+        _workAvailable.wait(lock);
+      } else {
+        _workAvailable.wait_for(lock, std::chrono::microseconds(_retryJobs.tick_micros()));
+      }
+      continue;
+    }
 
-  append_jobs_back_to_queue();
+    bool isPriority = !_priorityJobs.empty();
+    auto& queue = isPriority ? _priorityJobs : _jobs;
+    auto job = std::move(queue.front());
+    queue.pop_front();
+    _numRunningJobs++;
+    lock.unlock();
+
+    try {
+      do_job(std::move(job), isPriority);
+    } catch (const std::exception& e) {
+      LOG_TO_ERROR("Job scheduler worker failed to do job: %s", e.what());
+    }
+
+    lock.lock();
+    _numRunningJobs--;
+    if (_numRunningJobs == 0 && _pauseCount > 0) {
+      _workersIdle.notify_all();
+    }
+  }
+}
+
+bool JobScheduler::pop_job(bool isPriority, std::shared_ptr<BaseJob>& job) {
+  std::lock_guard lock{_mutex};
+  auto& queue = isPriority ? _priorityJobs : _jobs;
+  if (queue.empty()) return false;
+  job = std::move(queue.front());
+  queue.pop_front();
+  return true;
 }
 
 void JobScheduler::do_job(std::shared_ptr<BaseJob>&& job, bool isPriority) {
@@ -71,7 +159,7 @@ void JobScheduler::do_job(std::shared_ptr<BaseJob>&& job, bool isPriority) {
 
     switch (status) {
       case BaseJob::Status::RETRY:
-        _attemptedJobs.push(job);
+        queue_retry_job(std::move(job));
         return;
       case BaseJob::Status::COMPLETE:
         job->_state = BaseJob::State::FINISHED;
@@ -146,23 +234,46 @@ void JobScheduler::add_job(std::shared_ptr<BaseJob>&& job, bool isPriority) {
                 job->_name.c_str(), static_cast<int>(job->_state));
   }
 
-  if (isPriority) {
-    _priorityJobs.push(std::move(job));
-  } else {
-    _jobs.push(std::move(job));
+  {
+    std::lock_guard schedulerLock{_mutex};
+    if (isPriority) {
+      _priorityJobs.push_back(std::move(job));
+    } else {
+      _jobs.push_back(std::move(job));
+    }
+  }
+  _workAvailable.notify_one();
+}
+
+void JobScheduler::queue_retry_job(std::shared_ptr<BaseJob>&& job) {
+  job->_retryDelayMicros =
+      job->_retryDelayMicros == 0
+          ? coresdkconstants::JobRetryInitialDelayMicros
+          : std::min(job->_retryDelayMicros * 2, coresdkconstants::JobRetryMaxDelayMicros);
+  LOG_VERBOSE("BaseJob %s to be retried in %lld us", job->_name.c_str(),
+              static_cast<long long>(job->_retryDelayMicros));
+  auto deadline = now_micros() + job->_retryDelayMicros;
+  {
+    std::lock_guard lock{_mutex};
+    _retryJobs.schedule(std::move(job), deadline);
   }
+  // A sleeping worker has to start waking up every tick to expire the job
+  _workAvailable.notify_one();
 }
 
-void JobScheduler::append_jobs_back_to_queue() {
-  while (_attemptedJobs.size() != 0) {
-    auto job = _attemptedJobs.front();
-    _attemptedJobs.pop();
-    add_job(std::move(job), false);
+void JobScheduler::requeue_retry_jobs() {
+  if (_retryJobs.empty()) return;
+  std::vector<std::shared_ptr<BaseJob>> expired;
+  _retryJobs.expire(now_micros(), expired);
+  for (auto& job : expired) {
+    // Retried jobs go back to the non-priority queue, the state of the job is already SCHEDULED
+    _jobs.push_back(std::move(job));
   }
 }
 
 void JobScheduler::queue_internet_waiting_job(std::shared_ptr<BaseJob>&& job) {
   LOG_VERBOSE("BaseJob %s queued waiting for internet", job->_name.c_str());
+  job->_retryDelayMicros = 0;
   std::lock_guard lockGuard{_internetJobsMutex};
   _jobsWaitingForInternet.push_back(std::move(job));
 }
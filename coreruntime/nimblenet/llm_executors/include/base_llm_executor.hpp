@@ -24,6 +24,8 @@ class NoneVariable;
 struct LLMExecutorConfig {
   int maxInputNumTokens = 10'000; /**< Maximum number of input tokens accepted per prompt. */
   int internalQueueSize = 500;    /**< Size of internal queue containing the LLM output tokens. */
+  int numCachedContexts = 1; /**< Number of model contexts (KV caches) kept alive for reuse by
+                                  prompts sharing a prefix, across sessions. */
 };
 
 /**
@@ -98,4 +100,14 @@ class BaseLLMExecutor {
    * @return A shared pointer to a NoneVariable indicating completion of context reset.
    */
   virtual std::shared_ptr<NoneVariable> clear_context() = 0;
+
+  /**
+   * @brief Switch to a named session, created empty on first use. Sessions have their own context,
+   * prompts, cancel and clear_context apply to the current one.
+   *
+   * Not supported by default, executors keeping several contexts override it.
+   *
+   * @param name Name of the session.
+   */
+  virtual void set_session(const std::string& name);
 };
@@ -12,7 +12,7 @@
 #include "executorch/extension/llm/runner/runner.h"
 #endif  // EXECUTORCH_EXECUTOR
 #include "ne_fwd.hpp"
-#include "rigtorp/SPSCQueue.h"
+#include "token_queue.hpp"
 
 /**
  * @class ExecutorchLLMExecutor
@@ -23,7 +23,7 @@
  * functionality.
  */
 class ExecutorchLLMExecutor : public BaseLLMExecutor {
-  using Queue = rigtorp::SPSCQueue<char>;
+  using Queue = TokenQueue;
 
 #ifdef EXECUTORCH_EXECUTOR
   std::unique_ptr<::executorch::extension::llm::IRunner>
@@ -9,9 +9,9 @@
 #include "base_llm_executor.hpp"
 #include "char_stream.hpp"
 #include "ne_fwd.hpp"
-#include "rigtorp/SPSCQueue.h"
+#include "token_queue.hpp"
 
-using Queue = rigtorp::SPSCQueue<char>;
+using Queue = TokenQueue;
 
 /**
  * @class GeminiNanoExecutor
@@ -7,17 +7,21 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "base_llm_executor.hpp"
 #include "char_stream.hpp"
 #include "ne_fwd.hpp"
 #include "ort_genai.h"
 #include "ort_genai_c.h"
-#include "rigtorp/SPSCQueue.h"
+#include "prefix_context_cache.hpp"
+#include "token_queue.hpp"
 
 class Task;
 
@@ -26,21 +30,36 @@ class Task;
  * @brief Executor class responsible for running inference using ONNX-GenAI executor.
  *
  * Inherits from BaseLLMExecutor. It wraps and manages the ONNX GenAI model, tokenizer,
- * generator, and associated inference thread. Responsible for prompt submission,
+ * generators, and associated inference thread. Responsible for prompt submission,
  * token streaming, cancellation, and context reset.
+ *
+ * Conversations are kept per named session as the sequence of tokens of their context. Generators,
+ * which hold the KV cache, are pooled across sessions: a prompt runs on the generator sharing the
+ * longest prefix with the context of its session, rewound to that prefix, so that only the new
+ * tokens are prefilled. Switching back and forth between sessions, or clearing a context and
+ * starting again with the same system prompt, does not recompute the shared prefix.
  */
 class ONNXLLMExecutor : public BaseLLMExecutor {
-  using Queue = rigtorp::SPSCQueue<char>;
+  using Queue = TokenQueue;
 
   OgaHandle _ogaHandle; /**< Handle to ONNX GenAI runtime environment. */
 
   // Core GenAI components for local inference
   std::unique_ptr<OgaModel> _model;         /**< Loaded ONNX LLM model. */
   std::unique_ptr<OgaTokenizer> _tokenizer; /**< Tokenizer for converting text to tokens. */
-  std::unique_ptr<OgaGenerator> _generator; /**< Generator object which stores the context of user
-                                               prompts and assistant response. */
+  PrefixContextCache<std::unique_ptr<OgaGenerator>>
+      _generators; /**< Generators, along with the tokens in their KV cache. */
   std::unique_ptr<OgaGeneratorParams> _params; /**< Parameters for text generation. */
 
+  /**
+   * @brief Tokens of the context of every session, user prompts and assistant responses. They are
+   * only fed to a generator when a prompt is run.
+   */
+  std::map<std::string, std::vector<int32_t>> _sessions;
+  std::string _currentSession; /**< Name of the session prompts are added to. */
+  std::string _inferenceSession; /**< Name of the session of the running inference, if any. */
+  CommandCenter* _commandCenter; /**< Used to log metrics of every inference. */
+
   std::shared_ptr<CharStream> _charStream; /**< Stream to hold generated character output. */
   std::shared_ptr<Queue> _internalQueue;   /**< Internal single-producer single-consumer queue used
                                                 for inference communication. */
@@ -80,26 +99,36 @@ class ONNXLLMExecutor : public BaseLLMExecutor {
   void add_prompt(const std::string& prompt) override;
 
   /**
-   * @brief Cancel any ongoing inference operation.
+   * @brief Cancel the ongoing inference operation, if it runs for the current session.
    */
   void cancel() override;
 
   /**
-   * @brief Clears model context (i.e., resets generator state).
+   * @brief Clears the context of the current session. Generators are kept, so that a shared prefix
+   * of the next context is not computed again.
    *
    * @return Shared pointer to a NoneVariable indicating reset completion.
    */
   std::shared_ptr<NoneVariable> clear_context() override;
 
+  /**
+   * @brief Switches to a session, created with an empty context on first use.
+   *
+   * @param name Name of the session.
+   */
+  void set_session(const std::string& name) override;
+
  private:
   /**
    * @brief Inference loop run in a background thread.
    *
-   * Responsible for token generation and pushing tokens to the CharStream.
+   * Prefills the tokens of the session context missing from the generator, then generates tokens
+   * and pushes them to the CharStream. Logs the prefill and decode throughput as a metric.
    *
-   * @param prompt Prompt to feed to the generator.
+   * @param sessionName Session of the prompt.
+   * @param context Tokens of the session, including the prompt. Extended with the generated tokens.
    */
-  void run_inference(std::string prompt);
+  void run_inference(std::string sessionName, std::vector<int32_t>& context);
 
   /**
    * @brief Stops the inference thread and joins it safely.
@@ -107,18 +136,18 @@ class ONNXLLMExecutor : public BaseLLMExecutor {
   void stop_inference_thread();
 
   /**
-   * @brief Adds input string to the generator.
+   * @brief Tokenizes input and appends it to the context of the current session.
    *
    * @param input The input prompt.
    *
-   * @pre Caller must hold the `_mutex` lock.
+   * @pre Caller must hold the `_mutex` lock, with the inference thread stopped.
    */
-  void add_input_to_generator(const std::string& input);
+  void add_input_to_session(const std::string& input);
 
   /**
    * @brief Marks the end of stream in case of error or an error from the executor.
    *
-   * Pushes a null character `'\0'` to the stream queue.
+   * Closes the stream queue.
    */
   void mark_end_of_stream();
 };
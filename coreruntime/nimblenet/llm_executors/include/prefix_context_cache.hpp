@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bounded pool of model contexts, e.g. generators holding a KV cache, indexed by the tokens
+ * they were fed.
+ *
+ * acquire() returns the context sharing the longest token prefix with a target sequence, so that
+ * only the tokens after that prefix have to be prefilled. When no context shares any token, an
+ * empty context is handed out, or a new one is added while the pool is not full, otherwise the
+ * least recently used context is handed out to be reset.
+ *
+ * Not thread safe, the owner is expected to serialize calls.
+ *
+ * @tparam Context Type of the contexts, default constructed for new entries.
+ */
+template <typename Context>
+class PrefixContextCache {
+ public:
+  /**
+   * @brief A context and the tokens it holds, which the owner keeps in sync with the context.
+   */
+  struct Entry {
+    Context context{};
+    std::vector<int32_t> tokens;
+    uint64_t lastUsed = 0; /**< Value of the use counter when the entry was last acquired. */
+  };
+
+ private:
+  std::vector<Entry> _entries;
+  std::size_t _capacity;
+  uint64_t _useCounter = 0;
+
+  static std::size_t common_prefix(const std::vector<int32_t>& a, const std::vector<int32_t>& b) {
+    std::size_t length = std::min(a.size(), b.size());
+    std::size_t i = 0;
+    while (i < length && a[i] == b[i]) i++;
+    return i;
+  }
+
+ public:
+  /**
+   * @brief Constructs an empty pool.
+   *
+   * @param capacity Maximum number of contexts kept, at least one.
+   */
+  explicit PrefixContextCache(std::size_t capacity)
+      : _capacity(std::max<std::size_t>(capacity, 1)) {
+    _entries.reserve(_capacity);
+  }
+
+  /**
+   * @brief Picks the context to extend up to the target tokens and marks it as most recently used.
+   *
+   * Entries are never moved, so the returned pointer stays valid until clear().
+   *
+   * @param tokens Target sequence of tokens.
+   * @return The entry and the number of leading target tokens it already holds. The entry holds
+   * tokens past the prefix when it diverges from the target, these have to be rewound. A prefix of
+   * 0 means the context has to be reset, it is default constructed for a new entry.
+   */
+  std::pair<Entry*, std::size_t> acquire(const std::vector<int32_t>& tokens) {
+    Entry* best = nullptr;
+    std::size_t bestPrefix = 0;
+    for (auto& entry : _entries) {
+      std::size_t prefix = common_prefix(entry.tokens, tokens);
+      if (!best || prefix > bestPrefix ||
+          (prefix == bestPrefix && entry.lastUsed > best->lastUsed)) {
+        best = &entry;
+        bestPrefix = prefix;
+      }
+    }
+
+    if (bestPrefix == 0) {
+      // Nothing to reuse: take an empty context, else add one, else recycle the least recently used
+      auto empty = std::find_if(_entries.begin(), _entries.end(),
+                                [](const Entry& entry) { return entry.tokens.empty(); });
+      if (empty != _entries.end()) {
+        best = &*empty;
+      } else if (_entries.size() < _capacity) {
+        best = &_entries.emplace_back();
+      } else {
+        for (auto& entry : _entries) {
+          if (entry.lastUsed < best->lastUsed) best = &entry;
+        }
+      }
+    }
+    best->lastUsed = ++_useCounter;
+    return {best, bestPrefix};
+  }
+
+  /**
+   * @brief Number of contexts in the pool.
+   */
+  std::size_t size() const noexcept { return _entries.size(); }
+
+  /**
+   * @brief Drops every context.
+   */
+  void clear() { _entries.clear(); }
+};
@@ -17,11 +17,16 @@ void from_json(const nlohmann::json& j, LLMExecutorConfig& config) {
   if (auto it = j.find("internalQueueSize"); it != j.end()) {
     it.value().get_to(config.internalQueueSize);
   }
+
+  if (auto it = j.find("numCachedContexts"); it != j.end()) {
+    it.value().get_to(config.numCachedContexts);
+  }
 };
 
 void to_json(nlohmann::json& j, const LLMExecutorConfig& config) {
   j = nlohmann::json{{"maxInputNumTokens", config.maxInputNumTokens},
-                     {"internalQueueSize", config.internalQueueSize}};
+                     {"internalQueueSize", config.internalQueueSize},
+                     {"numCachedContexts", config.numCachedContexts}};
 };
 
 BaseLLMExecutor::BaseLLMExecutor(CommandCenter* commandCenter)
@@ -30,3 +35,7 @@ BaseLLMExecutor::BaseLLMExecutor(CommandCenter* commandCenter)
 int BaseLLMExecutor::max_input_num_tokens() const noexcept {
   return _executorConfig.maxInputNumTokens;
 }
+
+void BaseLLMExecutor::set_session(const std::string& name) {
+  THROW("Sessions are not supported by this LLM executor");
+}
@@ -69,13 +69,11 @@ void ExecutorchLLMExecutor::run_inference(const std::string& prompt) {
       mark_end_of_stream();
       return;
     }
-    for (char c : piece) {
-      if (c != '\0') {
-        _internalQueue->push(c);
-      } else {
-        mark_end_of_stream();
-        return;
-      }
+    auto end = piece.find('\0');
+    _internalQueue->push(std::string_view(piece).substr(0, end));
+    if (end != std::string::npos) {
+      mark_end_of_stream();
+      return;
     }
     (*numOfTokens)++;
   };
@@ -86,8 +84,9 @@ void ExecutorchLLMExecutor::run_inference(const std::string& prompt) {
         .temperature = _temperature,
     };
     auto status = _runner->generate_from_pos(prompt, config, _start_pos, token_callback, {});
+    // Closing the queue more than once is fine, generation can also end without an end of turn
+    mark_end_of_stream();
     if (status != ::executorch::runtime::Error::Ok) {
-      mark_end_of_stream();
       LOG_TO_CLIENT_ERROR("Error while running inference on LLM using executorch.");
     }
   } catch (const std::exception& e) {
@@ -133,4 +132,4 @@ void ExecutorchLLMExecutor::stop_inference_thread() {
   _internalQueue = nullptr;
 }
 
-void ExecutorchLLMExecutor::mark_end_of_stream() { _internalQueue->push('\0'); }
+void ExecutorchLLMExecutor::mark_end_of_stream() { _internalQueue->close(); }
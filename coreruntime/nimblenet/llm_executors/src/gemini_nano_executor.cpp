@@ -52,9 +52,7 @@ void GeminiNanoExecutor::push_to_queue(const std::string& text) {
   std::lock_guard<std::mutex> lock{_mutex};
 
   if (_internalQueue) {
-    for (char c : text) {
-      _internalQueue->push(c);
-    }
+    _internalQueue->push(text);
   }
 }
 
@@ -62,7 +60,7 @@ void GeminiNanoExecutor::mark_end_of_stream() {
   std::lock_guard<std::mutex> lock{_mutex};
 
   if (_internalQueue) {
-    _internalQueue->push('\0');
+    _internalQueue->close();
     _internalQueue = nullptr;
   }
 }
@@ -71,6 +69,8 @@ void GeminiNanoExecutor::cancel() {
   std::lock_guard<std::mutex> lock{_mutex};
 
   nativeinterface::cancel_os_llm_query();
+  // Close the stream, no more output is coming for it
+  if (_internalQueue) _internalQueue->close();
   _internalQueue = nullptr;
 }
 
@@ -9,17 +9,23 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <tuple>
 
 #include "base_llm_executor.hpp"
 #include "char_stream.hpp"
 #include "command_center.hpp"
+#include "nimble_net_util.hpp"
+#include "nlohmann/json.hpp"
 #include "ort_genai.h"
 #include "ort_genai_c.h"
 #include "task.hpp"
+#include "time_manager.hpp"
 
 ONNXLLMExecutor::ONNXLLMExecutor(const std::string& configPath, std::shared_ptr<Task> task,
                                  CommandCenter* commandCenter)
-    : BaseLLMExecutor(commandCenter) {
+    : BaseLLMExecutor(commandCenter),
+      _generators(_executorConfig.numCachedContexts),
+      _commandCenter(commandCenter) {
   if (!task) {
     THROW("%s", "Task pointer not set");
   }
@@ -30,7 +36,6 @@ ONNXLLMExecutor::ONNXLLMExecutor(const std::string& configPath, std::shared_ptr<
     _params = OgaGeneratorParams::Create(*_model);
     // TODO: Set this via ep config probably
     _params->SetSearchOption("max_length", _executorConfig.maxInputNumTokens);
-    _generator = OgaGenerator::Create(*_model, *_params);
   } catch (const std::exception& e) {
 // Don't delete LLM for simulator mode, as it is a symlink, which will delete the original
 #ifndef SIMULATION_MODE
@@ -59,47 +64,108 @@ std::shared_ptr<CharStream> ONNXLLMExecutor::run_prompt(const std::string& promp
 
   // NOTE: Initialize all variables that may be used by the inference thread before starting
   // the thread. This will ensure those variables are only touched by the thread
-  _inferenceThread = std::make_unique<std::thread>(&ONNXLLMExecutor::run_inference, this, prompt);
+  // Map nodes are stable, the thread extends the context while other sessions can be added
+  auto& context = _sessions[_currentSession];
+  try {
+    add_input_to_session(prompt);
+  } catch (const std::exception& e) {
+    mark_end_of_stream();
+    LOG_TO_CLIENT_ERROR("Could not tokenize prompt with error: %s using onnxruntime-genai",
+                        e.what());
+    return _charStream;
+  }
+  _inferenceSession = _currentSession;
+  _inferenceThread = std::make_unique<std::thread>(
+      [this, &context, sessionName = _currentSession]() { run_inference(sessionName, context); });
   return _charStream;
 }
 
-void ONNXLLMExecutor::add_input_to_generator(const std::string& input) {
+void ONNXLLMExecutor::add_input_to_session(const std::string& input) {
   auto sequences = OgaSequences::Create();
   _tokenizer->Encode(input.c_str(), *sequences);
-  _generator->AppendTokenSequences(*sequences);
+  const int32_t* tokens = sequences->SequenceData(0);
+  auto& context = _sessions[_currentSession];
+  context.insert(context.end(), tokens, tokens + sequences->SequenceCount(0));
 }
 
 void ONNXLLMExecutor::add_prompt(const std::string& prompt) {
   std::lock_guard<std::mutex> lock{_mutex};
-  stop_inference_thread();
+  // The context of the running inference is only complete once it is done
+  if (_inferenceSession == _currentSession) {
+    stop_inference_thread();
+  }
   try {
-    add_input_to_generator(prompt);
+    add_input_to_session(prompt);
   } catch (const std::exception& e) {
     LOG_TO_CLIENT_ERROR("Could not add input to generator with error: %s using onnxruntime-genai",
                         e.what());
   }
 }
 
-void ONNXLLMExecutor::run_inference(std::string prompt) {
+void ONNXLLMExecutor::run_inference(std::string sessionName, std::vector<int32_t>& context) {
+  decltype(_generators)::Entry* entry = nullptr;
   try {
-    add_input_to_generator(prompt);
+    std::size_t prefix;
+    std::tie(entry, prefix) = _generators.acquire(context);
+    auto& generator = entry->context;
+    // The last token is fed again if the generator holds the whole context, as a token has to be
+    // appended to compute the logits of the next one
+    if (prefix > 0 && prefix == context.size()) prefix--;
+    if (!generator || prefix == 0) {
+      // Frees the KV cache of a recycled generator before allocating the new one
+      generator.reset();
+      entry->tokens.clear();
+      generator = OgaGenerator::Create(*_model, *_params);
+    } else if (prefix < entry->tokens.size()) {
+      generator->RewindTo(prefix);
+      entry->tokens.resize(prefix);
+    }
+
+    std::size_t numPrefillTokens = context.size() - prefix;
+    auto prefillStart = Time::get_high_resolution_clock_time();
+    generator->AppendTokens(context.data() + prefix, numPrefillTokens);
+    entry->tokens.insert(entry->tokens.end(), context.begin() + prefix, context.end());
+    long long prefillMicros = Time::get_elapsed_time_in_micro(prefillStart);
 
+    std::size_t numDecodeTokens = 0;
+    auto decodeStart = Time::get_high_resolution_clock_time();
     auto tokenizerOutStream = OgaTokenizerStream::Create(*_tokenizer);
-    while (_runInferenceThread.load() && !_generator->IsDone()) {
-      _generator->GenerateNextToken();
+    while (_runInferenceThread.load() && !generator->IsDone()) {
+      generator->GenerateNextToken();
 
-      const auto num_tokens = _generator->GetSequenceCount(0);
-      const auto new_token = _generator->GetSequenceData(0)[num_tokens - 1];
+      const auto num_tokens = generator->GetSequenceCount(0);
+      const auto new_token = generator->GetSequenceData(0)[num_tokens - 1];
+      context.push_back(new_token);
+      entry->tokens.push_back(new_token);
+      numDecodeTokens++;
 
       const char* outStr = tokenizerOutStream->Decode(new_token);
       // LOG_TO_DEBUG("got from tokenizer: %s", outStr);
-      while (*outStr != '\0') {
-        _internalQueue->push(*outStr);
-        outStr++;
-      }
+      _internalQueue->push(outStr, new_token);
     }
     mark_end_of_stream();
+    long long decodeMicros = Time::get_elapsed_time_in_micro(decodeStart);
+
+    auto tokensPerSec = [](std::size_t numTokens, long long micros) {
+      return micros > 0 ? numTokens * 1e6 / micros : 0.0;
+    };
+    nlohmann::json metric = {
+        {"session", sessionName},
+        {"reusedTokens", prefix},
+        {"prefillTokens", numPrefillTokens},
+        {"prefillTimeMicros", prefillMicros},
+        {"prefillTokensPerSec", tokensPerSec(numPrefillTokens, prefillMicros)},
+        {"decodeTokens", numDecodeTokens},
+        {"decodeTimeMicros", decodeMicros},
+        {"decodeTokensPerSec", tokensPerSec(numDecodeTokens, decodeMicros)},
+    };
+    _commandCenter->log_metrics(LLMINFERENCEMETRIC, metric);
   } catch (const std::exception& e) {
+    // The generator may not hold the tokens recorded for it anymore
+    if (entry) {
+      entry->context.reset();
+      entry->tokens.clear();
+    }
     mark_end_of_stream();
     LOG_TO_CLIENT_ERROR("Error: %s while running inference on LLM using onnxruntime-genai.",
                         e.what());
@@ -113,6 +179,7 @@ void ONNXLLMExecutor::stop_inference_thread() {
   _inferenceThread->join();
   _inferenceThread.reset();
   _runInferenceThread.store(true);
+  _inferenceSession.clear();
 
   _charStream = nullptr;
   _internalQueue = nullptr;
@@ -120,23 +187,24 @@ void ONNXLLMExecutor::stop_inference_thread() {
 
 void ONNXLLMExecutor::cancel() {
   std::lock_guard<std::mutex> lock{_mutex};
-
-  stop_inference_thread();
+  if (_inferenceSession == _currentSession) {
+    stop_inference_thread();
+  }
 }
 
 std::shared_ptr<NoneVariable> ONNXLLMExecutor::clear_context() {
   std::lock_guard<std::mutex> lock{_mutex};
-  stop_inference_thread();
-  try {
-    _generator->SetRuntimeOption("terminate_session", "1");
-    _generator.reset();
-    _generator = OgaGenerator::Create(*_model, *_params);
-  } catch (const std::exception& e) {
-    LOG_TO_CLIENT_ERROR("Error: %s while clearing context for LLM using onnxruntime-genai.",
-                        e.what());
+  if (_inferenceSession == _currentSession) {
+    stop_inference_thread();
   }
-
+  // Generators keep their KV cache, a context starting with the same tokens reuses it
+  _sessions[_currentSession].clear();
   return std::make_shared<NoneVariable>();
 }
 
-void ONNXLLMExecutor::mark_end_of_stream() { _internalQueue->push('\0'); }
+void ONNXLLMExecutor::set_session(const std::string& name) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  _currentSession = name;
+}
+
+void ONNXLLMExecutor::mark_end_of_stream() { _internalQueue->close(); }
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Streaming compression and decompression of files.
+ *
+ * The codec of a file is detected from its first bytes, so a reader accepts files written with any
+ * codec as well as uncompressed files. A codec is added by implementing FileReader and FileWriter,
+ * and recognizing its magic bytes in detect_codec().
+ */
+namespace filecodec {
+
+/**
+ * @brief Compression format of a file.
+ */
+enum class Codec {
+  NONE, /**< Uncompressed. */
+  GZIP, /**< gzip, through zlib. */
+};
+
+/** Compression level chosen by the codec, see open_writer() */
+static inline constexpr int DefaultLevel = -1;
+
+/**
+ * @brief Reads the content of a file, decompressing it.
+ */
+class FileReader {
+ public:
+  virtual ~FileReader() = default;
+
+  /**
+   * @brief Reads the next bytes of content.
+   *
+   * @param buffer Buffer to read into.
+   * @param size Size of the buffer.
+   * @return Number of bytes read, 0 at the end of the content or -1 if the file is corrupted or
+   * could not be read.
+   */
+  virtual int64_t read(char* buffer, size_t size) = 0;
+};
+
+/**
+ * @brief Writes content to a file, compressing it.
+ */
+class FileWriter {
+ public:
+  virtual ~FileWriter() = default;
+
+  /**
+   * @brief Appends bytes of content.
+   *
+   * @return false if the file could not be written.
+   */
+  virtual bool write(const char* data, size_t size) = 0;
+
+  /**
+   * @brief Completes the file. Destroying an open writer closes it as well, ignoring errors.
+   *
+   * @return false if the file could not be written.
+   */
+  virtual bool close() = 0;
+};
+
+/**
+ * @brief Detects the codec of a file from its magic bytes.
+ *
+ * @param filePath Full path of the file.
+ * @return The codec, NONE if the file is not compressed or could not be read.
+ */
+Codec detect_codec(const std::string& filePath);
+
+/**
+ * @brief Opens a file for reading, with the codec it is written with.
+ *
+ * @param filePath Full path of the file.
+ * @return The reader, or nullptr if the file could not be opened.
+ */
+std::unique_ptr<FileReader> open_reader(const std::string& filePath);
+
+/**
+ * @brief Creates or truncates a file for writing.
+ *
+ * @param filePath Full path of the file.
+ * @param codec Codec to compress the content with.
+ * @param level Compression level, from 1 (fastest) to 9 (smallest) for gzip. Ignored for
+ * uncompressed files.
+ * @return The writer, or nullptr if the file could not be opened.
+ */
+std::unique_ptr<FileWriter> open_writer(const std::string& filePath, Codec codec,
+                                        int level = DefaultLevel);
+
+}  // namespace filecodec
@@ -7,11 +7,13 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 
 #include "core_utils/fmt.hpp"
+#include "mapped_file.hpp"
 #include "native_interface_constants.hpp"
 #include "native_interface_structs.hpp"
 
@@ -76,6 +78,45 @@ std::pair<bool, std::string> read_log_file(const std::string& logFileName);
 std::pair<bool, std::string> read_potentially_compressed_file(const std::string& fileName,
                                                               bool filePathProvided = false);
 
+/**
+ * @brief Maps a file read-only into memory, decompressing it if needed.
+ *
+ * A gzip compressed file is decompressed once, replacing the compressed file on disk, so that its
+ * content can be mapped and later calls map it directly. The content is never copied into the heap.
+ *
+ * @param fileName           Path to the file
+ * @param filePathProvided   If true then take the fileName as is else add HOMEDIR to get the
+ * complete path.
+ * @param access             How the mapping is going to be read.
+ * @return                   The mapping, or nullptr if the file could not be decompressed or mapped
+ */
+std::unique_ptr<MappedFile> map_potentially_compressed_file(
+    const std::string& fileName, bool filePathProvided = false,
+    MappedFile::Access access = MappedFile::Access::WHOLE);
+
+/**
+ * @brief Checks whether a file starts with the gzip magic.
+ *
+ * @param fileName           Path to the file
+ * @param filePathProvided   If true then take the fileName as is else add HOMEDIR to get the
+ * complete path.
+ * @return                   false if the file is not gzip compressed or could not be read
+ */
+bool is_gzip_file(const std::string& fileName, bool filePathProvided = false);
+
+/**
+ * @brief Reads a file chunk by chunk, decompressing it if needed.
+ *
+ * Unlike read_potentially_compressed_file the content is never held whole in memory, only one
+ * chunk of at most FileReadChunkSize bytes at a time.
+ *
+ * @param filePath   Path to the file
+ * @param onChunk    Function called with every chunk of content, in order
+ * @return           false if the file could not be opened, or is corrupted past the chunks passed
+ */
+bool read_potentially_compressed_file_in_chunks(
+    const std::string& filePath, const std::function<void(const char*, size_t)>& onChunk);
+
 /**
  * @brief Reads a file's content into a string from the device. Decrypting it if needed.
  *
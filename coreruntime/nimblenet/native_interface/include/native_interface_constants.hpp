@@ -8,4 +8,8 @@
 
 namespace nativeinterfaceconstants {
 static inline const std::string systemMetrics = "system-metrics";
+// Size of the chunks in which files are read and decompressed when streaming them
+static inline constexpr int FileReadChunkSize = 64 * 1024;
+// Size of the buffers of zlib when compressing and decompressing files
+static inline constexpr int FileCodecBufferSize = 256 * 1024;
 }  // namespace nativeinterfaceconstants
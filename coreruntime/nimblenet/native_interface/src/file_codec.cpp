@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "file_codec.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+
+#include "native_interface_constants.hpp"
+#include "zlib.h"
+
+namespace filecodec {
+
+namespace {
+
+/**
+ * @brief Reads an uncompressed file straight into the buffers given, without copying.
+ */
+class PlainFileReader final : public FileReader {
+  int _fd;
+
+ public:
+  explicit PlainFileReader(int fd) : _fd(fd) {}
+
+  ~PlainFileReader() override { ::close(_fd); }
+
+  int64_t read(char* buffer, size_t size) override {
+    while (true) {
+      ssize_t numRead = ::read(_fd, buffer, size);
+      if (numRead >= 0 || errno != EINTR) return numRead;
+    }
+  }
+};
+
+/**
+ * @brief Writes an uncompressed file straight from the buffers given.
+ */
+class PlainFileWriter final : public FileWriter {
+  int _fd;
+
+ public:
+  explicit PlainFileWriter(int fd) : _fd(fd) {}
+
+  ~PlainFileWriter() override {
+    if (_fd >= 0) ::close(_fd);
+  }
+
+  bool write(const char* data, size_t size) override {
+    while (size > 0) {
+      ssize_t numWritten = ::write(_fd, data, size);
+      if (numWritten < 0) {
+        if (errno == EINTR) continue;
+        return false;
+      }
+      data += numWritten;
+      size -= numWritten;
+    }
+    return true;
+  }
+
+  bool close() override {
+    int ret = ::close(_fd);
+    _fd = -1;
+    return ret == 0;
+  }
+};
+
+/**
+ * @brief Reads a gzip file, possibly made of several members, checking the CRC32 of every member.
+ */
+class GzipFileReader final : public FileReader {
+  gzFile _file;
+
+ public:
+  explicit GzipFileReader(gzFile file) : _file(file) {
+    gzbuffer(_file, nativeinterfaceconstants::FileCodecBufferSize);
+  }
+
+  ~GzipFileReader() override { gzclose(_file); }
+
+  int64_t read(char* buffer, size_t size) override {
+    int numRead = gzread(_file, buffer, std::min<size_t>(size, INT_MAX));
+    if (numRead == 0) {
+      // A truncated file also ends the content, with an error
+      int error = Z_OK;
+      gzerror(_file, &error);
+      if (error != Z_OK) return -1;
+    }
+    return numRead;
+  }
+};
+
+/**
+ * @brief Writes a gzip file with the compression level it was opened with.
+ */
+class GzipFileWriter final : public FileWriter {
+  gzFile _file;
+
+ public:
+  explicit GzipFileWriter(gzFile file) : _file(file) {
+    gzbuffer(_file, nativeinterfaceconstants::FileCodecBufferSize);
+  }
+
+  ~GzipFileWriter() override {
+    if (_file != Z_NULL) gzclose(_file);
+  }
+
+  bool write(const char* data, size_t size) override {
+    while (size > 0) {
+      unsigned chunk = std::min<size_t>(size, INT_MAX);
+      if (gzwrite(_file, data, chunk) != static_cast<int>(chunk)) return false;
+      data += chunk;
+      size -= chunk;
+    }
+    return true;
+  }
+
+  bool close() override {
+    int ret = gzclose(_file);
+    _file = Z_NULL;
+    return ret == Z_OK;
+  }
+};
+
+}  // namespace
+
+Codec detect_codec(const std::string& filePath) {
+  unsigned char magic[2] = {0, 0};
+  FILE* file = fopen(filePath.c_str(), "rb");
+  if (file == nullptr) return Codec::NONE;
+  size_t numRead = fread(magic, 1, sizeof(magic), file);
+  fclose(file);
+  if (numRead == sizeof(magic) && magic[0] == 0x1f && magic[1] == 0x8b) {
+    return Codec::GZIP;
+  }
+  return Codec::NONE;
+}
+
+std::unique_ptr<FileReader> open_reader(const std::string& filePath) {
+  switch (detect_codec(filePath)) {
+    case Codec::GZIP: {
+      gzFile file = gzopen(filePath.c_str(), "rb");
+      if (file == Z_NULL) return nullptr;
+      return std::make_unique<GzipFileReader>(file);
+    }
+    case Codec::NONE: {
+      int fd = ::open(filePath.c_str(), O_RDONLY);
+      if (fd < 0) return nullptr;
+      return std::make_unique<PlainFileReader>(fd);
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<FileWriter> open_writer(const std::string& filePath, Codec codec, int level) {
+  switch (codec) {
+    case Codec::GZIP: {
+      std::string mode = "wb";
+      if (level != DefaultLevel) mode += std::to_string(level);
+      gzFile file = gzopen(filePath.c_str(), mode.c_str());
+      if (file == Z_NULL) return nullptr;
+      return std::make_unique<GzipFileWriter>(file);
+    }
+    case Codec::NONE: {
+      int fd = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd < 0) return nullptr;
+      return std::make_unique<PlainFileWriter>(fd);
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace filecodec
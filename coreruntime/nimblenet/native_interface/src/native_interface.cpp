@@ -9,17 +9,21 @@
 #include "miniz.h"
 #endif
 #include <sys/stat.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <thread>
+#include <vector>
 
 #include "client.h"
+#include "file_codec.hpp"
 #include "logger.hpp"
 #include "resource_manager_constants.hpp"
 #include "util.hpp"
-#include "zlib.h"
 using namespace std;
 
 static inline bool get_file_from_device(const std::string& fullFilePath, string& result,
@@ -62,94 +66,66 @@ FileDownloadInfo download_to_file_async(const string& url, const string& header,
 }
 
 std::pair<bool, std::string> decompress_file_to_string(const char* inFileName) {
-  gzFile inFile = gzopen(inFileName, "rb");
-  if (inFile == Z_NULL) {
-    LOG_TO_ERROR("could not open gzFile=%s", inFileName);
+  auto reader = filecodec::open_reader(inFileName);
+  if (reader == nullptr) {
+    LOG_TO_ERROR("could not open file=%s", inFileName);
     return {false, ""};
   }
 
+  // Read straight into the string, growing it a chunk at a time
   std::string uncompressedString;
-  char buffer[128];
-  int numRead = 0;
-  while ((numRead = gzread(inFile, buffer, sizeof(buffer))) > 0) {
-    uncompressedString.append(buffer, numRead);
+  int64_t numRead = 0;
+  do {
+    size_t size = uncompressedString.size();
+    uncompressedString.resize(size + nativeinterfaceconstants::FileReadChunkSize);
+    numRead = reader->read(uncompressedString.data() + size,
+                           nativeinterfaceconstants::FileReadChunkSize);
+    uncompressedString.resize(size + std::max<int64_t>(numRead, 0));
+  } while (numRead > 0);
+  if (numRead < 0) {
+    LOG_TO_ERROR("could not read file=%s", inFileName);
+    return {false, ""};
   }
-
-  gzclose(inFile);
-  return {true, uncompressedString};
+  return {true, std::move(uncompressedString)};
 }
 
-bool decompress_file(const std::string& inFileName, const std::string& outFileName) {
-  // Open gzipped input file
-  std::string fullInFileName = get_full_file_path_common(inFileName);
-  std::string fullOutFileName = get_full_file_path_common(outFileName);
-  gzFile inFile = gzopen(fullInFileName.c_str(), "rb");
-  if (inFile == Z_NULL) {
-    int err;
-    LOG_TO_ERROR("could not open gzFile=%s, error=%s", inFileName.c_str(), gzerror(inFile, &err));
+// Copies the content of a file to another, decompressing and compressing it as the codecs say
+static bool transcode_file(const char* inFileName, const char* outFileName,
+                           filecodec::Codec outCodec) {
+  auto reader = filecodec::open_reader(inFileName);
+  if (reader == nullptr) {
+    LOG_TO_ERROR("could not open file=%s", inFileName);
     return false;
   }
-
-  // Open output file for normal binary writing
-  FILE* outFile = fopen(fullOutFileName.c_str(), "wb");
-  if (outFile == nullptr) {
-    gzclose(inFile);
-    LOG_TO_ERROR("could not open file=%s", outFileName.c_str());
+  auto writer = filecodec::open_writer(outFileName, outCodec);
+  if (writer == nullptr) {
+    LOG_TO_ERROR("could not open file=%s", outFileName);
     return false;
   }
 
-  char buffer[128];
-  int numRead = 0;
-  while ((numRead = gzread(inFile, buffer, sizeof(buffer))) > 0) {
-    size_t numWritten = fwrite(buffer, 1, numRead, outFile);
-    if (numWritten != static_cast<size_t>(numRead)) {
-      gzclose(inFile);
-      fclose(outFile);
-      LOG_TO_ERROR("Error while decompressing gzFile=%s to file=%s, error=%d", inFile, outFile,
-                   errno);
-      return false;
+  std::vector<char> buffer(nativeinterfaceconstants::FileReadChunkSize);
+  int64_t numRead = 0;
+  while ((numRead = reader->read(buffer.data(), buffer.size())) > 0) {
+    if (!writer->write(buffer.data(), numRead)) {
+      break;
     }
   }
-
-  gzclose(inFile);
-  fclose(outFile);
-  return true;
-}
-
-bool compress_file(const char* inFileName, const char* outFileName) {
-  // TODO: Do proper RAII closing of files on error
-  gzFile inFile = gzopen(inFileName, "rb");
-  if (inFile == Z_NULL) {
-    int err;
-    // LOG_TO_ERROR("could not open gzFile=%s, error=%s", inFileName, gzerror(inFile, &err));
-    return false;
-  }
-
-  gzFile outFile = gzopen(outFileName, "wb");
-  if (outFile == Z_NULL) {
-    gzclose(inFile);
-    int err;
-    // LOG_TO_ERROR("could not open gzFile=%s, error=%s", outFileName, gzerror(outFile, &err));
+  if (numRead != 0 || !writer->close()) {
+    LOG_TO_ERROR("Error while copying file=%s to file=%s, error=%s", inFileName, outFileName,
+                 strerror(errno));
     return false;
   }
+  return true;
+}
 
-  char buffer[128];
-  int numRead = 0;
-  while ((numRead = gzread(inFile, buffer, sizeof(buffer))) > 0) {
-    int numWritten = gzwrite(outFile, buffer, numRead);
-    if (numWritten <= 0) {
-      int err;
-      // LOG_TO_ERROR("Error while decompressing file=%s to gzFile=%s, error=%s", inFile, outFile,
-      //              gzerror(outFile, &err));
-      gzclose(inFile);
-      gzclose(outFile);
-      return false;
-    }
-  }
+bool decompress_file(const std::string& inFileName, const std::string& outFileName) {
+  std::string fullInFileName = get_full_file_path_common(inFileName);
+  std::string fullOutFileName = get_full_file_path_common(outFileName);
+  return transcode_file(fullInFileName.c_str(), fullOutFileName.c_str(), filecodec::Codec::NONE);
+}
 
-  gzclose(inFile);
-  gzclose(outFile);
-  return true;
+bool compress_file(const char* inFileName, const char* outFileName) {
+  return transcode_file(inFileName, outFileName, filecodec::Codec::GZIP);
 }
 
 std::pair<bool, std::string> read_log_file(const std::string& logFileName) {
@@ -168,6 +144,80 @@ std::pair<bool, std::string> read_potentially_compressed_file(const std::string&
   return decompress_file_to_string(fullFilePath.c_str());
 }
 
+// Replaces a gzip file by its content, through a temporary file so that the original is only
+// replaced once fully decompressed
+static bool decompress_file_in_place(const std::string& filePath) {
+  // Unique name in the same directory, so that concurrent decompressions of the file do not write
+  // into the same temporary file and the rename stays on one filesystem
+  std::string tmpFilePath = filePath + ".XXXXXX";
+  int fd = mkstemp(&tmpFilePath[0]);
+  if (fd < 0) {
+    LOG_TO_ERROR("could not create temporary file for file=%s, error=%s", filePath.c_str(),
+                 strerror(errno));
+    return false;
+  }
+  // mkstemp creates the file readable only by the owner, keep the mode of the replaced file
+  struct stat fileStat;
+  if (stat(filePath.c_str(), &fileStat) == 0) {
+    fchmod(fd, fileStat.st_mode & 0777);
+  }
+  FILE* outFile = fdopen(fd, "wb");
+  if (outFile == nullptr) {
+    LOG_TO_ERROR("could not open file=%s", tmpFilePath.c_str());
+    close(fd);
+    remove(tmpFilePath.c_str());
+    return false;
+  }
+  bool written = true;
+  bool opened = read_potentially_compressed_file_in_chunks(
+      filePath, [&](const char* data, size_t size) {
+        written = written && fwrite(data, 1, size, outFile) == size;
+      });
+  written = fclose(outFile) == 0 && written;
+  if (!opened || !written || rename(tmpFilePath.c_str(), filePath.c_str()) != 0) {
+    LOG_TO_ERROR("Could not decompress file=%s in place, error=%s", filePath.c_str(),
+                 strerror(errno));
+    remove(tmpFilePath.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool is_gzip_file(const std::string& fileName, bool filePathProvided) {
+  std::string fullFilePath = filePathProvided ? fileName : HOMEDIR + fileName;
+  return filecodec::detect_codec(fullFilePath) == filecodec::Codec::GZIP;
+}
+
+std::unique_ptr<MappedFile> map_potentially_compressed_file(const std::string& fileName,
+                                                            bool filePathProvided,
+                                                            MappedFile::Access access) {
+  std::string fullFilePath = filePathProvided ? fileName : HOMEDIR + fileName;
+  bool isCompressed = filecodec::detect_codec(fullFilePath) != filecodec::Codec::NONE;
+  if (isCompressed && !decompress_file_in_place(fullFilePath)) {
+    return nullptr;
+  }
+  return MappedFile::open(fullFilePath, access);
+}
+
+bool read_potentially_compressed_file_in_chunks(
+    const std::string& filePath, const std::function<void(const char*, size_t)>& onChunk) {
+  auto reader = filecodec::open_reader(filePath);
+  if (reader == nullptr) {
+    return false;
+  }
+
+  std::vector<char> buffer(nativeinterfaceconstants::FileReadChunkSize);
+  int64_t numRead = 0;
+  while ((numRead = reader->read(buffer.data(), buffer.size())) > 0) {
+    onChunk(buffer.data(), numRead);
+  }
+  if (numRead < 0) {
+    LOG_TO_ERROR("could not read file=%s", filePath.c_str());
+    return false;
+  }
+  return true;
+}
+
 bool get_file_from_device_common(const std::string& fileName, string& result,
                                  bool filePathProvided) {
   std::string fullFilePath = filePathProvided ? fileName : HOMEDIR + fileName;
@@ -185,19 +235,12 @@ bool get_unencrypted_file_from_device_common(const std::string& fileName, std::s
 // This will always overwrite the current file with given content
 bool compress_and_save_file_on_device(const std::string& content, const std::string& fileName) {
   const auto fullFilePath = HOMEDIR + fileName;
-  gzFile file = gzopen(fullFilePath.c_str(), "wb");
-  int ret = gzwrite(file, content.c_str(), content.size());
-  gzclose(file);
-  if (ret <= 0) {
-    LOG_TO_ERROR("Unable to compress and save file to device, gzwrite return: %d, err: %s", ret,
-                 gzerror(file, &ret));
-    return false;
-  } else if (ret != content.size()) {
-    LOG_TO_ERROR("File not fully written. Wrote %d bytes, had to write %d bytes", ret,
-                 content.size());
+  auto writer = filecodec::open_writer(fullFilePath, filecodec::Codec::GZIP);
+  if (writer == nullptr || !writer->write(content.data(), content.size()) || !writer->close()) {
+    LOG_TO_ERROR("Unable to compress and save file=%s to device, error=%s", fullFilePath.c_str(),
+                 strerror(errno));
     return false;
   }
-
   return true;
 }
 
@@ -167,6 +167,9 @@ bool load_model_from_file(const char* modelFilePath, const char* inferenceConfig
 void delete_database() {
   auto fileName = (nativeinterface::HOMEDIR + DEFAULT_SQLITE_DB_NAME);
   remove(fileName.c_str());
+  // Files of the WAL journal of the database
+  remove((fileName + "-wal").c_str());
+  remove((fileName + "-shm").c_str());
 }
 
 bool reload_model_with_epConfig(const char* modelName, const char* epConfig) {
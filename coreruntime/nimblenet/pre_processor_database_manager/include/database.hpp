@@ -8,11 +8,17 @@
 
 #include <sqlite3.h>
 
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
 
 #include "database_constants.hpp"
+#include "event_record.hpp"
+#include "flush_timer.hpp"
 #include "table_store.hpp"
 #include "time_manager.hpp"
 #include "user_events_struct.hpp"
@@ -22,10 +28,31 @@ class MetricsAgent;
 /**
  * @brief Class responsible for managing database operations such as storing,
  * retrieving, and managing event-related data. The data is stored in a sqlite db.
- * sqlite db.
+ *
+ * The db is journaled in WAL mode and every statement is prepared once and cached. Events are
+ * stored as binary records of EventRecordEncoder in BLOBs, rows stored as JSON text by older
+ * versions are still read. Added events are grouped in a transaction committed every
+ * MaxUncommittedEvents events, by FlushTimer MaxUncommittedDelayMicros after the transaction was
+ * started or before any other operation, so an event is not durable until then.
  */
 class Database {
  private:
+  /**
+   * @brief Resets a cached statement when it is released, keeping it prepared for the next use.
+   */
+  struct StatementResetter {
+    void operator()(sqlite3_stmt* stmt) const {
+      sqlite3_reset(stmt);
+      sqlite3_clear_bindings(stmt);
+    }
+  };
+
+  /** @brief Cached statement in use, reset when it goes out of scope. */
+  using Statement = std::unique_ptr<sqlite3_stmt, StatementResetter>;
+
+  /** @brief Mutex to synchronize access to the database operations and cached statements. */
+  mutable std::mutex _mutex;
+
 #ifdef SIMULATION_MODE
   /** @brief Flag indicating if the database operation is triggered from nimblenet_py. */
   bool _isSimulation = true;
@@ -36,11 +63,24 @@ class Database {
 
   sqlite3* _db = NULL; /**< Sqlite db instance used for CRUD operations. */
 
+  /** @brief Prepared statements of _db, by their SQL. */
+  std::unordered_map<std::string, sqlite3_stmt*> _statements;
+
   MetricsAgent* _metricsAgent =
       nullptr; /**<Pointer to a MetricsAgent used for logging database related metrics. */
 
   std::set<std::string> _eventTypes; /**< Set of event types stored in the DB. */
 
+  EventRecordEncoder _encoder; /**< Encoder of the events, reset for every row. */
+
+  int _uncommittedEvents = 0; /**< Number of events added in the open transaction. */
+
+  int64_t _firstUncommittedTimeMicros = 0; /**< Time the open transaction was started at. */
+
+  int _commitTimerId = -1; /**< Id of the delayed commit of added events in FlushTimer. */
+
+  bool _flushEveryRecord = false; /**< Whether every added event is committed at once. */
+
   bool _full = false; /**< Flag indicating if the database has reached its full capacity */
 
   /**
@@ -48,6 +88,11 @@ class Database {
    */
   int open_database_file();
 
+  /**
+   * @brief Sets the journal mode of the DB and creates its tables and index if needed.
+   */
+  bool init_database();
+
   /**
    * @brief Does a sanity check of the DB by checking its size
    */
@@ -58,27 +103,57 @@ class Database {
    */
   void remove_database_file();
 
+  /**
+   * @brief Finalizes the cached statements and closes the DB.
+   */
+  void close_database();
+
   /**
    * @brief Returns true in case the db is malformed.
    */
   static bool should_delete(int status);
 
   /**
-   * @brief Checks if the tableName exists in eventsType table.
+   * @brief Runs SQL statements without results, for schema changes and transactions.
    *
-   * @param tableName eventType to check
+   * @param sql Statements to run.
+   * @return true on success, the error is logged otherwise.
    */
-  bool check_tableName_in_eventsType_Table(const std::string& tableName);
+  bool execute(const char* sql);
 
   /**
-   * @brief Create eventsType table in DB.
+   * @brief Gets the cached prepared statement of a SQL query, preparing it on first use.
+   *
+   * @param sql Query with parameters bound by the caller.
+   * @return The statement, or nullptr if it could not be prepared, which is logged.
    */
-  bool create_eventsType_table();
+  Statement get_statement(const std::string& sql);
 
   /**
-   * @brief Create events table in DB.
+   * @brief Commits the transaction of added events, if one is open.
    */
-  bool create_events_table();
+  void commit_events();
+
+  /**
+   * @brief Reads the size of the DB, caller holds _mutex.
+   */
+  int read_db_size(int& dbSize);
+
+  /**
+   * @brief Counts the rows of the events table, of an event type if one is given, caller holds
+   * _mutex.
+   *
+   * @param eventType Event type to count, nullptr to count all the rows.
+   * @return Number of rows, -1 on error.
+   */
+  int count_events(const std::string* eventType);
+
+  /**
+   * @brief Checks if the tableName exists in eventsType table.
+   *
+   * @param tableName eventType to check
+   */
+  bool check_tableName_in_eventsType_Table(const std::string& tableName);
 
   /**
    * @brief Delete old rows from table before expiry time.
@@ -99,9 +174,18 @@ class Database {
  public:
   /**
    * @brief Constructor to Create DB.
+   *
+   * @param metricsAgent Pointer to a MetricsAgent for reporting metrics.
+   * @param flushEveryRecord Whether every event is committed as it is added, see
+   * Config::flushEveryRecord.
    */
-  Database(MetricsAgent* metricsAgent) : _db(nullptr) {
+  Database(MetricsAgent* metricsAgent, bool flushEveryRecord = false) : _db(nullptr) {
     _metricsAgent = metricsAgent;
+    _flushEveryRecord = flushEveryRecord;
+    _commitTimerId = FlushTimer::instance().add([this]() {
+      std::lock_guard<std::mutex> lockGuard(_mutex);
+      commit_events();
+    });
     database_open();
   };
 
@@ -134,11 +218,24 @@ class Database {
   bool add_event_in_db(const std::string& tableName, const OpReturnType eventMapTable);
 
   /**
-   * @brief Get all the events stored in Events table filtering by tableName.
+   * @brief Function called for every event read from the database.
+   *
+   * Receives the time the event was stored at in seconds and the fields of the event.
+   */
+  using EventCallback =
+      std::function<void(int64_t timestamp, std::map<std::string, OpReturnType>&& event)>;
+
+  /**
+   * @brief Streams all the events stored in Events table filtering by tableName, oldest first.
+   *
+   * Rows are read one at a time through the index on event type and timestamp.
    *
    * @param tableName eventType to be used for filtering.
+   * @param callback Function called for every event.
+   * @param expiryTime Events older than this timestamp are skipped.
    */
-  std::vector<nlohmann::json> get_events_from_db(const std::string& tableName);
+  void for_each_event(const std::string& tableName, const EventCallback& callback,
+                      int64_t expiryTime = 0);
 
   /**
    * @brief Updates the events type table with a new or modified table name.
@@ -180,5 +277,8 @@ class Database {
   int get_count_from_eventsTable(const std::string& eventType);
 #endif
 
-  ~Database() { sqlite3_close_v2(_db); }
+  /**
+   * @brief Cancels the delayed commit, commits the added events and closes the DB.
+   */
+  ~Database();
 };
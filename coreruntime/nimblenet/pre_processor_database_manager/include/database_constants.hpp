@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 /**
@@ -38,6 +39,23 @@ static inline const std::string TimeStampColumnName = "TIMESTAMP";
  */
 static inline const std::string EventColumnName = "event";
 
+/**
+ * @brief Name of the index of the Events table on event type and timestamp, used by reads and
+ * deletions of the events of a type.
+ */
+static inline const std::string EventsIndexName = "EventsTypeTimestampIndex";
+
+/**
+ * @brief Number of added events after which their transaction is committed.
+ */
+static inline const int MaxUncommittedEvents = 256;
+
+/**
+ * @brief Time after which the transaction of added events is committed, checked when an event is
+ * added.
+ */
+static inline const int64_t MaxUncommittedDelayMicros = 1000000;  // 1 second
+
 /**
  * @brief Maximum allowed database size in kilobytes.
  *
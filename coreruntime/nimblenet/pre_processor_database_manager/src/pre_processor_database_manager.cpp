@@ -4,109 +4,125 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <mutex>
+#include <vector>
+
 #include "command_center.hpp"
+#include "data_variable.hpp"
 #include "database.hpp"
 #include "native_interface.hpp"
 #include "user_events_constants.hpp"
 
 using namespace std;
+using dbconstants::EventColumnName;
+using dbconstants::EventsTableName;
+using dbconstants::EventsTypeTableName;
+using dbconstants::EventTypeColumnName;
+using dbconstants::TimeStampColumnName;
+
+static std::string get_database_path() {
+  return nativeinterface::HOMEDIR + DEFAULT_SQLITE_DB_NAME;
+}
 
-struct CallBackData {
-  std::string tableName;
-  std::vector<nlohmann::json> events;
-};
-
-static int emptyCallback(void* input, int argc, char** argv, char** azColName) { return 0; }
-
-static int get_rows(void* data, int argc, char** argv, char** azColName) {
-  CallBackData* callBackData = (CallBackData*)data;
-  std::string tableName = callBackData->tableName;
-  int timestampIndex = -1;
-  int eventIndex = -1;
-  nlohmann::json eventMapTable;
-
-  for (int i = 0; i < argc; i++) {
-    if (!strcmp(azColName[i], dbconstants::TimeStampColumnName.c_str())) {
-      timestampIndex = i;
-    } else if (!strcmp(azColName[i], dbconstants::EventColumnName.c_str())) {
-      eventIndex = i;
-    }
-  }
-  if (eventIndex == -1) {
-    LOG_TO_ERROR("No event found in table row for eventType=%s", tableName.c_str());
-    return 1;
+bool Database::execute(const char* sql) {
+  char* zErrMsg = 0;
+  int rc = sqlite3_exec(_db, sql, nullptr, nullptr, &zErrMsg);
+  if (rc != SQLITE_OK) {
+    LOG_TO_ERROR("Error in running command %s with error %s", sql, zErrMsg);
+    sqlite3_free(zErrMsg);
+    return false;
   }
-  try {
-    eventMapTable = nlohmann::json::parse(argv[eventIndex]);
-  } catch (...) {
-    LOG_TO_ERROR("Event=%s is not a valid json", argv[eventIndex]);
-    return 1;
+  return true;
+}
+
+Database::Statement Database::get_statement(const std::string& sql) {
+  auto it = _statements.find(sql);
+  if (it != _statements.end()) {
+    return Statement(it->second);
   }
-  if (timestampIndex != -1) {
-    eventMapTable[usereventconstants::TimestampField] = stoll(argv[timestampIndex]);
-  } else {
-    LOG_TO_ERROR("No timestamp found in %s table row for eventType=%s",
-                 dbconstants::EventsTableName.c_str(), tableName.c_str());
-    return 1;
+  sqlite3_stmt* stmt = nullptr;
+  int rc = sqlite3_prepare_v3(_db, sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr);
+  if (rc != SQLITE_OK) {
+    LOG_TO_ERROR("Error in preparing command %s with error %s", sql.c_str(), sqlite3_errmsg(_db));
+    sqlite3_finalize(stmt);
+    return nullptr;
   }
-  callBackData->events.push_back(eventMapTable);
-  return 0;
+  _statements.emplace(sql, stmt);
+  return Statement(stmt);
 }
 
-static int exists_tableName(void* data, int argc, char** argv, char** azColName) {
-  int* res = static_cast<int*>(data);
-  *res = std::stoi(argv[0]);
-  return 0;
+void Database::commit_events() {
+  if (_db == nullptr || sqlite3_get_autocommit(_db)) {
+    // No transaction open
+    return;
+  }
+  if (!execute("COMMIT;")) {
+    LOG_TO_ERROR("Could not commit %d events, will retry on next operation", _uncommittedEvents);
+    FlushTimer::instance().schedule(_commitTimerId, dbconstants::MaxUncommittedDelayMicros);
+    return;
+  }
+  _uncommittedEvents = 0;
 }
 
-int Database::get_db_size(int& dbSize) {
+int Database::read_db_size(int& dbSize) {
   // also used for sanity check of database
-  if (_isSimulation) {
-    dbSize = 0;
-    return SQLITE_OK;
+  static const std::string sizeCommand =
+      "SELECT page_count * page_size as size FROM pragma_page_count(), pragma_page_size();";
+  auto stmt = get_statement(sizeCommand);
+  if (!stmt) {
+    return sqlite3_errcode(_db);
   }
-  sqlite3_stmt* stmt;
-  char* sanityCheckCommand;
-  asprintf(&sanityCheckCommand, "%s",
-           "SELECT page_count * page_size as size FROM pragma_page_count(), pragma_page_size();");
-  int sanityCode = sqlite3_prepare_v2(_db, sanityCheckCommand, -1, &stmt, NULL);
-
-  if (sanityCode != SQLITE_OK) {
-    LOG_TO_ERROR("Error in Sanity Check for Database with error: %s on command %s",
-                 sqlite3_errmsg(_db), sanityCheckCommand);
-    sqlite3_finalize(stmt);
-    free(sanityCheckCommand);
-    return sanityCode;
-  }
-  free(sanityCheckCommand);
-  while ((sanityCode = sqlite3_step(stmt)) == SQLITE_ROW) {
-    dbSize = sqlite3_column_int(stmt, 0);
+  int sanityCode;
+  while ((sanityCode = sqlite3_step(stmt.get())) == SQLITE_ROW) {
+    dbSize = sqlite3_column_int(stmt.get(), 0);
   }
   if (sanityCode != SQLITE_DONE) {
     LOG_TO_ERROR("Error in sanity_check sqlite3_done: %s", sqlite3_errmsg(_db));
-    sqlite3_finalize(stmt);
     return sanityCode;
   }
-  sqlite3_finalize(stmt);
   return SQLITE_OK;
 }
 
+int Database::get_db_size(int& dbSize) {
+  std::lock_guard<std::mutex> lockGuard(_mutex);
+  if (_isSimulation) {
+    dbSize = 0;
+    return SQLITE_OK;
+  }
+  commit_events();
+  return read_db_size(dbSize);
+}
+
 int Database::run_sanity_check_command() {
   int dbSize;
-  auto sanityStatus = get_db_size(dbSize);
+  auto sanityStatus = read_db_size(dbSize);
   if (sanityStatus != SQLITE_OK) {
     return sanityStatus;
   }
   nlohmann::json j;
   j["dbSize"] = dbSize;
-  j["numEvents"] = get_rows_in_events_table();
+  j["numEvents"] = count_events(nullptr);
   _metricsAgent->save_metrics("DATABASEMETRIC", j);
   return SQLITE_OK;
 }
 
+void Database::close_database() {
+  commit_events();
+  for (const auto& [sql, stmt] : _statements) {
+    sqlite3_finalize(stmt);
+  }
+  _statements.clear();
+  sqlite3_close_v2(_db);
+  _db = nullptr;
+}
+
 void Database::remove_database_file() {
-  sqlite3_close(_db);
-  int didRemove = remove((nativeinterface::HOMEDIR + DEFAULT_SQLITE_DB_NAME).c_str());
+  close_database();
+  auto fileName = get_database_path();
+  int didRemove = remove(fileName.c_str());
+  // Log and shared memory files of the WAL journal, only present if the db was not closed cleanly
+  remove((fileName + "-wal").c_str());
+  remove((fileName + "-shm").c_str());
   if (didRemove) {
     LOG_TO_ERROR("%s could not be removed from the system. Failed with error %d",
                  DEFAULT_SQLITE_DB_NAME, didRemove);
@@ -116,7 +132,10 @@ void Database::remove_database_file() {
 }
 
 int Database::open_database_file() {
-  int rc = sqlite3_open((nativeinterface::HOMEDIR + DEFAULT_SQLITE_DB_NAME).c_str(), &_db);
+  // Calls on the connection are serialized by _mutex, sqlite does not need to lock them again
+  int rc = sqlite3_open_v2(get_database_path().c_str(), &_db,
+                           SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX,
+                           nullptr);
   if (rc) {
     LOG_TO_ERROR("Can't open database: %s %s", DEFAULT_SQLITE_DB_NAME, sqlite3_errmsg(_db));
     return rc;
@@ -124,6 +143,27 @@ int Database::open_database_file() {
   return rc;
 }
 
+bool Database::init_database() {
+  // WAL appends commits to a log instead of rewriting pages through a rollback journal. With
+  // synchronous=NORMAL the log is only synced at checkpoints, a power loss can drop the last
+  // commits but does not corrupt the db.
+  // Events are BLOBs in a TEXT column, which sqlite stores as is, so that rows written as JSON
+  // text by older versions stay in the same table.
+  static const std::string initCommand =
+      "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;"
+      "CREATE TABLE IF NOT EXISTS " + EventsTypeTableName + " (" + EventTypeColumnName +
+      " TEXT UNIQUE);"
+      "CREATE TABLE IF NOT EXISTS " + EventsTableName + " (" + EventColumnName + " TEXT, " +
+      TimeStampColumnName + " INTEGER, " + EventTypeColumnName + " TEXT);"
+      "CREATE INDEX IF NOT EXISTS " + dbconstants::EventsIndexName + " ON " + EventsTableName +
+      " (" + EventTypeColumnName + ", " + TimeStampColumnName + ");";
+  if (!execute(initCommand.c_str())) {
+    LOG_TO_ERROR("Could not create tables of database=%s", DEFAULT_SQLITE_DB_NAME);
+    return false;
+  }
+  return true;
+}
+
 bool Database::should_delete(int status) {
   switch (status) {
     case SQLITE_CORRUPT:
@@ -134,115 +174,150 @@ bool Database::should_delete(int status) {
 }
 
 void Database::database_open() {
+  std::lock_guard<std::mutex> lockGuard(_mutex);
   if (_isSimulation) return;
   int databaseStatus = open_database_file();
   if (databaseStatus) {
-    if (should_delete(databaseStatus)) remove_database_file();
+    if (should_delete(databaseStatus)) {
+      remove_database_file();
+    } else {
+      close_database();
+    }
     if (open_database_file()) return;
   }
-  if (!create_eventsType_table()) {
-    LOG_TO_ERROR("Could not create tableName=%s", dbconstants::EventsTypeTableName.c_str());
-    return;
-  }
-  if (!create_events_table()) {
-    LOG_TO_ERROR("Could not create tableName=%s", dbconstants::EventsTableName.c_str());
-    return;
-  }
 
-  int sanityStatus = run_sanity_check_command();
+  // sqlite only reads the file on the first statement, a malformed db is detected here
+  int sanityStatus = init_database() ? run_sanity_check_command() : sqlite3_errcode(_db);
   if (sanityStatus) {
-    if (should_delete(sanityStatus)) remove_database_file();
-    if (open_database_file()) return;
+    if (should_delete(sanityStatus)) {
+      remove_database_file();
+    } else {
+      close_database();
+    }
+    if (open_database_file() || !init_database()) return;
   }
 
   LOG_TO_INFO("Opened database=%s successfully", DEFAULT_SQLITE_DB_NAME);
 }
 
-std::vector<nlohmann::json> Database::get_events_from_db(const std::string& tableName) {
+void Database::for_each_event(const std::string& tableName, const EventCallback& callback,
+                              int64_t expiryTime) {
+  std::lock_guard<std::mutex> lockGuard(_mutex);
   if (this->_isSimulation) {
-    return {};
+    return;
   }
+  commit_events();
 
-  char* zErrMsg = 0;
-  // SELECT * from Events WHERE eventType='%s' ORDER BY TIMESTAMP;
-  const char* selectCommand = "SELECT * from %s WHERE %s='%s' ORDER BY %s;";
-  char* sqlQueryCommand;
-  asprintf(&sqlQueryCommand, selectCommand, dbconstants::EventsTableName.c_str(),
-           dbconstants::EventTypeColumnName.c_str(), tableName.c_str(),
-           dbconstants::TimeStampColumnName.c_str());
-
-  CallBackData callBackData;
-  callBackData.tableName = tableName;
-  int rc = sqlite3_exec(_db, sqlQueryCommand, get_rows, &callBackData, &zErrMsg);
-  free(sqlQueryCommand);
-  if (rc != SQLITE_OK) {
-    LOG_TO_ERROR("Error in fetching events from table=%s for eventType=%s with error %s",
-                 dbconstants::EventsTableName.c_str(), tableName.c_str(), zErrMsg);
-    sqlite3_free(zErrMsg);
-    return {};
+  // SELECT event, TIMESTAMP FROM Events WHERE eventType=?1 AND TIMESTAMP>=?2 ORDER BY TIMESTAMP;
+  static const std::string selectCommand =
+      "SELECT " + EventColumnName + ", " + TimeStampColumnName + " FROM " + EventsTableName +
+      " WHERE " + EventTypeColumnName + " = ?1 AND " + TimeStampColumnName + " >= ?2 ORDER BY " +
+      TimeStampColumnName + ", rowid;";
+  auto stmt = get_statement(selectCommand);
+  if (!stmt) {
+    return;
   }
+  sqlite3_bind_text(stmt.get(), 1, tableName.data(), tableName.size(), SQLITE_STATIC);
+  sqlite3_bind_int64(stmt.get(), 2, expiryTime);
+
+  EventRecordDecoder decoder;
+  int64_t recordTimestamp;
+  std::map<std::string, OpReturnType> event;
+  int rc;
+  while ((rc = sqlite3_step(stmt.get())) == SQLITE_ROW) {
+    int64_t timestamp = sqlite3_column_int64(stmt.get(), 1);
+    if (sqlite3_column_type(stmt.get(), 0) == SQLITE_BLOB) {
+      auto record = static_cast<const char*>(sqlite3_column_blob(stmt.get(), 0));
+      if (!decoder.decode(record, sqlite3_column_bytes(stmt.get(), 0), recordTimestamp, event)) {
+        LOG_TO_ERROR("Skipping corrupted event in table=%s for eventType=%s",
+                     EventsTableName.c_str(), tableName.c_str());
+        continue;
+      }
+      callback(timestamp, std::move(event));
+      continue;
+    }
 
-  return callBackData.events;
+    // Events written as JSON text by older versions
+    auto eventText = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 0));
+    nlohmann::json eventJson;
+    try {
+      eventJson = nlohmann::json::parse(eventText ? eventText : "");
+    } catch (...) {
+      LOG_TO_ERROR("Event=%s is not a valid json", eventText ? eventText : "NULL");
+      continue;
+    }
+    std::map<std::string, OpReturnType> legacyEvent;
+    for (const auto& column : eventJson.items()) {
+      if (column.key() == usereventconstants::TimestampField) continue;
+      legacyEvent[column.key()] = DataVariable::get_SingleVariableFrom_JSON(column.value());
+    }
+    callback(timestamp, std::move(legacyEvent));
+  }
+  if (rc != SQLITE_DONE) {
+    LOG_TO_ERROR("Error in fetching events from table=%s for eventType=%s with error %s",
+                 EventsTableName.c_str(), tableName.c_str(), sqlite3_errmsg(_db));
+  }
 }
 
 bool Database::delete_old_rows_by_count(const std::string& tableName, const int64_t maxEvents) {
-  char* zErrMsg = 0;
-  // DELETE FROM Events where eventType=%s AND TIMESTAMP<%ld;
-  const char* tableDeleteRowsCommand =
-      "DELETE FROM %s WHERE %s = '%s' and TIMESTAMP NOT IN(SELECT TIMESTAMP FROM "
-      "%s where %s = '%s' ORDER "
-      "BY TIMESTAMP DESC LIMIT %ld);";
-  char* sqlQueryCommand;
-  asprintf(&sqlQueryCommand, tableDeleteRowsCommand, dbconstants::EventsTableName.c_str(),
-           dbconstants::EventTypeColumnName.c_str(), tableName.c_str(),
-           dbconstants::EventsTableName.c_str(), dbconstants::EventTypeColumnName.c_str(),
-           tableName.c_str(), maxEvents);
-  int rc = sqlite3_exec(_db, sqlQueryCommand, emptyCallback, 0, &zErrMsg);
-  free(sqlQueryCommand);
-  if (rc != SQLITE_OK) {
+  // DELETE FROM Events WHERE eventType=?1 AND rowid NOT IN (SELECT rowid FROM Events WHERE
+  // eventType=?1 ORDER BY TIMESTAMP DESC LIMIT ?2);
+  static const std::string deleteCommand =
+      "DELETE FROM " + EventsTableName + " WHERE " + EventTypeColumnName +
+      " = ?1 AND rowid NOT IN (SELECT rowid FROM " + EventsTableName + " WHERE " +
+      EventTypeColumnName + " = ?1 ORDER BY " + TimeStampColumnName +
+      " DESC, rowid DESC LIMIT ?2);";
+  auto stmt = get_statement(deleteCommand);
+  if (!stmt) {
+    return false;
+  }
+  sqlite3_bind_text(stmt.get(), 1, tableName.data(), tableName.size(), SQLITE_STATIC);
+  sqlite3_bind_int64(stmt.get(), 2, maxEvents);
+  if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
     LOG_TO_ERROR(
         "Error in Deleting old rows from Table %s with eventType=%s and maxEvents=%ld with "
         "error=%s",
-        dbconstants::EventsTableName.c_str(), tableName.c_str(), maxEvents, zErrMsg);
-    sqlite3_free(zErrMsg);
+        EventsTableName.c_str(), tableName.c_str(), maxEvents, sqlite3_errmsg(_db));
     return false;
   }
   LOG_TO_DEBUG("Deleted old rows from Table %s where eventType=%s in DB successfully",
-               dbconstants::EventsTableName.c_str(), tableName.c_str());
+               EventsTableName.c_str(), tableName.c_str());
   return true;
 }
 
 bool Database::delete_old_rows_by_expiryTime(const std::string& tableName,
                                              const int64_t expiryTimeInMins) {
-  char* zErrMsg = 0;
-  // DELETE FROM Events where eventType=%s AND TIMESTAMP<%ld;
-  const char* tableDeleteRowsCommand = "DELETE FROM %s where %s='%s' AND %s <%ld";
-  char* sqlQueryCommand;
+  // DELETE FROM Events WHERE eventType=?1 AND TIMESTAMP<?2;
+  static const std::string deleteCommand = "DELETE FROM " + EventsTableName + " WHERE " +
+                                           EventTypeColumnName + " = ?1 AND " +
+                                           TimeStampColumnName + " < ?2;";
+  auto stmt = get_statement(deleteCommand);
+  if (!stmt) {
+    return false;
+  }
   long expiryTimestamp = Time::get_time() - expiryTimeInMins * 60;  // change the time func
-  asprintf(&sqlQueryCommand, tableDeleteRowsCommand, dbconstants::EventsTableName.c_str(),
-           dbconstants::EventTypeColumnName.c_str(), tableName.c_str(),
-           dbconstants::TimeStampColumnName.c_str(), expiryTimestamp);
-  int rc = sqlite3_exec(_db, sqlQueryCommand, emptyCallback, 0, &zErrMsg);
-  free(sqlQueryCommand);
-  if (rc != SQLITE_OK) {
+  sqlite3_bind_text(stmt.get(), 1, tableName.data(), tableName.size(), SQLITE_STATIC);
+  sqlite3_bind_int64(stmt.get(), 2, expiryTimestamp);
+  if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
     LOG_TO_ERROR(
         "Error in Deleting old rows from Table %s with eventType=%s and expiryTimeStamp=%ld with "
         "error=%s",
-        dbconstants::EventsTableName.c_str(), tableName.c_str(), expiryTimestamp, zErrMsg);
-    sqlite3_free(zErrMsg);
+        EventsTableName.c_str(), tableName.c_str(), expiryTimestamp, sqlite3_errmsg(_db));
     return false;
   }
   LOG_TO_DEBUG("Deleted old rows from Table %s where eventType=%s in DB successfully",
-               dbconstants::EventsTableName.c_str(), tableName.c_str());
+               EventsTableName.c_str(), tableName.c_str());
   return true;
 }
 
 bool Database::delete_old_rows_from_table_in_db(const std::string& tableName,
                                                 const std::string& expiryType,
                                                 const int64_t expiryValue) {
+  std::lock_guard<std::mutex> lockGuard(_mutex);
   if (this->_isSimulation) {
     return true;
   }
+  commit_events();
   if (expiryType == "time") {
     return delete_old_rows_by_expiryTime(tableName, expiryValue);
   } else if (expiryType == "count") {
@@ -252,6 +327,7 @@ bool Database::delete_old_rows_from_table_in_db(const std::string& tableName,
 }
 
 bool Database::add_event_in_db(const string& tableName, OpReturnType eventMapTable) {
+  std::lock_guard<std::mutex> lockGuard(_mutex);
   if (this->_isSimulation) {
     return true;
   }
@@ -261,69 +337,66 @@ bool Database::add_event_in_db(const string& tableName, OpReturnType eventMapTab
   }
   if (!check_tableName_in_eventsType_Table(tableName)) {
     LOG_TO_DEBUG("TableName=%s not found in %s table, event won't be added to database.",
-                 tableName.c_str(), dbconstants::EventsTypeTableName.c_str());
+                 tableName.c_str(), EventsTypeTableName.c_str());
     return true;
   }
 
-  char* zErrMsg = 0;
-  // INSERT INTO Events (TIMESTAMP, eventType, event) VALUES (%ld, '%s', '%s')
-  const char* tableInserCommand = "INSERT INTO %s (%s, %s, %s) VALUES (%ld, '%s', '%s');";
-  char* sqlQueryCommand;
-  std::string eventDump = eventMapTable->to_json_str();
-  asprintf(&sqlQueryCommand, tableInserCommand, dbconstants::EventsTableName.c_str(),
-           dbconstants::TimeStampColumnName.c_str(), dbconstants::EventTypeColumnName.c_str(),
-           dbconstants::EventColumnName.c_str(), long(Time::get_time()), tableName.c_str(),
-           eventDump.c_str());
-  int rc = sqlite3_exec(_db, sqlQueryCommand, emptyCallback, 0, &zErrMsg);
-  free(sqlQueryCommand);
-  if (rc != SQLITE_OK) {
-    LOG_TO_ERROR("Error in Inserting event=%s to Table %s with eventType=%s with error %s",
-                 eventDump.c_str(), dbconstants::EventsTableName.c_str(), tableName.c_str(),
-                 zErrMsg);
-    sqlite3_free(zErrMsg);
+  // INSERT INTO Events (TIMESTAMP, eventType, event) VALUES (?1, ?2, ?3);
+  static const std::string insertCommand = "INSERT INTO " + EventsTableName + " (" +
+                                           TimeStampColumnName + ", " + EventTypeColumnName +
+                                           ", " + EventColumnName + ") VALUES (?1, ?2, ?3);";
+  auto stmt = get_statement(insertCommand);
+  if (!stmt) {
     return false;
   }
-  return true;
-}
-
-bool Database::create_eventsType_table() {
-  if (this->_isSimulation) {
-    return true;
-  }
-
-  char* zErrMsg = 0;
-  const char* createTableCommand = "CREATE TABLE IF NOT EXISTS %s (%s TEXT UNIQUE);";
+  int64_t timestamp = Time::get_time();
+  // Rows are deleted and read independently, every record carries its own column names
+  _encoder.reset();
+  auto record = _encoder.encode(timestamp, eventMapTable->get_map());
 
-  char* sqlQueryCommand;
-  asprintf(&sqlQueryCommand, createTableCommand, dbconstants::EventsTypeTableName.c_str(),
-           dbconstants::EventTypeColumnName.c_str());
-  int rc = sqlite3_exec(_db, sqlQueryCommand, emptyCallback, 0, &zErrMsg);
-  free(sqlQueryCommand);
-  if (rc != SQLITE_OK) {
-    LOG_TO_ERROR("Error in Creating %s Table with error %s",
-                 dbconstants::EventsTypeTableName.c_str(), zErrMsg);
-    sqlite3_free(zErrMsg);
+  if (sqlite3_get_autocommit(_db)) {
+    if (!execute("BEGIN;")) {
+      return false;
+    }
+    _uncommittedEvents = 0;
+    _firstUncommittedTimeMicros = Time::get_time_in_micro();
+    // Commits the events even if no other operation follows
+    FlushTimer::instance().schedule(_commitTimerId, dbconstants::MaxUncommittedDelayMicros);
+  }
+  sqlite3_bind_int64(stmt.get(), 1, timestamp);
+  sqlite3_bind_text(stmt.get(), 2, tableName.data(), tableName.size(), SQLITE_STATIC);
+  sqlite3_bind_blob(stmt.get(), 3, record.data(), record.size(), SQLITE_STATIC);
+  if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+    LOG_TO_ERROR("Error in Inserting event=%s to Table %s with eventType=%s with error %s",
+                 eventMapTable->to_json_str().c_str(), EventsTableName.c_str(), tableName.c_str(),
+                 sqlite3_errmsg(_db));
     return false;
   }
+  if (_flushEveryRecord || ++_uncommittedEvents >= dbconstants::MaxUncommittedEvents ||
+      Time::get_time_in_micro() - _firstUncommittedTimeMicros >=
+          dbconstants::MaxUncommittedDelayMicros) {
+    commit_events();
+  }
   return true;
 }
 
 bool Database::update_eventsType_table(const std::string& tableName) {
+  std::lock_guard<std::mutex> lockGuard(_mutex);
   if (this->_isSimulation) {
     return true;
   }
+  commit_events();
 
-  char* zErrMsg = 0;
-  const char* insertOrReplaceSql = "INSERT OR IGNORE INTO %s (%s) VALUES ('%s')";
-  char* sqlQueryCommand = 0;
-  asprintf(&sqlQueryCommand, insertOrReplaceSql, dbconstants::EventsTypeTableName.c_str(),
-           dbconstants::EventTypeColumnName.c_str(), tableName.c_str());
-  int rc = sqlite3_exec(_db, sqlQueryCommand, emptyCallback, 0, &zErrMsg);
-  free(sqlQueryCommand);
-  if (rc != SQLITE_OK) {
+  static const std::string insertOrIgnoreCommand = "INSERT OR IGNORE INTO " + EventsTypeTableName +
+                                                   " (" + EventTypeColumnName + ") VALUES (?1);";
+  auto stmt = get_statement(insertOrIgnoreCommand);
+  if (!stmt) {
+    return false;
+  }
+  sqlite3_bind_text(stmt.get(), 1, tableName.data(), tableName.size(), SQLITE_STATIC);
+  if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
     LOG_TO_ERROR("Error in inserting %s in EventTypes Table with error %s", tableName.c_str(),
-                 zErrMsg);
-    sqlite3_free(zErrMsg);
+                 sqlite3_errmsg(_db));
     return false;
   }
   // Store eventType in memory once added to DB
@@ -331,129 +404,112 @@ bool Database::update_eventsType_table(const std::string& tableName) {
   return true;
 }
 
-bool Database::create_events_table() {
-  if (this->_isSimulation) {
-    return true;
-  }
-
-  char* zErrMsg = 0;
-  // CREATE TABLE IF NOT EXISTS Events (event TEXT, TIMESTAMP INTEGER, eventType TEXT);
-  const char* createTableCommand = "CREATE TABLE IF NOT EXISTS %s (%s TEXT, %s INTEGER, %s TEXT);";
-  char* sqlQueryCommand = 0;
-  asprintf(&sqlQueryCommand, createTableCommand, dbconstants::EventsTableName.c_str(),
-           dbconstants::EventColumnName.c_str(), dbconstants::TimeStampColumnName.c_str(),
-           dbconstants::EventTypeColumnName.c_str());
-  int rc = sqlite3_exec(_db, sqlQueryCommand, emptyCallback, 0, &zErrMsg);
-  free(sqlQueryCommand);
-  if (rc != SQLITE_OK) {
-    LOG_TO_ERROR("Error in Creating %s Table with error %s", dbconstants::EventsTableName.c_str(),
-                 zErrMsg);
-    sqlite3_free(zErrMsg);
-    return false;
-  }
-  return true;
-}
-
 bool Database::check_tableName_in_eventsType_Table(const std::string& tableName) {
+  // Caller is supposed to be holding the mutex when this is called
   if (this->_isSimulation) {
     return true;
   }
   if (_eventTypes.find(tableName) != _eventTypes.end()) {
     return true;
   }
-  char* zErrMsg = 0;
-  const char* existsCommand = "SELECT EXISTS(SELECT 1 FROM %s WHERE %s = '%s');";
-  char* sqlQueryCommand = 0;
-  asprintf(&sqlQueryCommand, existsCommand, dbconstants::EventsTypeTableName.c_str(),
-           dbconstants::EventTypeColumnName.c_str(), tableName.c_str());
-  int result = 0;
-  int rc = sqlite3_exec(_db, sqlQueryCommand, exists_tableName, &result, &zErrMsg);
-  free(sqlQueryCommand);
-  if (rc != SQLITE_OK) {
-    LOG_TO_ERROR("Error in checking if tableName=%s is present in EventsTypes table with error %s",
-                 tableName.data(), zErrMsg);
-    sqlite3_free(zErrMsg);
+  static const std::string existsCommand = "SELECT EXISTS(SELECT 1 FROM " + EventsTypeTableName +
+                                           " WHERE " + EventTypeColumnName + " = ?1);";
+  auto stmt = get_statement(existsCommand);
+  if (!stmt) {
     return false;
   }
-  if (result == 1) {
-    return true;
+  sqlite3_bind_text(stmt.get(), 1, tableName.data(), tableName.size(), SQLITE_STATIC);
+  if (sqlite3_step(stmt.get()) != SQLITE_ROW) {
+    LOG_TO_ERROR("Error in checking if tableName=%s is present in EventsTypes table with error %s",
+                 tableName.c_str(), sqlite3_errmsg(_db));
+    return false;
   }
-  return false;
+  return sqlite3_column_int(stmt.get(), 0) == 1;
 }
 
 bool Database::delete_old_entries_from_eventsType_Table() {
+  std::lock_guard<std::mutex> lockGuard(_mutex);
   if (this->_isSimulation) {
     return true;
   }
-  char* zErrMsg = 0;
-  const char* deleteCommand = "DELETE FROM %s WHERE %s NOT IN (%s)";
-
-  std::string currentEventTypes = "";
-  for (const auto& it : _eventTypes) {
-    currentEventTypes += "'" + it + "',";
-  }
-  // Remove last character(,) from the command
-  if (currentEventTypes.size() > 0) {
-    currentEventTypes.pop_back();
+  commit_events();
+
+  static const std::string selectCommand =
+      "SELECT " + EventTypeColumnName + " FROM " + EventsTypeTableName + ";";
+  static const std::string deleteCommand =
+      "DELETE FROM " + EventsTypeTableName + " WHERE " + EventTypeColumnName + " = ?1;";
+  std::vector<std::string> oldEventTypes;
+  {
+    auto stmt = get_statement(selectCommand);
+    if (!stmt) {
+      return false;
+    }
+    int rc;
+    while ((rc = sqlite3_step(stmt.get())) == SQLITE_ROW) {
+      auto eventType = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 0));
+      if (eventType && _eventTypes.find(eventType) == _eventTypes.end()) {
+        oldEventTypes.push_back(eventType);
+      }
+    }
+    if (rc != SQLITE_DONE) {
+      LOG_TO_ERROR("Error in reading eventTypes from tableName=%s with error %s",
+                   EventsTypeTableName.c_str(), sqlite3_errmsg(_db));
+      return false;
+    }
   }
-
-  char* sqlQueryCommand = 0;
-  // DELETE FROM EventsType WHERE eventType NOT IN ('%s', '%s')
-  asprintf(&sqlQueryCommand, deleteCommand, dbconstants::EventsTypeTableName.c_str(),
-           dbconstants::EventTypeColumnName.c_str(), currentEventTypes.c_str());
-  int result = 0;
-  int rc = sqlite3_exec(_db, sqlQueryCommand, emptyCallback, 0, &zErrMsg);
-  free(sqlQueryCommand);
-  if (rc != SQLITE_OK) {
-    LOG_TO_ERROR("Error in deleting old eventTypes from tableName=%s with error %s",
-                 dbconstants::EventsTypeTableName.c_str(), zErrMsg);
-    sqlite3_free(zErrMsg);
-    return false;
+  for (const auto& eventType : oldEventTypes) {
+    auto stmt = get_statement(deleteCommand);
+    if (!stmt) {
+      return false;
+    }
+    sqlite3_bind_text(stmt.get(), 1, eventType.data(), eventType.size(), SQLITE_STATIC);
+    if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+      LOG_TO_ERROR("Error in deleting old eventTypes from tableName=%s with error %s",
+                   EventsTypeTableName.c_str(), sqlite3_errmsg(_db));
+      return false;
+    }
   }
   return true;
 }
 
-static int callback(void* count, int argc, char** argv, char** azColName) {
-  int* c = static_cast<int*>(count);
-  *c = atoi(argv[0]);
-  return 0;
+int Database::count_events(const std::string* eventType) {
+  static const std::string countCommand = "SELECT COUNT(*) FROM " + EventsTableName + ";";
+  static const std::string countTypeCommand =
+      "SELECT COUNT(*) FROM " + EventsTableName + " WHERE " + EventTypeColumnName + " = ?1;";
+  auto stmt = get_statement(eventType ? countTypeCommand : countCommand);
+  if (!stmt) {
+    return -1;
+  }
+  if (eventType) {
+    sqlite3_bind_text(stmt.get(), 1, eventType->data(), eventType->size(), SQLITE_STATIC);
+  }
+  if (sqlite3_step(stmt.get()) != SQLITE_ROW) {
+    LOG_TO_ERROR("Error in getting count from %s table with error %s", EventsTableName.c_str(),
+                 sqlite3_errmsg(_db));
+    return -1;
+  }
+  return sqlite3_column_int(stmt.get(), 0);
 }
 
 int Database::get_rows_in_events_table() {
-  char* zErrMsg = 0;
-  const char* countCommand = "SELECT COUNT(*) FROM %s;";
-  char* sqlQueryCommand = 0;
-  asprintf(&sqlQueryCommand, countCommand, dbconstants::EventsTableName.c_str());
-  int result = 0;
-  int rc = sqlite3_exec(_db, sqlQueryCommand, callback, &result, &zErrMsg);
-  free(sqlQueryCommand);
-  if (rc != SQLITE_OK) {
-    LOG_TO_ERROR("Error in getting count from %s table with error %s",
-                 dbconstants::EventsTableName.c_str(), zErrMsg);
-    sqlite3_free(zErrMsg);
-    return -1;
-  }
-  return result;
+  std::lock_guard<std::mutex> lockGuard(_mutex);
+  commit_events();
+  return count_events(nullptr);
+}
+
+Database::~Database() {
+  // Not holding _mutex, which the delayed commit takes
+  FlushTimer::instance().remove(_commitTimerId);
+  std::lock_guard<std::mutex> lockGuard(_mutex);
+  close_database();
 }
 
 #ifdef TESTING
 
 int Database::get_count_from_eventsTable(const std::string& eventType) {
-  char* zErrMsg = 0;
-  const char* countCommand = "SELECT COUNT(*) FROM %s WHERE %s = '%s';";
-  char* sqlQueryCommand = 0;
-  asprintf(&sqlQueryCommand, countCommand, dbconstants::EventsTableName.c_str(),
-           dbconstants::EventTypeColumnName.c_str(), eventType.c_str());
-  int result = 0;
-  int rc = sqlite3_exec(_db, sqlQueryCommand, callback, &result, &zErrMsg);
-  free(sqlQueryCommand);
-  if (rc != SQLITE_OK) {
-    LOG_TO_ERROR("Error in getting count from %s table for eventType=%s with error %s",
-                 dbconstants::EventsTableName.c_str(), eventType.data(), zErrMsg);
-    sqlite3_free(zErrMsg);
-    return -1;
-  }
-  return result;
+  std::lock_guard<std::mutex> lockGuard(_mutex);
+  commit_events();
+  return count_events(&eventType);
 }
 
 #endif
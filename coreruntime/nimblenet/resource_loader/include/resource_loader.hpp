@@ -64,8 +64,11 @@ class ResourceLoader {
   /**
    * @brief Handles loading of document-type assets,
    *
+   * A JSON list of documents is converted to a DocumentStore file on its first load, which is
+   * mapped and decodes a document only when it is accessed.
+   *
    * @param asset The document asset.
-   * @return Datavariable with the json content.
+   * @return Datavariable with the documents, or with the json content if it is not a list.
    */
   OpReturnType load_document(std::shared_ptr<Asset> asset);
 
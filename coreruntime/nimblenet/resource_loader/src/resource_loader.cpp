@@ -14,6 +14,7 @@
 #include "native_interface.hpp"
 
 #ifdef GENAI
+#include "document_store_data_variable.hpp"
 #include "retriever.hpp"
 #endif  // GENAI
 
@@ -75,20 +76,33 @@ bool ResourceLoader::load_task(std::shared_ptr<Asset> taskAsset) {
 
 #ifdef GENAI
 OpReturnType ResourceLoader::load_document(std::shared_ptr<Asset> asset) {
-  auto fullFilePath = asset->get_file_name_on_device();
-  const auto [success, jsonDocStr] =
-      nativeinterface::read_potentially_compressed_file(fullFilePath);
-  if (!success) {
+  auto fileName = asset->get_file_name_on_device();
+  std::shared_ptr<const MappedFile> file = nativeinterface::map_potentially_compressed_file(
+      fileName, false, MappedFile::Access::RANDOM);
+  if (!file) {
     LOG_TO_ERROR("Could not read document %s from path %s", asset->name.c_str(),
-                 fullFilePath.c_str());
+                 fileName.c_str());
     return nullptr;
   }
 
-  nlohmann::json j = nlohmann::json::parse(jsonDocStr);
-  if (j.is_array()) {
-    return DataVariable::get_list_from_json_array(std::move(j));
+  if (!DocumentStore::is_document_store(*file)) {
+    nlohmann::json j = nlohmann::json::parse(file->data(), file->data() + file->size());
+    if (!j.is_array()) {
+      return DataVariable::get_map_from_json_object(std::move(j));
+    }
+    // A list of documents is converted once to a DocumentStore replacing the JSON file, later
+    // loads map it without parsing anything
+    auto fullFilePath = nativeinterface::get_full_file_path_common(fileName);
+    file.reset();
+    DocumentStore::write(j, fullFilePath);
+    file = MappedFile::open(fullFilePath, MappedFile::Access::RANDOM);
+    if (!file) {
+      LOG_TO_ERROR("Could not read document %s from path %s", asset->name.c_str(),
+                   fullFilePath.c_str());
+      return nullptr;
+    }
   }
-  return DataVariable::get_map_from_json_object(std::move(j));
+  return std::make_shared<DocumentStoreDataVariable>(DocumentStore::open(std::move(file)));
 }
 
 OpReturnType ResourceLoader::load_retriever(std::shared_ptr<Asset> asset,
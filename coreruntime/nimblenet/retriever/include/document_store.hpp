@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "mapped_file.hpp"
+#include "nlohmann/json.hpp"
+
+/**
+ * @brief Read-only list of documents mapped from a file, a document being read only when it is
+ * accessed.
+ *
+ * The file holds a header, a table of numDocuments + 1 offsets and the packed payloads of the
+ * documents, document i spanning from offset i to offset i + 1 of the payloads. A payload starts
+ * with the DocumentType of the document: a string is stored as its UTF-8 text and any other
+ * document, usually a map of a text and its metadata, as its JSON dump. Values are in the byte
+ * order of the device, which is little endian on every supported platform.
+ *
+ * Opening a store only reads its header, so its size does not matter for the load time and
+ * documents take no memory until they are accessed.
+ */
+class DocumentStore {
+ public:
+  /**
+   * @brief Encoding of the payload of a document.
+   */
+  enum class DocumentType : uint8_t {
+    STRING = 0, /**< UTF-8 text. */
+    JSON = 1,   /**< JSON dump of a value other than a string. */
+  };
+
+  /**
+   * @brief Payload of a document, pointing into the mapping of the store.
+   */
+  struct Document {
+    DocumentType type;
+    std::string_view data;
+  };
+
+ private:
+  std::shared_ptr<const MappedFile> _file; /**< Mapping of the store. */
+  std::size_t _numDocuments = 0;           /**< Number of documents. */
+  const char* _offsets = nullptr;          /**< Table of numDocuments + 1 offsets. */
+  const char* _payloads = nullptr;         /**< Start of the payloads in the mapping. */
+  std::size_t _payloadsSize = 0;           /**< Number of bytes of the payloads. */
+
+  DocumentStore() = default;
+
+  uint64_t get_offset(std::size_t index) const;
+
+ public:
+  /**
+   * @brief Checks the header of a mapped file.
+   *
+   * @return true if the file is a document store of the current version.
+   */
+  static bool is_document_store(const MappedFile& file);
+
+  /**
+   * @brief Opens a document store, THROWs if the file is not one or is truncated.
+   *
+   * @param file Mapping of the file, kept alive by the store.
+   */
+  static std::unique_ptr<DocumentStore> open(std::shared_ptr<const MappedFile> file);
+
+  /**
+   * @brief Converts documents from JSON to a document store file.
+   *
+   * The file is written next to filePath and renamed over it, so filePath can be the JSON file the
+   * documents were read from.
+   *
+   * @param documents JSON array of the documents.
+   * @param filePath Path of the document store file.
+   */
+  static void write(const nlohmann::json& documents, const std::string& filePath);
+
+  std::size_t size() const noexcept { return _numDocuments; }
+
+  /**
+   * @brief Reads the payload of a document, THROWs if the index is out of range or the store is
+   * corrupted.
+   */
+  Document get(std::size_t index) const;
+};
@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "data_variable.hpp"
+#include "document_store.hpp"
+
+/**
+ * @brief Read-only list of the documents of a DocumentStore, used as the document store of a
+ * Retriever.
+ *
+ * A document is decoded into a data variable every time it is accessed, so modifying it does not
+ * change the store.
+ */
+class DocumentStoreDataVariable final : public DataVariable {
+  std::unique_ptr<DocumentStore> _store; /**< The store. */
+
+  int get_containerType() const override { return CONTAINERTYPE::LIST; }
+
+  int get_dataType_enum() const override { return DATATYPE::EMPTY; }
+
+  bool get_bool() override { return _store->size() > 0; }
+
+  /**
+   * @brief Decodes a document.
+   *
+   * @param index Index of the document, negative to count from the end.
+   * @return The document as a string, or as the data variable of its JSON value.
+   */
+  OpReturnType get_int_subscript(int index) override;
+
+  OpReturnType get_subscript(const OpReturnType& subscriptVal) override {
+    if (subscriptVal->get_containerType() == CONTAINERTYPE::SLICE) {
+      THROW("%s", "Slicing is not supported for a DocumentStore");
+    }
+    return get_int_subscript(subscriptVal->get_int32());
+  }
+
+ public:
+  explicit DocumentStoreDataVariable(std::unique_ptr<DocumentStore> store)
+      : _store(std::move(store)) {}
+
+  int get_size() override { return _store->size(); }
+
+  std::string print() override { return fallback_print(); }
+
+  /**
+   * @brief Decodes all the documents, only to be used on small stores.
+   */
+  nlohmann::json to_json() const override;
+};
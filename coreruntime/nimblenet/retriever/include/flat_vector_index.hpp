@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <unordered_map>
+
+#include "vector_index.hpp"
+#include "vector_store.hpp"
+
+/**
+ * @brief Exact vector index, scoring the query against every vector with SIMD dot products.
+ *
+ * Vectors are kept densely packed: removing a vector moves the last one into its slot.
+ */
+class FlatVectorIndex final : public VectorIndex {
+  VectorStore _store;
+  std::unordered_map<int64_t, uint32_t> _slots; /**< Slot of every id. */
+
+ public:
+  explicit FlatVectorIndex(const VectorIndexConfig& config);
+
+  void add(int64_t id, const float* vector) override;
+
+  bool remove(int64_t id) override;
+
+  std::vector<VectorSearchResult> search(const float* query, int k) const override;
+
+  std::size_t size() const noexcept override { return _store.size(); }
+
+ protected:
+  void write(VectorIndexWriter& writer) const override;
+
+  void read(VectorIndexReader& reader) override;
+};
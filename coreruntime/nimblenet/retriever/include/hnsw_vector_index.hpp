@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <random>
+#include <unordered_map>
+#include <utility>
+
+#include "vector_index.hpp"
+#include "vector_store.hpp"
+
+/**
+ * @brief Approximate vector index over a hierarchical navigable small world graph.
+ *
+ * Every vector is a node of the graph, present on layers 0 to a random level. A search descends
+ * greedily from the entry point on the top layer and explores efSearch candidates on layer 0.
+ *
+ * Removed vectors stay in the graph as tombstones so that it remains connected, and are skipped in
+ * results. The graph is rebuilt from the live vectors once tombstones outnumber them.
+ */
+class HNSWVectorIndex final : public VectorIndex {
+  using Candidate = std::pair<float, uint32_t>; /**< Score and slot. */
+
+  struct Node {
+    std::vector<std::vector<uint32_t>> neighbors; /**< Neighbour slots on layers 0 to level. */
+    bool deleted = false;
+  };
+
+  VectorStore _store;                           /**< Vectors, at the slot of their node. */
+  std::vector<Node> _nodes;                     /**< Nodes, including tombstones. */
+  std::unordered_map<int64_t, uint32_t> _slots; /**< Slot of every live id. */
+  uint32_t _entryPoint = 0;                     /**< Node on the top layer. */
+  int _maxLevel = -1;                           /**< Top layer, -1 when the graph is empty. */
+  std::mt19937 _rng;
+  double _levelMultiplier; /**< 1 / ln(M), so each layer has about M times fewer nodes. */
+
+  int max_neighbors(int level) const { return level == 0 ? 2 * _config.M : _config.M; }
+
+  int random_level();
+
+  /**
+   * @brief Moves from entry to the closest neighbour of the query until none is closer, on every
+   * layer from fromLevel down to and excluding toLevel.
+   */
+  uint32_t greedy_search(const float* query, uint32_t entry, int fromLevel, int toLevel) const;
+
+  /**
+   * @brief Best-first search of a layer keeping ef candidates.
+   *
+   * Tombstones are always traversed, so that the search goes through them to the live vectors
+   * behind.
+   *
+   * @param liveOnly Whether tombstones are left out of the candidates kept.
+   * @return The candidates, best first.
+   */
+  std::vector<Candidate> search_layer(const float* query, uint32_t entry, int ef, int level,
+                                      bool liveOnly = false) const;
+
+  /**
+   * @brief Picks up to maxNeighbors of the candidates, skipping a candidate closer to an already
+   * picked neighbour than to the query, so that edges spread in every direction.
+   *
+   * @param candidates Candidates sorted best first.
+   */
+  std::vector<uint32_t> select_neighbors(const std::vector<Candidate>& candidates,
+                                         int maxNeighbors) const;
+
+  /**
+   * @brief Adds an edge from node to neighbor on a layer, pruning the edges of node if needed.
+   */
+  void connect(uint32_t node, uint32_t neighbor, int level);
+
+  void insert(int64_t id, const float* vector);
+
+  /**
+   * @brief Recreates the graph from the live vectors, dropping tombstones.
+   */
+  void rebuild();
+
+ public:
+  explicit HNSWVectorIndex(const VectorIndexConfig& config);
+
+  void add(int64_t id, const float* vector) override;
+
+  bool remove(int64_t id) override;
+
+  std::vector<VectorSearchResult> search(const float* query, int k) const override;
+
+  std::size_t size() const noexcept override { return _slots.size(); }
+
+ protected:
+  void write(VectorIndexWriter& writer) const override;
+
+  void read(VectorIndexReader& reader) override;
+};
@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "command_center.hpp"
 #include "data_variable.hpp"
+#include "lru_cache.hpp"
 
 class CommandCenter;
 
@@ -19,8 +22,12 @@ class CommandCenter;
 class RetrieverDataVariable final : public DataVariable {
   CommandCenter* _commandCenter;           /**< Pointer to the command center. */
   OpReturnType _embeddingModel;            /**< Model for converting text into vector embeddings. */
-  OpReturnType _embeddingStoreModel;       /**< Model for handling similarity search over embedding vectors. */
+  OpReturnType _embeddingStoreModel;       /**< Model or VectorIndex for handling similarity search over embedding vectors. */
   OpReturnType _documentStore;             /**< Store containing retrievable documents. */
+  LRUCache<std::string, OpReturnType> _embeddingCache; /**< Embedding of recent queries. */
+  std::mutex _embeddingCacheMutex;         /**< Guards _embeddingCache. */
+
+  static constexpr std::size_t EmbeddingCacheSize = 128; /**< Queries kept in _embeddingCache. */
 
   /**
    * @brief Get the container type for this variable.
@@ -68,12 +75,31 @@ class RetrieverDataVariable final : public DataVariable {
 
  private:
   /**
-   * @brief Retrieve top-k relevant documents for a query.
+   * @brief Embed queries, running the embedding model once for all the queries not in the cache.
+   *
+   * @param queries Query strings.
+   * @param stack Call stack for function invocation context.
+   * @return Embedding tensor of every query, in order.
+   */
+  std::vector<OpReturnType> embed(const std::vector<std::string>& queries, CallStack& stack);
+
+  /**
+   * @brief Retrieve top-k relevant documents for an embedded query.
    *
-   * @param arguments Vector containing the query string and k.
+   * @param embedding Embedding tensor of the query.
+   * @param k Maximum number of documents.
    * @param stack Call stack for function invocation context.
    * @return Tuple containing scores and documents.
    */
+  OpReturnType search(const OpReturnType& embedding, int k, CallStack& stack);
+
+  /**
+   * @brief Retrieve top-k relevant documents for a query, or for each query of a list.
+   *
+   * @param arguments Vector containing the query string or a list of query strings, and k.
+   * @param stack Call stack for function invocation context.
+   * @return Tuple containing scores and documents, or a list of such tuples for a list of queries.
+   */
   OpReturnType topk(const std::vector<OpReturnType>& arguments, CallStack& stack);
 
   /**
@@ -86,4 +112,6 @@ class RetrieverDataVariable final : public DataVariable {
    */
   OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
                              CallStack& stack) override;
+
+  bool is_mutating_member(int memberFuncIndex) const override;
 };
@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json_fwd.hpp"
+
+class VectorIndexReader;
+class VectorIndexWriter;
+
+/**
+ * @brief Similarity between a query and the vectors of an index, higher is closer.
+ */
+enum class VectorMetric : uint32_t {
+  DOT = 0,    /**< Inner product of the raw vectors. */
+  COSINE = 1, /**< Inner product of the vectors normalized at insertion and query time. */
+};
+
+/**
+ * @brief Storage format of the vectors of an index.
+ */
+enum class VectorQuantization : uint32_t {
+  FP32 = 0, /**< Vectors stored as is. */
+  INT8 = 1, /**< Vectors scaled into int8 with a scale per vector, a quarter of the memory. */
+};
+
+/**
+ * @brief Kind of index, used to pick the implementation when loading a file.
+ */
+enum class VectorIndexType : uint32_t {
+  FLAT = 0, /**< Exact search, comparing the query with every vector. */
+  HNSW = 1, /**< Approximate search over a hierarchical navigable small world graph. */
+};
+
+/**
+ * @brief Configuration of a vector index.
+ */
+struct VectorIndexConfig {
+  VectorIndexType type = VectorIndexType::FLAT;
+  int dim = 0; /**< Number of dimensions of every vector. */
+  VectorMetric metric = VectorMetric::COSINE;
+  VectorQuantization quantization = VectorQuantization::FP32;
+  int M = 16;                /**< HNSW: neighbours per node on upper layers, twice on layer 0. */
+  int efConstruction = 200;  /**< HNSW: candidates considered when inserting a vector. */
+  int efSearch = 64;         /**< HNSW: candidates considered when searching, at least k. */
+};
+
+/**
+ * @brief Deserialize VectorIndexConfig from JSON. "dim" is required, other fields are optional:
+ * "type" ("flat" or "hnsw"), "metric" ("cosine" or "dot"), "quantization" ("fp32" or "int8"), "M",
+ * "efConstruction" and "efSearch".
+ *
+ * @param j The JSON object to read from.
+ * @param config The config object to populate.
+ */
+void from_json(const nlohmann::json& j, VectorIndexConfig& config);
+
+/**
+ * @brief A vector of an index matching a query.
+ */
+struct VectorSearchResult {
+  int64_t id;  /**< Id the vector was added with. */
+  float score; /**< Similarity with the query. */
+};
+
+/**
+ * @brief In-process index of embedding vectors identified by an int64 id, searched for the vectors
+ * most similar to a query.
+ *
+ * Vectors can be added and removed at any time. An index is saved to a single file, which is
+ * memory mapped when loaded: vectors are read in place from the mapping and only copied into the
+ * heap when the index is modified.
+ *
+ * Not thread safe, searches can run concurrently with each other but not with modifications.
+ */
+class VectorIndex {
+ protected:
+  VectorIndexConfig _config;
+
+  explicit VectorIndex(const VectorIndexConfig& config) : _config(config) {}
+
+ public:
+  virtual ~VectorIndex() = default;
+
+  /**
+   * @brief Creates an empty index.
+   *
+   * @param config Configuration of the index, THROWs if invalid.
+   */
+  static std::unique_ptr<VectorIndex> create(const VectorIndexConfig& config);
+
+  /**
+   * @brief Loads an index saved with save(), mapping the file.
+   *
+   * @param filePath Path to the file.
+   * @return The index, THROWs if the file is missing or corrupt.
+   */
+  static std::unique_ptr<VectorIndex> load(const std::string& filePath);
+
+  const VectorIndexConfig& config() const noexcept { return _config; }
+
+  /**
+   * @brief Adds a vector, replacing the vector with the same id if any.
+   *
+   * @param id Id of the vector.
+   * @param vector config().dim values.
+   */
+  virtual void add(int64_t id, const float* vector) = 0;
+
+  /**
+   * @brief Removes a vector.
+   *
+   * @param id Id of the vector.
+   * @return false if there is no vector with this id.
+   */
+  virtual bool remove(int64_t id) = 0;
+
+  /**
+   * @brief Finds the vectors most similar to a query.
+   *
+   * @param query config().dim values.
+   * @param k Maximum number of results.
+   * @return Up to k results, most similar first.
+   */
+  virtual std::vector<VectorSearchResult> search(const float* query, int k) const = 0;
+
+  /**
+   * @brief Number of vectors in the index.
+   */
+  virtual std::size_t size() const noexcept = 0;
+
+  /**
+   * @brief Writes the index to a file, replacing it atomically.
+   *
+   * @param filePath Path to the file.
+   */
+  void save(const std::string& filePath) const;
+
+ protected:
+  /**
+   * @brief Writes the vectors and any index structure after the common header.
+   */
+  virtual void write(VectorIndexWriter& writer) const = 0;
+
+  /**
+   * @brief Reads what write() wrote.
+   */
+  virtual void read(VectorIndexReader& reader) = 0;
+};
@@ -0,0 +1,104 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <mutex>
+#include <shared_mutex>
+
+#include "data_variable.hpp"
+#include "vector_index.hpp"
+
+/**
+ * @brief Data variable for VectorIndex, an in-process index of embeddings searched by similarity.
+ *
+ * Created from a map with the fields of VectorIndexConfig and an optional "path", relative to the
+ * SDK home directory, where save() writes the index. If the file exists the index is loaded from
+ * it instead of created empty.
+ *
+ * Searches run concurrently, additions and removals wait for them to finish.
+ */
+class VectorIndexDataVariable final : public DataVariable {
+  std::unique_ptr<VectorIndex> _index; /**< The index. */
+  std::string _filePath;               /**< Full path of the file of the index, may be empty. */
+  mutable std::shared_mutex _mutex;    /**< Shared by searches, exclusive for modifications. */
+  std::mutex _saveMutex;               /**< Serializes saves, which write the same file. */
+
+  int get_containerType() const override { return CONTAINERTYPE::SINGLE; }
+
+  bool get_bool() override { return true; }
+
+  int get_dataType_enum() const override { return DATATYPE::NIMBLENET; }
+
+  nlohmann::json to_json() const override { return "[VectorIndex]"; }
+
+  /**
+   * @brief Reads vectors of the dimension of the index from a float or double tensor.
+   *
+   * @param tensor Tensor with a multiple of dim elements.
+   * @param funcIndex Member function the tensor is an argument of, for errors.
+   * @return The vectors, one after the other.
+   */
+  std::vector<float> get_vectors(const OpReturnType& tensor, int funcIndex) const;
+
+  /**
+   * @brief Add a vector with its id, or a list of ids and a tensor of one vector per id.
+   *
+   * @param arguments Vector containing the id(s) and the tensor.
+   * @return None.
+   */
+  OpReturnType add(const std::vector<OpReturnType>& arguments);
+
+  /**
+   * @brief Remove the vector of an id.
+   *
+   * @param arguments Vector containing the id.
+   * @return Whether a vector was removed.
+   */
+  OpReturnType remove(const std::vector<OpReturnType>& arguments);
+
+  /**
+   * @brief Find the k vectors most similar to a query.
+   *
+   * @param arguments Vector containing the query tensor and k.
+   * @return Tuple containing scores and ids, most similar first.
+   */
+  OpReturnType topk(const std::vector<OpReturnType>& arguments);
+
+  /**
+   * @brief Write the index to its path.
+   *
+   * @param arguments Empty vector.
+   * @return None.
+   */
+  OpReturnType save(const std::vector<OpReturnType>& arguments);
+
+ public:
+  /**
+   * @brief Constructor for VectorIndexDataVariable.
+   *
+   * @param arguments Vector containing the config map.
+   */
+  explicit VectorIndexDataVariable(const std::vector<OpReturnType>& arguments);
+
+  /**
+   * @brief Find the k vectors most similar to a query, used by Retriever.
+   *
+   * @param query Tensor of dim elements.
+   * @param k Maximum number of results.
+   * @return Up to k results, most similar first.
+   */
+  std::vector<VectorSearchResult> search(const OpReturnType& query, int k) const;
+
+  int get_size() override;
+
+  std::string print() override { return fallback_print(); }
+
+  OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
+                             CallStack& stack) override;
+
+  bool is_mutating_member(int memberFuncIndex) const override;
+};
@@ -0,0 +1,179 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "vector_index.hpp"
+
+/**
+ * @brief Sequential binary writer of an index file, tracking the offset to align sections.
+ */
+class VectorIndexWriter {
+  std::ofstream _out;
+  std::size_t _offset = 0;
+
+ public:
+  explicit VectorIndexWriter(const std::string& filePath);
+
+  void write(const void* data, std::size_t size);
+
+  template <typename T>
+  void write_value(const T& value) {
+    write(&value, sizeof(T));
+  }
+
+  /**
+   * @brief Pads with zeros up to the next multiple of alignment.
+   */
+  void align(std::size_t alignment);
+
+  /**
+   * @brief Flushes and closes the file, THROWs if anything could not be written.
+   */
+  void close();
+};
+
+/**
+ * @brief Sequential binary reader over a mapped index file, THROWs if the file is truncated.
+ */
+class VectorIndexReader {
+  std::shared_ptr<const MappedFile> _file;
+  std::size_t _offset = 0;
+
+ public:
+  explicit VectorIndexReader(std::shared_ptr<const MappedFile> file) : _file(std::move(file)) {}
+
+  std::size_t remaining() const noexcept { return _file->size() - _offset; }
+
+  const std::shared_ptr<const MappedFile>& file() const noexcept { return _file; }
+
+  /**
+   * @brief Returns a pointer to the next size bytes of the mapping and skips them.
+   */
+  const char* take(std::size_t size);
+
+  void read(void* data, std::size_t size);
+
+  template <typename T>
+  T read_value() {
+    T value;
+    read(&value, sizeof(T));
+    return value;
+  }
+
+  /**
+   * @brief Skips the padding written by VectorIndexWriter::align().
+   */
+  void align(std::size_t alignment);
+};
+
+/**
+ * @brief Vectors of an index, stored contiguously in slots numbered from 0, along with their id.
+ *
+ * Vectors are normalized on insertion for the cosine metric, so that every score is a dot product.
+ * In int8, a vector v is stored as round(v / scale) with scale = max|v| / 127, and scored against a
+ * float query, which keeps the query at full precision.
+ *
+ * Rows of a store read from a file point into the mapping, they are copied into the heap the first
+ * time a vector is modified.
+ */
+class VectorStore {
+  int _dim;
+  VectorMetric _metric;
+  VectorQuantization _quantization;
+  std::size_t _rowBytes;        /**< Size of a stored vector. */
+  std::size_t _size = 0;        /**< Number of slots. */
+  std::vector<char> _rows;      /**< Rows of every slot, unless read in place from _file. */
+  std::vector<float> _scales;   /**< Scale of every slot, in int8. */
+  std::vector<int64_t> _ids;    /**< Id of every slot. */
+  std::shared_ptr<const MappedFile> _file; /**< Mapping the rows are read from, if any. */
+  const char* _mappedRows = nullptr;       /**< Rows in the mapping, until modified. */
+
+  const char* row(uint32_t slot) const {
+    return (_mappedRows ? _mappedRows : _rows.data()) + slot * _rowBytes;
+  }
+
+  /**
+   * @brief Copies rows read in place into the heap, before modifying them.
+   */
+  void own_rows();
+
+  /**
+   * @brief Normalizes if needed and quantizes vector into the row of a slot.
+   */
+  void encode(uint32_t slot, const float* vector);
+
+ public:
+  explicit VectorStore(const VectorIndexConfig& config);
+
+  std::size_t size() const noexcept { return _size; }
+
+  int dim() const noexcept { return _dim; }
+
+  int64_t id(uint32_t slot) const { return _ids[slot]; }
+
+  /**
+   * @brief Stores a vector in a new slot at the end.
+   *
+   * @return The slot.
+   */
+  uint32_t append(int64_t id, const float* vector);
+
+  /**
+   * @brief Replaces the vector of a slot.
+   */
+  void set(uint32_t slot, const float* vector);
+
+  /**
+   * @brief Copies the vector and id of a slot into another.
+   */
+  void move(uint32_t from, uint32_t to);
+
+  /**
+   * @brief Drops the last slot.
+   */
+  void pop_back();
+
+  /**
+   * @brief Turns a query into the form scored against the stored vectors, normalized for cosine.
+   *
+   * @param query dim() values.
+   * @param prepared Output, dim() values.
+   */
+  void prepare_query(const float* query, std::vector<float>& prepared) const;
+
+  /**
+   * @brief Similarity between a prepared query and the vector of a slot.
+   */
+  float score(const float* preparedQuery, uint32_t slot) const;
+
+  /**
+   * @brief Writes the stored form of the vector of a slot, as a prepared query, into out.
+   *
+   * @param slot Slot of the vector.
+   * @param out dim() values.
+   */
+  void decode(uint32_t slot, float* out) const;
+
+  /**
+   * @brief Writes the number of slots, ids, scales and rows, rows aligned for SIMD loads once
+   * mapped.
+   */
+  void write(VectorIndexWriter& writer) const;
+
+  /**
+   * @brief Reads slots written by write(), keeping the rows in the mapping.
+   */
+  void read(VectorIndexReader& reader);
+};
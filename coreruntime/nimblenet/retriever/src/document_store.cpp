@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "document_store.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "logger.hpp"
+
+static constexpr char FileMagic[4] = {'N', 'E', 'D', 'S'};
+static constexpr uint32_t FileVersion = 1;
+
+/**
+ * @brief Header of a document store file, followed by the offset table and the payloads.
+ */
+struct DocumentStoreFileHeader {
+  char magic[4];
+  uint32_t version;
+  uint64_t numDocuments;
+  uint8_t reserved[16];
+};
+
+static_assert(sizeof(DocumentStoreFileHeader) == 32, "Header should keep the offsets aligned");
+
+bool DocumentStore::is_document_store(const MappedFile& file) {
+  if (file.size() < sizeof(DocumentStoreFileHeader)) return false;
+  DocumentStoreFileHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  return std::memcmp(header.magic, FileMagic, sizeof(FileMagic)) == 0 &&
+         header.version == FileVersion;
+}
+
+std::unique_ptr<DocumentStore> DocumentStore::open(std::shared_ptr<const MappedFile> file) {
+  if (!is_document_store(*file)) {
+    THROW("File is not a DocumentStore of version=%u", FileVersion);
+  }
+  DocumentStoreFileHeader header;
+  std::memcpy(&header, file->data(), sizeof(header));
+  std::size_t available = file->size() - sizeof(header);
+  if (header.numDocuments >= available / sizeof(uint64_t)) {
+    THROW("DocumentStore of %llu documents is truncated",
+          static_cast<unsigned long long>(header.numDocuments));
+  }
+
+  std::unique_ptr<DocumentStore> store(new DocumentStore());
+  store->_numDocuments = header.numDocuments;
+  store->_offsets = file->data() + sizeof(header);
+  std::size_t tableSize = (header.numDocuments + 1) * sizeof(uint64_t);
+  store->_payloads = store->_offsets + tableSize;
+  store->_payloadsSize = available - tableSize;
+  store->_file = std::move(file);
+  if (store->get_offset(0) != 0 || store->get_offset(store->_numDocuments) > store->_payloadsSize) {
+    THROW("DocumentStore of %llu documents is truncated",
+          static_cast<unsigned long long>(header.numDocuments));
+  }
+  return store;
+}
+
+uint64_t DocumentStore::get_offset(std::size_t index) const {
+  uint64_t offset;
+  std::memcpy(&offset, _offsets + index * sizeof(uint64_t), sizeof(offset));
+  return offset;
+}
+
+DocumentStore::Document DocumentStore::get(std::size_t index) const {
+  if (index >= _numDocuments) {
+    THROW("trying to access %zu index for DocumentStore of size=%zu", index, _numDocuments);
+  }
+  uint64_t begin = get_offset(index);
+  uint64_t end = get_offset(index + 1);
+  if (begin >= end || end > _payloadsSize) {
+    THROW("Document at index=%zu of DocumentStore is corrupted", index);
+  }
+  auto type = static_cast<DocumentType>(_payloads[begin]);
+  if (type != DocumentType::STRING && type != DocumentType::JSON) {
+    THROW("Document at index=%zu of DocumentStore has invalid type=%d", index,
+          static_cast<int>(type));
+  }
+  return {type, std::string_view(_payloads + begin + 1, end - begin - 1)};
+}
+
+void DocumentStore::write(const nlohmann::json& documents, const std::string& filePath) {
+  if (!documents.is_array()) {
+    THROW("Expected documents to be a JSON array, found %s", documents.type_name());
+  }
+
+  std::string payloads;
+  std::vector<uint64_t> offsets;
+  offsets.reserve(documents.size() + 1);
+  for (const auto& document : documents) {
+    offsets.push_back(payloads.size());
+    if (document.is_string()) {
+      payloads.push_back(static_cast<char>(DocumentType::STRING));
+      payloads.append(document.get_ref<const std::string&>());
+    } else {
+      payloads.push_back(static_cast<char>(DocumentType::JSON));
+      payloads.append(document.dump());
+    }
+  }
+  offsets.push_back(payloads.size());
+
+  DocumentStoreFileHeader header{};
+  std::memcpy(header.magic, FileMagic, sizeof(FileMagic));
+  header.version = FileVersion;
+  header.numDocuments = documents.size();
+
+  // Written next to the file and renamed over it, so that a crash never leaves a partial store
+  std::string tmpFilePath = filePath + ".tmp";
+  {
+    std::ofstream out(tmpFilePath, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+    out.write(payloads.data(), payloads.size());
+    out.close();
+    if (!out) {
+      std::remove(tmpFilePath.c_str());
+      THROW("Could not write DocumentStore to file=%s", tmpFilePath.c_str());
+    }
+  }
+  if (std::rename(tmpFilePath.c_str(), filePath.c_str()) != 0) {
+    std::remove(tmpFilePath.c_str());
+    THROW("Could not save DocumentStore to file=%s", filePath.c_str());
+  }
+}
@@ -0,0 +1,43 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "document_store_data_variable.hpp"
+
+#include "single_variable.hpp"
+
+OpReturnType DocumentStoreDataVariable::get_int_subscript(int index) {
+  int size = _store->size();
+  int index_ = index < 0 ? index + size : index;
+  if (index_ >= size || index_ < 0) {
+    THROW("trying to access %d index for DocumentStore of size=%d", index, size);
+  }
+  auto document = _store->get(index_);
+  if (document.type == DocumentStore::DocumentType::STRING) {
+    return OpReturnType(new SingleVariable<std::string>(std::string(document.data)));
+  }
+  auto value = nlohmann::json::parse(document.data);
+  switch (value.type()) {
+    case nlohmann::json::value_t::object:
+      return DataVariable::get_map_from_json_object(std::move(value));
+    case nlohmann::json::value_t::array:
+      return DataVariable::get_list_from_json_array(std::move(value));
+    default:
+      return DataVariable::get_SingleVariableFrom_JSON(value);
+  }
+}
+
+nlohmann::json DocumentStoreDataVariable::to_json() const {
+  auto output = nlohmann::json::array();
+  for (std::size_t i = 0; i < _store->size(); i++) {
+    auto document = _store->get(i);
+    if (document.type == DocumentStore::DocumentType::STRING) {
+      output.push_back(std::string(document.data));
+    } else {
+      output.push_back(nlohmann::json::parse(document.data));
+    }
+  }
+  return output;
+}
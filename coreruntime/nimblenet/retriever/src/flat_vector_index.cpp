@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "flat_vector_index.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+#include "logger.hpp"
+
+FlatVectorIndex::FlatVectorIndex(const VectorIndexConfig& config)
+    : VectorIndex(config), _store(config) {}
+
+void FlatVectorIndex::add(int64_t id, const float* vector) {
+  auto it = _slots.find(id);
+  if (it != _slots.end()) {
+    _store.set(it->second, vector);
+    return;
+  }
+  _slots[id] = _store.append(id, vector);
+}
+
+bool FlatVectorIndex::remove(int64_t id) {
+  auto it = _slots.find(id);
+  if (it == _slots.end()) return false;
+  uint32_t slot = it->second;
+  uint32_t last = _store.size() - 1;
+  _slots.erase(it);
+  if (slot != last) {
+    _store.move(last, slot);
+    _slots[_store.id(slot)] = slot;
+  }
+  _store.pop_back();
+  return true;
+}
+
+std::vector<VectorSearchResult> FlatVectorIndex::search(const float* query, int k) const {
+  if (k <= 0 || _store.size() == 0) return {};
+  std::vector<float> prepared;
+  _store.prepare_query(query, prepared);
+
+  // Min-heap of the k best scores seen so far
+  using Candidate = std::pair<float, uint32_t>;
+  std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> best;
+  for (uint32_t slot = 0; slot < _store.size(); slot++) {
+    float score = _store.score(prepared.data(), slot);
+    if (best.size() < static_cast<std::size_t>(k)) {
+      best.emplace(score, slot);
+    } else if (score > best.top().first) {
+      best.pop();
+      best.emplace(score, slot);
+    }
+  }
+
+  std::vector<VectorSearchResult> results(best.size());
+  for (auto it = results.rbegin(); it != results.rend(); it++) {
+    *it = {_store.id(best.top().second), best.top().first};
+    best.pop();
+  }
+  return results;
+}
+
+void FlatVectorIndex::write(VectorIndexWriter& writer) const { _store.write(writer); }
+
+void FlatVectorIndex::read(VectorIndexReader& reader) {
+  _store.read(reader);
+  _slots.reserve(_store.size());
+  for (uint32_t slot = 0; slot < _store.size(); slot++) {
+    if (!_slots.emplace(_store.id(slot), slot).second) {
+      THROW("Vector index file has duplicate id=%lld", (long long)_store.id(slot));
+    }
+  }
+}
@@ -0,0 +1,261 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "hnsw_vector_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+#include "logger.hpp"
+
+// Bounds a corrupt file cannot exceed, a level above 32 is out of reach for any realistic size
+static constexpr uint32_t MaxLevels = 32;
+
+// Fixed seed so that building an index from the same vectors gives the same graph
+static constexpr uint32_t LevelSeed = 5489;
+
+HNSWVectorIndex::HNSWVectorIndex(const VectorIndexConfig& config)
+    : VectorIndex(config), _store(config), _rng(LevelSeed) {
+  _levelMultiplier = 1 / std::log(static_cast<double>(config.M));
+}
+
+int HNSWVectorIndex::random_level() {
+  std::uniform_real_distribution<double> distribution(0, 1);
+  // 1 - U is in (0, 1], so the logarithm is finite
+  double level = -std::log(1 - distribution(_rng)) * _levelMultiplier;
+  return std::min(static_cast<int>(level), static_cast<int>(MaxLevels) - 1);
+}
+
+uint32_t HNSWVectorIndex::greedy_search(const float* query, uint32_t entry, int fromLevel,
+                                        int toLevel) const {
+  uint32_t current = entry;
+  float currentScore = _store.score(query, current);
+  for (int level = fromLevel; level > toLevel; level--) {
+    bool moved = true;
+    while (moved) {
+      moved = false;
+      for (uint32_t neighbor : _nodes[current].neighbors[level]) {
+        float score = _store.score(query, neighbor);
+        if (score > currentScore) {
+          current = neighbor;
+          currentScore = score;
+          moved = true;
+        }
+      }
+    }
+  }
+  return current;
+}
+
+std::vector<HNSWVectorIndex::Candidate> HNSWVectorIndex::search_layer(const float* query,
+                                                                      uint32_t entry, int ef,
+                                                                      int level,
+                                                                      bool liveOnly) const {
+  std::vector<bool> visited(_nodes.size());
+  // Max-heap of the candidates left to expand, min-heap of the ef best found
+  std::priority_queue<Candidate> toExpand;
+  std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> best;
+
+  Candidate start{_store.score(query, entry), entry};
+  visited[entry] = true;
+  toExpand.push(start);
+  if (!liveOnly || !_nodes[entry].deleted) best.push(start);
+  while (!toExpand.empty()) {
+    Candidate current = toExpand.top();
+    if (best.size() >= static_cast<std::size_t>(ef) && current.first < best.top().first) break;
+    toExpand.pop();
+    for (uint32_t neighbor : _nodes[current.second].neighbors[level]) {
+      if (visited[neighbor]) continue;
+      visited[neighbor] = true;
+      float score = _store.score(query, neighbor);
+      if (best.size() < static_cast<std::size_t>(ef) || score > best.top().first) {
+        toExpand.emplace(score, neighbor);
+        if (liveOnly && _nodes[neighbor].deleted) continue;
+        best.emplace(score, neighbor);
+        if (best.size() > static_cast<std::size_t>(ef)) best.pop();
+      }
+    }
+  }
+
+  std::vector<Candidate> results(best.size());
+  for (auto it = results.rbegin(); it != results.rend(); it++) {
+    *it = best.top();
+    best.pop();
+  }
+  return results;
+}
+
+std::vector<uint32_t> HNSWVectorIndex::select_neighbors(const std::vector<Candidate>& candidates,
+                                                        int maxNeighbors) const {
+  std::vector<uint32_t> selected;
+  std::vector<float> candidateVector(_store.dim());
+  for (const auto& [score, slot] : candidates) {
+    if (selected.size() >= static_cast<std::size_t>(maxNeighbors)) break;
+    _store.decode(slot, candidateVector.data());
+    bool diverse = std::none_of(selected.begin(), selected.end(), [&](uint32_t neighbor) {
+      return _store.score(candidateVector.data(), neighbor) > score;
+    });
+    if (diverse) selected.push_back(slot);
+  }
+  return selected;
+}
+
+void HNSWVectorIndex::connect(uint32_t node, uint32_t neighbor, int level) {
+  auto& neighbors = _nodes[node].neighbors[level];
+  neighbors.push_back(neighbor);
+  if (neighbors.size() <= static_cast<std::size_t>(max_neighbors(level))) return;
+
+  std::vector<float> nodeVector(_store.dim());
+  _store.decode(node, nodeVector.data());
+  std::vector<Candidate> candidates;
+  candidates.reserve(neighbors.size());
+  for (uint32_t slot : neighbors) {
+    candidates.emplace_back(_store.score(nodeVector.data(), slot), slot);
+  }
+  std::sort(candidates.begin(), candidates.end(), std::greater<Candidate>());
+  neighbors = select_neighbors(candidates, max_neighbors(level));
+}
+
+void HNSWVectorIndex::insert(int64_t id, const float* vector) {
+  uint32_t slot = _store.append(id, vector);
+  int level = random_level();
+  _nodes.emplace_back();
+  _nodes.back().neighbors.resize(level + 1);
+  _slots[id] = slot;
+  if (_maxLevel < 0) {
+    _entryPoint = slot;
+    _maxLevel = level;
+    return;
+  }
+
+  // Link with the stored form of the vector, which is what other nodes are compared to
+  std::vector<float> query(_store.dim());
+  _store.decode(slot, query.data());
+  uint32_t entry = greedy_search(query.data(), _entryPoint, _maxLevel, level);
+  for (int layer = std::min(level, _maxLevel); layer >= 0; layer--) {
+    auto candidates = search_layer(query.data(), entry, _config.efConstruction, layer);
+    _nodes[slot].neighbors[layer] = select_neighbors(candidates, _config.M);
+    for (uint32_t neighbor : _nodes[slot].neighbors[layer]) {
+      connect(neighbor, slot, layer);
+    }
+    entry = candidates.front().second;
+  }
+  if (level > _maxLevel) {
+    _entryPoint = slot;
+    _maxLevel = level;
+  }
+}
+
+void HNSWVectorIndex::rebuild() {
+  VectorStore oldStore = std::move(_store);
+  std::vector<Node> oldNodes = std::move(_nodes);
+  _store = VectorStore(_config);
+  _nodes.clear();
+  _slots.clear();
+  _maxLevel = -1;
+  std::vector<float> vector(oldStore.dim());
+  for (uint32_t slot = 0; slot < oldNodes.size(); slot++) {
+    if (oldNodes[slot].deleted) continue;
+    oldStore.decode(slot, vector.data());
+    insert(oldStore.id(slot), vector.data());
+  }
+}
+
+void HNSWVectorIndex::add(int64_t id, const float* vector) {
+  remove(id);
+  insert(id, vector);
+}
+
+bool HNSWVectorIndex::remove(int64_t id) {
+  auto it = _slots.find(id);
+  if (it == _slots.end()) return false;
+  _nodes[it->second].deleted = true;
+  _slots.erase(it);
+  if (_nodes.size() - _slots.size() > _slots.size()) {
+    rebuild();
+  }
+  return true;
+}
+
+std::vector<VectorSearchResult> HNSWVectorIndex::search(const float* query, int k) const {
+  if (k <= 0 || _slots.empty()) return {};
+  std::vector<float> prepared;
+  _store.prepare_query(query, prepared);
+  uint32_t entry = greedy_search(prepared.data(), _entryPoint, _maxLevel, 0);
+  // Tombstones would take the place of live vectors among the ef candidates kept
+  auto candidates = search_layer(prepared.data(), entry, std::max(_config.efSearch, k), 0, true);
+
+  std::vector<VectorSearchResult> results;
+  results.reserve(k);
+  for (const auto& [score, slot] : candidates) {
+    if (results.size() == static_cast<std::size_t>(k)) break;
+    results.push_back({_store.id(slot), score});
+  }
+  return results;
+}
+
+void HNSWVectorIndex::write(VectorIndexWriter& writer) const {
+  _store.write(writer);
+  writer.write_value<int32_t>(_maxLevel);
+  writer.write_value<uint32_t>(_entryPoint);
+  for (const auto& node : _nodes) {
+    writer.write_value<uint8_t>(node.deleted);
+    writer.write_value<uint32_t>(node.neighbors.size());
+    for (const auto& neighbors : node.neighbors) {
+      writer.write_value<uint32_t>(neighbors.size());
+      writer.write(neighbors.data(), neighbors.size() * sizeof(uint32_t));
+    }
+  }
+}
+
+void HNSWVectorIndex::read(VectorIndexReader& reader) {
+  _store.read(reader);
+  std::size_t count = _store.size();
+  _maxLevel = reader.read_value<int32_t>();
+  _entryPoint = reader.read_value<uint32_t>();
+  if (_maxLevel >= static_cast<int>(MaxLevels) || (count > 0 && _entryPoint >= count) ||
+      (count > 0) != (_maxLevel >= 0)) {
+    THROW("%s", "Vector index file has an invalid graph entry point");
+  }
+
+  _nodes.resize(count);
+  for (uint32_t slot = 0; slot < count; slot++) {
+    auto& node = _nodes[slot];
+    node.deleted = reader.read_value<uint8_t>();
+    uint32_t numLevels = reader.read_value<uint32_t>();
+    if (numLevels == 0 || numLevels > MaxLevels) {
+      THROW("Vector index file has invalid levels=%u for a node", numLevels);
+    }
+    node.neighbors.resize(numLevels);
+    for (uint32_t level = 0; level < numLevels; level++) {
+      uint32_t numNeighbors = reader.read_value<uint32_t>();
+      if (numNeighbors > static_cast<uint32_t>(max_neighbors(level))) {
+        THROW("Vector index file has too many neighbours=%u for a node", numNeighbors);
+      }
+      node.neighbors[level].resize(numNeighbors);
+      reader.read(node.neighbors[level].data(), numNeighbors * sizeof(uint32_t));
+    }
+    if (!node.deleted && !_slots.emplace(_store.id(slot), slot).second) {
+      THROW("Vector index file has duplicate id=%lld", (long long)_store.id(slot));
+    }
+  }
+
+  // Neighbours are only checked once every node is read, as edges can point to later nodes
+  for (const auto& node : _nodes) {
+    for (uint32_t level = 0; level < node.neighbors.size(); level++) {
+      for (uint32_t neighbor : node.neighbors[level]) {
+        if (neighbor >= count || _nodes[neighbor].neighbors.size() <= level) {
+          THROW("%s", "Vector index file has an invalid edge");
+        }
+      }
+    }
+  }
+  if (count > 0 && _nodes[_entryPoint].neighbors.size() != static_cast<uint32_t>(_maxLevel + 1)) {
+    THROW("%s", "Vector index file has an invalid graph entry point");
+  }
+}
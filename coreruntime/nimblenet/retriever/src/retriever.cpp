@@ -6,45 +6,120 @@
 
 #include "retriever.hpp"
 
+#include <algorithm>
+
 #include "asset_load_job.hpp"
 #include "list_data_variable.hpp"
+#include "single_variable.hpp"
 #include "tensor_data_variable.hpp"
 #include "tuple_data_variable.hpp"
+#include "vector_index_data_variable.hpp"
+
+std::vector<OpReturnType> RetrieverDataVariable::embed(const std::vector<std::string>& queries,
+                                                       CallStack& stack) {
+  std::vector<OpReturnType> embeddings(queries.size());
+  std::vector<std::string> misses;
+  {
+    std::lock_guard<std::mutex> lock(_embeddingCacheMutex);
+    for (int i = 0; i < queries.size(); i++) {
+      if (auto cached = _embeddingCache.get(queries[i])) {
+        embeddings[i] = *cached;
+      } else if (std::find(misses.begin(), misses.end(), queries[i]) == misses.end()) {
+        misses.push_back(queries[i]);
+      }
+    }
+  }
+  if (misses.empty()) return embeddings;
+
+  std::vector<OpReturnType> missStrings;
+  for (const auto& query : misses) {
+    missStrings.push_back(OpReturnType(new SingleVariable<std::string>(query)));
+  }
+  std::vector<OpReturnType> embeddingModelArgs;
+  embeddingModelArgs.push_back(
+      OpReturnType(new StringTensorVariable(missStrings, missStrings.size())));
+  auto output = _embeddingModel->call_function(MemberFuncType::RUNMODEL, embeddingModelArgs, stack);
+  if (!output->get_bool()) {
+    THROW("%s", "embedding could not be created for query");
+  }
+
+  // The batch is split along its first dimension, each query keeping a batch of 1
+  auto batch = output->get_int_subscript(0);
+  auto rowShape = batch->get_shape();
+  if (!rowShape.empty() && rowShape[0] == misses.size()) {
+    rowShape[0] = 1;
+  } else if (misses.size() != 1) {
+    THROW("Embedding model returned a batch of shape[0]=%lld for %d queries",
+          rowShape.empty() ? 0LL : (long long)rowShape[0], (int)misses.size());
+  }
+  auto dataType = static_cast<DATATYPE>(batch->get_dataType_enum());
+  std::size_t rowBytes = batch->get_numElements() / misses.size() *
+                         util::get_field_size_from_data_type(dataType);
+  // Rows are copied, so that the cache does not hold on to the output buffers of the model
+  auto data = static_cast<char*>(batch->get_raw_ptr());
+  std::lock_guard<std::mutex> lock(_embeddingCacheMutex);
+  for (int j = 0; j < misses.size(); j++) {
+    auto embedding = TensorVariable::copy_tensor_from_raw_data(data + j * rowBytes, dataType,
+                                                               rowShape);
+    _embeddingCache.put(misses[j], embedding);
+    for (int i = 0; i < queries.size(); i++) {
+      if (!embeddings[i] && queries[i] == misses[j]) embeddings[i] = embedding;
+    }
+  }
+  return embeddings;
+}
+
+OpReturnType RetrieverDataVariable::search(const OpReturnType& embedding, int k,
+                                           CallStack& stack) {
+  std::vector<OpReturnType> documents;
+  std::vector<OpReturnType> docScores;
+  if (auto vectorIndex = std::dynamic_pointer_cast<VectorIndexDataVariable>(_embeddingStoreModel)) {
+    // Ids of the vectors in the index are indices in the document store
+    for (const auto& result : vectorIndex->search(embedding, k)) {
+      documents.push_back(_documentStore->get_int_subscript(result.id));
+      docScores.push_back(OpReturnType(new SingleVariable<float>(result.score)));
+    }
+  } else {
+    std::vector<OpReturnType> embeddingStoreModelArgs;
+    embeddingStoreModelArgs.push_back(embedding);
+    auto output = _embeddingStoreModel->call_function(MemberFuncType::RUNMODEL,
+                                                      embeddingStoreModelArgs, stack);
+    if (!output->get_bool()) {
+      THROW("%s", "Ranks could not be fetched from embeddingStore");
+    }
+    auto scores = output->get_int_subscript(0);
+    auto indices = output->get_int_subscript(1);
+    int total = indices->get_size();
+    for (int i = 0; i < k && i < total; i++) {
+      int index = indices->get_int_subscript(i)->get_int32();
+      documents.push_back(_documentStore->get_int_subscript(index));
+      docScores.push_back(scores->get_int_subscript(i));
+    }
+  }
+  OpReturnType docScoresList = OpReturnType(new ListDataVariable(std::move(docScores)));
+  OpReturnType documentsList = OpReturnType(new ListDataVariable(std::move(documents)));
+  return OpReturnType(new TupleDataVariable({docScoresList, documentsList}));
+}
 
 OpReturnType RetrieverDataVariable::topk(const std::vector<OpReturnType>& arguments,
                                          CallStack& stack) {
   THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 2, MemberFuncType::TOPK);
-  THROW_ARGUMENT_DATATYPE_NOT_MATCH(arguments[0]->get_dataType_enum(), DATATYPE::STRING, 0,
-                                    MemberFuncType::TOPK);
   int k = arguments[1]->get_int32();
-  std::vector<OpReturnType> embeddingModelArgs;
-  embeddingModelArgs.push_back(OpReturnType(new StringTensorVariable({arguments[0]}, 1)));
-  auto embedding =
-      _embeddingModel->call_function(MemberFuncType::RUNMODEL, embeddingModelArgs, stack);
-
-  if (!embedding->get_bool()) {
-    THROW("%s", "embedding could not be created for query");
+  if (arguments[0]->get_containerType() == CONTAINERTYPE::SINGLE) {
+    THROW_ARGUMENT_DATATYPE_NOT_MATCH(arguments[0]->get_dataType_enum(), DATATYPE::STRING, 0,
+                                      MemberFuncType::TOPK);
+    return search(embed({arguments[0]->get_string()}, stack)[0], k, stack);
   }
-  std::vector<OpReturnType> embeddingStoreModelArgs;
-  embeddingStoreModelArgs.push_back(embedding->get_int_subscript(0));
-  auto output =
-      _embeddingStoreModel->call_function(MemberFuncType::RUNMODEL, embeddingStoreModelArgs, stack);
-  if (!output->get_bool()) {
-    THROW("%s", "Ranks could not be fetched from embeddingStore");
+
+  std::vector<std::string> queries;
+  for (int i = 0; i < arguments[0]->get_size(); i++) {
+    queries.push_back(arguments[0]->get_int_subscript(i)->get_string());
   }
-  auto scores = output->get_int_subscript(0);
-  auto indices = output->get_int_subscript(1);
-  int total = indices->get_size();
-  OpReturnType documents = OpReturnType(new ListDataVariable(std::vector<OpReturnType>()));
-  OpReturnType docScores = OpReturnType(new ListDataVariable(std::vector<OpReturnType>()));
-  for (int i = 0; i < k && i < total; i++) {
-    int index = indices->get_int_subscript(i)->get_int32();
-    auto val = _documentStore->get_int_subscript(index);
-    documents->append(val);
-    auto score = scores->get_int_subscript(i);
-    docScores->append(score);
+  std::vector<OpReturnType> results;
+  for (const auto& embedding : embed(queries, stack)) {
+    results.push_back(search(embedding, k, stack));
   }
-  return OpReturnType(new TupleDataVariable({docScores, documents}));
+  return OpReturnType(new ListDataVariable(std::move(results)));
 }
 
 OpReturnType RetrieverDataVariable::call_function(int memberFuncIndex,
@@ -57,8 +132,19 @@ OpReturnType RetrieverDataVariable::call_function(int memberFuncIndex,
   THROW("%s not implemented for Retriever", DataVariable::get_member_func_string(memberFuncIndex));
 }
 
+bool RetrieverDataVariable::is_mutating_member(int memberFuncIndex) const {
+  switch (memberFuncIndex) {
+    // The embedding cache and the index are guarded by their own mutexes
+    case MemberFuncType::TOPK:
+      return false;
+    default:
+      return DataVariable::is_mutating_member(memberFuncIndex);
+  }
+}
+
 RetrieverDataVariable::RetrieverDataVariable(CommandCenter* commandCenter_,
-                                             const std::vector<OpReturnType>& arguments) {
+                                             const std::vector<OpReturnType>& arguments)
+    : _embeddingCache(EmbeddingCacheSize) {
   THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 3, MemberFuncType::RETRIEVER);
   _commandCenter = commandCenter_;
   _embeddingModel = arguments[0];
@@ -0,0 +1,159 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "vector_index.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#include "flat_vector_index.hpp"
+#include "hnsw_vector_index.hpp"
+#include "logger.hpp"
+#include "nlohmann/json.hpp"
+
+static constexpr char FileMagic[4] = {'N', 'E', 'V', 'I'};
+static constexpr uint32_t FileVersion = 1;
+
+/**
+ * @brief Header of an index file, followed by the data written by VectorIndex::write(). Values are
+ * in the byte order of the device, which is little endian on every supported platform.
+ */
+struct VectorIndexFileHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t type;
+  uint32_t dim;
+  uint32_t metric;
+  uint32_t quantization;
+  int32_t M;
+  int32_t efConstruction;
+  int32_t efSearch;
+  uint8_t reserved[28];
+};
+
+static_assert(sizeof(VectorIndexFileHeader) == 64, "Header should keep the data 64-byte aligned");
+
+template <typename Enum>
+static Enum parse_enum(const nlohmann::json& j, const char* key,
+                       std::initializer_list<std::pair<const char*, Enum>> values, Enum value) {
+  auto it = j.find(key);
+  if (it == j.end()) return value;
+  const auto name = it.value().get<std::string>();
+  for (const auto& [valueName, enumValue] : values) {
+    if (name == valueName) return enumValue;
+  }
+  THROW("Invalid %s=%s for VectorIndex", key, name.c_str());
+}
+
+void from_json(const nlohmann::json& j, VectorIndexConfig& config) {
+  if (auto it = j.find("dim"); it != j.end()) {
+    it.value().get_to(config.dim);
+  } else {
+    THROW("%s", "dim is required to create a VectorIndex");
+  }
+
+  config.type = parse_enum(j, "type",
+                           {{"flat", VectorIndexType::FLAT}, {"hnsw", VectorIndexType::HNSW}},
+                           config.type);
+  config.metric = parse_enum(j, "metric",
+                             {{"cosine", VectorMetric::COSINE}, {"dot", VectorMetric::DOT}},
+                             config.metric);
+  config.quantization =
+      parse_enum(j, "quantization",
+                 {{"fp32", VectorQuantization::FP32}, {"int8", VectorQuantization::INT8}},
+                 config.quantization);
+
+  if (auto it = j.find("M"); it != j.end()) {
+    it.value().get_to(config.M);
+  }
+
+  if (auto it = j.find("efConstruction"); it != j.end()) {
+    it.value().get_to(config.efConstruction);
+  }
+
+  if (auto it = j.find("efSearch"); it != j.end()) {
+    it.value().get_to(config.efSearch);
+  }
+}
+
+std::unique_ptr<VectorIndex> VectorIndex::create(const VectorIndexConfig& config) {
+  if (config.dim <= 0) {
+    THROW("Invalid dim=%d for VectorIndex", config.dim);
+  }
+  if (config.metric != VectorMetric::DOT && config.metric != VectorMetric::COSINE) {
+    THROW("Invalid metric=%u for VectorIndex", static_cast<uint32_t>(config.metric));
+  }
+  if (config.quantization != VectorQuantization::FP32 &&
+      config.quantization != VectorQuantization::INT8) {
+    THROW("Invalid quantization=%u for VectorIndex", static_cast<uint32_t>(config.quantization));
+  }
+
+  switch (config.type) {
+    case VectorIndexType::FLAT:
+      return std::make_unique<FlatVectorIndex>(config);
+    case VectorIndexType::HNSW:
+      if (config.M < 2 || config.efConstruction < 1 || config.efSearch < 1) {
+        THROW("Invalid M=%d, efConstruction=%d or efSearch=%d for VectorIndex", config.M,
+              config.efConstruction, config.efSearch);
+      }
+      return std::make_unique<HNSWVectorIndex>(config);
+  }
+  THROW("Invalid type=%u for VectorIndex", static_cast<uint32_t>(config.type));
+}
+
+std::unique_ptr<VectorIndex> VectorIndex::load(const std::string& filePath) {
+  std::shared_ptr<const MappedFile> file = MappedFile::open(filePath);
+  if (!file) {
+    THROW("Could not open VectorIndex file=%s", filePath.c_str());
+  }
+  VectorIndexReader reader(file);
+  auto header = reader.read_value<VectorIndexFileHeader>();
+  if (std::memcmp(header.magic, FileMagic, sizeof(FileMagic)) != 0 ||
+      header.version != FileVersion) {
+    THROW("File=%s is not a VectorIndex of version=%u", filePath.c_str(), FileVersion);
+  }
+
+  VectorIndexConfig config;
+  config.type = static_cast<VectorIndexType>(header.type);
+  config.dim = header.dim;
+  config.metric = static_cast<VectorMetric>(header.metric);
+  config.quantization = static_cast<VectorQuantization>(header.quantization);
+  config.M = header.M;
+  config.efConstruction = header.efConstruction;
+  config.efSearch = header.efSearch;
+  auto index = create(config);
+  index->read(reader);
+  return index;
+}
+
+void VectorIndex::save(const std::string& filePath) const {
+  VectorIndexFileHeader header{};
+  std::memcpy(header.magic, FileMagic, sizeof(FileMagic));
+  header.version = FileVersion;
+  header.type = static_cast<uint32_t>(_config.type);
+  header.dim = _config.dim;
+  header.metric = static_cast<uint32_t>(_config.metric);
+  header.quantization = static_cast<uint32_t>(_config.quantization);
+  header.M = _config.M;
+  header.efConstruction = _config.efConstruction;
+  header.efSearch = _config.efSearch;
+
+  // Written next to the file and renamed over it, so that a crash never leaves a partial index
+  std::string tmpFilePath = filePath + ".tmp";
+  try {
+    VectorIndexWriter writer(tmpFilePath);
+    writer.write_value(header);
+    write(writer);
+    writer.close();
+  } catch (...) {
+    std::remove(tmpFilePath.c_str());
+    throw;
+  }
+  if (std::rename(tmpFilePath.c_str(), filePath.c_str()) != 0) {
+    std::remove(tmpFilePath.c_str());
+    THROW("Could not save VectorIndex to file=%s", filePath.c_str());
+  }
+}
@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "vector_index_data_variable.hpp"
+
+#include <mutex>
+
+#include "list_data_variable.hpp"
+#include "native_interface.hpp"
+#include "nlohmann/json.hpp"
+#include "single_variable.hpp"
+#include "tuple_data_variable.hpp"
+
+VectorIndexDataVariable::VectorIndexDataVariable(const std::vector<OpReturnType>& arguments) {
+  THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 1, MemberFuncType::VECTOR_INDEX);
+  if (arguments[0]->get_containerType() != CONTAINERTYPE::MAP) {
+    THROW("%s", "Expected VectorIndex argument to be a map");
+  }
+  auto configJson = arguments[0]->to_json();
+  auto config = configJson.get<VectorIndexConfig>();
+  if (auto it = configJson.find("path"); it != configJson.end()) {
+    auto fileName = it.value().get<std::string>();
+    _filePath = nativeinterface::get_full_file_path_common(fileName);
+    if (nativeinterface::file_exists_common(fileName)) {
+      _index = VectorIndex::load(_filePath);
+      if (_index->config().dim != config.dim) {
+        THROW("VectorIndex at path=%s has dim=%d, expected dim=%d", fileName.c_str(),
+              _index->config().dim, config.dim);
+      }
+      return;
+    }
+  }
+  _index = VectorIndex::create(config);
+}
+
+std::vector<float> VectorIndexDataVariable::get_vectors(const OpReturnType& tensor,
+                                                        int funcIndex) const {
+  if (tensor->get_containerType() != CONTAINERTYPE::VECTOR) {
+    THROW("%s expects a tensor of vectors, given %s", get_member_func_string(funcIndex),
+          tensor->get_containerType_string());
+  }
+  int dim = _index->config().dim;
+  int numElements = tensor->get_numElements();
+  if (numElements == 0 || numElements % dim != 0) {
+    THROW("%s expects vectors of dim=%d, given a tensor of %d elements",
+          get_member_func_string(funcIndex), dim, numElements);
+  }
+  switch (tensor->get_dataType_enum()) {
+    case DATATYPE::FLOAT: {
+      auto data = static_cast<const float*>(tensor->get_raw_ptr());
+      return std::vector<float>(data, data + numElements);
+    }
+    case DATATYPE::DOUBLE: {
+      auto data = static_cast<const double*>(tensor->get_raw_ptr());
+      return std::vector<float>(data, data + numElements);
+    }
+  }
+  THROW("%s expects a float or double tensor, given %s", get_member_func_string(funcIndex),
+        util::get_string_from_enum(tensor->get_dataType_enum()));
+}
+
+OpReturnType VectorIndexDataVariable::add(const std::vector<OpReturnType>& arguments) {
+  THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 2, MemberFuncType::ADD);
+  auto vectors = get_vectors(arguments[1], MemberFuncType::ADD);
+  int dim = _index->config().dim;
+  std::vector<int64_t> ids;
+  if (arguments[0]->get_containerType() == CONTAINERTYPE::SINGLE) {
+    ids.push_back(arguments[0]->get_int64());
+  } else {
+    for (int i = 0; i < arguments[0]->get_size(); i++) {
+      ids.push_back(arguments[0]->get_int_subscript(i)->get_int64());
+    }
+  }
+  if (ids.size() * dim != vectors.size()) {
+    THROW("add expects one vector per id, given %d ids and %d vectors", (int)ids.size(),
+          (int)(vectors.size() / dim));
+  }
+
+  std::unique_lock<std::shared_mutex> lock(_mutex);
+  for (int i = 0; i < ids.size(); i++) {
+    _index->add(ids[i], vectors.data() + i * dim);
+  }
+  return std::make_shared<NoneVariable>();
+}
+
+OpReturnType VectorIndexDataVariable::remove(const std::vector<OpReturnType>& arguments) {
+  THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 1, MemberFuncType::REMOVE);
+  auto id = arguments[0]->get_int64();
+  std::unique_lock<std::shared_mutex> lock(_mutex);
+  return OpReturnType(new SingleVariable<bool>(_index->remove(id)));
+}
+
+std::vector<VectorSearchResult> VectorIndexDataVariable::search(const OpReturnType& query,
+                                                                int k) const {
+  auto vector = get_vectors(query, MemberFuncType::TOPK);
+  if (vector.size() != _index->config().dim) {
+    THROW("topk expects a single query of dim=%d", _index->config().dim);
+  }
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+  return _index->search(vector.data(), k);
+}
+
+OpReturnType VectorIndexDataVariable::topk(const std::vector<OpReturnType>& arguments) {
+  THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 2, MemberFuncType::TOPK);
+  auto results = search(arguments[0], arguments[1]->get_int32());
+  OpReturnType scores = OpReturnType(new ListDataVariable(std::vector<OpReturnType>()));
+  OpReturnType ids = OpReturnType(new ListDataVariable(std::vector<OpReturnType>()));
+  for (const auto& result : results) {
+    scores->append(OpReturnType(new SingleVariable<float>(result.score)));
+    ids->append(OpReturnType(new SingleVariable<int64_t>(result.id)));
+  }
+  return OpReturnType(new TupleDataVariable({scores, ids}));
+}
+
+OpReturnType VectorIndexDataVariable::save(const std::vector<OpReturnType>& arguments) {
+  THROW_ARGUMENTS_NOT_MATCH(arguments.size(), 0, MemberFuncType::SAVE);
+  if (_filePath.empty()) {
+    THROW("%s", "VectorIndex needs a path to be saved");
+  }
+  // Saving only reads the index, searches can go on meanwhile but not another save
+  std::lock_guard<std::mutex> saveLock(_saveMutex);
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+  _index->save(_filePath);
+  return std::make_shared<NoneVariable>();
+}
+
+int VectorIndexDataVariable::get_size() {
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+  return _index->size();
+}
+
+OpReturnType VectorIndexDataVariable::call_function(int memberFuncIndex,
+                                                    const std::vector<OpReturnType>& arguments,
+                                                    CallStack& stack) {
+  switch (memberFuncIndex) {
+    case MemberFuncType::ADD:
+      return add(arguments);
+    case MemberFuncType::REMOVE:
+      return remove(arguments);
+    case MemberFuncType::TOPK:
+      return topk(arguments);
+    case MemberFuncType::SAVE:
+      return save(arguments);
+  }
+  THROW("%s not implemented for VectorIndex",
+        DataVariable::get_member_func_string(memberFuncIndex));
+}
+
+bool VectorIndexDataVariable::is_mutating_member(int memberFuncIndex) const {
+  switch (memberFuncIndex) {
+    // Guarded by _mutex and _saveMutex
+    case MemberFuncType::ADD:
+    case MemberFuncType::REMOVE:
+    case MemberFuncType::TOPK:
+    case MemberFuncType::SAVE:
+      return false;
+    default:
+      return DataVariable::is_mutating_member(memberFuncIndex);
+  }
+}
@@ -0,0 +1,272 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "vector_store.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "logger.hpp"
+
+// Alignment of the rows in a file, so that mapped rows are as aligned as heap allocated ones
+static constexpr std::size_t RowsAlignment = 64;
+
+static float dot_fp32(const float* a, const float* b, int n) {
+  int i = 0;
+  float sum = 0;
+#if defined(__ARM_NEON)
+  float32x4_t acc0 = vdupq_n_f32(0), acc1 = vdupq_n_f32(0);
+  for (; i + 8 <= n; i += 8) {
+    acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+    acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+  }
+  float32x4_t acc = vaddq_f32(acc0, acc1);
+  float lanes[4];
+  vst1q_f32(lanes, acc);
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__SSE2__)
+  __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+  }
+  float lanes[4];
+  _mm_storeu_ps(lanes, _mm_add_ps(acc0, acc1));
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+  for (; i < n; i++) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+static float dot_int8(const float* a, const int8_t* b, int n) {
+  int i = 0;
+  float sum = 0;
+#if defined(__ARM_NEON)
+  float32x4_t acc0 = vdupq_n_f32(0), acc1 = vdupq_n_f32(0);
+  for (; i + 8 <= n; i += 8) {
+    int16x8_t wide = vmovl_s8(vld1_s8(b + i));
+    float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(wide)));
+    float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(wide)));
+    acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), low);
+    acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), high);
+  }
+  float lanes[4];
+  vst1q_f32(lanes, vaddq_f32(acc0, acc1));
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__SSE4_1__)
+  __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+  for (; i + 8 <= n; i += 8) {
+    int32_t low, high;
+    std::memcpy(&low, b + i, 4);
+    std::memcpy(&high, b + i + 4, 4);
+    __m128 lowValues = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(low)));
+    __m128 highValues = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(high)));
+    acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), lowValues));
+    acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), highValues));
+  }
+  float lanes[4];
+  _mm_storeu_ps(lanes, _mm_add_ps(acc0, acc1));
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#else
+  // Independent accumulators let the compiler vectorize the loop
+  float acc[8] = {0};
+  for (; i + 8 <= n; i += 8) {
+    for (int j = 0; j < 8; j++) {
+      acc[j] += a[i + j] * b[i + j];
+    }
+  }
+  for (int j = 0; j < 8; j++) {
+    sum += acc[j];
+  }
+#endif
+  for (; i < n; i++) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+VectorIndexWriter::VectorIndexWriter(const std::string& filePath)
+    : _out(filePath, std::ios::out | std::ios::binary | std::ios::trunc) {
+  if (!_out) {
+    THROW("Could not open file=%s to write vector index", filePath.c_str());
+  }
+}
+
+void VectorIndexWriter::write(const void* data, std::size_t size) {
+  _out.write(static_cast<const char*>(data), size);
+  _offset += size;
+}
+
+void VectorIndexWriter::align(std::size_t alignment) {
+  static const char zeros[RowsAlignment] = {0};
+  std::size_t padding = (alignment - _offset % alignment) % alignment;
+  while (padding > 0) {
+    std::size_t chunk = std::min(padding, sizeof(zeros));
+    write(zeros, chunk);
+    padding -= chunk;
+  }
+}
+
+void VectorIndexWriter::close() {
+  _out.close();
+  if (_out.fail()) {
+    THROW("%s", "Could not write vector index");
+  }
+}
+
+const char* VectorIndexReader::take(std::size_t size) {
+  if (size > remaining()) {
+    THROW("%s", "Vector index file is truncated");
+  }
+  const char* data = _file->data() + _offset;
+  _offset += size;
+  return data;
+}
+
+void VectorIndexReader::read(void* data, std::size_t size) {
+  if (size > 0) std::memcpy(data, take(size), size);
+}
+
+void VectorIndexReader::align(std::size_t alignment) {
+  take((alignment - _offset % alignment) % alignment);
+}
+
+VectorStore::VectorStore(const VectorIndexConfig& config)
+    : _dim(config.dim), _metric(config.metric), _quantization(config.quantization) {
+  _rowBytes = _quantization == VectorQuantization::INT8 ? _dim : _dim * sizeof(float);
+}
+
+void VectorStore::own_rows() {
+  if (!_mappedRows) return;
+  _rows.assign(_mappedRows, _mappedRows + _size * _rowBytes);
+  _mappedRows = nullptr;
+  _file.reset();
+}
+
+void VectorStore::encode(uint32_t slot, const float* vector) {
+  float norm = 1;
+  if (_metric == VectorMetric::COSINE) {
+    norm = std::sqrt(dot_fp32(vector, vector, _dim));
+    if (norm == 0) norm = 1;
+  }
+  char* out = _rows.data() + slot * _rowBytes;
+  if (_quantization == VectorQuantization::FP32) {
+    float* values = reinterpret_cast<float*>(out);
+    for (int i = 0; i < _dim; i++) {
+      values[i] = vector[i] / norm;
+    }
+    return;
+  }
+  float maxAbs = 0;
+  for (int i = 0; i < _dim; i++) {
+    maxAbs = std::max(maxAbs, std::abs(vector[i] / norm));
+  }
+  float scale = maxAbs > 0 ? maxAbs / 127 : 1;
+  int8_t* values = reinterpret_cast<int8_t*>(out);
+  for (int i = 0; i < _dim; i++) {
+    values[i] = static_cast<int8_t>(std::lround(vector[i] / norm / scale));
+  }
+  _scales[slot] = scale;
+}
+
+uint32_t VectorStore::append(int64_t id, const float* vector) {
+  own_rows();
+  uint32_t slot = _size++;
+  _rows.resize(_size * _rowBytes);
+  _ids.push_back(id);
+  if (_quantization == VectorQuantization::INT8) _scales.push_back(1);
+  encode(slot, vector);
+  return slot;
+}
+
+void VectorStore::set(uint32_t slot, const float* vector) {
+  own_rows();
+  encode(slot, vector);
+}
+
+void VectorStore::move(uint32_t from, uint32_t to) {
+  own_rows();
+  std::memcpy(_rows.data() + to * _rowBytes, _rows.data() + from * _rowBytes, _rowBytes);
+  _ids[to] = _ids[from];
+  if (_quantization == VectorQuantization::INT8) _scales[to] = _scales[from];
+}
+
+void VectorStore::pop_back() {
+  own_rows();
+  _size--;
+  _rows.resize(_size * _rowBytes);
+  _ids.pop_back();
+  if (_quantization == VectorQuantization::INT8) _scales.pop_back();
+}
+
+void VectorStore::prepare_query(const float* query, std::vector<float>& prepared) const {
+  prepared.assign(query, query + _dim);
+  if (_metric == VectorMetric::COSINE) {
+    float norm = std::sqrt(dot_fp32(query, query, _dim));
+    if (norm == 0) return;
+    for (auto& value : prepared) {
+      value /= norm;
+    }
+  }
+}
+
+float VectorStore::score(const float* preparedQuery, uint32_t slot) const {
+  if (_quantization == VectorQuantization::FP32) {
+    return dot_fp32(preparedQuery, reinterpret_cast<const float*>(row(slot)), _dim);
+  }
+  return _scales[slot] * dot_int8(preparedQuery, reinterpret_cast<const int8_t*>(row(slot)), _dim);
+}
+
+void VectorStore::decode(uint32_t slot, float* out) const {
+  if (_quantization == VectorQuantization::FP32) {
+    std::memcpy(out, row(slot), _rowBytes);
+    return;
+  }
+  const int8_t* values = reinterpret_cast<const int8_t*>(row(slot));
+  for (int i = 0; i < _dim; i++) {
+    out[i] = values[i] * _scales[slot];
+  }
+}
+
+void VectorStore::write(VectorIndexWriter& writer) const {
+  writer.write_value<uint64_t>(_size);
+  writer.write(_ids.data(), _size * sizeof(int64_t));
+  if (_quantization == VectorQuantization::INT8) {
+    writer.write(_scales.data(), _size * sizeof(float));
+  }
+  writer.align(RowsAlignment);
+  writer.write(row(0), _size * _rowBytes);
+}
+
+void VectorStore::read(VectorIndexReader& reader) {
+  uint64_t count = reader.read_value<uint64_t>();
+  // Every slot takes more than _rowBytes, which bounds count before allocating
+  if (count > reader.remaining() / _rowBytes) {
+    THROW("%s", "Vector index file is truncated");
+  }
+  _size = count;
+  _ids.resize(count);
+  reader.read(_ids.data(), count * sizeof(int64_t));
+  if (_quantization == VectorQuantization::INT8) {
+    _scales.resize(count);
+    reader.read(_scales.data(), count * sizeof(float));
+  }
+  reader.align(RowsAlignment);
+  _rows.clear();
+  _mappedRows = reader.take(count * _rowBytes);
+  _file = reader.file();
+}
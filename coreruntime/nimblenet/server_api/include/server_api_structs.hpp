@@ -199,6 +199,7 @@ struct CloudConfigResponse {
   int inferenceMetricLogInterval = loggerconstants::InferenceMetricLogInterval; /**< Inference metric log interval. */
   long long int threadSleepTimeUSecs = coresdkconstants::LongRunningThreadSleepUTime; /**< Thread sleep time in microseconds. */
   float fileDeleteTimeInDays = coresdkconstants::FileDeleteTimeInDays; /**< File delete time in days. */
+  int jobSchedulerWorkers = coresdkconstants::DefaultJobSchedulerWorkers; /**< Worker threads running scheduled jobs. */
   LoggerConfig nimbleLoggerConfig; /**< Nimble logger configuration. */
   LoggerConfig externalLoggerConfig; /**< External logger configuration. */
   uint64_t serverTimeMicros = 0;  /**< Server time in microseconds from UTC. */
@@ -345,14 +345,21 @@ FileDownloadStatus ServerAPI::get_llm(std::shared_ptr<Asset> asset) {
 
   auto fileDownloadStatus = ServerAPI::download_file_async(URL, gzFileName);
   if (fileDownloadStatus == FileDownloadStatus::DOWNLOAD_SUCCESS) {
-    // Decompress .zip.gz to .zip
-    if (!nativeinterface::decompress_file(gzFileName, zipFileName)) {
-      LOG_TO_CLIENT_ERROR("Could not decompress file: %s", gzFileName.c_str());
-      return FileDownloadStatus::DOWNLOAD_FAILURE;
-    }
-    // Delete .gz.zip
-    if (!nativeinterface::delete_file(gzFileName, false)) {
-      LOG_TO_CLIENT_ERROR("Could not delete file: %s", gzFileName.c_str());
+    if (nativeinterface::is_gzip_file(gzFileName)) {
+      // Decompress .zip.gz to .zip
+      if (!nativeinterface::decompress_file(gzFileName, zipFileName)) {
+        LOG_TO_CLIENT_ERROR("Could not decompress file: %s", gzFileName.c_str());
+        return FileDownloadStatus::DOWNLOAD_FAILURE;
+      }
+      // Delete .gz.zip
+      if (!nativeinterface::delete_file(gzFileName, false)) {
+        LOG_TO_CLIENT_ERROR("Could not delete file: %s", gzFileName.c_str());
+        return FileDownloadStatus::DOWNLOAD_FAILURE;
+      }
+    } else if (rename(nativeinterface::get_full_file_path_common(gzFileName).c_str(),
+                      nativeinterface::get_full_file_path_common(zipFileName).c_str()) != 0) {
+      // The archive was already decompressed while downloading, it only needs to be renamed
+      LOG_TO_CLIENT_ERROR("Could not rename file: %s", gzFileName.c_str());
       return FileDownloadStatus::DOWNLOAD_FAILURE;
     }
     // Unarchive .zip to folder
@@ -62,6 +62,10 @@ void from_json(const json& j, CloudConfigResponse& cloudConfigResponse) {
         std::max(cloudConfigResponse.threadSleepTimeUSecs,
                  (long long)coresdkconstants::LongRunningThreadSleepUTime);
   }
+  if (j.find("jobSchedulerWorkers") != j.end()) {
+    j.at("jobSchedulerWorkers").get_to(cloudConfigResponse.jobSchedulerWorkers);
+    cloudConfigResponse.jobSchedulerWorkers = std::max(cloudConfigResponse.jobSchedulerWorkers, 1);
+  }
   if (j.find("requestToHostMap") != j.end()) {
     j.at("requestToHostMap").get_to(cloudConfigResponse.requestToHostMap);
   }
@@ -122,6 +126,7 @@ void to_json(json& j, const CloudConfigResponse& cloudConfig) {
   j = json{
       {"inferMetricLogInterval", cloudConfig.inferenceMetricLogInterval},
       {"threadSleepTimeUSecs", cloudConfig.threadSleepTimeUSecs},
+      {"jobSchedulerWorkers", cloudConfig.jobSchedulerWorkers},
       {"requestToHostMap", cloudConfig.requestToHostMap},
       {"fileDeleteTimeInDays", cloudConfig.fileDeleteTimeInDays},
       {"time", cloudConfig.serverTimeMicros},
@@ -12,7 +12,7 @@
 #include <thread>
 
 #include "char_stream.hpp"
-#include "rigtorp/SPSCQueue.h"
+#include "token_queue.hpp"
 #include "stream_producer.hpp"
 
 class Task;
@@ -24,7 +24,7 @@ class Task;
  * To pull characters out of the internal buffer and into the character stream, the process() function needs to be called.
  */
 class DummyOffloadedStream {
-  using Queue = rigtorp::SPSCQueue<char>;
+  using Queue = TokenQueue;
 
   /**
    * @brief Producer thread that pushes characters into the internal queue at a fixed rate.
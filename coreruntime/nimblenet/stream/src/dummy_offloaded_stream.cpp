@@ -20,12 +20,12 @@ void DummyOffloadedStream::ProducerThread::operator()(const std::atomic<bool>& k
   while (keepProcessing.load(std::memory_order_acquire) && _nextIdx < _sourceString.size()) {
     std::this_thread::sleep_for(std::chrono::microseconds(_sleepAfterCharMicros));
 
-    _internalQueue->push(_sourceString[_nextIdx]);
+    _internalQueue->push(std::string_view(_sourceString).substr(_nextIdx, 1));
     _nextIdx++;
   }
 
   // Signal that the generation is finished
-  _internalQueue->push('\0');
+  _internalQueue->close();
 }
 
 DummyOffloadedStream::DummyOffloadedStream(const std::string& str, std::size_t charsPerSec,
@@ -264,6 +264,49 @@ class ListBinOp : public BaseBinOp {
   OpReturnType mult(OpReturnType val1, OpReturnType val2) const override;
 };
 
+/**
+ * @brief Binary operations for numeric tensors
+ *
+ * Supports element-wise add, sub, mult, div, pow and mod between two tensors or between a
+ * tensor and a numeric single variable. Shapes are broadcast following NumPy rules and the
+ * result is written into a single freshly allocated TensorVariable. Operands of FLOAT, DOUBLE,
+ * INT32 and INT64 data types are supported.
+ */
+class TensorBinOp : public BaseBinOp {
+ public:
+  /** @brief Adds two tensors element-wise */
+  OpReturnType add(OpReturnType val1, OpReturnType val2) const override;
+
+  /** @brief Subtracts second tensor from first element-wise */
+  OpReturnType sub(OpReturnType val1, OpReturnType val2) const override;
+
+  /** @brief Multiplies two tensors element-wise */
+  OpReturnType mult(OpReturnType val1, OpReturnType val2) const override;
+
+  /**
+   * @brief Divides first tensor by second element-wise
+   * @throws Exception if any element of the divisor is zero
+   */
+  OpReturnType div(OpReturnType val1, OpReturnType val2) const override;
+
+  /** @brief Raises elements of first tensor to the power of elements of second */
+  OpReturnType pow(OpReturnType val1, OpReturnType val2) const override;
+
+  /**
+   * @brief Computes modulo of first tensor by second element-wise
+   * @throws Exception if any element of the divisor is zero
+   */
+  OpReturnType mod(OpReturnType val1, OpReturnType val2) const override;
+
+  /**
+   * @brief Checks whether the operands can be handled by tensor operations
+   *
+   * At least one operand should be a numeric typed tensor and the other should either be a
+   * numeric typed tensor or a numeric single variable.
+   */
+  static bool is_supported(const OpReturnType& v1, const OpReturnType& v2);
+};
+
 /**
  * @brief Main class for performing binary operations
  *
@@ -277,7 +320,7 @@ class BinaryOperators {
    *
    * Automatically selects the appropriate operation handler based on operand types:
    * - Lists: Uses ListBinOp
-   * - Tensors: Currently throws exception (not supported)
+   * - Tensors: Uses TensorBinOp, operands are broadcast against each other
    * - Numeric: Uses NumericBinOp with appropriate type promotion
    * - Strings: Uses StringBinOp
    *
@@ -292,10 +335,15 @@ class BinaryOperators {
         v2->get_containerType() == CONTAINERTYPE::LIST) {
       static ListBinOp listOp;
       return listOp.perform_operation(v1, v2, opType);
+    } else if (TensorBinOp::is_supported(v1, v2)) {
+      static TensorBinOp tensorOp;
+      return tensorOp.perform_operation(v1, v2, opType);
     } else if (auto t1 = std::dynamic_pointer_cast<BaseTensorVariable>(v1),
                t2 = std::dynamic_pointer_cast<BaseTensorVariable>(v2);
                t1 && t2) {
-      THROW("%s", "tensor ops not supported");
+      THROW("tensor ops not supported for %s and %s tensors",
+            util::get_string_from_enum(v1->get_dataType_enum()),
+            util::get_string_from_enum(v2->get_dataType_enum()));
     } else if (v1->is_numeric() && v2->is_numeric()) {
       auto returnType = get_max_dataType(v1->get_dataType_enum(), v2->get_dataType_enum());
       switch (returnType) {
@@ -0,0 +1,324 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "binary_operators.hpp"
+#include "data_variable.hpp"
+#include "tensor_data_variable.hpp"
+
+/*
+ * Element-wise kernels. Each operator is a stateless struct so that the loops below get fully
+ * inlined and can be auto-vectorized by the compiler for the contiguous cases.
+ */
+struct TensorAddOp {
+  template <typename T>
+  static T apply(T a, T b) {
+    return a + b;
+  }
+};
+
+struct TensorSubOp {
+  template <typename T>
+  static T apply(T a, T b) {
+    return a - b;
+  }
+};
+
+struct TensorMultOp {
+  template <typename T>
+  static T apply(T a, T b) {
+    return a * b;
+  }
+};
+
+struct TensorDivOp {
+  template <typename T>
+  static T apply(T a, T b) {
+    return a / b;
+  }
+};
+
+struct TensorPowOp {
+  template <typename T>
+  static T apply(T a, T b) {
+    return static_cast<T>(std::pow(a, b));
+  }
+};
+
+struct TensorModOp {
+  template <typename T>
+  static T apply(T a, T b) {
+    return ModOperator<T>::compute(a, b);
+  }
+};
+
+static bool is_numeric_dataType(int dataType) {
+  return dataType == DATATYPE::FLOAT || dataType == DATATYPE::DOUBLE ||
+         dataType == DATATYPE::INT32 || dataType == DATATYPE::INT64;
+}
+
+static bool is_numeric_tensor(const OpReturnType& v) {
+  return (dynamic_cast<BaseTypedTensorVariable*>(v.get()) != nullptr ||
+          dynamic_cast<EmptyTensorVariable*>(v.get()) != nullptr) &&
+         is_numeric_dataType(v->get_dataType_enum());
+}
+
+bool TensorBinOp::is_supported(const OpReturnType& v1, const OpReturnType& v2) {
+  bool isTensor1 = is_numeric_tensor(v1);
+  bool isTensor2 = is_numeric_tensor(v2);
+  if (!isTensor1 && !isTensor2) {
+    return false;
+  }
+  return (isTensor1 || (v1->is_single() && v1->is_numeric())) &&
+         (isTensor2 || (v2->is_single() && v2->is_numeric()));
+}
+
+/**
+ * @brief Decides the data type of the result of a tensor binary operation
+ *
+ * Two tensors follow the usual type promotion. When a tensor is mixed with a single variable the
+ * tensor data type is kept as long as both are integers or both are floating point, so that
+ * multiplying a float tensor with a Python float literal does not silently upcast the whole tensor
+ * to double.
+ */
+static DATATYPE get_result_dataType(const OpReturnType& v1, const OpReturnType& v2) {
+  int dataType1 = v1->get_dataType_enum();
+  int dataType2 = v2->get_dataType_enum();
+  if (v1->is_single() || v2->is_single()) {
+    const OpReturnType& tensor = v1->is_single() ? v2 : v1;
+    const OpReturnType& scalar = v1->is_single() ? v1 : v2;
+    if (tensor->is_integer() == scalar->is_integer()) {
+      return static_cast<DATATYPE>(tensor->get_dataType_enum());
+    }
+  }
+  return static_cast<DATATYPE>(get_max_dataType(dataType1, dataType2));
+}
+
+/**
+ * @brief Returns a pointer to the elements of an operand as type T
+ *
+ * Tensors that already hold T are returned without copying. Tensors of other data types are
+ * converted once into the scratch buffer, and single variables are written as one element.
+ */
+template <typename T>
+static const T* get_typed_buffer(const OpReturnType& v, std::vector<T>& scratch) {
+  if (v->is_single()) {
+    scratch.assign(1, v->get<T>());
+    return scratch.data();
+  }
+  if (v->get_dataType_enum() == get_dataType_enum<T>()) {
+    return static_cast<const T*>(v->get_raw_ptr());
+  }
+  auto convert = [&](auto typeObj) {
+    using S = decltype(typeObj);
+    const S* src = static_cast<const S*>(v->get_raw_ptr());
+    int numElements = v->get_numElements();
+    scratch.resize(numElements);
+    for (int i = 0; i < numElements; i++) {
+      scratch[i] = static_cast<T>(src[i]);
+    }
+  };
+  util::call_function_for_numeric_dataType(convert, static_cast<DATATYPE>(v->get_dataType_enum()));
+  return scratch.data();
+}
+
+static std::vector<int64_t> get_operand_shape(const OpReturnType& v) {
+  if (v->is_single()) {
+    return {};
+  }
+  return v->get_shape();
+}
+
+static std::string shape_to_string(const std::vector<int64_t>& shape) {
+  return util::recursive_string<int64_t>({(int64_t)shape.size()}, 0, shape.data(), 0,
+                                         shape.size());
+}
+
+/**
+ * @brief Computes the broadcasted shape of two operands following NumPy rules
+ *
+ * Shapes are aligned from the trailing dimension and each pair of dimensions should either be
+ * equal or one of them should be 1.
+ */
+static std::vector<int64_t> get_broadcast_shape(const std::vector<int64_t>& shape1,
+                                                const std::vector<int64_t>& shape2) {
+  int rank = std::max(shape1.size(), shape2.size());
+  std::vector<int64_t> outShape(rank, 1);
+  for (int i = 0; i < rank; i++) {
+    int64_t dim1 = i < shape1.size() ? shape1[shape1.size() - 1 - i] : 1;
+    int64_t dim2 = i < shape2.size() ? shape2[shape2.size() - 1 - i] : 1;
+    if (dim1 != dim2 && dim1 != 1 && dim2 != 1) {
+      THROW("operands could not be broadcast together with shapes %s and %s",
+            shape_to_string(shape1).c_str(), shape_to_string(shape2).c_str());
+    }
+    outShape[rank - 1 - i] = dim1 == 1 ? dim2 : dim1;
+  }
+  return outShape;
+}
+
+/**
+ * @brief Strides of an operand expressed in the coordinates of the broadcasted output
+ *
+ * Broadcasted dimensions get a stride of 0 so the same element is read repeatedly.
+ */
+static std::vector<int64_t> get_broadcast_strides(const std::vector<int64_t>& shape,
+                                                  const std::vector<int64_t>& outShape) {
+  int rank = outShape.size();
+  int offset = rank - shape.size();
+  std::vector<int64_t> strides(rank, 0);
+  int64_t stride = 1;
+  for (int i = shape.size() - 1; i >= 0; i--) {
+    strides[offset + i] = shape[i] == 1 ? 0 : stride;
+    stride *= shape[i];
+  }
+  return strides;
+}
+
+template <typename Op, typename T>
+static void run_kernel(const T* a, const std::vector<int64_t>& shape1, const T* b,
+                       const std::vector<int64_t>& shape2, T* out,
+                       const std::vector<int64_t>& outShape, int numElements) {
+  int numElements1 = 1, numElements2 = 1;
+  for (auto x : shape1) numElements1 *= x;
+  for (auto x : shape2) numElements2 *= x;
+
+  // Fast paths: equal sized contiguous buffers, or one side being a single element
+  if (numElements1 == numElements && numElements2 == numElements && shape1 == shape2) {
+    for (int i = 0; i < numElements; i++) {
+      out[i] = Op::apply(a[i], b[i]);
+    }
+    return;
+  }
+  if (numElements2 == 1) {
+    const T scalar = b[0];
+    for (int i = 0; i < numElements1; i++) {
+      out[i] = Op::apply(a[i], scalar);
+    }
+    return;
+  }
+  if (numElements1 == 1) {
+    const T scalar = a[0];
+    for (int i = 0; i < numElements2; i++) {
+      out[i] = Op::apply(scalar, b[i]);
+    }
+    return;
+  }
+
+  // General broadcast: walk the outer dimensions with a counter and run the innermost dimension
+  // as a tight loop with constant strides
+  int rank = outShape.size();
+  auto strides1 = get_broadcast_strides(shape1, outShape);
+  auto strides2 = get_broadcast_strides(shape2, outShape);
+  const int64_t innerSize = outShape[rank - 1];
+  const int64_t innerStride1 = strides1[rank - 1];
+  const int64_t innerStride2 = strides2[rank - 1];
+  std::vector<int64_t> counter(rank, 0);
+  int64_t offset1 = 0, offset2 = 0;
+  for (int outIndex = 0; outIndex < numElements; outIndex += innerSize) {
+    const T* aRow = a + offset1;
+    const T* bRow = b + offset2;
+    T* outRow = out + outIndex;
+    if (innerStride1 == 1 && innerStride2 == 1) {
+      for (int64_t i = 0; i < innerSize; i++) {
+        outRow[i] = Op::apply(aRow[i], bRow[i]);
+      }
+    } else if (innerStride1 == 1 && innerStride2 == 0) {
+      const T scalar = bRow[0];
+      for (int64_t i = 0; i < innerSize; i++) {
+        outRow[i] = Op::apply(aRow[i], scalar);
+      }
+    } else if (innerStride1 == 0 && innerStride2 == 1) {
+      const T scalar = aRow[0];
+      for (int64_t i = 0; i < innerSize; i++) {
+        outRow[i] = Op::apply(scalar, bRow[i]);
+      }
+    } else {
+      for (int64_t i = 0; i < innerSize; i++) {
+        outRow[i] = Op::apply(aRow[i * innerStride1], bRow[i * innerStride2]);
+      }
+    }
+
+    // Increment the counter over the outer dimensions and update the input offsets
+    for (int dim = rank - 2; dim >= 0; dim--) {
+      counter[dim]++;
+      offset1 += strides1[dim];
+      offset2 += strides2[dim];
+      if (counter[dim] < outShape[dim]) {
+        break;
+      }
+      offset1 -= strides1[dim] * counter[dim];
+      offset2 -= strides2[dim] * counter[dim];
+      counter[dim] = 0;
+    }
+  }
+}
+
+template <typename Op>
+static OpReturnType tensor_operate(const OpReturnType& val1, const OpReturnType& val2,
+                                   bool checkZeroDivisor) {
+  auto shape1 = get_operand_shape(val1);
+  auto shape2 = get_operand_shape(val2);
+  auto outShape = get_broadcast_shape(shape1, shape2);
+  int numElements = 1;
+  for (auto x : outShape) {
+    if (x < 0) {
+      THROW("dimension %ld is invalid for tensor operation", x);
+    }
+    numElements *= x;
+  }
+  DATATYPE returnType = get_result_dataType(val1, val2);
+
+  auto func = [&](auto typeObj) -> OpReturnType {
+    using T = decltype(typeObj);
+    std::vector<T> scratch1, scratch2;
+    const T* a = get_typed_buffer<T>(val1, scratch1);
+    const T* b = get_typed_buffer<T>(val2, scratch2);
+
+    if (checkZeroDivisor) {
+      int numElements2 = val2->is_single() ? 1 : val2->get_numElements();
+      for (int i = 0; i < numElements2; i++) {
+        if (b[i] == (T)0) {
+          THROW("%s", "Division by zero will result in undefined behaviour.");
+        }
+      }
+    }
+
+    T* out = static_cast<T*>(malloc(sizeof(T) * numElements));
+    // Zero sized dimensions broadcast to an empty result, there is nothing to compute
+    if (numElements > 0) {
+      run_kernel<Op, T>(a, shape1, b, shape2, out, outShape, numElements);
+    }
+    return std::make_shared<TensorVariable>(out, returnType, outShape, CreateTensorType::MOVE);
+  };
+  return util::call_function_for_numeric_dataType(func, returnType);
+}
+
+OpReturnType TensorBinOp::add(OpReturnType val1, OpReturnType val2) const {
+  return tensor_operate<TensorAddOp>(val1, val2, false);
+}
+
+OpReturnType TensorBinOp::sub(OpReturnType val1, OpReturnType val2) const {
+  return tensor_operate<TensorSubOp>(val1, val2, false);
+}
+
+OpReturnType TensorBinOp::mult(OpReturnType val1, OpReturnType val2) const {
+  return tensor_operate<TensorMultOp>(val1, val2, false);
+}
+
+OpReturnType TensorBinOp::div(OpReturnType val1, OpReturnType val2) const {
+  return tensor_operate<TensorDivOp>(val1, val2, true);
+}
+
+OpReturnType TensorBinOp::pow(OpReturnType val1, OpReturnType val2) const {
+  return tensor_operate<TensorPowOp>(val1, val2, false);
+}
+
+OpReturnType TensorBinOp::mod(OpReturnType val1, OpReturnType val2) const {
+  return tensor_operate<TensorModOp>(val1, val2, true);
+}
@@ -0,0 +1,170 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "variable_scope.hpp"
+
+class ASTNode;
+class Statement;
+
+/**
+ * @file bytecode.hpp
+ * @brief Linear register bytecode for DelitePy function bodies
+ *
+ * Function bodies are lowered once, when the FunctionDef is parsed, into a flat array of
+ * instructions operating on a per call register file. Registers only hold temporaries, variables
+ * still live in the StackFrame of the function so that closures, imports and concurrent functions
+ * observe the same state as with the tree walker. Statements and expressions that have no lowering
+ * are kept as a single instruction that evaluates the original AST node, so every script can be
+ * compiled.
+ */
+
+// clang-format off
+#define BYTECODE_OPCODES(X)                                                                          \
+  X(LOAD_CONST)   /* regs[dst] = constants[a]                                                     */ \
+  X(LOAD_VAR)     /* regs[dst] = stack variable at locations[a]                                   */ \
+  X(STORE_VAR)    /* stack variable at locations[b] = regs[a]                                     */ \
+  X(STORE_NODE)   /* node->set_variable(regs[a])                                                  */ \
+  X(EVAL_NODE)    /* regs[dst] = node->get_value()                                                */ \
+  X(EXEC_STMT)    /* statement->execute(), b = break target, c = continue target                  */ \
+  X(BINARY)       /* regs[dst] = regs[a] <op> regs[b], op taken from the BinNode                  */ \
+  X(UNARY)        /* regs[dst] = <op> regs[a], op taken from the UnaryNode                        */ \
+  X(COMPARE)      /* regs[dst] = regs[a] <cmp> regs[b], cmp taken from the CompareNode            */ \
+  X(GET_MEMBER)   /* regs[dst] = regs[a].member(b)                                                */ \
+  X(SUBSCRIPT)    /* regs[dst] = regs[a][regs[b]]                                                 */ \
+  X(CALL)         /* regs[dst] = regs[dst](regs[a], ..., regs[a + b - 1])                         */ \
+  X(CALL_MEMBER)  /* regs[dst] = regs[dst].member(regs[a], ..., regs[a + b - 1]), AttributeNode   */ \
+  X(BUILD_LIST)   /* regs[dst] = [regs[a], ..., regs[a + b - 1]]                                  */ \
+  X(BUILD_TUPLE)  /* regs[dst] = (regs[a], ..., regs[a + b - 1])                                  */ \
+  X(BUILD_DICT)   /* regs[dst] = {regs[a + i]: regs[a + b + i]}                                   */ \
+  X(CLEAR)        /* regs[a] = nullptr                                                            */ \
+  X(JUMP)         /* pc = b                                                                       */ \
+  X(JUMP_IF_FALSE)/* if not regs[a]: pc = b                                                       */ \
+  X(FOR_INIT)     /* counters[c] = 0                                                              */ \
+  X(FOR_NEXT)     /* if counters[c] < len(regs[a]): regs[dst] = regs[a][counters[c]++] else pc = b*/ \
+  X(RETURN)       /* return regs[a]                                                               */ \
+  X(RETURN_NONE)  /* return None                                                                  */
+// clang-format on
+
+enum class BytecodeOp : uint8_t {
+#define BYTECODE_OPCODE_ENUM(name) name,
+  BYTECODE_OPCODES(BYTECODE_OPCODE_ENUM)
+#undef BYTECODE_OPCODE_ENUM
+};
+
+/**
+ * @brief A single bytecode instruction
+ *
+ * Operand meaning depends on the opcode, see BYTECODE_OPCODES. Instructions that reuse the logic
+ * of an AST node (operators, fallbacks) keep a non owning pointer to it.
+ */
+struct BytecodeInstruction {
+  BytecodeOp op;
+  int32_t dst = 0;
+  int32_t a = 0;
+  int32_t b = 0;
+  int32_t c = 0;
+  int32_t lineIndex = 0; /**< Index into the line chains, used to build error messages */
+  ASTNode* node = nullptr;
+  Statement* statement = nullptr;
+};
+
+/**
+ * @brief Compiled body of a single FunctionDef
+ *
+ * Immutable once compiled, so it can be executed concurrently from multiple threads. Each call
+ * gets its own register file.
+ */
+class BytecodeFunction {
+  friend class BytecodeCompiler;
+
+  std::vector<BytecodeInstruction> _code;
+  std::vector<OpReturnType> _constants;
+  std::vector<StackLocation> _locations;
+  std::vector<std::string> _locationNames; /**< Variable names, for the unassigned variable error */
+  // Line numbers of the nested statements an instruction belongs to, outermost first. Errors are
+  // prefixed with them to match the messages produced by execute_codelines.
+  std::vector<std::vector<int>> _lineChains;
+  int _numRegisters = 0;
+  int _numCounters = 0;
+
+  std::string get_error_message(const BytecodeInstruction& instruction, const char* error) const;
+
+ public:
+  /**
+   * @brief Runs the function body on the current stack frame
+   *
+   * @return Value of the executed return statement or nullptr if the body ended without one.
+   */
+  OpReturnType execute(CallStack& stack) const;
+
+  int num_instructions() const { return _code.size(); }
+};
+
+/**
+ * @brief Lowers statements and AST nodes into a BytecodeFunction
+ *
+ * Statement::compile and ASTNode::compile call back into the compiler to emit instructions.
+ * Registers are allocated like a stack: an expression writes its result into the register given
+ * by its parent and allocates temporaries above it, temporaries are released after each
+ * statement.
+ */
+class BytecodeCompiler {
+  struct Loop {
+    int continueTarget = 0;
+    std::vector<int> breakJumps; /**< Jumps to be patched with the loop exit */
+  };
+
+  std::unique_ptr<BytecodeFunction> _function;
+  std::vector<Loop> _loops;
+  std::vector<int> _lineStack;
+  std::map<std::vector<int>, int> _lineChainIndices;
+  int _currentLineIndex = 0;
+  int _nextRegister = 0;
+
+  BytecodeCompiler();
+
+ public:
+  static std::unique_ptr<BytecodeFunction> compile(const std::vector<Statement*>& statements);
+
+  void compile_statements(const std::vector<Statement*>& statements);
+
+  int allocate_registers(int count = 1);
+
+  int add_constant(OpReturnType constant);
+
+  int add_location(StackLocation location, const std::string& name);
+
+  int emit(BytecodeOp op, int dst = 0, int a = 0, int b = 0, int c = 0);
+
+  int emit_node(BytecodeOp op, ASTNode* node, int dst = 0, int a = 0, int b = 0);
+
+  // Fallback that evaluates the node with the tree walker
+  void emit_eval(ASTNode* node, int dst) { emit_node(BytecodeOp::EVAL_NODE, node, dst); }
+
+  // Fallback that executes the statement with the tree walker
+  void emit_execute(Statement* statement);
+
+  int current_offset() const { return _function->_code.size(); }
+
+  // Jump targets are always kept in the b operand
+  void set_jump_target(int instructionIndex, int target) {
+    _function->_code[instructionIndex].b = target;
+  }
+
+  void begin_loop(int continueTarget);
+  void end_loop(int breakTarget);
+  void emit_break();
+  void emit_continue();
+  int allocate_counter() { return _function->_numCounters++; }
+};
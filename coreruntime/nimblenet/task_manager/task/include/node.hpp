@@ -18,6 +18,8 @@
 #include "unary_operators.hpp"
 #include "variable_scope.hpp"
 
+class BytecodeCompiler;
+
 /**
  * @brief Base class for all Abstract Syntax Tree nodes
  *
@@ -45,6 +47,28 @@ class ASTNode {
     THROW("%s", "Cannot call variable");
   }
 
+  /**
+   * @brief Emits bytecode that evaluates this node into register dst
+   *
+   * Nodes without a lowering emit a single instruction evaluating them with get_value.
+   */
+  virtual void compile(BytecodeCompiler& compiler, int dst);
+
+  /**
+   * @brief Emits bytecode that assigns the value in register src to this node
+   */
+  virtual void compile_store(BytecodeCompiler& compiler, int src);
+
+  /**
+   * @brief Emits bytecode that calls this node with the arguments and writes the result into dst
+   *
+   * @return false if the call cannot be lowered, in which case nothing is emitted.
+   */
+  virtual bool compile_call(BytecodeCompiler& compiler, const std::vector<ASTNode*>& arguments,
+                            int dst) {
+    return false;
+  }
+
   OpReturnType get(CallStack& stack) {
     try {
       auto ret = get_value(stack);
@@ -92,6 +116,8 @@ class ConstantNode : public ASTNode {
   ConstantNode(VariableScope* scope, const json& constJson);
 
   OpReturnType get_value(CallStack&) override { return _d; }
+
+  void compile(BytecodeCompiler& compiler, int dst) override;
 };
 
 class BinNode : public ASTNode {
@@ -103,6 +129,10 @@ class BinNode : public ASTNode {
  public:
   BinNode(VariableScope* scope, const json& binOpJson);
   OpReturnType get_value(CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int dst) override;
+
+  // Applies the operator to already evaluated operands
+  OpReturnType operate(const OpReturnType& d1, const OpReturnType& d2);
 
   virtual ~BinNode() {
     delete _left;
@@ -119,6 +149,10 @@ class UnaryNode : public ASTNode {
  public:
   UnaryNode(VariableScope* scope, const json& unaryOpJson);
   OpReturnType get_value(CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int dst) override;
+
+  // Applies the operator to an already evaluated operand
+  OpReturnType operate(const OpReturnType& d);
 
   virtual ~UnaryNode() { delete _operand; }
 };
@@ -133,6 +167,10 @@ class CompareNode : public ASTNode {
  public:
   CompareNode(VariableScope* scope, const json& compareOpJson);
   OpReturnType get_value(CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int dst) override;
+
+  // Applies the comparison at index to already evaluated operands
+  OpReturnType compare(int index, const OpReturnType& d1, const OpReturnType& d2);
 
   virtual ~CompareNode() {
     delete _left;
@@ -165,6 +203,7 @@ class CallNode : public ASTNode {
  public:
   CallNode(VariableScope* scope, const json& callFuncJson);
   OpReturnType get_value(CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int dst) override;
 
   virtual ~CallNode() {
     for (auto arg : _arguments) {
@@ -179,8 +218,8 @@ class ListNode : public ASTNode {
 
  public:
   ListNode(VariableScope* scope, const json& listNodeJson) : ASTNode(scope, listNodeJson) {
-    auto jsonArray = listNodeJson.at("elts");
-    for (auto itemJson : jsonArray) {
+    const auto& jsonArray = listNodeJson.at("elts");
+    for (const auto& itemJson : jsonArray) {
       _membersInList.push_back(create_node(scope, itemJson));
     }
   }
@@ -193,6 +232,8 @@ class ListNode : public ASTNode {
     return OpReturnType(new ListDataVariable(std::move(membersOfList)));
   }
 
+  void compile(BytecodeCompiler& compiler, int dst) override;
+
   virtual ~ListNode() {
     for (auto mem : _membersInList) {
       delete mem;
@@ -206,12 +247,12 @@ class TupleNode : public ASTNode {
 
  public:
   TupleNode(VariableScope* scope, const json& tupleNodeJson) : ASTNode(scope, tupleNodeJson) {
-    auto jsonArray = tupleNodeJson.at("elts");
+    const auto& jsonArray = tupleNodeJson.at("elts");
     std::string type = tupleNodeJson.at("ctx").at("_type");
     if (type == "Store") {
       _store = true;
     }
-    for (auto itemJson : jsonArray) {
+    for (const auto& itemJson : jsonArray) {
       _membersInTuple.push_back(create_node(scope, itemJson));
     }
   }
@@ -244,6 +285,8 @@ class TupleNode : public ASTNode {
     return ret;
   }
 
+  void compile(BytecodeCompiler& compiler, int dst) override;
+
   virtual ~TupleNode() {
     for (auto mem : _membersInTuple) {
       delete mem;
@@ -275,6 +318,10 @@ class NameNode : public ASTNode {
 
   OpReturnType get_value(CallStack& stack) override;
   OpReturnType call(const std::vector<OpReturnType>& args, CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int dst) override;
+  void compile_store(BytecodeCompiler& compiler, int src) override;
+  bool compile_call(BytecodeCompiler& compiler, const std::vector<ASTNode*>& arguments,
+                    int dst) override;
 };
 
 /**
@@ -288,6 +335,8 @@ class AttributeNode : public ASTNode {
   int _memberIndex = -1;  /**< Index of the member/attribute in the object */
   // this mainNode is the variable whose attribute is called or accessed.
   ASTNode* _mainNode = nullptr;  /**< The object whose attribute is being accessed */
+  /** Whether the function containing the node writes shared state, see VariableScope */
+  std::shared_ptr<std::atomic<bool>> _functionWritesSharedState;
 
  public:
   AttributeNode(VariableScope* scope, const json& nameOpJson);
@@ -306,6 +355,20 @@ class AttributeNode : public ASTNode {
 
   OpReturnType call(const std::vector<OpReturnType>& args, CallStack& stack) override;
 
+  /**
+   * @brief Calls the member function on the object, shared by the tree walker and the bytecode
+   *
+   * Calling a member that modifies its object records that the function containing the node writes
+   * shared state, so that it holds the script lock exclusively from its next call. A call holding
+   * the lock in shared mode holds it exclusively from here on.
+   */
+  OpReturnType call_member(const OpReturnType& object, const std::vector<OpReturnType>& args,
+                           CallStack& stack);
+
+  void compile(BytecodeCompiler& compiler, int dst) override;
+  bool compile_call(BytecodeCompiler& compiler, const std::vector<ASTNode*>& arguments,
+                    int dst) override;
+
   ~AttributeNode() { delete _mainNode; }
 };
 
@@ -360,9 +423,10 @@ class SubscriptNode : public ASTNode {
     std::string type = subOpJson.at("ctx").at("_type");
     if (type == "Store") {
       _store = true;
+      scope->mark_shared_state_written();
     }
-    auto sliceJson = subOpJson.at("slice");
-    auto valueJson = subOpJson.at("value");
+    const auto& sliceJson = subOpJson.at("slice");
+    const auto& valueJson = subOpJson.at("value");
     // Check if this is a slice operation
     if (sliceJson.contains("_type") && sliceJson.at("_type") == "Slice") {
       _sliceNode = new SliceNode(scope, sliceJson);
@@ -382,7 +446,13 @@ class SubscriptNode : public ASTNode {
   OpReturnType get_value(CallStack& stack) override {
     auto subscript = _sliceNode->get(stack);
     auto mainData = _mainNode->get(stack);
+    return this->subscript(mainData, subscript);
+  }
+
+  void compile(BytecodeCompiler& compiler, int dst) override;
 
+  // Indexes an already evaluated value with an already evaluated subscript
+  OpReturnType subscript(const OpReturnType& mainData, const OpReturnType& subscript) {
     if (subscript->get_containerType() == CONTAINERTYPE::SLICE) {
       if (mainData->get_containerType() == CONTAINERTYPE::LIST) {
         return mainData->get_subscript(subscript);
@@ -413,12 +483,12 @@ class DictNode : public ASTNode {
 
  public:
   DictNode(VariableScope* scope, const json& dictNodeJson) : ASTNode(scope, dictNodeJson) {
-    auto keysJsonArray = dictNodeJson.at("keys");
-    auto valuesJsonArray = dictNodeJson.at("values");
-    for (auto keyJson : keysJsonArray) {
+    const auto& keysJsonArray = dictNodeJson.at("keys");
+    const auto& valuesJsonArray = dictNodeJson.at("values");
+    for (const auto& keyJson : keysJsonArray) {
       _keyNodes.push_back(create_node(scope, keyJson));
     }
-    for (auto valueJson : valuesJsonArray) {
+    for (const auto& valueJson : valuesJsonArray) {
       _valueNodes.push_back(create_node(scope, valueJson));
     }
     if (_keyNodes.size() != _valueNodes.size()) {
@@ -429,6 +499,7 @@ class DictNode : public ASTNode {
   ~DictNode() override;
 
   OpReturnType get_value(CallStack& stack) override;
+  void compile(BytecodeCompiler& compiler, int dst) override;
 };
 
 /**
@@ -457,7 +528,7 @@ class SingleGeneratorNode : public ASTNode {
     // Parse the iterable and configure the generator
     _iterableNode = create_node(generatorScope, genJson.at("iter"));
     // Get target (which could be a name or tuple)
-    auto targetJson = genJson.at("target");
+    const auto& targetJson = genJson.at("target");
     std::string targetType = targetJson.at("_type");
 
     if (targetType == "Name") {
@@ -590,10 +661,12 @@ class ComprehensionNode : public ASTNode {
   // Constructor that handles all generators in the chain
   ComprehensionNode(VariableScope* scope, const json& comprehensionJson)
       : ASTNode(scope, comprehensionJson) {
+    // Iteration state is kept in the generator nodes, which every call of the function shares
+    scope->mark_shared_state_written();
     auto generatorScope = scope;
 
     // Extract generators from the comprehension JSON
-    auto generatorsJson = comprehensionJson.at("generators");
+    const auto& generatorsJson = comprehensionJson.at("generators");
 
     // Create a scope for the generator's variables
     for (const auto& generatorJson : generatorsJson) {
@@ -643,7 +716,7 @@ class ListComprehensionNode : public ComprehensionNode {
   ListComprehensionNode(VariableScope* scope, const json& comprehensionJson)
       : ComprehensionNode(scope, comprehensionJson) {
     // Extract the element expression (result expression)
-    auto eltJson = comprehensionJson.at("elt");
+    const auto& eltJson = comprehensionJson.at("elt");
     _elementNode = create_element_node(eltJson);
   }
 
@@ -677,9 +750,9 @@ class DictComprehensionNode : public ComprehensionNode {
   DictComprehensionNode(VariableScope* scope, const json& dictCompJson)
       : ComprehensionNode(scope, dictCompJson) {
     // Extract the key and value expressions
-    auto keyJson = dictCompJson.at("key");
+    const auto& keyJson = dictCompJson.at("key");
     _keyNode = create_element_node(keyJson);
-    auto valueJson = dictCompJson.at("value");
+    const auto& valueJson = dictCompJson.at("value");
     _valueNode = create_element_node(valueJson);
   }
 
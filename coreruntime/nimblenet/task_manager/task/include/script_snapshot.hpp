@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+/**
+ * @brief Compact binary form of the AST of a script, decoded one module at a time.
+ *
+ * The snapshot holds a header, a pool of every distinct string of the AST (node types, keys,
+ * identifiers and string constants), a table of the modules and then the tree of each module.
+ * A value of a tree is a ValueType byte followed by its payload: integers as varints, floats as 8
+ * bytes, strings as varint indices in the pool, arrays and objects as their number of elements
+ * followed by the elements, each key of an object being an index in the pool. Source positions
+ * other than lineno are dropped, they are never read when building the modules.
+ *
+ * Building a module from a snapshot still goes through nlohmann::json, but skips tokenizing and
+ * unescaping the text of the AST and only decodes the modules that are imported. The header holds
+ * a hash of the script the snapshot was created from, a snapshot saved on disk is only used for
+ * the same script.
+ */
+class ScriptSnapshot {
+  std::string _data;                      /**< Header, string pool, module table and trees. */
+  std::vector<std::string_view> _strings; /**< String pool, pointing into _data. */
+  /** Offset and size in _data of the tree of each module. */
+  std::unordered_map<std::string_view, std::pair<std::size_t, std::size_t>> _modules;
+  uint64_t _sourceHash = 0; /**< Hash of the script the snapshot was created from. */
+
+  ScriptSnapshot() = default;
+
+  /**
+   * @brief Reads the string pool and module table of _data and checks every tree.
+   *
+   * @return false if _data is not a snapshot of the current version or is corrupted.
+   */
+  bool index();
+
+ public:
+  /**
+   * @brief Suffix added to the file name of a script asset to get the file of its snapshot.
+   */
+  static inline const std::string FileSuffix = ".snapshot";
+
+  /**
+   * @brief Name of the module run when the script is loaded.
+   */
+  static inline const std::string MainModule = "main";
+
+  /**
+   * @brief 64 bit FNV-1a hash of the text of a script.
+   */
+  static uint64_t hash(std::string_view source) noexcept;
+
+  /**
+   * @brief Creates the snapshot of an AST.
+   *
+   * @param ast AST of a script, either a single module or an object of modules with a main module.
+   * @param sourceHash Hash of the text the AST was parsed from, 0 if it is not saved.
+   */
+  static std::unique_ptr<ScriptSnapshot> create(const nlohmann::json& ast,
+                                                uint64_t sourceHash = 0);
+
+  /**
+   * @brief Loads the snapshot saved in a file.
+   *
+   * @return nullptr if the file does not exist, was saved for another script or by another
+   * version of the SDK, or is corrupted.
+   */
+  static std::unique_ptr<ScriptSnapshot> load(const std::string& filePath, uint64_t sourceHash);
+
+  /**
+   * @brief Saves the snapshot to a file, written next to it and renamed over it.
+   *
+   * @return false if the file could not be written.
+   */
+  bool save(const std::string& filePath) const;
+
+  bool has_module(const std::string& name) const { return _modules.count(name) > 0; }
+
+  /**
+   * @brief Decodes the AST of a module, THROWs if the module does not exist.
+   */
+  nlohmann::json get_module(const std::string& name) const;
+
+  uint64_t source_hash() const noexcept { return _sourceHash; }
+
+  std::size_t size() const noexcept { return _data.size(); }
+};
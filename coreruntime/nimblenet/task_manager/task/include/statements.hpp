@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "bytecode.hpp"
 #include "data_variable.hpp"
 #include "json.hpp"
 #include "nimble_net_data_variable.hpp"
@@ -62,6 +63,13 @@ class Statement {
   int get_line() { return _lineNo; }
 
   virtual StatRetType* execute(CallStack& stack) = 0;
+
+  /**
+   * @brief Emits the bytecode of this statement
+   *
+   * Statements without a lowering emit a single instruction that runs execute.
+   */
+  virtual void compile(BytecodeCompiler& compiler);
 };
 
 /*
@@ -80,6 +88,8 @@ class AssignStatement : public Statement {
 
   StatRetType* execute(CallStack& stack) override;
 
+  void compile(BytecodeCompiler& compiler) override;
+
   virtual ~AssignStatement();
 };
 
@@ -98,6 +108,8 @@ class ExprStatement : public Statement {
 
   StatRetType* execute(CallStack& stack) override;
 
+  void compile(BytecodeCompiler& compiler) override;
+
   virtual ~ExprStatement();
 };
 
@@ -116,6 +128,8 @@ class ReturnStatement : public Statement {
 
   StatRetType* execute(CallStack& stack) override;
 
+  void compile(BytecodeCompiler& compiler) override;
+
   virtual ~ReturnStatement();
 };
 
@@ -124,6 +138,8 @@ class BreakStatement : public Statement {
   BreakStatement(VariableScope* scope, const json& line) : Statement(line) {}
 
   StatRetType* execute(CallStack& stack) override { return StatRetType::create_break(); };
+
+  void compile(BytecodeCompiler& compiler) override { compiler.emit_break(); }
 };
 
 class ContinueStatement : public Statement {
@@ -131,6 +147,8 @@ class ContinueStatement : public Statement {
   ContinueStatement(VariableScope* scope, const json& line) : Statement(line) {}
 
   StatRetType* execute(CallStack& stack) override { return StatRetType::create_continue(); };
+
+  void compile(BytecodeCompiler& compiler) override { compiler.emit_continue(); }
 };
 
 class Body {
@@ -141,6 +159,8 @@ class Body {
 
   StatRetType* execute(CallStack& stack);
 
+  const std::vector<Statement*>& get_statements() const { return _codeLines; }
+
   ~Body() {
     for (auto line : _codeLines) {
       delete line;
@@ -160,6 +180,11 @@ class FunctionDef : public Statement, public std::enable_shared_from_this<Functi
   int _index;        /**< Unique index assigned to each function in the Task */
   Body* _body = nullptr;  /**< The function's body containing all statements */
   bool _static = false;   /**< Whether this function is static */
+  bool _scriptConcurrency = false;  /**< Whether the scriptConcurrency config is enabled */
+  /** Whether this function writes state shared between its calls, see VariableScope */
+  std::shared_ptr<std::atomic<bool>> _writesSharedState;
+  /** Set once a call ended without writing shared state, calls are exclusive until then */
+  std::atomic<bool> _readOnlyCallCompleted{false};
   std::string _functionName;  /**< Name of the function */
   std::vector<StackLocation> _argumentLocations;  /**< Stack locations of function arguments */
   std::shared_ptr<int> _numVariablesStack;  /**< Shared counter for variables in function's stack frame */
@@ -167,6 +192,7 @@ class FunctionDef : public Statement, public std::enable_shared_from_this<Functi
   StackLocation _functionLocation = StackLocation::null;  /**< Location of the function in the stack */
   // ^This is  maintained by VariableScope, we just use it here on execution
   StackLocation _stackLocation{StackLocation::null};  /**< Stack location for the function itself */
+  std::unique_ptr<BytecodeFunction> _bytecode;  /**< Compiled body, null when running on the tree walker */
 
   void set_static() { _static = true; }
 
@@ -186,6 +212,25 @@ class FunctionDef : public Statement, public std::enable_shared_from_this<Functi
 
   bool is_static() const { return _static; }
 
+  // Functions decorated with concurrent run without the script lock. With scriptConcurrency,
+  // functions only reading the script state hold it in shared mode and run concurrently with each
+  // other, functions writing it hold it exclusively. Writes through member functions are only found
+  // while running, so a function holds it exclusively until one of its calls ended without any.
+  // Otherwise every function holds it exclusively.
+  ScriptLock::Mode script_lock_mode() const {
+    if (_static) {
+      return ScriptLock::Mode::NONE;
+    }
+    if (_scriptConcurrency && _readOnlyCallCompleted.load(std::memory_order_relaxed) &&
+        !_writesSharedState->load(std::memory_order_relaxed)) {
+      return ScriptLock::Mode::SHARED;
+    }
+    return ScriptLock::Mode::EXCLUSIVE;
+  }
+
+  // Whether frames captured by the function can be accessed by several threads at once
+  bool can_run_concurrently() const { return _static || _scriptConcurrency; }
+
   virtual ~FunctionDef() { delete _body; }
 };
 
@@ -230,12 +275,20 @@ class FunctionDataVariable final : public DataVariable {
 
   nlohmann::json to_json() const override { return "[Function]"; }
 
-  void set_static() { _def->set_static(); }
+  void set_static() {
+    // Captured frames are now reachable from threads running without the script lock
+    _stack.mark_frames_shared();
+    _def->set_static();
+  }
+
   friend class CustomFunctions;
 
  public:
   FunctionDataVariable(CallStack& stack, std::shared_ptr<FunctionDef> def) : _stack(stack) {
     _def = def;
+    if (_def->can_run_concurrently()) {
+      _stack.mark_frames_shared();
+    }
   }
 
   OpReturnType execute_function(const std::vector<OpReturnType>& arguments,
@@ -270,12 +323,12 @@ class ImportStatement : public Statement {
 
  public:
   ImportStatement(VariableScope* scope, const json& line) : Statement(line) {
-    auto module = line.at("module");
-    auto nameJsonArray = line.at("names");
-    for (auto nameJson : nameJsonArray) {
+    const auto& module = line.at("module");
+    const auto& nameJsonArray = line.at("names");
+    for (const auto& nameJson : nameJsonArray) {
       std::string importName = nameJson.at("name");
       std::string varName = importName;
-      auto aliasName = nameJson.at("asname");
+      const auto& aliasName = nameJson.at("asname");
       if (aliasName.type() != json::value_t::null) {
         varName = aliasName;
       }
@@ -297,6 +350,8 @@ class ForStatement : public Statement {
 
   StatRetType* execute(CallStack& stack) override;
 
+  void compile(BytecodeCompiler& compiler) override;
+
   virtual ~ForStatement();
 };
 
@@ -309,6 +364,8 @@ class WhileStatement : public Statement {
 
   StatRetType* execute(CallStack& stack) override;
 
+  void compile(BytecodeCompiler& compiler) override;
+
   virtual ~WhileStatement();
 };
 
@@ -322,6 +379,8 @@ class IfStatement : public Statement {
 
   StatRetType* execute(CallStack& stack) override;
 
+  void compile(BytecodeCompiler& compiler) override;
+
   virtual ~IfStatement();
 };
 
@@ -437,6 +496,9 @@ class ClassDataVariable final : public DataVariable {
   OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
                              CallStack& stack) override;
 
+  // Members are script functions, which take the script lock according to what they write
+  bool is_mutating_member(int memberFuncIndex) const override { return false; }
+
   std::string print() override { return fallback_print(); }
 
   OpReturnType get_member(int memberIndex) override;
@@ -470,6 +532,9 @@ class ObjectDataVariable final : public DataVariable {
   OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
                              CallStack& stack) override;
 
+  // Members are script functions, which take the script lock according to what they write
+  bool is_mutating_member(int memberFuncIndex) const override { return false; }
+
   std::string print() override { return fallback_print(); }
 
   OpReturnType get_member(int memberIndex) override;
@@ -511,13 +576,13 @@ class RuntimeFunctionDef : public Statement {
   static RuntimeFunctionDef* create_class_member_function_def(VariableScope* classVariablesScope,
                                                               VariableScope* functionCreationScope,
                                                               const json& line) {
-    auto funcName = line.at("name");
+    const auto& funcName = line.at("name");
     auto location = classVariablesScope->add_variable(funcName);
     return new RuntimeFunctionDef(functionCreationScope, line, std::move(location));
   }
 
   static RuntimeFunctionDef* create_normal_function_def(VariableScope* scope, const json& line) {
-    auto funcName = line.at("name");
+    const auto& funcName = line.at("name");
     auto location = scope->add_variable(funcName);
     return new RuntimeFunctionDef(scope, line, std::move(location));
   }
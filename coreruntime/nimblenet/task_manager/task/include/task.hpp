@@ -11,6 +11,7 @@
 // #include <shared_lock>
 #include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <thread>
@@ -20,7 +21,8 @@
 #include "dp_module.hpp"
 #include "job.hpp"
 #include "json.hpp"
-#include "rigtorp/SPSCQueue.h"
+#include "script_snapshot.hpp"
+#include "token_queue.hpp"
 #include "variable_scope.hpp"
 
 class CharStream;
@@ -37,20 +39,31 @@ class FutureDataVariable;
  *
  * This job is responsible for populating character streams with data
  * from an internal queue, typically used for streaming operations.
+ * Every run pushes the tokens produced since the previous run to the stream at once, so
+ * subscribers of the stream are notified once per batch of tokens.
  */
 class FillCharStreamJob : public Job<void> {
-  using Queue = rigtorp::SPSCQueue<char>;
-  std::weak_ptr<CharStream> _charStream;  /**< Weak reference to the target character stream */
-  std::shared_ptr<Queue> _internalQueue;  /**< Internal queue containing data to stream */
+  std::weak_ptr<CharStream> _charStream;      /**< Weak reference to the target character stream */
+  std::shared_ptr<TokenQueue> _internalQueue; /**< Internal queue containing data to stream */
 
  public:
-  FillCharStreamJob(std::weak_ptr<CharStream> charStream, std::shared_ptr<Queue> queue)
+  FillCharStreamJob(std::weak_ptr<CharStream> charStream, std::shared_ptr<TokenQueue> queue)
       : Job("FillCharStreamJob") {
     _charStream = charStream;
     _internalQueue = queue;
   }
 
   Job::Status process() override;
+
+  /**
+   * @brief Waits until the producer has pushed output or closed the queue, or the job is stopped.
+   */
+  void wait_for_output() { _internalQueue->wait_for_output(); }
+
+  /**
+   * @brief Stops waiting for output, the producer's further output is dropped.
+   */
+  void stop() { _internalQueue->detach(); }
 };
 
 /**
@@ -70,15 +83,15 @@ class Task {
   std::vector<std::weak_ptr<CharStream>> _charStreams;  /**< Active character streams for streaming operations */
 
  private:
-  static inline const std::string MAIN_MODULE = "main";
-
   CommandCenter* _commandCenter = nullptr;  /**< Reference to the command center for system access */
   std::string _version;                     /**< Version identifier for this task */
   std::vector<std::weak_ptr<FutureDataVariable>> _pendingFutures;  /**< Pending future variables awaiting completion */
+  std::mutex _pendingFuturesMutex;  /**< Guards _pendingFutures, futures can be saved by functions running without the script lock */
 
-  json _astJson;  /**< Abstract Syntax Tree representation of the task */
+  std::unique_ptr<ScriptSnapshot> _snapshot;  /**< Abstract Syntax Tree of the task, decoded per module */
   std::unique_ptr<DpModule> _mainModule;  /**< The main module containing the entry point */
   std::unordered_map<std::string, std::shared_ptr<DpModule>> _modules;  /**< All modules in this task */
+  mutable std::recursive_mutex _modulesMutex;  /**< Guards _modules, loading a module can import other modules */
 
   std::shared_mutex _taskMutex;  /**< Mutex for thread-safe task operations */
 #ifdef GENAI
@@ -86,7 +99,7 @@ class Task {
   std::condition_variable _streamPushThreadCondition;  /**< Condition variable for stream push thread synchronization */
   std::thread _streamPushThread;  /**< Background thread for stream push operations */
   std::atomic<bool> _threadCleanupInitiated = false;  /**< Flag indicating thread cleanup has started */
-  std::shared_ptr<BaseJob> _streamPushJob;  /**< Job for stream push operations */
+  std::shared_ptr<FillCharStreamJob> _streamPushJob;  /**< Job for stream push operations */
 #endif
   CallStack _callStack;  /**< Call stack for function execution */
 
@@ -116,9 +129,7 @@ class Task {
   // caller must ensure that the module exists using has_module method
   std::shared_ptr<DpModule> get_module(const std::string& name, CallStack& stack);
 
-  std::unique_lock<std::shared_mutex> get_script_deferred_lock() {
-    return std::unique_lock<std::shared_mutex>(_taskMutex, std::defer_lock);
-  }
+  ScriptLock get_script_deferred_lock() { return ScriptLock(_taskMutex); }
 
   void save_future(std::shared_ptr<FutureDataVariable> futureVal);
   bool is_ready() noexcept;
@@ -129,13 +140,16 @@ class Task {
     return std::unique_lock<std::mutex>(_streamPushMutex);
   }
 
-  void add_stream_push_job(std::shared_ptr<BaseJob> job);
+  void add_stream_push_job(std::shared_ptr<FillCharStreamJob> job);
 
   void run_background_jobs_until_condition(std::function<bool()>&& condition,
                                            std::unique_lock<std::mutex>& streamPushLock);
 
   void add_char_stream(std::weak_ptr<CharStream> charStream);
 
-  void wait_until_stream_push_job_is_created();
+  /**
+   * @brief Waits until a stream push job is added, returns nullptr if the task is being destroyed.
+   */
+  std::shared_ptr<FillCharStreamJob> wait_until_stream_push_job_is_created();
 #endif  // GENAI
 };
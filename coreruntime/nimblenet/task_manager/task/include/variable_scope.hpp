@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <shared_mutex>
 
 #include "data_variable.hpp"
@@ -60,55 +62,156 @@ class CallStack;
  *
  * Each stack frame contains the local variables for a function call,
  * along with metadata about the module and function being executed.
- * Thread-safe access to variable values is provided through mutex protection.
+ * A frame is normally only touched by the thread running its function, so variable slots are a
+ * plain array read and written without synchronization. Frames captured by a concurrent function
+ * can be accessed from several threads at once and are switched to atomic slot access with
+ * mark_shared().
  */
 class StackFrame {
   using StackFramePtr = std::shared_ptr<StackFrame>;
 
-  std::vector<OpReturnType> _varValues;  /**< Storage for variable values in this frame */
-  // StackFramePtr _parentFrame;
+  std::unique_ptr<OpReturnType[]> _varValues;  /**< Storage for variable values in this frame */
+  int _numVariables = 0;  /**< Number of variables used by the current function */
+  int _capacity = 0;      /**< Number of allocated slots, kept when the frame is reused */
   int _moduleIndex;    /**< Index of the module this frame belongs to */
   int _functionIndex;  /**< Index of the function this frame represents */
-  std::mutex mutex;    /**< Mutex for thread-safe access to variable values */
+  std::atomic<bool> _shared{false};  /**< Whether the frame can be accessed by multiple threads */
+
+  friend class CallStack;
+
+  // Prepares a pooled frame for a new call, slots must already be cleared
+  void reset(int moduleIndex, int functionIndex, int numVariables);
+
+  // Drops the variable values so that the frame can be pooled
+  void clear();
 
  public:
   int get_module_index() const { return _moduleIndex; }
 
   int get_function_index() const { return _functionIndex; }
 
-  StackFrame(int moduleIndex, int functionIndex, int numVariables)
-      : _moduleIndex(moduleIndex), _functionIndex(functionIndex), _varValues(numVariables) {}
+  StackFrame(int moduleIndex, int functionIndex, int numVariables) {
+    reset(moduleIndex, functionIndex, numVariables);
+  }
+
+  StackFrame(const StackFrame&) = delete;
+  StackFrame& operator=(const StackFrame&) = delete;
 
-  OpReturnType get(int varIndex) {
-    std::lock_guard<std::mutex> locker(mutex);
-    assert(_varValues.size() > varIndex);
+  OpReturnType get(int varIndex) const {
+    assert(_numVariables > varIndex);
+    if (_shared.load(std::memory_order_relaxed)) {
+      return std::atomic_load(&_varValues[varIndex]);
+    }
     return _varValues[varIndex];
   }
 
   void set(int varIndex, OpReturnType val) {
-    std::lock_guard<std::mutex> locker(mutex);
-    assert(_varValues.size() > varIndex);
-    _varValues[varIndex] = val;
+    assert(_numVariables > varIndex);
+    if (_shared.load(std::memory_order_relaxed)) {
+      std::atomic_store(&_varValues[varIndex], std::move(val));
+      return;
+    }
+    _varValues[varIndex] = std::move(val);
   }
+
+  // Must be called before the frame is handed to another thread, the frame stays shared until the
+  // call it belongs to has ended
+  void mark_shared() { _shared.store(true, std::memory_order_release); }
+
+  bool is_shared() const { return _shared.load(std::memory_order_relaxed); }
 };
 
 /**
- * @brief RAII wrapper for acquiring a shared mutex lock
+ * @brief Hold of the script mutex by a call stack
  *
- * Automatically acquires the lock if not already held and releases it
- * when the object goes out of scope.
+ * Functions that only read the script state hold the mutex in shared mode and run concurrently
+ * with each other, functions writing it hold it exclusively. Moving a ScriptLock transfers the
+ * hold.
+ */
+class ScriptLock {
+ public:
+  enum class Mode {
+    NONE,      /**< The mutex is not held */
+    SHARED,    /**< Held along with other readers */
+    EXCLUSIVE, /**< Held by this stack only */
+  };
+
+ private:
+  std::shared_mutex* _mutex = nullptr; /**< Script mutex of the task */
+  Mode _mode = Mode::NONE;             /**< How the mutex is currently held */
+
+ public:
+  ScriptLock() = default;
+
+  explicit ScriptLock(std::shared_mutex& mutex) : _mutex(&mutex) {}
+
+  ScriptLock(ScriptLock&& other) noexcept : _mutex(other._mutex), _mode(other._mode) {
+    other._mutex = nullptr;
+    other._mode = Mode::NONE;
+  }
+
+  ScriptLock& operator=(ScriptLock&& other) noexcept {
+    if (this != &other) {
+      release();
+      _mutex = other._mutex;
+      _mode = other._mode;
+      other._mutex = nullptr;
+      other._mode = Mode::NONE;
+    }
+    return *this;
+  }
+
+  ScriptLock(const ScriptLock&) = delete;
+  ScriptLock& operator=(const ScriptLock&) = delete;
+
+  ~ScriptLock() { release(); }
+
+  std::shared_mutex* mutex() const { return _mutex; }
+
+  Mode mode() const { return _mode; }
+
+  // The mutex must not be held already
+  void acquire(Mode mode) {
+    assert(_mode == Mode::NONE);
+    if (mode == Mode::SHARED) {
+      _mutex->lock_shared();
+    } else if (mode == Mode::EXCLUSIVE) {
+      _mutex->lock();
+    }
+    _mode = mode;
+  }
+
+  void release() {
+    if (_mode == Mode::SHARED) {
+      _mutex->unlock_shared();
+    } else if (_mode == Mode::EXCLUSIVE) {
+      _mutex->unlock();
+    }
+    _mode = Mode::NONE;
+  }
+};
+
+/**
+ * @brief RAII wrapper for acquiring the script lock
+ *
+ * Acquires the lock in the requested mode if it is not already held in that mode or a stronger
+ * one, and restores the previous mode when the object goes out of scope. Going from shared to
+ * exclusive releases the lock in between, so other functions can run at that point.
  */
 class ScopedLock {
-  std::unique_lock<std::shared_mutex>& lock;  /**< Reference to the lock to manage */
-  bool lockedByMe = false;                    /**< Whether this object acquired the lock */
+  ScriptLock& lock;                                       /**< Reference to the lock to manage */
+  ScriptLock::Mode previousMode = ScriptLock::Mode::NONE; /**< Mode to restore on destruction */
+  bool lockedByMe = false;                                /**< Whether this object locked */
 
  public:
-  ScopedLock(std::unique_lock<std::shared_mutex>& l) : lock(l) {
+  ScopedLock(ScriptLock& l, ScriptLock::Mode mode = ScriptLock::Mode::EXCLUSIVE) : lock(l) {
     assert(lock.mutex());
-    if (!lock.owns_lock()) {
-      // does not own lock
+    previousMode = lock.mode();
+    if (previousMode == ScriptLock::Mode::NONE ||
+        (previousMode == ScriptLock::Mode::SHARED && mode == ScriptLock::Mode::EXCLUSIVE)) {
       lockedByMe = true;
-      lock.lock();
+      lock.release();
+      lock.acquire(mode);
     }
   }
 
@@ -117,39 +220,33 @@ class ScopedLock {
 
   ~ScopedLock() {
     if (lockedByMe) {
-      lock.unlock();
+      lock.release();
+      lock.acquire(previousMode);
     }
   }
 };
 
 /**
- * @brief RAII wrapper for temporarily releasing a shared mutex lock
+ * @brief RAII wrapper for temporarily releasing the script lock
  *
- * Temporarily unlocks the mutex if it's currently held and re-acquires it
- * when the object goes out of scope.
+ * Temporarily releases the lock if it's currently held and re-acquires it in the same mode when
+ * the object goes out of scope.
  */
 class ScopedUnlock {
-  std::unique_lock<std::shared_mutex>& lock;  /**< Reference to the lock to manage */
-  bool unlockedByMe = false;                  /**< Whether this object released the lock */
+  ScriptLock& lock;                                       /**< Reference to the lock to manage */
+  ScriptLock::Mode previousMode = ScriptLock::Mode::NONE; /**< Mode to restore on destruction */
 
  public:
-  ScopedUnlock(std::unique_lock<std::shared_mutex>& l) : lock(l) {
+  ScopedUnlock(ScriptLock& l) : lock(l) {
     assert(bool(lock.mutex()));
-    if (lock.owns_lock()) {
-      // does not own lock
-      unlockedByMe = true;
-      lock.unlock();
-    }
+    previousMode = lock.mode();
+    lock.release();
   }
 
   ScopedUnlock(const ScopedUnlock& l) = delete;
   ScopedUnlock& operator=(const ScopedUnlock& other) = delete;
 
-  ~ScopedUnlock() {
-    if (unlockedByMe) {
-      lock.lock();
-    }
-  }
+  ~ScopedUnlock() { lock.acquire(previousMode); }
 };
 
 /**
@@ -166,8 +263,19 @@ class CallStack {
 
   using StackFramePtr = std::shared_ptr<StackFrame>;
 
-  std::vector<StackFramePtr> _functionsStack;  /**< Current call stack of active functions */
-  std::vector<std::vector<std::vector<StackFramePtr>>> _moduleToStackFrameMap;  /**< 3D map: module -> function -> stack frames */
+  /**
+   * @brief An active function call, along with the frame it shadows
+   *
+   * Only the innermost frame of a function is visible, the frame of an enclosing recursive call is
+   * restored from here when the call exits.
+   */
+  struct ActiveFrame {
+    StackFramePtr frame;
+    StackFramePtr shadowedFrame;
+  };
+
+  std::vector<ActiveFrame> _functionsStack;  /**< Current call stack of active functions */
+  std::vector<std::vector<StackFramePtr>> _currentFrames;  /**< module -> function -> innermost frame */
 
   CommandCenter* _commandCenter = nullptr;  /**< Reference to the command center for task access */
 
@@ -180,7 +288,7 @@ class CallStack {
   friend class LLMDataVariable;
 #endif  // GENAI
   CallStack(const CallStack& other);
-  std::unique_lock<std::shared_mutex> lock;  /**< Shared mutex for thread-safe operations */
+  ScriptLock lock;  /**< Hold of the script mutex by this stack */
 
  public:
   CallStack(CommandCenter* commandCenter) : _commandCenter(commandCenter) {}
@@ -196,8 +304,20 @@ class CallStack {
 
   ScopedLock scoped_lock() { return ScopedLock(lock); }
 
-  std::unique_ptr<ScopedLock> scoped_lock_unique_ptr() {
-    return std::make_unique<ScopedLock>(lock);
+  std::unique_ptr<ScopedLock> scoped_lock_unique_ptr(
+      ScriptLock::Mode mode = ScriptLock::Mode::EXCLUSIVE) {
+    return std::make_unique<ScopedLock>(lock, mode);
+  }
+
+  ScriptLock::Mode script_lock_mode() const { return lock.mode(); }
+
+  // Holds the script lock exclusively instead of in shared mode until the hold is released, other
+  // functions can run while switching
+  void upgrade_script_lock() {
+    if (lock.mode() == ScriptLock::Mode::SHARED) {
+      lock.release();
+      lock.acquire(ScriptLock::Mode::EXCLUSIVE);
+    }
   }
 
   bool is_script_lock_created() const { return lock.mutex(); }
@@ -205,6 +325,10 @@ class CallStack {
   void enter_function_frame(int moduleIndex, int functionIndex, int numVariablesInFrame);
   void exit_function_frame();
 
+  // Switches every frame reachable from this stack to atomic access, used when the stack is
+  // captured by a function that runs without the script lock
+  void mark_frames_shared();
+
   std::shared_ptr<Task> task() noexcept;
 };
 
@@ -234,6 +358,10 @@ class VariableScope {
   // of the number of variables a stack frame has and assign indices appropriately
   std::shared_ptr<int> _numVariablesStack;  /**< Shared counter for variables in the stack frame */
 
+  // Set once the function this scope belongs to is found to write state shared between its calls.
+  // Shared by the scopes of the function, nested functions have their own.
+  std::shared_ptr<std::atomic<bool>> _writesSharedState;
+
   VariableScope(VariableScope* p, bool isNewFunction);
 
   int get_variable_index_in_scope(const std::string& variableName);
@@ -278,6 +406,31 @@ class VariableScope {
 
   int create_new_variable();
 
+  // Whether function bodies are compiled to bytecode, controlled by the bytecodeInterpreter config
+  bool is_bytecode_enabled() const;
+
+  // Whether functions run without the script lock, controlled by the scriptConcurrency config
+  bool is_script_concurrency_enabled() const;
+
+  // Whether the location is a variable of the stack frame of the function this scope belongs to
+  bool is_in_function_frame(const StackLocation& location) const noexcept {
+    return location._moduleIndex == _moduleIndex &&
+           location._functionIndex == _currentFunctionIndex;
+  }
+
+  // Records that the function this scope belongs to writes a variable outside of its own frame,
+  // an element or attribute of an object, or keeps iteration state in its nodes. Writes made by
+  // the module body itself run while loading the script and are not recorded.
+  void mark_shared_state_written() {
+    if (_currentFunctionIndex != 0) {
+      _writesSharedState->store(true, std::memory_order_relaxed);
+    }
+  }
+
+  // Flag of the function this scope belongs to, member calls found to modify their object at
+  // runtime also set it, see AttributeNode::call_member
+  auto writes_shared_state() const noexcept { return _writesSharedState; }
+
   friend class ImportStatement;
   friend class DecoratorStatement;
 
@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "bytecode.hpp"
+
+#include "node.hpp"
+#include "statements.hpp"
+
+BytecodeCompiler::BytecodeCompiler() : _function(std::make_unique<BytecodeFunction>()) {
+  _function->_lineChains.push_back({});
+  _lineChainIndices[{}] = 0;
+}
+
+std::unique_ptr<BytecodeFunction> BytecodeCompiler::compile(
+    const std::vector<Statement*>& statements) {
+  BytecodeCompiler compiler;
+  compiler.compile_statements(statements);
+  // Falling off the end of the body returns None
+  compiler.emit(BytecodeOp::RETURN_NONE);
+  return std::move(compiler._function);
+}
+
+void BytecodeCompiler::compile_statements(const std::vector<Statement*>& statements) {
+  for (auto statement : statements) {
+    int registerMark = _nextRegister;
+    _lineStack.push_back(statement->get_line());
+    auto it = _lineChainIndices.find(_lineStack);
+    if (it == _lineChainIndices.end()) {
+      it = _lineChainIndices.insert({_lineStack, _function->_lineChains.size()}).first;
+      _function->_lineChains.push_back(_lineStack);
+    }
+    int parentLineIndex = _currentLineIndex;
+    _currentLineIndex = it->second;
+
+    statement->compile(*this);
+
+    _currentLineIndex = parentLineIndex;
+    _lineStack.pop_back();
+    // Temporaries of a statement are dead once it is executed
+    _nextRegister = registerMark;
+  }
+}
+
+int BytecodeCompiler::allocate_registers(int count) {
+  int first = _nextRegister;
+  _nextRegister += count;
+  _function->_numRegisters = std::max(_function->_numRegisters, _nextRegister);
+  return first;
+}
+
+int BytecodeCompiler::add_constant(OpReturnType constant) {
+  _function->_constants.push_back(constant);
+  return _function->_constants.size() - 1;
+}
+
+int BytecodeCompiler::add_location(StackLocation location, const std::string& name) {
+  for (int i = 0; i < _function->_locations.size(); i++) {
+    if (_function->_locations[i] == location) {
+      return i;
+    }
+  }
+  _function->_locations.push_back(location);
+  _function->_locationNames.push_back(name);
+  return _function->_locations.size() - 1;
+}
+
+int BytecodeCompiler::emit(BytecodeOp op, int dst, int a, int b, int c) {
+  BytecodeInstruction instruction;
+  instruction.op = op;
+  instruction.dst = dst;
+  instruction.a = a;
+  instruction.b = b;
+  instruction.c = c;
+  instruction.lineIndex = _currentLineIndex;
+  _function->_code.push_back(instruction);
+  return _function->_code.size() - 1;
+}
+
+int BytecodeCompiler::emit_node(BytecodeOp op, ASTNode* node, int dst, int a, int b) {
+  int index = emit(op, dst, a, b);
+  _function->_code[index].node = node;
+  return index;
+}
+
+void BytecodeCompiler::emit_execute(Statement* statement) {
+  // Break and continue returned by the statement are resolved against the enclosing compiled loop,
+  // -1 means that there is none and the function returns
+  int index = emit(BytecodeOp::EXEC_STMT, 0, 0, -1, -1);
+  _function->_code[index].statement = statement;
+  if (!_loops.empty()) {
+    _function->_code[index].c = _loops.back().continueTarget;
+    _loops.back().breakJumps.push_back(index);
+  }
+}
+
+void BytecodeCompiler::begin_loop(int continueTarget) {
+  Loop loop;
+  loop.continueTarget = continueTarget;
+  _loops.push_back(std::move(loop));
+}
+
+void BytecodeCompiler::end_loop(int breakTarget) {
+  for (auto jump : _loops.back().breakJumps) {
+    set_jump_target(jump, breakTarget);
+  }
+  _loops.pop_back();
+}
+
+void BytecodeCompiler::emit_break() {
+  if (_loops.empty()) {
+    // Matches the tree walker, where a break outside of a loop ends the function
+    emit(BytecodeOp::RETURN_NONE);
+    return;
+  }
+  _loops.back().breakJumps.push_back(emit(BytecodeOp::JUMP));
+}
+
+void BytecodeCompiler::emit_continue() {
+  if (_loops.empty()) {
+    emit(BytecodeOp::RETURN_NONE);
+    return;
+  }
+  emit(BytecodeOp::JUMP, 0, 0, _loops.back().continueTarget);
+}
@@ -0,0 +1,216 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <iterator>
+
+#include "bytecode.hpp"
+#include "node.hpp"
+#include "statements.hpp"
+
+// Computed goto jumps straight from the end of one handler to the next, giving every handler its
+// own indirect branch instead of funnelling all of them through the single branch of a switch.
+#if defined(__GNUC__) || defined(__clang__)
+#define BYTECODE_COMPUTED_GOTO 1
+#endif
+
+namespace {
+
+constexpr int kInlineRegisters = 16;
+constexpr int kInlineCounters = 4;
+
+// Moves a value out of a register. Handlers keep values only in temporaries of the full expression,
+// as an indirect goto is not allowed to leave the scope of a local with a destructor.
+inline OpReturnType take(OpReturnType& reg) { return std::move(reg); }
+
+std::vector<OpReturnType> take_arguments(OpReturnType* regs, int first, int count) {
+  return std::vector<OpReturnType>(std::make_move_iterator(regs + first),
+                                   std::make_move_iterator(regs + first + count));
+}
+
+}  // namespace
+
+std::string BytecodeFunction::get_error_message(const BytecodeInstruction& instruction,
+                                                const char* error) const {
+  std::string message = error;
+  const auto& lines = _lineChains[instruction.lineIndex];
+  for (auto it = lines.rbegin(); it != lines.rend(); ++it) {
+    message = ne::fmt("lineNo=%d, %s", *it, message.c_str()).str;
+  }
+  return message;
+}
+
+OpReturnType BytecodeFunction::execute(CallStack& stack) const {
+  // Small functions run entirely on registers allocated on the native stack
+  OpReturnType inlineRegisters[kInlineRegisters];
+  std::vector<OpReturnType> heapRegisters;
+  OpReturnType* regs = inlineRegisters;
+  if (_numRegisters > kInlineRegisters) {
+    heapRegisters.resize(_numRegisters);
+    regs = heapRegisters.data();
+  }
+  int inlineCounters[kInlineCounters];
+  std::vector<int> heapCounters;
+  int* counters = inlineCounters;
+  if (_numCounters > kInlineCounters) {
+    heapCounters.resize(_numCounters);
+    counters = heapCounters.data();
+  }
+
+  const BytecodeInstruction* const code = _code.data();
+  const BytecodeInstruction* ip = code;
+
+#ifdef BYTECODE_COMPUTED_GOTO
+  static const void* dispatchTable[] = {
+#define BYTECODE_OPCODE_LABEL(name) &&op_##name,
+      BYTECODE_OPCODES(BYTECODE_OPCODE_LABEL)
+#undef BYTECODE_OPCODE_LABEL
+  };
+#define DISPATCH() goto* dispatchTable[static_cast<int>(ip->op)]
+#define HANDLER(name) op_##name:
+#else
+#define DISPATCH() continue
+#define HANDLER(name) case BytecodeOp::name:
+#endif
+#define NEXT() \
+  ++ip;        \
+  DISPATCH()
+#define JUMP_TO(target) \
+  ip = code + (target); \
+  DISPATCH()
+
+  try {
+#ifdef BYTECODE_COMPUTED_GOTO
+    DISPATCH();
+#else
+    for (;;) {
+      switch (ip->op) {
+#endif
+    HANDLER(LOAD_CONST) {
+      regs[ip->dst] = _constants[ip->a];
+      NEXT();
+    }
+    HANDLER(LOAD_VAR) {
+      regs[ip->dst] = stack.get_variable(_locations[ip->a]);
+      if (regs[ip->dst] == nullptr) {
+        THROW("Local variable %s accessed before assignment", _locationNames[ip->a].c_str());
+      }
+      NEXT();
+    }
+    HANDLER(STORE_VAR) {
+      stack.set_variable(_locations[ip->b], take(regs[ip->a]));
+      NEXT();
+    }
+    HANDLER(STORE_NODE) {
+      ip->node->set_variable(take(regs[ip->a]), stack);
+      NEXT();
+    }
+    HANDLER(EVAL_NODE) {
+      regs[ip->dst] = ip->node->get_value(stack);
+      NEXT();
+    }
+    HANDLER(EXEC_STMT) {
+      StatRetType* ret = ip->statement->execute(stack);
+      if (ret == nullptr) {
+        NEXT();
+      }
+      int target = ret->type == RETURNTYPE::BREAK      ? ip->b
+                   : ret->type == RETURNTYPE::CONTINUE ? ip->c
+                                                       : -1;
+      if (target < 0) {
+        OpReturnType returnVal = ret->type == RETURNTYPE::RETURN ? ret->returnVal : nullptr;
+        delete ret;
+        return returnVal;
+      }
+      delete ret;
+      JUMP_TO(target);
+    }
+    HANDLER(BINARY) {
+      regs[ip->dst] =
+          static_cast<BinNode*>(ip->node)->operate(take(regs[ip->a]), take(regs[ip->b]));
+      NEXT();
+    }
+    HANDLER(UNARY) {
+      regs[ip->dst] = static_cast<UnaryNode*>(ip->node)->operate(take(regs[ip->a]));
+      NEXT();
+    }
+    HANDLER(COMPARE) {
+      regs[ip->dst] =
+          static_cast<CompareNode*>(ip->node)->compare(0, take(regs[ip->a]), take(regs[ip->b]));
+      NEXT();
+    }
+    HANDLER(GET_MEMBER) {
+      regs[ip->dst] = take(regs[ip->a])->get_member(ip->b);
+      NEXT();
+    }
+    HANDLER(SUBSCRIPT) {
+      regs[ip->dst] =
+          static_cast<SubscriptNode*>(ip->node)->subscript(take(regs[ip->a]), take(regs[ip->b]));
+      NEXT();
+    }
+    HANDLER(CALL) {
+      regs[ip->dst] =
+          take(regs[ip->dst])->execute_function(take_arguments(regs, ip->a, ip->b), stack);
+      NEXT();
+    }
+    HANDLER(CALL_MEMBER) {
+      regs[ip->dst] = static_cast<AttributeNode*>(ip->node)->call_member(
+          take(regs[ip->dst]), take_arguments(regs, ip->a, ip->b), stack);
+      NEXT();
+    }
+    HANDLER(BUILD_LIST) {
+      regs[ip->dst] = OpReturnType(new ListDataVariable(take_arguments(regs, ip->a, ip->b)));
+      NEXT();
+    }
+    HANDLER(BUILD_TUPLE) {
+      regs[ip->dst] = OpReturnType(new TupleDataVariable(take_arguments(regs, ip->a, ip->b)));
+      NEXT();
+    }
+    HANDLER(BUILD_DICT) {
+      regs[ip->dst] = OpReturnType(new MapDataVariable(
+          take_arguments(regs, ip->a, ip->b), take_arguments(regs, ip->a + ip->b, ip->b)));
+      NEXT();
+    }
+    HANDLER(CLEAR) {
+      regs[ip->a] = nullptr;
+      NEXT();
+    }
+    HANDLER(JUMP) { JUMP_TO(ip->b); }
+    HANDLER(JUMP_IF_FALSE) {
+      bool condition = take(regs[ip->a])->get_bool();
+      if (!condition) {
+        JUMP_TO(ip->b);
+      }
+      NEXT();
+    }
+    HANDLER(FOR_INIT) {
+      counters[ip->c] = 0;
+      NEXT();
+    }
+    HANDLER(FOR_NEXT) {
+      // The size is read on every iteration since the body can add or remove elements
+      int index = counters[ip->c];
+      if (index >= regs[ip->a]->get_size()) {
+        JUMP_TO(ip->b);
+      }
+      counters[ip->c] = index + 1;
+      regs[ip->dst] = regs[ip->a]->get_int_subscript(index);
+      NEXT();
+    }
+    HANDLER(RETURN) { return take(regs[ip->a]); }
+    HANDLER(RETURN_NONE) { return nullptr; }
+#ifndef BYTECODE_COMPUTED_GOTO
+      }
+    }
+#endif
+  } catch (std::exception& e) {
+    THROW("%s", get_error_message(*ip, e.what()).c_str());
+  }
+
+#undef JUMP_TO
+#undef NEXT
+#undef HANDLER
+#undef DISPATCH
+}
@@ -7,19 +7,20 @@
 #include "node.hpp"
 
 #include "binary_operators.hpp"
+#include "bytecode.hpp"
 #include "single_variable.hpp"
 #include "statements.hpp"
 
 ConstantNode::ConstantNode(VariableScope* scope, const json& constJson)
     : ASTNode(scope, constJson) {
-  auto value = constJson.at("value");
+  const auto& value = constJson.at("value");
   _d = DataVariable::get_SingleVariableFrom_JSON(value);
 }
 
 BinNode::BinNode(VariableScope* scope, const json& binOpJson) : ASTNode(scope, binOpJson) {
-  auto leftBlock = binOpJson.at("left");
+  const auto& leftBlock = binOpJson.at("left");
   _left = ASTNode::create_node(scope, leftBlock);
-  auto rightBlock = binOpJson.at("right");
+  const auto& rightBlock = binOpJson.at("right");
   _right = ASTNode::create_node(scope, rightBlock);
   _opType = binOpJson.at("op").at("_type");
 }
@@ -27,6 +28,10 @@ BinNode::BinNode(VariableScope* scope, const json& binOpJson) : ASTNode(scope, b
 OpReturnType BinNode::get_value(CallStack& stack) {
   auto d1 = _left->get(stack);
   auto d2 = _right->get(stack);
+  return operate(d1, d2);
+}
+
+OpReturnType BinNode::operate(const OpReturnType& d1, const OpReturnType& d2) {
   auto ret = BinaryOperators::operate(d1, d2, _opType);
   if (ret == nullptr) {
     auto enum1 = util::get_string_from_enum(d1->get_dataType_enum());
@@ -39,7 +44,7 @@ OpReturnType BinNode::get_value(CallStack& stack) {
 }
 
 UnaryNode::UnaryNode(VariableScope* scope, const json& unaryOpJson) : ASTNode(scope, unaryOpJson) {
-  auto operandBlock = unaryOpJson.at("operand");
+  const auto& operandBlock = unaryOpJson.at("operand");
   _operand = ASTNode::create_node(scope, operandBlock);
   _opType = unaryOpJson.at("op").at("_type");
   _func = UnaryOperators::get_operator(_opType);
@@ -47,6 +52,10 @@ UnaryNode::UnaryNode(VariableScope* scope, const json& unaryOpJson) : ASTNode(sc
 
 OpReturnType UnaryNode::get_value(CallStack& stack) {
   auto d = _operand->get(stack);
+  return operate(d);
+}
+
+OpReturnType UnaryNode::operate(const OpReturnType& d) {
   auto ret = _func(d);
   if (ret == nullptr) {
     auto enumString = util::get_string_from_enum(d->get_dataType_enum());
@@ -57,14 +66,14 @@ OpReturnType UnaryNode::get_value(CallStack& stack) {
 }
 
 CompareNode::CompareNode(VariableScope* scope, const json& j) {
-  auto comparatorsJson = j.at("comparators");
-  for (auto singleCompar : comparatorsJson) {
+  const auto& comparatorsJson = j.at("comparators");
+  for (const auto& singleCompar : comparatorsJson) {
     _comparators.push_back(create_node(scope, singleCompar));
   }
-  auto leftJson = j.at("left");
+  const auto& leftJson = j.at("left");
   _left = create_node(scope, leftJson);
-  auto compareFuncJsons = j.at("ops");
-  for (auto singleFunc : compareFuncJsons) {
+  const auto& compareFuncJsons = j.at("ops");
+  for (const auto& singleFunc : compareFuncJsons) {
     std::string type = singleFunc.at("_type");
     _opTypes.push_back(type);
     _compareFuncs.push_back(CompareOperators::get_operator(type));
@@ -80,14 +89,7 @@ OpReturnType CompareNode::get_value(CallStack& stack) {
   OpReturnType ret = nullptr;
   for (int i = 0; i < _comparators.size(); i++) {
     auto d2 = _comparators[i]->get(stack);
-    ret = _compareFuncs[i](d, d2);
-    if (ret == nullptr) {
-      auto enumString1 = util::get_string_from_enum(d->get_dataType_enum());
-      auto enumString2 = util::get_string_from_enum(d2->get_dataType_enum());
-      throw create_exception("Could not %s, check types left=%s[%s], right=%s[%s]",
-                             _opTypes[i].c_str(), enumString1, d->get_containerType_string(),
-                             enumString2, d2->get_containerType_string());
-    }
+    ret = compare(i, d, d2);
     if (!ret->get_bool()) {
       return ret;
     }
@@ -96,6 +98,18 @@ OpReturnType CompareNode::get_value(CallStack& stack) {
   return ret;
 }
 
+OpReturnType CompareNode::compare(int index, const OpReturnType& d1, const OpReturnType& d2) {
+  auto ret = _compareFuncs[index](d1, d2);
+  if (ret == nullptr) {
+    auto enumString1 = util::get_string_from_enum(d1->get_dataType_enum());
+    auto enumString2 = util::get_string_from_enum(d2->get_dataType_enum());
+    throw create_exception("Could not %s, check types left=%s[%s], right=%s[%s]",
+                           _opTypes[index].c_str(), enumString1, d1->get_containerType_string(),
+                           enumString2, d2->get_containerType_string());
+  }
+  return ret;
+}
+
 BoolNode::BoolNode(VariableScope* scope, const json& j) {
   _opType = j.at("op").at("_type");
   _func = BoolOperators::get_operator(_opType);
@@ -131,10 +145,10 @@ OpReturnType BoolNode::get_value(CallStack& stack) {
 }
 
 CallNode::CallNode(VariableScope* scope, const json& callFuncJson) : ASTNode(scope, callFuncJson) {
-  auto args = callFuncJson.at("args");
-  auto funcNodeJson = callFuncJson.at("func");
+  const auto& args = callFuncJson.at("args");
+  const auto& funcNodeJson = callFuncJson.at("func");
   _functionNode = ASTNode::create_node(scope, funcNodeJson);
-  for (auto arg : args) {
+  for (const auto& arg : args) {
     _arguments.push_back(ASTNode::create_node(scope, arg));
   }
 }
@@ -159,6 +173,8 @@ NameNode::NameNode(VariableScope* scope, const json& nameOpJson) : ASTNode(scope
     auto stack_location = _scope->get_variable_location_on_stack(varName);
     if (stack_location == StackLocation::null) {
       stack_location = _scope->add_variable(varName);
+    } else if (!_scope->is_in_function_frame(stack_location)) {
+      _scope->mark_shared_state_written();
     }
     _stackLocation = std::move(stack_location);
   } else {
@@ -195,19 +211,163 @@ OpReturnType NameNode::call(const std::vector<OpReturnType>& args, CallStack& st
 AttributeNode::AttributeNode(VariableScope* scope, const json& attributeNodeJson)
     : ASTNode(scope, attributeNodeJson) {
   std::string type = attributeNodeJson.at("ctx").at("_type");
-  auto mainNodeJson = attributeNodeJson.at("value");
+  const auto& mainNodeJson = attributeNodeJson.at("value");
   _mainNode = ASTNode::create_node(scope, mainNodeJson);
   std::string attr = attributeNodeJson.at("attr");
   _memberIndex = DataVariable::add_and_get_member_func_index(attr);
   if (_memberIndex == -1) {
     THROW("Member %s does not exist", attr.c_str());
   }
+  if (type == "Store") {
+    scope->mark_shared_state_written();
+  }
+  _functionWritesSharedState = scope->writes_shared_state();
 }
 
 OpReturnType AttributeNode::call(const std::vector<OpReturnType>& args, CallStack& stack) {
   auto classVariable = _mainNode->get(stack);
   // this calls member function
-  return classVariable->call_function(_memberIndex, args, stack);
+  return call_member(classVariable, args, stack);
+}
+
+OpReturnType AttributeNode::call_member(const OpReturnType& object,
+                                        const std::vector<OpReturnType>& args, CallStack& stack) {
+  // Functions decorated with concurrent hold no lock and manage their own synchronization
+  if (stack.script_lock_mode() != ScriptLock::Mode::NONE &&
+      object->is_mutating_member(_memberIndex)) {
+    if (!_functionWritesSharedState->load(std::memory_order_relaxed)) {
+      _functionWritesSharedState->store(true, std::memory_order_relaxed);
+    }
+    stack.upgrade_script_lock();
+  }
+  return object->call_function(_memberIndex, args, stack);
+}
+
+// BYTECODE LOWERING BELOW
+
+void ASTNode::compile(BytecodeCompiler& compiler, int dst) { compiler.emit_eval(this, dst); }
+
+void ASTNode::compile_store(BytecodeCompiler& compiler, int src) {
+  compiler.emit_node(BytecodeOp::STORE_NODE, this, 0, src);
+}
+
+void ConstantNode::compile(BytecodeCompiler& compiler, int dst) {
+  compiler.emit(BytecodeOp::LOAD_CONST, dst, compiler.add_constant(_d));
+}
+
+void BinNode::compile(BytecodeCompiler& compiler, int dst) {
+  int right = compiler.allocate_registers();
+  _left->compile(compiler, dst);
+  _right->compile(compiler, right);
+  compiler.emit_node(BytecodeOp::BINARY, this, dst, dst, right);
+}
+
+void UnaryNode::compile(BytecodeCompiler& compiler, int dst) {
+  _operand->compile(compiler, dst);
+  compiler.emit_node(BytecodeOp::UNARY, this, dst, dst);
+}
+
+void CompareNode::compile(BytecodeCompiler& compiler, int dst) {
+  if (_comparators.size() != 1) {
+    // Chained comparisons short circuit, leave them to the tree walker
+    ASTNode::compile(compiler, dst);
+    return;
+  }
+  int right = compiler.allocate_registers();
+  _left->compile(compiler, dst);
+  _comparators[0]->compile(compiler, right);
+  compiler.emit_node(BytecodeOp::COMPARE, this, dst, dst, right);
+}
+
+void CallNode::compile(BytecodeCompiler& compiler, int dst) {
+  if (!_functionNode->compile_call(compiler, _arguments, dst)) {
+    ASTNode::compile(compiler, dst);
+  }
+}
+
+void ListNode::compile(BytecodeCompiler& compiler, int dst) {
+  int first = compiler.allocate_registers(_membersInList.size());
+  for (int i = 0; i < _membersInList.size(); i++) {
+    _membersInList[i]->compile(compiler, first + i);
+  }
+  compiler.emit(BytecodeOp::BUILD_LIST, dst, first, _membersInList.size());
+}
+
+void TupleNode::compile(BytecodeCompiler& compiler, int dst) {
+  if (_store) {
+    ASTNode::compile(compiler, dst);
+    return;
+  }
+  int first = compiler.allocate_registers(_membersInTuple.size());
+  for (int i = 0; i < _membersInTuple.size(); i++) {
+    _membersInTuple[i]->compile(compiler, first + i);
+  }
+  compiler.emit(BytecodeOp::BUILD_TUPLE, dst, first, _membersInTuple.size());
+}
+
+void NameNode::compile(BytecodeCompiler& compiler, int dst) {
+  if (_type != Type::LOAD) {
+    ASTNode::compile(compiler, dst);
+    return;
+  }
+  compiler.emit(BytecodeOp::LOAD_VAR, dst, compiler.add_location(_stackLocation, _variableName));
+}
+
+void NameNode::compile_store(BytecodeCompiler& compiler, int src) {
+  if (_type != Type::STORE) {
+    ASTNode::compile_store(compiler, src);
+    return;
+  }
+  compiler.emit(BytecodeOp::STORE_VAR, 0, src, compiler.add_location(_stackLocation, _variableName));
+}
+
+bool NameNode::compile_call(BytecodeCompiler& compiler, const std::vector<ASTNode*>& arguments,
+                            int dst) {
+  if (_type != Type::LOAD) {
+    return false;
+  }
+  // Arguments are evaluated before the function itself, same as CallNode::get_value
+  int first = compiler.allocate_registers(arguments.size());
+  for (int i = 0; i < arguments.size(); i++) {
+    arguments[i]->compile(compiler, first + i);
+  }
+  compile(compiler, dst);
+  compiler.emit(BytecodeOp::CALL, dst, first, arguments.size());
+  return true;
+}
+
+void AttributeNode::compile(BytecodeCompiler& compiler, int dst) {
+  _mainNode->compile(compiler, dst);
+  compiler.emit(BytecodeOp::GET_MEMBER, dst, dst, _memberIndex);
+}
+
+bool AttributeNode::compile_call(BytecodeCompiler& compiler,
+                                 const std::vector<ASTNode*>& arguments, int dst) {
+  int first = compiler.allocate_registers(arguments.size());
+  for (int i = 0; i < arguments.size(); i++) {
+    arguments[i]->compile(compiler, first + i);
+  }
+  _mainNode->compile(compiler, dst);
+  compiler.emit_node(BytecodeOp::CALL_MEMBER, this, dst, first, arguments.size());
+  return true;
+}
+
+void SubscriptNode::compile(BytecodeCompiler& compiler, int dst) {
+  int subscriptRegister = compiler.allocate_registers();
+  _sliceNode->compile(compiler, subscriptRegister);
+  _mainNode->compile(compiler, dst);
+  compiler.emit_node(BytecodeOp::SUBSCRIPT, this, dst, dst, subscriptRegister);
+}
+
+void DictNode::compile(BytecodeCompiler& compiler, int dst) {
+  int first = compiler.allocate_registers(2 * _keyNodes.size());
+  for (int i = 0; i < _keyNodes.size(); i++) {
+    _keyNodes[i]->compile(compiler, first + i);
+  }
+  for (int i = 0; i < _valueNodes.size(); i++) {
+    _valueNodes[i]->compile(compiler, first + _keyNodes.size() + i);
+  }
+  compiler.emit(BytecodeOp::BUILD_DICT, dst, first, _keyNodes.size());
 }
 
 // STATIC FUNCTIONS BELOW
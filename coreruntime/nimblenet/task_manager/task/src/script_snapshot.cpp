@@ -0,0 +1,415 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "script_snapshot.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unordered_set>
+
+#include "file_store.hpp"
+#include "logger.hpp"
+
+using json = nlohmann::json;
+using recordformat::append_varint;
+using recordformat::read_varint;
+
+namespace {
+
+constexpr char FileMagic[4] = {'N', 'E', 'S', 'S'};
+constexpr uint32_t FileVersion = 1;
+// The AST of a script is never nested this deep, such a tree can only come from a corrupted file
+constexpr int MaxDepth = 1000;
+
+/**
+ * @brief Header of a snapshot, followed by the string pool, the module table and the trees.
+ */
+struct SnapshotFileHeader {
+  char magic[4];
+  uint32_t version;
+  uint64_t sourceHash;
+  uint32_t numStrings;
+  uint32_t numModules;
+};
+
+/**
+ * @brief Type of a value of a tree, written before its payload.
+ */
+enum class ValueType : uint8_t {
+  NONE = 0,
+  BOOL_FALSE = 1,
+  BOOL_TRUE = 2,
+  INTEGER = 3,  /**< Zigzag varint. */
+  UNSIGNED = 4, /**< Varint. */
+  FLOAT = 5,    /**< 8 bytes. */
+  STRING = 6,   /**< Varint index in the string pool. */
+  ARRAY = 7,    /**< Varint number of elements, then the elements. */
+  OBJECT = 8,   /**< Varint number of members, then the key index and value of each member. */
+};
+
+// Source positions of the nodes, only lineno is used for errors
+const std::unordered_set<std::string> DroppedKeys = {
+    "col_offset", "end_col_offset", "end_lineno", "kind", "n", "s", "type_comment", "type_ignores",
+};
+
+inline uint64_t zigzag_encode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzag_decode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/**
+ * @brief Writes the trees of a snapshot, interning their strings in the string pool.
+ */
+class Encoder {
+  std::unordered_map<std::string, uint32_t> _stringIndices;
+
+ public:
+  std::vector<const std::string*> strings; /**< String pool, in the order of the indices. */
+
+  uint32_t intern(const std::string& str) {
+    auto [it, inserted] = _stringIndices.try_emplace(str, _stringIndices.size());
+    if (inserted) strings.push_back(&it->first);
+    return it->second;
+  }
+
+  void encode(const json& value, std::string& out) {
+    switch (value.type()) {
+      case json::value_t::null:
+        out.push_back(static_cast<char>(ValueType::NONE));
+        return;
+      case json::value_t::boolean:
+        out.push_back(
+            static_cast<char>(value.get<bool>() ? ValueType::BOOL_TRUE : ValueType::BOOL_FALSE));
+        return;
+      case json::value_t::number_integer:
+        out.push_back(static_cast<char>(ValueType::INTEGER));
+        append_varint(out, zigzag_encode(value.get<int64_t>()));
+        return;
+      case json::value_t::number_unsigned:
+        out.push_back(static_cast<char>(ValueType::UNSIGNED));
+        append_varint(out, value.get<uint64_t>());
+        return;
+      case json::value_t::number_float: {
+        double number = value.get<double>();
+        out.push_back(static_cast<char>(ValueType::FLOAT));
+        out.append(reinterpret_cast<const char*>(&number), sizeof(number));
+        return;
+      }
+      case json::value_t::string:
+        out.push_back(static_cast<char>(ValueType::STRING));
+        append_varint(out, intern(value.get_ref<const std::string&>()));
+        return;
+      case json::value_t::array:
+        out.push_back(static_cast<char>(ValueType::ARRAY));
+        append_varint(out, value.size());
+        for (const auto& element : value) {
+          encode(element, out);
+        }
+        return;
+      case json::value_t::object: {
+        std::size_t numMembers = 0;
+        for (const auto& member : value.items()) {
+          numMembers += DroppedKeys.count(member.key()) == 0;
+        }
+        out.push_back(static_cast<char>(ValueType::OBJECT));
+        append_varint(out, numMembers);
+        for (const auto& member : value.items()) {
+          if (DroppedKeys.count(member.key())) continue;
+          append_varint(out, intern(member.key()));
+          encode(member.value(), out);
+        }
+        return;
+      }
+      default:
+        THROW("Value of type=%s not supported in the AST of a script", value.type_name());
+    }
+  }
+};
+
+/**
+ * @brief Reads the tree of a module.
+ */
+class Reader {
+  const char* _ptr;
+  const char* _end;
+  const std::vector<std::string_view>& _strings;
+
+  bool read_type(ValueType& type) {
+    if (_ptr == _end) return false;
+    type = static_cast<ValueType>(*_ptr++);
+    return true;
+  }
+
+  bool read_string(std::string_view& str) {
+    uint64_t index;
+    if (!read_varint(_ptr, _end, index) || index >= _strings.size()) return false;
+    str = _strings[index];
+    return true;
+  }
+
+  // Every element takes at least a byte, so a count is bounded by the remaining bytes
+  bool read_count(uint64_t& count) {
+    return read_varint(_ptr, _end, count) && count <= static_cast<uint64_t>(_end - _ptr);
+  }
+
+ public:
+  Reader(const char* begin, std::size_t size, const std::vector<std::string_view>& strings)
+      : _ptr(begin), _end(begin + size), _strings(strings) {}
+
+  bool at_end() const noexcept { return _ptr == _end; }
+
+  /**
+   * @brief Reads past a value without decoding it.
+   *
+   * @return false if the value is truncated or invalid.
+   */
+  bool skip(int depth = 0) {
+    ValueType type;
+    uint64_t number;
+    std::string_view str;
+    if (depth > MaxDepth || !read_type(type)) return false;
+    switch (type) {
+      case ValueType::NONE:
+      case ValueType::BOOL_FALSE:
+      case ValueType::BOOL_TRUE:
+        return true;
+      case ValueType::INTEGER:
+      case ValueType::UNSIGNED:
+        return read_varint(_ptr, _end, number);
+      case ValueType::FLOAT:
+        if (_end - _ptr < static_cast<std::ptrdiff_t>(sizeof(double))) return false;
+        _ptr += sizeof(double);
+        return true;
+      case ValueType::STRING:
+        return read_string(str);
+      case ValueType::ARRAY:
+        if (!read_count(number)) return false;
+        for (uint64_t i = 0; i < number; i++) {
+          if (!skip(depth + 1)) return false;
+        }
+        return true;
+      case ValueType::OBJECT:
+        if (!read_count(number)) return false;
+        for (uint64_t i = 0; i < number; i++) {
+          if (!read_string(str) || !skip(depth + 1)) return false;
+        }
+        return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Decodes a value, THROWs if it is truncated or invalid.
+   */
+  json decode() {
+    ValueType type;
+    uint64_t number;
+    std::string_view str;
+    if (!read_type(type)) {
+      THROW("%s", "Script snapshot is truncated");
+    }
+    switch (type) {
+      case ValueType::NONE:
+        return nullptr;
+      case ValueType::BOOL_FALSE:
+        return false;
+      case ValueType::BOOL_TRUE:
+        return true;
+      case ValueType::INTEGER:
+        if (!read_varint(_ptr, _end, number)) break;
+        return zigzag_decode(number);
+      case ValueType::UNSIGNED:
+        if (!read_varint(_ptr, _end, number)) break;
+        return number;
+      case ValueType::FLOAT: {
+        double value;
+        if (_end - _ptr < static_cast<std::ptrdiff_t>(sizeof(value))) break;
+        std::memcpy(&value, _ptr, sizeof(value));
+        _ptr += sizeof(value);
+        return value;
+      }
+      case ValueType::STRING:
+        if (!read_string(str)) break;
+        return std::string(str);
+      case ValueType::ARRAY: {
+        if (!read_count(number)) break;
+        json array = json::array();
+        auto& elements = array.get_ref<json::array_t&>();
+        elements.reserve(number);
+        for (uint64_t i = 0; i < number; i++) {
+          elements.push_back(decode());
+        }
+        return array;
+      }
+      case ValueType::OBJECT: {
+        if (!read_count(number)) break;
+        json object = json::object();
+        auto& members = object.get_ref<json::object_t&>();
+        for (uint64_t i = 0; i < number; i++) {
+          if (!read_string(str)) {
+            THROW("%s", "Script snapshot is corrupted");
+          }
+          // Keys were written in the order of the map, each one goes at the end
+          members.emplace_hint(members.end(), std::string(str), decode());
+        }
+        return object;
+      }
+    }
+    THROW("Script snapshot is corrupted at value of type=%d", static_cast<int>(type));
+  }
+};
+
+}  // namespace
+
+uint64_t ScriptSnapshot::hash(std::string_view source) noexcept {
+  // FNV-1a over 8 byte words instead of bytes, it only has to tell that the script changed
+  constexpr uint64_t Prime = 1099511628211ULL;
+  uint64_t hash = 14695981039346656037ULL ^ source.size();
+  std::size_t i = 0;
+  for (; i + sizeof(uint64_t) <= source.size(); i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, source.data() + i, sizeof(word));
+    hash = (hash ^ word) * Prime;
+  }
+  for (; i < source.size(); i++) {
+    hash = (hash ^ static_cast<uint8_t>(source[i])) * Prime;
+  }
+  return hash;
+}
+
+std::unique_ptr<ScriptSnapshot> ScriptSnapshot::create(const json& ast, uint64_t sourceHash) {
+  Encoder encoder;
+  std::vector<std::pair<uint32_t, std::string>> trees;
+  if (ast.is_object() && ast.contains(MainModule)) {
+    for (const auto& module : ast.items()) {
+      trees.emplace_back(encoder.intern(module.key()), std::string());
+      encoder.encode(module.value(), trees.back().second);
+    }
+  } else {
+    // A script without modules is its main module
+    trees.emplace_back(encoder.intern(MainModule), std::string());
+    encoder.encode(ast, trees.back().second);
+  }
+
+  SnapshotFileHeader header{};
+  std::memcpy(header.magic, FileMagic, sizeof(FileMagic));
+  header.version = FileVersion;
+  header.sourceHash = sourceHash;
+  header.numStrings = encoder.strings.size();
+  header.numModules = trees.size();
+
+  std::unique_ptr<ScriptSnapshot> snapshot(new ScriptSnapshot());
+  std::string& data = snapshot->_data;
+  data.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (const auto* str : encoder.strings) {
+    append_varint(data, str->size());
+    data.append(*str);
+  }
+  for (const auto& [nameIndex, tree] : trees) {
+    append_varint(data, nameIndex);
+    append_varint(data, tree.size());
+  }
+  for (const auto& [nameIndex, tree] : trees) {
+    data.append(tree);
+  }
+  if (!snapshot->index()) {
+    THROW("%s", "Could not read back the snapshot of the script");
+  }
+  return snapshot;
+}
+
+bool ScriptSnapshot::index() {
+  SnapshotFileHeader header;
+  if (_data.size() < sizeof(header)) return false;
+  std::memcpy(&header, _data.data(), sizeof(header));
+  if (std::memcmp(header.magic, FileMagic, sizeof(FileMagic)) != 0 ||
+      header.version != FileVersion) {
+    return false;
+  }
+  _sourceHash = header.sourceHash;
+
+  const char* ptr = _data.data() + sizeof(header);
+  const char* end = _data.data() + _data.size();
+  _strings.clear();
+  for (uint32_t i = 0; i < header.numStrings; i++) {
+    uint64_t size;
+    if (!read_varint(ptr, end, size) || size > static_cast<uint64_t>(end - ptr)) return false;
+    _strings.emplace_back(ptr, size);
+    ptr += size;
+  }
+
+  std::vector<std::pair<uint64_t, uint64_t>> table;
+  for (uint32_t i = 0; i < header.numModules; i++) {
+    uint64_t nameIndex, size;
+    if (!read_varint(ptr, end, nameIndex) || nameIndex >= _strings.size() ||
+        !read_varint(ptr, end, size)) {
+      return false;
+    }
+    table.emplace_back(nameIndex, size);
+  }
+
+  _modules.clear();
+  for (const auto& [nameIndex, size] : table) {
+    if (size > static_cast<uint64_t>(end - ptr)) return false;
+    Reader reader(ptr, size, _strings);
+    if (!reader.skip() || !reader.at_end()) return false;
+    _modules[_strings[nameIndex]] = {ptr - _data.data(), size};
+    ptr += size;
+  }
+  return ptr == end;
+}
+
+std::unique_ptr<ScriptSnapshot> ScriptSnapshot::load(const std::string& filePath,
+                                                     uint64_t sourceHash) {
+  std::ifstream in(filePath, std::ios::binary | std::ios::ate);
+  if (!in) return nullptr;
+  std::unique_ptr<ScriptSnapshot> snapshot(new ScriptSnapshot());
+  snapshot->_data.resize(in.tellg());
+  in.seekg(0);
+  in.read(snapshot->_data.data(), snapshot->_data.size());
+  if (!in || !snapshot->index()) {
+    LOG_TO_ERROR("Script snapshot %s could not be read, the script will be parsed",
+                 filePath.c_str());
+    return nullptr;
+  }
+  if (snapshot->_sourceHash != sourceHash) {
+    LOG_TO_DEBUG("Script snapshot %s is of another script, the script will be parsed",
+                 filePath.c_str());
+    return nullptr;
+  }
+  return snapshot;
+}
+
+bool ScriptSnapshot::save(const std::string& filePath) const {
+  std::string tmpFilePath = filePath + ".tmp";
+  {
+    std::ofstream out(tmpFilePath, std::ios::binary | std::ios::trunc);
+    out.write(_data.data(), _data.size());
+    out.close();
+    if (!out) {
+      std::remove(tmpFilePath.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmpFilePath.c_str(), filePath.c_str()) != 0) {
+    std::remove(tmpFilePath.c_str());
+    return false;
+  }
+  return true;
+}
+
+json ScriptSnapshot::get_module(const std::string& name) const {
+  auto it = _modules.find(name);
+  if (it == _modules.end()) {
+    THROW("Module=%s not found in script", name.c_str());
+  }
+  Reader reader(_data.data() + it->second.first, it->second.second, _strings);
+  return reader.decode();
+}
@@ -9,9 +9,9 @@
 #include "exception_data_variable.hpp"
 
 AssignStatement::AssignStatement(VariableScope* scope, const json& line) : Statement(line) {
-  auto valueBlock = line.at("value");
+  const auto& valueBlock = line.at("value");
   _node = ASTNode::create_node(scope, valueBlock);
-  auto targetBlock = line.at("targets").at(0);
+  const auto& targetBlock = line.at("targets").at(0);
   _targetOp = ASTNode::create_node(scope, targetBlock);
 }
 
@@ -21,13 +21,19 @@ StatRetType* AssignStatement::execute(CallStack& stack) {
   return nullptr;
 }
 
+void AssignStatement::compile(BytecodeCompiler& compiler) {
+  int value = compiler.allocate_registers();
+  _node->compile(compiler, value);
+  _targetOp->compile_store(compiler, value);
+}
+
 AssignStatement::~AssignStatement() {
   delete _node;
   delete _targetOp;
 }
 
 ExprStatement::ExprStatement(VariableScope* scope, const json& line) : Statement(line) {
-  auto valueBlock = line.at("value");
+  const auto& valueBlock = line.at("value");
   _node = ASTNode::create_node(scope, valueBlock);
 }
 
@@ -36,10 +42,17 @@ StatRetType* ExprStatement::execute(CallStack& stack) {
   return nullptr;
 }
 
+void ExprStatement::compile(BytecodeCompiler& compiler) {
+  int value = compiler.allocate_registers();
+  _node->compile(compiler, value);
+  // Release the unused result right away instead of when the register is reused
+  compiler.emit(BytecodeOp::CLEAR, 0, value);
+}
+
 ExprStatement::~ExprStatement() { delete _node; }
 
 ReturnStatement::ReturnStatement(VariableScope* scope, const json& line) : Statement(line) {
-  auto valueBlock = line.at("value");
+  const auto& valueBlock = line.at("value");
 
   _node = ASTNode::create_node(scope, valueBlock);
 }
@@ -49,6 +62,12 @@ StatRetType* ReturnStatement::execute(CallStack& stack) {
   return StatRetType::create_return(d);
 }
 
+void ReturnStatement::compile(BytecodeCompiler& compiler) {
+  int value = compiler.allocate_registers();
+  _node->compile(compiler, value);
+  compiler.emit(BytecodeOp::RETURN, 0, value);
+}
+
 ReturnStatement::~ReturnStatement() { delete _node; }
 
 StatRetType* execute_codelines(CallStack& stack, const std::vector<Statement*> codeLines) {
@@ -67,25 +86,32 @@ StatRetType* execute_codelines(CallStack& stack, const std::vector<Statement*> c
 
 StatRetType* Body::execute(CallStack& stack) { return execute_codelines(stack, _codeLines); }
 
+void Statement::compile(BytecodeCompiler& compiler) { compiler.emit_execute(this); }
+
 FunctionDef::FunctionDef(VariableScope* scope, const json& line, StackLocation&& functionLocation)
     : Statement(line) {
   auto inFunctionScope = scope->add_function_scope();
   _numVariablesStack = inFunctionScope->num_variables_stack();
   _index = inFunctionScope->current_function_index();
   _moduleIndex = inFunctionScope->current_module_index();
-  auto arguments = line.at("args").at("args");
+  const auto& arguments = line.at("args").at("args");
   _functionName = line.at("name");
-  for (auto arg : arguments) {
+  for (const auto& arg : arguments) {
     std::string argName = arg.at("arg");
     const auto varLocation = inFunctionScope->add_variable(argName);
     _argumentLocations.push_back(varLocation);
   }
   // Add function to scope before evaluating body to support recursive function calls
   _functionLocation = functionLocation;
-  auto bodyJson = line.at("body");
+  _scriptConcurrency = inFunctionScope->is_script_concurrency_enabled();
+  _writesSharedState = inFunctionScope->writes_shared_state();
+  const auto& bodyJson = line.at("body");
   _body = new Body(inFunctionScope, bodyJson);
+  if (inFunctionScope->is_bytecode_enabled()) {
+    _bytecode = BytecodeCompiler::compile(_body->get_statements());
+  }
   if (line.contains("decorator_list")) {
-    auto decorators = line.at("decorator_list");
+    const auto& decorators = line.at("decorator_list");
     for (int i = 0; i < decorators.size(); i++) {
       _decorators.push_back(ASTNode::create_node(scope, decorators[i]));
     }
@@ -111,9 +137,10 @@ OpReturnType FunctionDef::call_function(const std::vector<OpReturnType>& argumen
   bool lockTaken = false;
 
   std::unique_ptr<ScopedLock> scopedLock;
-  if (!is_static()) {
+  auto lockMode = script_lock_mode();
+  if (lockMode != ScriptLock::Mode::NONE) {
     // lock needs to be held since function is not static
-    scopedLock = stack.scoped_lock_unique_ptr();
+    scopedLock = stack.scoped_lock_unique_ptr(lockMode);
   }
   if (arguments.size() != _argumentLocations.size()) {
     THROW("function arguments number not matching %d given %d expected", arguments.size(),
@@ -123,13 +150,24 @@ OpReturnType FunctionDef::call_function(const std::vector<OpReturnType>& argumen
   for (int i = 0; i < _argumentLocations.size(); i++) {
     stack.set_variable(_argumentLocations[i], arguments[i]);
   }
-  auto ret = _body->execute(stack);
+  OpReturnType retVal = nullptr;
+  if (_bytecode) {
+    retVal = _bytecode->execute(stack);
+  } else {
+    auto ret = _body->execute(stack);
+    if (ret != nullptr && ret->type == RETURNTYPE::RETURN) {
+      retVal = ret->returnVal;
+    }
+    delete ret;
+  }
   stack.exit_function_frame();
-  if (ret == nullptr || ret->type != RETURNTYPE::RETURN) {
+  if (_scriptConcurrency && lockMode == ScriptLock::Mode::EXCLUSIVE &&
+      !_writesSharedState->load(std::memory_order_relaxed)) {
+    _readOnlyCallCompleted.store(true, std::memory_order_relaxed);
+  }
+  if (retVal == nullptr) {
     return OpReturnType(new NoneVariable());
   }
-  auto retVal = ret->returnVal;
-  delete ret;
   return retVal;
 }
 
@@ -137,7 +175,8 @@ OpReturnType FunctionDef::call_function(const std::vector<OpReturnType>& argumen
   {statementType, [](auto scope, auto line) { return new StatementClass(scope, line); }}
 
 static inline Statement* get_statement_from_line(VariableScope* scope, const nlohmann::json& line) {
-  static std::map<std::string, std::function<Statement*(VariableScope*, const nlohmann::json&)>>
+  static std::unordered_map<std::string,
+                            std::function<Statement*(VariableScope*, const nlohmann::json&)>>
       statementFactory = {
           STAT_REGISTER("Assign", AssignStatement),
           STAT_REGISTER("ImportFrom", ImportStatement),
@@ -157,32 +196,35 @@ static inline Statement* get_statement_from_line(VariableScope* scope, const nlo
           STAT_REGISTER("Raise", RaiseStatement),
           STAT_REGISTER("Try", TryStatement),
       };
-  std::string lineType = line.at("_type");
-  if (statementFactory.find(lineType) == statementFactory.end()) {
+  const auto& lineType = line.at("_type").get_ref<const std::string&>();
+  auto it = statementFactory.find(lineType);
+  if (it == statementFactory.end()) {
     THROW("Could not find implementation for Statement=%s at lineNo=%d", lineType.c_str(),
           line.at("lineno").get<int>());
   }
-  return statementFactory.at(lineType)(scope, line);
+  return it->second(scope, line);
 }
 
 Body::Body(VariableScope* scope, const json& body, Statement* initialStatement) {
   if (initialStatement != nullptr) {
     _codeLines.push_back(initialStatement);
   }
-  for (auto line : body) {  // This is not a literal a line, this is a code block of the below
-                            // type, it denotes a list element from ast.json
+  // This is not a literal a line, this is a code block of the below type, it denotes a list
+  // element from ast.json
+  for (const auto& line : body) {
     _codeLines.push_back(get_statement_from_line(scope, line));
   }
 }
 
 ClassDef::ClassDef(VariableScope* scope, const json& line) : Statement(line) {
-  auto bodyJson = line.at("body");
-  auto className = line.at("name");
+  const auto& bodyJson = line.at("body");
+  const auto& className = line.at("name");
   _classLocation = scope->add_variable(className);
   auto classVariablesScope = scope->add_scope();
   auto functionCreationScope = scope->add_scope();
-  for (auto line : bodyJson) {  // This is not a literal a line, this is a code block of the below
-                                // type, it denotes a list element from ast.json
+  // This is not a literal a line, this is a code block of the below type, it denotes a list
+  // element from ast.json
+  for (const auto& line : bodyJson) {
     std::string lineType = line.at("_type");
     if (lineType == "FunctionDef") {
       auto statement = RuntimeFunctionDef::create_class_member_function_def(
@@ -279,9 +321,9 @@ void ObjectDataVariable::set_member(int memberIndex, OpReturnType d) {
 }
 
 AssertStatement::AssertStatement(VariableScope* scope, const json& line) : Statement(line) {
-  auto testJson = line.at("test");
+  const auto& testJson = line.at("test");
   _testNode = ASTNode::create_node(scope, testJson);
-  auto msgJson = line.at("msg");
+  const auto& msgJson = line.at("msg");
   if (msgJson.type() != json::value_t::null) {
     _msgNode = ASTNode::create_node(scope, msgJson);
   }
@@ -309,7 +351,7 @@ AssertStatement::~AssertStatement() {
 }
 
 RaiseStatement::RaiseStatement(VariableScope* scope, const json& line) : Statement(line) {
-  auto throwJson = line.at("exc");
+  const auto& throwJson = line.at("exc");
   _throwNode = ASTNode::create_node(scope, throwJson);
 }
 
@@ -328,8 +370,8 @@ StatRetType* RaiseStatement::execute(CallStack& stack) {
 RaiseStatement::~RaiseStatement() { delete _throwNode; }
 
 Handler::Handler(VariableScope* scope, const json& line) : Statement(line) {
-  auto handlerBodyJson = line.at("body");
-  auto exceptionVariableName = line.at("name");
+  const auto& handlerBodyJson = line.at("body");
+  const auto& exceptionVariableName = line.at("name");
   if (exceptionVariableName != json::value_t::null) {
     std::string exceptionVar = exceptionVariableName;
     // Exception variable ideally should pe created in a newScope in python
@@ -337,7 +379,7 @@ Handler::Handler(VariableScope* scope, const json& line) : Statement(line) {
     // TODO: This is a big change, cannot be done now. adding in same scope for now.
     _exceptionVariableLocation = scope->add_variable(exceptionVar);
   }
-  auto typeJson = line.at("type");
+  const auto& typeJson = line.at("type");
   if (typeJson != json::value_t::null) {
     _exceptionType = typeJson.at("id");
   }
@@ -360,9 +402,9 @@ StatRetType* Handler::catch_exception(CallStack& stack, OpReturnType exception)
 }
 
 TryStatement::TryStatement(VariableScope* scope, const json& line) : Statement(line) {
-  auto tryJson = line.at("body");
+  const auto& tryJson = line.at("body");
   _tryBody = new Body(scope, tryJson);
-  auto handlerJsons = line.at("handlers");
+  const auto& handlerJsons = line.at("handlers");
   for (auto& handlerJson : handlerJsons) {
     auto handler = std::make_shared<Handler>(scope, handlerJson);
     _handlers.push_back(handler);
@@ -465,13 +507,31 @@ StatRetType* ForStatement::execute(CallStack& stack) {
   return nullptr;
 }
 
+void ForStatement::compile(BytecodeCompiler& compiler) {
+  int iterable = compiler.allocate_registers();
+  int item = compiler.allocate_registers();
+  int counter = compiler.allocate_counter();
+  _iterator->compile(compiler, iterable);
+  compiler.emit(BytecodeOp::FOR_INIT, 0, 0, 0, counter);
+  int loopStart = compiler.current_offset();
+  int exitJump = compiler.emit(BytecodeOp::FOR_NEXT, item, iterable, 0, counter);
+  _newVar->compile_store(compiler, item);
+  compiler.begin_loop(loopStart);
+  compiler.compile_statements(_body->get_statements());
+  compiler.emit(BytecodeOp::JUMP, 0, 0, loopStart);
+  int loopEnd = compiler.current_offset();
+  compiler.emit(BytecodeOp::CLEAR, 0, iterable);
+  compiler.set_jump_target(exitJump, loopEnd);
+  compiler.end_loop(loopEnd);
+}
+
 ForStatement::ForStatement(VariableScope* scope, const json& line) : Statement(line) {
   auto forLoopScope = scope->add_scope();
-  auto newVarJson = line.at("target");
+  const auto& newVarJson = line.at("target");
   _newVar = ASTNode::create_node(forLoopScope, newVarJson);
-  auto iterJson = line.at("iter");
+  const auto& iterJson = line.at("iter");
   _iterator = ASTNode::create_node(forLoopScope, iterJson);
-  auto bodyJson = line.at("body");
+  const auto& bodyJson = line.at("body");
   _body = new Body(forLoopScope, bodyJson);
 }
 
@@ -483,9 +543,9 @@ ForStatement::~ForStatement() {
 
 WhileStatement::WhileStatement(VariableScope* scope, const json& line) : Statement(line) {
   auto whileLoopScope = scope->add_scope();
-  auto testJson = line.at("test");
+  const auto& testJson = line.at("test");
   _testNode = ASTNode::create_node(scope, testJson);
-  auto bodyJson = line.at("body");
+  const auto& bodyJson = line.at("body");
   _body = new Body(whileLoopScope, bodyJson);
 }
 
@@ -508,18 +568,31 @@ StatRetType* WhileStatement::execute(CallStack& stack) {
   return nullptr;
 }
 
+void WhileStatement::compile(BytecodeCompiler& compiler) {
+  int loopStart = compiler.current_offset();
+  int test = compiler.allocate_registers();
+  _testNode->compile(compiler, test);
+  int exitJump = compiler.emit(BytecodeOp::JUMP_IF_FALSE, 0, test);
+  compiler.begin_loop(loopStart);
+  compiler.compile_statements(_body->get_statements());
+  compiler.emit(BytecodeOp::JUMP, 0, 0, loopStart);
+  int loopEnd = compiler.current_offset();
+  compiler.set_jump_target(exitJump, loopEnd);
+  compiler.end_loop(loopEnd);
+}
+
 WhileStatement::~WhileStatement() {
   delete _body;
   delete _testNode;
 }
 
 IfStatement::IfStatement(VariableScope* scope, const json& line) : Statement(line) {
-  auto testJson = line.at("test");
+  const auto& testJson = line.at("test");
   _testNode = ASTNode::create_node(scope, testJson);
   auto trueScope = scope->add_scope();
-  auto trueBodyJson = line.at("body");
+  const auto& trueBodyJson = line.at("body");
   _trueBody = new Body(trueScope, trueBodyJson);
-  auto elseBodyJson = line.at("orelse");
+  const auto& elseBodyJson = line.at("orelse");
   auto elseScope = scope->add_scope();
   _elseBody = new Body(elseScope, elseBodyJson);
 }
@@ -533,6 +606,21 @@ StatRetType* IfStatement::execute(CallStack& stack) {
   }
 }
 
+void IfStatement::compile(BytecodeCompiler& compiler) {
+  int test = compiler.allocate_registers();
+  _testNode->compile(compiler, test);
+  int elseJump = compiler.emit(BytecodeOp::JUMP_IF_FALSE, 0, test);
+  compiler.compile_statements(_trueBody->get_statements());
+  if (_elseBody->get_statements().empty()) {
+    compiler.set_jump_target(elseJump, compiler.current_offset());
+    return;
+  }
+  int endJump = compiler.emit(BytecodeOp::JUMP);
+  compiler.set_jump_target(elseJump, compiler.current_offset());
+  compiler.compile_statements(_elseBody->get_statements());
+  compiler.set_jump_target(endJump, compiler.current_offset());
+}
+
 IfStatement::~IfStatement() {
   delete _trueBody;
   delete _elseBody;
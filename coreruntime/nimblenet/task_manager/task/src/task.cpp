@@ -32,7 +32,8 @@ Task::~Task() {
 
     auto streamPushLock = get_stream_push_lock();
     _threadCleanupInitiated = true;
-    // so thread reaches cleanup
+    // so thread reaches cleanup, even if it is waiting for output of the job
+    if (_streamPushJob) _streamPushJob->stop();
   }
   _streamPushThreadCondition.notify_one();
   _streamPushThread.join();
@@ -43,7 +44,7 @@ Task::Task(const std::string& version, json&& astJson, CommandCenter* commandCen
     : _callStack(commandCenter) {
   _version = version;
   _commandCenter = commandCenter;
-  _astJson = std::move(astJson);
+  _snapshot = ScriptSnapshot::create(astJson);
 
 #ifdef GENAI
   _streamPushThread = std::thread(&Task::run_background_jobs_on_new_thread, this);
@@ -74,7 +75,17 @@ Task::Task(CommandCenter* commandCenter, std::shared_ptr<Asset> taskAsset)
 
   _version = taskAsset->version;
   _commandCenter = commandCenter;
-  _astJson = nlohmann::json::parse(task);
+  // The script is only parsed when it changed since its snapshot was saved
+  auto snapshotPath = nativeinterface::get_full_file_path_common(
+      taskAsset->get_file_name_on_device() + ScriptSnapshot::FileSuffix);
+  auto sourceHash = ScriptSnapshot::hash(task);
+  _snapshot = ScriptSnapshot::load(snapshotPath, sourceHash);
+  if (!_snapshot) {
+    _snapshot = ScriptSnapshot::create(nlohmann::json::parse(task), sourceHash);
+    if (!_snapshot->save(snapshotPath)) {
+      LOG_TO_ERROR("Could not save script snapshot to %s", snapshotPath.c_str());
+    }
+  }
 
 #ifdef GENAI
   _streamPushThread = std::thread(&Task::run_background_jobs_on_new_thread, this);
@@ -91,25 +102,27 @@ void Task::operate(const std::string& functionName, const MapVariablePtr inputs,
 
 void Task::parse_main_module() {
   if (_mainModule) return;
-  json mainAst = _astJson;
-  if (_astJson.contains(MAIN_MODULE)) {
-    mainAst = _astJson.at(MAIN_MODULE);
+  if (!_snapshot) {
+    THROW("%s", "Script is not loaded");
   }
-  _mainModule = std::make_unique<DpModule>(_commandCenter, MAIN_MODULE, 0, mainAst, _callStack);
+  _mainModule = std::make_unique<DpModule>(_commandCenter, ScriptSnapshot::MainModule, 0,
+                                           _snapshot->get_module(ScriptSnapshot::MainModule),
+                                           _callStack);
   LOG_TO_CLIENT_INFO("Script Loaded with version=%s", _version.c_str());
 }
 
 bool Task::has_module(const std::string& module) const {
-  return _modules.find(module) != _modules.end() ||
-         (_astJson.is_object() && _astJson.contains(module));
+  std::lock_guard<std::recursive_mutex> locker(_modulesMutex);
+  return _modules.find(module) != _modules.end() || (_snapshot && _snapshot->has_module(module));
 }
 
 std::shared_ptr<DpModule> Task::get_module(const std::string& name, CallStack& stack) {
+  std::lock_guard<std::recursive_mutex> locker(_modulesMutex);
   if (_modules.find(name) != _modules.end()) {
     return _modules.at(name);
   }
   auto module = std::make_shared<DpModule>(_commandCenter, name, _modules.size() + 1,
-                                           _astJson.at(name), stack);
+                                           _snapshot->get_module(name), stack);
   _modules[name] = module;
   return module;
 }
@@ -121,80 +134,70 @@ void Task::run_background_jobs_until_condition(std::function<bool()>&& condition
   assert(streamPushLock.owns_lock());
 
   while (!condition()) {
-    {
-      if (_streamPushJob) {
-        // Explicitly ignoring return condition of this job run
-        static_cast<void>(_streamPushJob->process_base_job());
-      } else {
-        // Throwing as condition will never be true, unless we are running a job here.
-        THROW("%s", "No background jobs running to process to complete function");
-      }
+    auto job = _streamPushJob;
+    if (!job) {
+      // Throwing as condition will never be true, unless we are running a job here.
+      THROW("%s", "No background jobs running to process to complete function");
     }
-    // for now leaving lock once in a while as maybe someone elses condition becomes true.
-    // TODO: Do this later with condition variable syntax.
+    // Sleep until the producer pushes output, the stream push thread may consume it first
     streamPushLock.unlock();
-    usleep(1);
+    job->wait_for_output();
     streamPushLock.lock();
+    if (_streamPushJob == job && job->process_base_job() == BaseJob::Status::COMPLETE) {
+      _streamPushJob = nullptr;
+    }
   }
 }
 
-void Task::wait_until_stream_push_job_is_created() {
+std::shared_ptr<FillCharStreamJob> Task::wait_until_stream_push_job_is_created() {
   auto lock = get_stream_push_lock();
   // wait until a streamPushJob is created or _thread needs to be stopped
   _streamPushThreadCondition.wait(
       lock, [&] { return _streamPushJob != nullptr || _threadCleanupInitiated; });
+  if (_threadCleanupInitiated) return nullptr;
+  return _streamPushJob;
 }
 
 void Task::run_background_jobs_on_new_thread() {
   // This runs on a separate thread.
-  while (true) {
-    wait_until_stream_push_job_is_created();
-    if (_threadCleanupInitiated) {
-      break;
-    }
-    {
-      // new scope so that destructor of lock is called
-      auto lock = get_stream_push_lock();
-      if (_streamPushJob) {
-        auto status = _streamPushJob->process_base_job();
-        if (status == BaseJob::Status::COMPLETE) {
-          // remove job from thread.
-          _streamPushJob = nullptr;
-          // ideally should notify conditionVariable here, not notifying right now as this is the
-          // only thread that waits
-        }
-      }
+  while (auto job = wait_until_stream_push_job_is_created()) {
+    // Sleep until the producer pushes output instead of polling the job, the stream push lock is
+    // not held meanwhile so functions waiting on the stream can take it
+    job->wait_for_output();
+    auto lock = get_stream_push_lock();
+    // The job may have been completed by a function waiting on the stream, or replaced
+    if (_streamPushJob == job && job->process_base_job() == BaseJob::Status::COMPLETE) {
+      // remove job from thread.
+      _streamPushJob = nullptr;
     }
-    // This sleep is required so that someone waiting gets priority for acquiring lock
-    usleep(1);
   }
 }
 
 BaseJob::Status FillCharStreamJob::process() {
   auto charStream = _charStream.lock();
-  if (!charStream || charStream->closed()) return BaseJob::Status::COMPLETE;
-  int n = _internalQueue->size();
-  // Running till atmost internalQueue size, as LLM thread is continuously running and we would want
-  // other functions to consume the char stream, before the entire output is present
-  while (n-- && !_internalQueue->empty()) {
-    char c = *_internalQueue->front();
-    _internalQueue->pop();
-
-    if (c == '\0') {
-      // producer thread is finished producing
-      charStream->close();
-      return BaseJob::Status::COMPLETE;
-    }
-
-    charStream->push(c);
+  if (!charStream || charStream->closed()) {
+    // Nobody reads the output anymore, don't let the producer block on a full queue
+    _internalQueue->detach();
+    return BaseJob::Status::COMPLETE;
+  }
+  // Everything the LLM thread has produced till now is pushed at once, the next parts of the
+  // output will be consumed in the next try
+  bool finished = _internalQueue->consume(
+      [&](std::string_view text, const std::vector<int32_t>&) { charStream->push(text); });
+  if (finished) {
+    // producer thread is finished producing
+    charStream->close();
+    return BaseJob::Status::COMPLETE;
   }
-  // We have parsed the output that LLM thread has streamed till now.
-  // Next parts of the stream will be consumed in the next try
   return BaseJob::Status::RETRY;
 }
 
-void Task::add_stream_push_job(std::shared_ptr<BaseJob> job) {
+void Task::add_stream_push_job(std::shared_ptr<FillCharStreamJob> job) {
   auto streamPushLock = get_stream_push_lock();
+  if (_streamPushJob) {
+    // Output of the previous job won't be read, wake up threads waiting for it
+    _streamPushJob->stop();
+  }
   _streamPushJob = job;
   // using one or all is the same, as only one thread is waiting on this condition variable
   _streamPushThreadCondition.notify_one();
@@ -203,11 +206,13 @@ void Task::add_stream_push_job(std::shared_ptr<BaseJob> job) {
 
 void Task::save_future(std::shared_ptr<FutureDataVariable> futureVal) {
   _commandCenter->update_dependency_of_script_ready_job(futureVal->get_job());
+  std::lock_guard<std::mutex> locker(_pendingFuturesMutex);
   _pendingFutures.push_back(std::weak_ptr<FutureDataVariable>(futureVal));
 }
 
 bool Task::is_ready() noexcept {
   try {
+    std::lock_guard<std::mutex> locker(_pendingFuturesMutex);
     while (!_pendingFutures.empty()) {
       auto futureWeakVal = _pendingFutures.back();
       auto futureVal = futureWeakVal.lock();
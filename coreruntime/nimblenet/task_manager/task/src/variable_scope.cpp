@@ -16,18 +16,44 @@ StackLocation StackLocation::local(int moduleIndex, int functionIndex, int varIn
   return StackLocation(moduleIndex, functionIndex, varIndex);
 }
 
+namespace {
+
+// Frames of calls that ended are kept per thread and reused by the next call, so that a function
+// call does not allocate a frame, its control block or its slots. Frames still referenced by a
+// closure when their call ends are not pooled.
+constexpr size_t kMaxPooledStackFrames = 64;
+thread_local std::vector<std::shared_ptr<StackFrame>> stackFramePool;
+
+}  // namespace
+
+void StackFrame::reset(int moduleIndex, int functionIndex, int numVariables) {
+  _moduleIndex = moduleIndex;
+  _functionIndex = functionIndex;
+  _numVariables = numVariables;
+  if (numVariables > _capacity) {
+    _varValues.reset(new OpReturnType[numVariables]);
+    _capacity = numVariables;
+  }
+  _shared.store(false, std::memory_order_relaxed);
+}
+
+void StackFrame::clear() {
+  for (int i = 0; i < _numVariables; i++) {
+    _varValues[i] = nullptr;
+  }
+}
+
 // Responsibility of caller to ensure that the location is correct
 OpReturnType CallStack::get_variable(StackLocation loc) const {
-  assert(loc._moduleIndex < _moduleToStackFrameMap.size() &&
-         loc._functionIndex < _moduleToStackFrameMap[loc._moduleIndex].size());
-  const auto stackFramePtr = _moduleToStackFrameMap[loc._moduleIndex][loc._functionIndex].back();
-  return stackFramePtr->get(loc._varIndex);
+  assert(loc._moduleIndex < _currentFrames.size() &&
+         loc._functionIndex < _currentFrames[loc._moduleIndex].size());
+  return _currentFrames[loc._moduleIndex][loc._functionIndex]->get(loc._varIndex);
 }
 
 // Caller will ensure the StackLocation is correct
 void CallStack::set_variable(StackLocation loc, OpReturnType val) {
-  assert(loc._moduleIndex < _moduleToStackFrameMap.size() &&
-         loc._functionIndex < _moduleToStackFrameMap[loc._moduleIndex].size());
+  assert(loc._moduleIndex < _currentFrames.size() &&
+         loc._functionIndex < _currentFrames[loc._moduleIndex].size());
 
   if (auto futureVal = std::dynamic_pointer_cast<FutureDataVariable>(val); futureVal) {
     // Internally, the function will call _task->save_future() only once. Hence futures can be
@@ -35,8 +61,7 @@ void CallStack::set_variable(StackLocation loc, OpReturnType val) {
     futureVal->save_to_task(*task());
   }
 
-  auto stackFramePtr = _moduleToStackFrameMap[loc._moduleIndex][loc._functionIndex].back();
-  stackFramePtr->set(loc._varIndex, val);
+  _currentFrames[loc._moduleIndex][loc._functionIndex]->set(loc._varIndex, std::move(val));
 }
 
 CallStack::CallStack(const CallStack& other) { *this = other; }
@@ -46,7 +71,7 @@ CallStack& CallStack::operator=(const CallStack& other) {
     return *this;  // Handle self-assignment
   }
   _functionsStack = other._functionsStack;
-  _moduleToStackFrameMap = other._moduleToStackFrameMap;
+  _currentFrames = other._currentFrames;
   _commandCenter = other._commandCenter;
   return *this;
 }
@@ -61,31 +86,59 @@ CallStack CallStack::create_copy_with_deferred_lock() {
 std::shared_ptr<Task> CallStack::task() noexcept { return _commandCenter->get_task(); }
 
 void CallStack::enter_function_frame(int moduleIndex, int functionIndex, int numVariablesInFrame) {
-  if (moduleIndex >= _moduleToStackFrameMap.size()) {
-    _moduleToStackFrameMap.resize(moduleIndex + 1);
+  if (moduleIndex >= _currentFrames.size()) {
+    _currentFrames.resize(moduleIndex + 1);
   }
-  if (functionIndex >= _moduleToStackFrameMap[moduleIndex].size()) {
-    _moduleToStackFrameMap[moduleIndex].resize(functionIndex + 1);
+  if (functionIndex >= _currentFrames[moduleIndex].size()) {
+    _currentFrames[moduleIndex].resize(functionIndex + 1);
   }
-  // Not calling make_shared since StackFrame's constructor is private
-  std::shared_ptr<StackFrame> stackFramePtr{
-      new StackFrame{moduleIndex, functionIndex, numVariablesInFrame}};
-  _moduleToStackFrameMap[moduleIndex][functionIndex].push_back(stackFramePtr);
-  _functionsStack.push_back(stackFramePtr);
+  StackFramePtr stackFramePtr;
+  if (!stackFramePool.empty()) {
+    stackFramePtr = std::move(stackFramePool.back());
+    stackFramePool.pop_back();
+    stackFramePtr->reset(moduleIndex, functionIndex, numVariablesInFrame);
+  } else {
+    // Not calling make_shared since StackFrame's constructor is private
+    stackFramePtr.reset(new StackFrame{moduleIndex, functionIndex, numVariablesInFrame});
+  }
+  auto& currentFrame = _currentFrames[moduleIndex][functionIndex];
+  _functionsStack.push_back({stackFramePtr, std::move(currentFrame)});
+  currentFrame = std::move(stackFramePtr);
 }
 
 void CallStack::exit_function_frame() {
   if (_functionsStack.size() == 0) {
     THROW("%s", "Attempting to exit function frame when there is currently no function running");
   }
-  const auto currentStackFramePtr = _functionsStack.back();
+  auto activeFrame = std::move(_functionsStack.back());
   _functionsStack.pop_back();
-  auto& currentFunctionExecs = _moduleToStackFrameMap[currentStackFramePtr->get_module_index()]
-                                                     [currentStackFramePtr->get_function_index()];
-  if (currentFunctionExecs.size() == 0) {
+  auto& currentFrame = _currentFrames[activeFrame.frame->get_module_index()]
+                                     [activeFrame.frame->get_function_index()];
+  if (currentFrame != activeFrame.frame) {
     THROW("%s", "Function existed in functions stack, but can't find its frame pointer");
   }
-  currentFunctionExecs.pop_back();
+  currentFrame = std::move(activeFrame.shadowedFrame);
+
+  // A frame owned only by this call cannot be reached by any other thread, so it can be reused
+  auto& stackFramePtr = activeFrame.frame;
+  if (stackFramePtr.use_count() == 1 && stackFramePool.size() < kMaxPooledStackFrames) {
+    stackFramePtr->clear();
+    stackFramePool.push_back(std::move(stackFramePtr));
+  }
+}
+
+void CallStack::mark_frames_shared() {
+  for (auto& moduleFrames : _currentFrames) {
+    for (auto& frame : moduleFrames) {
+      if (frame) {
+        frame->mark_shared();
+      }
+    }
+  }
+  // Frames of enclosing recursive calls are not visible through _currentFrames
+  for (auto& activeFrame : _functionsStack) {
+    activeFrame.frame->mark_shared();
+  }
 }
 
 VariableScope::VariableScope(VariableScope* p, bool isNewFunction) {
@@ -97,9 +150,11 @@ VariableScope::VariableScope(VariableScope* p, bool isNewFunction) {
     _currentFunctionIndex = *_nextFunctionIndex;
     *_nextFunctionIndex += 1;
     _numVariablesStack = std::make_shared<int>(0);
+    _writesSharedState = std::make_shared<std::atomic<bool>>(false);
   } else {
     _currentFunctionIndex = p->_currentFunctionIndex;
     _numVariablesStack = p->_numVariablesStack;
+    _writesSharedState = p->_writesSharedState;
   }
 }
 
@@ -111,6 +166,7 @@ VariableScope::VariableScope(CommandCenter* commandCenter, int moduleIndex) {
   _currentFunctionIndex = 0;
   _nextFunctionIndex = std::make_shared<int>(1);
   _numVariablesStack = std::make_shared<int>(0);
+  _writesSharedState = std::make_shared<std::atomic<bool>>(false);
 }
 
 StackLocation VariableScope::add_variable(const std::string& variableName) {
@@ -159,6 +215,20 @@ VariableScope::~VariableScope() {
   }
 }
 
+bool VariableScope::is_bytecode_enabled() const {
+  if (_commandCenter == nullptr || _commandCenter->get_config() == nullptr) {
+    return false;
+  }
+  return _commandCenter->get_config()->bytecodeInterpreter;
+}
+
+bool VariableScope::is_script_concurrency_enabled() const {
+  if (_commandCenter == nullptr || _commandCenter->get_config() == nullptr) {
+    return false;
+  }
+  return _commandCenter->get_config()->scriptConcurrency;
+}
+
 int VariableScope::create_new_variable() {
   int ret = *_numVariablesStack;
   (*_numVariablesStack)++;
@@ -65,7 +65,7 @@ class Time {
   /**
    * @brief Get the current time formatted for event store files.
    *
-   * @return String in the format "<seconds>.<microseconds>".
+   * @return String in the format "<seconds>.<microseconds>", microseconds padded to 6 digits.
    */
   static std::string get_time_for_event_store_file();
   /**
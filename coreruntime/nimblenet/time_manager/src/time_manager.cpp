@@ -46,7 +46,10 @@ std::string Time::get_time_for_event_store_file() {
   int64_t seconds = std::chrono::duration_cast<std::chrono::seconds>(duration).count();
   int64_t micros =
       std::chrono::duration_cast<std::chrono::microseconds>(duration).count() % 1000000;
-  return std::to_string(seconds) + "." + std::to_string(micros);
+  // Zero padded so that file names sort in time order
+  std::ostringstream name;
+  name << seconds << "." << std::setw(6) << std::setfill('0') << micros;
+  return name.str();
 }
 
 int64_t Time::get_time_in_micro() {
@@ -16,15 +16,27 @@
  *
  * Defines the interface for different types of aggregations (e.g., Sum, Count, Min, Max, Avg)
  * over a rolling window of events. Manages the state for a specific aggregation
- * on a single column for a particular group.
+ * on a single column for a particular group. The rolling window adds events of the group as they
+ * arrive and removes them in the same order once they expire, so every aggregation is updated in
+ * amortized constant time per event.
  */
 class AggregateColumn {
   using T = double; /**< Type alias for the aggregation data type. */
 
+ protected:
+  /**
+   * @brief Computes the aggregated value over the events currently in the window.
+   *
+   * Only called when there is at least one event in the window.
+   *
+   * @return The aggregated value.
+   */
+  virtual T get_value() const = 0;
+
  public:
   T* _storeValue = nullptr; /**< Pointer to the location where the aggregated value is stored. */
   int _columnId; /**< Index of the column being aggregated. */
-  std::string _group; /**< Group identifier this aggregation belongs to. */
+  int _group; /**< Dense id of the group this aggregation belongs to. */
   int _preprocessorId; /**< Identifier of the preprocessor this aggregation is for. */
   T _defaultValue; /**< Default value for this aggregation. */
   int _totalCount = 0; /**< Total number of events considered in the aggregation. */
@@ -34,10 +46,10 @@ class AggregateColumn {
    *
    * @param preprocessorId Identifier of the parent preprocessor.
    * @param columnId Index of the column to aggregate.
-   * @param group Group identifier for this aggregation.
+   * @param group Dense id of the group for this aggregation.
    * @param storePtr Pointer to where the aggregated value is stored.
    */
-  AggregateColumn(int preprocessorId, int columnId, const std::string& group, T* storePtr) {
+  AggregateColumn(int preprocessorId, int columnId, int group, T* storePtr) {
     _preprocessorId = preprocessorId;
     _columnId = columnId;
     _group = group;
@@ -48,19 +60,25 @@ class AggregateColumn {
   /**
    * @brief Adds a new event to the aggregation.
    *
-   * @param allEvents Vector of all events in the table.
+   * @param tableData Columns of all events in the table.
    * @param newEventIndex Index of the new event to add.
    */
-  virtual void add_event(const std::vector<TableEvent>& allEvents, int newEventIndex) = 0;
+  virtual void add_event(const TableData& tableData, int newEventIndex) = 0;
 
   /**
-   * @brief Removes expired events from the aggregation.
+   * @brief Removes the oldest event of the group from the aggregation.
    *
-   * @param allEvents Vector of all events in the table.
-   * @param oldestValidIndex Index of the oldest event still in the window.
+   * @param tableData Columns of all events in the table.
+   * @param eventIndex Index of the expired event, always the oldest one still in the aggregation.
    */
-  virtual void remove_events(const std::vector<TableEvent>& allEvents, int oldestValidIndex) = 0;
-  
+  virtual void remove_event(const TableData& tableData, int eventIndex) = 0;
+
+  /**
+   * @brief Writes the aggregated value, or the default value if the window is empty, to the
+   * feature vector.
+   */
+  void store_value() { *_storeValue = _totalCount == 0 ? _defaultValue : get_value(); }
+
   /**
    * @brief Virtual destructor.
    */
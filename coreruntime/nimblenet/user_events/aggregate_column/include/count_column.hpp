@@ -16,7 +16,12 @@
  */
 class CountColumn final : public AggregateColumn {
   using T = double; /**< Type alias for the aggregation data type. */
-  int _oldestIndex = -1; /**< Index of the oldest event included in the aggregation. */
+
+ protected:
+  /**
+   * @brief Returns the number of events in the window.
+   */
+  T get_value() const override;
 
  public:
   /**
@@ -24,25 +29,25 @@ class CountColumn final : public AggregateColumn {
    *
    * @param preprocessorId Identifier of the parent preprocessor.
    * @param columnId Index of the column to aggregate.
-   * @param group Group identifier for this aggregation.
+   * @param group Dense id of the group for this aggregation.
    * @param storePtr Pointer to where the aggregated value is stored.
    */
-  CountColumn(int preprocessorId, int columnId, const std::string& group, T* storePtr)
+  CountColumn(int preprocessorId, int columnId, int group, T* storePtr)
       : AggregateColumn(preprocessorId, columnId, group, storePtr) {};
 
   /**
-   * @brief Increments the event count.
+   * @brief Increments the count for the new event.
    *
-   * @param allEvents Vector of all events in the table.
+   * @param tableData Columns of all events in the table.
    * @param newEventIndex Index of the new event to add.
    */
-  void add_event(const std::vector<TableEvent>& allEvents, int newEventIndex) override;
-  
+  void add_event(const TableData& tableData, int newEventIndex) override;
+
   /**
-   * @brief Decrements the event count for expired events.
+   * @brief Decrements the count for the expired event.
    *
-   * @param allEvents Vector of all events in the table.
-   * @param oldestValidIndex Index of the oldest event still in the window.
+   * @param tableData Columns of all events in the table.
+   * @param eventIndex Index of the expired event.
    */
-  void remove_events(const std::vector<TableEvent>& allEvents, int oldestValidIndex) override;
+  void remove_event(const TableData& tableData, int eventIndex) override;
 };
@@ -6,17 +6,28 @@
 
 #pragma once
 
+#include <deque>
+#include <utility>
+
 #include "aggregate_column.hpp"
 
 /**
  * @brief Calculates the minimum value of a column over a rolling window.
  *
  * This class maintains the running minimum value for a specific column and group.
- * It re-scans the window to find the new minimum if the current one expires.
+ * Candidates for the minimum are kept in a monotonic deque: values only increase from front to
+ * back and a new value evicts every candidate that is not smaller, since those can never be the
+ * minimum again. The front is the minimum and is dropped once its event expires.
  */
 class MinColumn final : public AggregateColumn {
   using T = double; /**< Type alias for the aggregation data type. */
-  int _oldestIndex = -1; /**< Index of the oldest event included in the aggregation. */
+  std::deque<std::pair<int, T>> _candidates; /**< (event index, value) of possible minimums. */
+
+ protected:
+  /**
+   * @brief Returns the value at the front of the candidates.
+   */
+  T get_value() const override;
 
  public:
   /**
@@ -24,25 +35,25 @@ class MinColumn final : public AggregateColumn {
    *
    * @param preprocessorId Identifier of the parent preprocessor.
    * @param columnId Index of the column to aggregate.
-   * @param group Group identifier for this aggregation.
+   * @param group Dense id of the group for this aggregation.
    * @param storePtr Pointer to where the aggregated value is stored.
    */
-  MinColumn(int preprocessorId, int columnId, const std::string& group, T* storePtr)
+  MinColumn(int preprocessorId, int columnId, int group, T* storePtr)
       : AggregateColumn(preprocessorId, columnId, group, storePtr) {};
-  
+
   /**
-   * @brief Updates the minimum value if new event's value is lower.
+   * @brief Adds the new event's value as a candidate for the minimum.
    *
-   * @param allEvents Vector of all events in the table.
+   * @param tableData Columns of all events in the table.
    * @param newEventIndex Index of the new event to add.
    */
-  void add_event(const std::vector<TableEvent>& allEvents, int newEventIndex) override;
+  void add_event(const TableData& tableData, int newEventIndex) override;
 
   /**
-   * @brief Removes expired events and recalculates the minimum if necessary.
+   * @brief Drops the expired event from the candidates if it is the current minimum.
    *
-   * @param allEvents Vector of all events in the table.
-   * @param oldestValidIndex Index of the oldest event still in the window.
+   * @param tableData Columns of all events in the table.
+   * @param eventIndex Index of the expired event.
    */
-  void remove_events(const std::vector<TableEvent>& allEvents, int oldestValidIndex) override;
+  void remove_event(const TableData& tableData, int eventIndex) override;
 };
@@ -15,7 +15,13 @@
  */
 class SumColumn final : public AggregateColumn {
   using T = double; /**< Type alias for the aggregation data type. */
-  int _oldestIndex = -1; /**< Index of the oldest event included in the aggregation. */
+  T _sum = 0; /**< The running sum of the column values. */
+
+ protected:
+  /**
+   * @brief Returns the running sum.
+   */
+  T get_value() const override;
 
  public:
   /**
@@ -23,25 +29,25 @@ class SumColumn final : public AggregateColumn {
    *
    * @param preprocessorId Identifier of the parent preprocessor.
    * @param columnId Index of the column to aggregate.
-   * @param group Group identifier for this aggregation.
+   * @param group Dense id of the group for this aggregation.
    * @param storePtr Pointer to where the aggregated value is stored.
    */
-  SumColumn(int preprocessorId, int columnId, const std::string& group, T* storePtr)
+  SumColumn(int preprocessorId, int columnId, int group, T* storePtr)
       : AggregateColumn(preprocessorId, columnId, group, storePtr) {};
 
   /**
-   * @brief Adds a new event's value to the running sum.
+   * @brief Adds the new event's value to the running sum.
    *
-   * @param allEvents Vector of all events in the table.
+   * @param tableData Columns of all events in the table.
    * @param newEventIndex Index of the new event to add.
    */
-  void add_event(const std::vector<TableEvent>& allEvents, int newEventIndex) override;
+  void add_event(const TableData& tableData, int newEventIndex) override;
 
   /**
-   * @brief Subtracts expired events' values from the running sum.
+   * @brief Subtracts the expired event's value from the running sum.
    *
-   * @param allEvents Vector of all events in the table.
-   * @param oldestValidIndex Index of the oldest event still in the window.
+   * @param tableData Columns of all events in the table.
+   * @param eventIndex Index of the expired event.
    */
-  void remove_events(const std::vector<TableEvent>& allEvents, int oldestValidIndex) override;
+  void remove_event(const TableData& tableData, int eventIndex) override;
 };
@@ -10,37 +10,24 @@
 
 using namespace std;
 
-void AverageColumn::add_event(const std::vector<TableEvent>& allEvents, int newEventIndex) {
-  const auto& event = allEvents[newEventIndex];
-  const auto eventGroup = event.groups[this->_preprocessorId];
+void AverageColumn::add_event(const TableData& tableData, int newEventIndex) {
+  int eventGroup = tableData.groups[this->_preprocessorId][newEventIndex];
   if (eventGroup != this->_group) {
-    LOG_TO_ERROR("AverageColumn: add_event event.group=%s not same as column.group=%s",
-                 eventGroup.c_str(), this->_group.c_str());
+    LOG_TO_ERROR("AverageColumn: add_event event.group=%d not same as column.group=%d",
+                 eventGroup, this->_group);
     return;
   }
   this->_totalCount++;
-  if (_oldestIndex == -1) {
-    _oldestIndex = newEventIndex;
-  }
-  _sum += event.row[this->_columnId]->template get<T>();
-  *this->_storeValue = _sum / this->_totalCount;
+  _sum += tableData.columnValues[this->_columnId].get<T>(newEventIndex);
 }
 
-void AverageColumn::remove_events(const std::vector<TableEvent>& allEvents, int oldestValidIndex) {
-  if (_oldestIndex == -1) return;
-  for (int i = _oldestIndex; i < oldestValidIndex; i++) {
-    const auto eventGroup = allEvents[i].groups[this->_preprocessorId];
-    if (eventGroup == this->_group) {
-      this->_totalCount--;
-      _sum -= allEvents[i].row[this->_columnId]->template get<T>();
-    }
-  }
+void AverageColumn::remove_event(const TableData& tableData, int eventIndex) {
+  this->_totalCount--;
   if (this->_totalCount == 0) {
     _sum = 0;
-    *this->_storeValue = this->_defaultValue;
-    _oldestIndex = -1;
     return;
   }
-  *this->_storeValue = _sum / this->_totalCount;
-  _oldestIndex = oldestValidIndex;
+  _sum -= tableData.columnValues[this->_columnId].get<T>(eventIndex);
 }
+
+AverageColumn::T AverageColumn::get_value() const { return _sum / this->_totalCount; }
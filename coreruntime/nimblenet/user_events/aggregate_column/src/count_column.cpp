@@ -10,36 +10,16 @@
 
 using namespace std;
 
-void CountColumn::add_event(const std::vector<TableEvent>& allEvents, int newEventIndex) {
-  const auto& event = allEvents[newEventIndex];
-  const auto eventGroup = event.groups[this->_preprocessorId];
+void CountColumn::add_event(const TableData& tableData, int newEventIndex) {
+  int eventGroup = tableData.groups[this->_preprocessorId][newEventIndex];
   if (eventGroup != this->_group) {
-    LOG_TO_ERROR("CountColumn: add_event event.group=%s not same as column.group=%s",
-                 eventGroup.c_str(), this->_group.c_str());
+    LOG_TO_ERROR("CountColumn: add_event event.group=%d not same as column.group=%d",
+                 eventGroup, this->_group);
     return;
   }
   this->_totalCount++;
-  if (_oldestIndex == -1) {
-    _oldestIndex = newEventIndex;
-    *this->_storeValue = 1;
-    return;
-  }
-  *this->_storeValue = (*this->_storeValue) + 1;
 }
 
-void CountColumn::remove_events(const std::vector<TableEvent>& allEvents, int oldestValidIndex) {
-  if (_oldestIndex == -1) return;
-  for (int i = _oldestIndex; i < oldestValidIndex; i++) {
-    const auto eventGroup = allEvents[i].groups[this->_preprocessorId];
-    if (eventGroup == this->_group) {
-      *this->_storeValue = (*this->_storeValue) - 1;
-      this->_totalCount--;
-    }
-  }
-  if (this->_totalCount == 0) {
-    *this->_storeValue = this->_defaultValue;
-    _oldestIndex = -1;
-    return;
-  }
-  _oldestIndex = oldestValidIndex;
-}
+void CountColumn::remove_event(const TableData& tableData, int eventIndex) { this->_totalCount--; }
+
+CountColumn::T CountColumn::get_value() const { return this->_totalCount; }
@@ -6,60 +6,31 @@
 
 #include "max_column.hpp"
 
-#include "data_variable.hpp"
 #include "util.hpp"
 
 using namespace std;
 
-void MaxColumn::add_event(const std::vector<TableEvent>& allEvents, int newEventIndex) {
-  const auto& event = allEvents[newEventIndex];
-  const auto eventGroup = event.groups[this->_preprocessorId];
+void MaxColumn::add_event(const TableData& tableData, int newEventIndex) {
+  int eventGroup = tableData.groups[this->_preprocessorId][newEventIndex];
   if (eventGroup != this->_group) {
-    LOG_TO_ERROR("MaxColumn: add_event event.group=%s not same as column.group=%s",
-                 eventGroup.c_str(), this->_group.c_str());
+    LOG_TO_ERROR("MaxColumn: add_event event.group=%d not same as column.group=%d",
+                 eventGroup, this->_group);
     return;
   }
   this->_totalCount++;
-  if (_oldestIndex == -1) {
-    _oldestIndex = newEventIndex;
-    *this->_storeValue = event.row[this->_columnId]->template get<T>();
-    return;
+  T val = tableData.columnValues[this->_columnId].get<T>(newEventIndex);
+  while (!_candidates.empty() && _candidates.back().second <= val) {
+    _candidates.pop_back();
   }
-
-  *this->_storeValue = max(*this->_storeValue, event.row[this->_columnId]->template get<T>());
+  _candidates.emplace_back(newEventIndex, val);
 }
 
-void MaxColumn::remove_events(const std::vector<TableEvent>& allEvents, int oldestValidIndex) {
-  if (_oldestIndex == -1) return;
-  bool isMaxChanged = false;
-  for (int i = _oldestIndex; i < allEvents.size(); i++) {
-    if (!isMaxChanged && (i >= oldestValidIndex)) {
-      break;
-    }
-    const auto eventGroup = allEvents[i].groups[this->_preprocessorId];
-    if (eventGroup == this->_group) {
-      T val = allEvents[i].row[this->_columnId]->template get<T>();
-      if (isMaxChanged) {
-        if (this->_totalCount == 0) {
-          *this->_storeValue = val;
-          _oldestIndex = i;
-        } else
-          *this->_storeValue = max(*this->_storeValue, val);
-        this->_totalCount++;
-      } else if (val == *this->_storeValue) {
-        isMaxChanged = true;
-        this->_totalCount = 0;
-        *this->_storeValue = this->_defaultValue;
-        i = oldestValidIndex - 1;
-      } else {
-        this->_totalCount--;
-      }
-    }
+void MaxColumn::remove_event(const TableData& tableData, int eventIndex) {
+  this->_totalCount--;
+  // Events expire in order, so an expired candidate can only be at the front
+  if (!_candidates.empty() && _candidates.front().first == eventIndex) {
+    _candidates.pop_front();
   }
-  if (this->_totalCount == 0) {
-    *this->_storeValue = this->_defaultValue;
-    _oldestIndex = -1;
-    return;
-  }
-  _oldestIndex = oldestValidIndex;
 }
+
+MaxColumn::T MaxColumn::get_value() const { return _candidates.front().second; }
@@ -10,37 +10,25 @@
 
 using namespace std;
 
-void SumColumn::add_event(const std::vector<TableEvent>& allEvents, int newEventIndex) {
-  const auto& event = allEvents[newEventIndex];
-  const auto eventGroup = event.groups[this->_preprocessorId];
+void SumColumn::add_event(const TableData& tableData, int newEventIndex) {
+  int eventGroup = tableData.groups[this->_preprocessorId][newEventIndex];
   if (eventGroup != this->_group) {
-    LOG_TO_ERROR("SumColumn: add_event event.group=%s not same as column.group=%s",
-                 eventGroup.c_str(), this->_group.c_str());
+    LOG_TO_ERROR("SumColumn: add_event event.group=%d not same as column.group=%d",
+                 eventGroup, this->_group);
     return;
   }
   this->_totalCount++;
-  if (_oldestIndex == -1) {
-    _oldestIndex = newEventIndex;
-    *this->_storeValue = event.row[this->_columnId]->template get<T>();
-    return;
-  }
-  *this->_storeValue = (*this->_storeValue) + event.row[this->_columnId]->template get<T>();
+  _sum += tableData.columnValues[this->_columnId].get<T>(newEventIndex);
 }
 
-void SumColumn::remove_events(const std::vector<TableEvent>& allEvents, int oldestValidIndex) {
-  if (_oldestIndex == -1) return;
-  for (int i = _oldestIndex; i < oldestValidIndex; i++) {
-    const auto eventGroup = allEvents[i].groups[this->_preprocessorId];
-    if (eventGroup == this->_group) {
-      this->_totalCount--;
-      *this->_storeValue =
-          (*this->_storeValue) - allEvents[i].row[this->_columnId]->template get<T>();
-    }
-  }
+void SumColumn::remove_event(const TableData& tableData, int eventIndex) {
+  this->_totalCount--;
+  // Resetting once the window is empty keeps floating point error from accumulating forever
   if (this->_totalCount == 0) {
-    *this->_storeValue = this->_defaultValue;
-    _oldestIndex = -1;
+    _sum = 0;
     return;
   }
-  _oldestIndex = oldestValidIndex;
+  _sum -= tableData.columnValues[this->_columnId].get<T>(eventIndex);
 }
+
+SumColumn::T SumColumn::get_value() const { return _sum; }
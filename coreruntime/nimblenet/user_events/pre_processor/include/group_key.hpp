@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Index from composite group keys to dense group ids.
+ *
+ * Values of the group-by columns are interned once into 32-bit ids, so a group is a fixed-width
+ * tuple of ids with one entry per group-by column. Tuples are stored contiguously and looked up
+ * through an open-addressing hash table with linear probing, which returns the dense id of the
+ * group. Dense ids are assigned in insertion order starting from 0.
+ */
+class GroupKeyIndex {
+  static constexpr int32_t kEmptySlot = -1;
+
+  int _numColumns; /**< Number of values in a composite key. */
+  std::unordered_map<std::string, uint32_t> _valueIds; /**< Interned values of group columns. */
+  std::vector<uint32_t> _keys; /**< Composite keys of all groups, _numColumns ids per group. */
+  std::vector<uint64_t> _hashes; /**< Hash of the composite key of every group. */
+  std::vector<int32_t> _slots; /**< Open-addressing table of group ids, size is a power of 2. */
+
+  /**
+   * @brief Hashes a composite key of interned value ids.
+   */
+  uint64_t hash_key(const uint32_t* ids) const;
+
+  /**
+   * @brief Probes the table for a composite key.
+   *
+   * @param ids Interned value ids of the key.
+   * @param hash Hash of the key.
+   * @return Slot holding the group if found, otherwise the empty slot where it would be inserted.
+   */
+  size_t probe(const uint32_t* ids, uint64_t hash) const;
+
+  /**
+   * @brief Doubles the table and reinserts all groups using their stored hashes.
+   */
+  void grow();
+
+  /**
+   * @brief Looks up the interned ids of the values of a group without interning new values.
+   *
+   * @return false if any of the values was never interned, in which case the group cannot exist.
+   */
+  bool find_value_ids(const std::vector<std::string>& values, uint32_t* ids) const;
+
+ public:
+  /**
+   * @brief Sentinel returned for groups which are not present in the index.
+   */
+  static constexpr int kNotFound = -1;
+
+  /**
+   * @brief Constructor for GroupKeyIndex.
+   *
+   * @param numColumns Number of group-by columns in a composite key.
+   */
+  explicit GroupKeyIndex(int numColumns);
+
+  /**
+   * @brief Returns the dense id of a group, adding the group and interning its values if needed.
+   *
+   * @param values Value of each group-by column, in the order of the group-by columns.
+   * @return Dense id of the group.
+   */
+  int get_or_insert(const std::vector<std::string>& values);
+
+  /**
+   * @brief Returns the dense id of a group without modifying the index.
+   *
+   * @param values Value of each group-by column, in the order of the group-by columns.
+   * @return Dense id of the group, or kNotFound.
+   */
+  int find(const std::vector<std::string>& values) const;
+
+  /**
+   * @brief Looks up many groups at once.
+   *
+   * Hashes of all keys are computed first and their slots prefetched, so that the cache misses of
+   * the probes overlap instead of being paid one group at a time.
+   *
+   * @param allValues Values of the group-by columns for every group to look up.
+   * @param groupIds Output dense id of every group, or kNotFound. Resized to allValues.size().
+   */
+  void find_batch(const std::vector<std::vector<std::string>>& allValues,
+                  std::vector<int>& groupIds) const;
+
+  /**
+   * @brief Gets the number of groups in the index.
+   */
+  int num_groups() const { return _hashes.size(); }
+
+  /**
+   * @brief Gets the number of values in a composite key.
+   */
+  int num_columns() const { return _numColumns; }
+};
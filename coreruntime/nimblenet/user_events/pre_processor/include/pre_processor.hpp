@@ -6,11 +6,11 @@
 
 #pragma once
 
-#include <map>
 #include <string>
 #include <vector>
 
 #include "data_variable.hpp"
+#include "group_key.hpp"
 #include "util.hpp"
 #include "rolling_window.hpp"
 #include "user_events_struct.hpp"
@@ -34,39 +34,38 @@ class BasePreProcessor {
   virtual void add_event(int newEventIndex) = 0;
 
   /**
-   * @brief Extracts group identifier from a table event.
+   * @brief Extracts the group of a table event.
    *
-   * Creates a group identifier by concatenating values from group columns
-   * in the TableEvent.
+   * Interns the values of the group columns of the event and returns the dense id of their
+   * composite group key.
    *
-   * @param e TableEvent to extract group from.
-   * @return Group identifier as a string.
+   * @param eventIndex Index of the event in the table.
+   * @return Dense group id of the event.
    */
-  virtual std::string get_group_from_event(const TableEvent& e) = 0;
+  virtual int get_group_from_event(int eventIndex) = 0;
 
   /**
-   * @brief Extracts group identifier from row data with validation.
+   * @brief Extracts group values from row data with validation.
    *
-   * Creates a group identifier by concatenating values from group columns
-   * in the row data. Validates that all required group columns have data
-   * before creating the group. Returns false if any required column is missing.
+   * Collects values of the group columns in the row data. Validates that all required group
+   * columns have data before creating the group. Returns false if any required column is missing.
    *
    * @param row Vector of string values representing a row.
    * @param columnsFilled Vector indicating which columns have valid data.
-   * @param retGroup Output parameter for the extracted group.
+   * @param retGroup Output parameter for the value of each group column.
    * @return true if group extraction was successful, false if required columns are missing.
    */
   virtual bool get_group_from_row(const std::vector<std::string>& row,
                                   const std::vector<bool>& columnsFilled,
-                                  std::string& retGroup) = 0;
+                                  std::vector<std::string>& retGroup) = 0;
 
   /**
-   * @brief Extracts group identifiers from JSON input.
+   * @brief Extracts group values from JSON input.
    *
    * @param preprocessorInput JSON array containing event data.
-   * @return Vector of group identifiers.
+   * @return Values of the group columns for every entry of the input.
    */
-  virtual std::vector<std::string> get_groups_from_json(
+  virtual std::vector<std::vector<std::string>> get_groups_from_json(
       const nlohmann::json& preprocessorInput) = 0;
 
   /**
@@ -77,14 +76,6 @@ class BasePreProcessor {
    */
   virtual std::shared_ptr<ModelInput> get_model_input(const nlohmann::json& preprocessorInput) = 0;
 
-  /**
-   * @brief Generates model input data variable from group identifiers.
-   *
-   * @param groups Vector of group identifiers.
-   * @return Data variable containing processed model input.
-   */
-  virtual OpReturnType get_model_input_data_variable(const std::vector<std::string>& groups) = 0;
-
   /**
    * @brief Generates model input data variable from JSON data.
    *
@@ -96,6 +87,8 @@ class BasePreProcessor {
   /**
    * @brief Generates model input data variable from nested group vectors.
    *
+   * All groups are looked up in one batch.
+   *
    * @param allGroups Vector of group vectors.
    * @return Data variable containing processed model input.
    */
@@ -109,14 +102,6 @@ class BasePreProcessor {
    */
   virtual int get_num_of_groupBys() = 0;
 
-  /**
-   * @brief Creates group identifier from group vector.
-   *
-   * @param groupVec Vector of group values.
-   * @return Combined group identifier.
-   */
-  virtual std::string get_group_from_group_vector(const std::vector<std::string>& groupVec) = 0;
-
   /**
    * @brief Constructor for BasePreProcessor.
    *
@@ -146,9 +131,27 @@ class PreProcessor : public BasePreProcessor {
   PreProcessorInfo _info; /**< Configuration information for this preprocessor. */
   std::vector<double> _defaultFeature; /**< Default feature values when no data is available. */
   std::vector<RollingWindow*> _rollingWindows; /**< Rolling windows for time-based aggregations. */
-  std::map<std::string, std::vector<double>> _groupWiseFeatureMap; /**< Feature values per group. */
+  GroupKeyIndex _groupKeyIndex; /**< Dense ids of the groups seen in events. */
+  std::vector<std::vector<double>> _groupWiseFeatures; /**< Feature values, indexed by group id. */
   std::shared_ptr<TableData> _tableData = nullptr; /**< Shared pointer to table data. */
 
+  /**
+   * @brief Copies the features of every group into a buffer.
+   *
+   * @param groupIds Dense id of every group, groups not found get the default features.
+   * @param out Buffer of groupIds.size() feature vectors.
+   */
+  template <typename U>
+  void copy_features(const std::vector<int>& groupIds, U* out) const;
+
+  /**
+   * @brief Generates model input data variable from dense group ids.
+   *
+   * @param groupIds Dense id of every group.
+   * @return Data variable containing processed model input.
+   */
+  OpReturnType get_features_data_variable(const std::vector<int>& groupIds);
+
  public:
   /**
    * @brief Gets the number of group-by columns.
@@ -158,46 +161,39 @@ class PreProcessor : public BasePreProcessor {
   int get_num_of_groupBys() override { return _groupIds.size(); }
 
   /**
-   * @brief Extracts group identifier from row data with validation.
+   * @brief Extracts group values from row data with validation.
    *
-   * Creates a group identifier by concatenating values from group columns
-   * in the row data. Validates that all required group columns have data
-   * before creating the group. Returns false if any required column is missing.
+   * Collects values of the group columns in the row data. Validates that all required group
+   * columns have data before creating the group. Returns false if any required column is missing.
    *
    * @param row Vector of string values representing a row.
    * @param columnsFilled Vector indicating which columns have valid data.
-   * @param retGroup Output parameter for the extracted group.
+   * @param retGroup Output parameter for the value of each group column.
    * @return true if group extraction was successful, false if required columns are missing.
    */
   bool get_group_from_row(const std::vector<std::string>& row,
-                          const std::vector<bool>& columnsFilled, std::string& retGroup) override;
-
-  /**
-   * @brief Creates group identifier from group vector.
-   *
-   * @param groupVec Vector of group values.
-   * @return Combined group identifier.
-   */
-  std::string get_group_from_group_vector(const std::vector<std::string>& groupVec) override;
+                          const std::vector<bool>& columnsFilled,
+                          std::vector<std::string>& retGroup) override;
 
   /**
-   * @brief Extracts group identifier from a table event.
+   * @brief Extracts the group of a table event.
    *
-   * Creates a group identifier by concatenating values from group columns
-   * in the TableEvent.
+   * Interns the values of the group columns of the event and returns the dense id of their
+   * composite group key, adding the group if it is seen for the first time.
    *
-   * @param e TableEvent to extract group from.
-   * @return Group identifier as a string (e.g., "user123+US+").
+   * @param eventIndex Index of the event in the table.
+   * @return Dense group id of the event.
    */
-  std::string get_group_from_event(const TableEvent& e) override;
+  int get_group_from_event(int eventIndex) override;
 
   /**
-   * @brief Extracts group identifiers from JSON input.
+   * @brief Extracts group values from JSON input.
    *
    * @param preprocessorInput JSON array containing event data.
-   * @return Vector of group identifiers.
+   * @return Values of the group columns for every entry of the input.
    */
-  std::vector<std::string> get_groups_from_json(const nlohmann::json& preprocessorInput) override;
+  std::vector<std::vector<std::string>> get_groups_from_json(
+      const nlohmann::json& preprocessorInput) override;
 
   /**
    * @brief Generates model input from JSON data.
@@ -207,14 +203,6 @@ class PreProcessor : public BasePreProcessor {
    */
   std::shared_ptr<ModelInput> get_model_input(const nlohmann::json& preprocessorInput) override;
 
-  /**
-   * @brief Generates model input data variable from group identifiers.
-   *
-   * @param groups Vector of group identifiers.
-   * @return Data variable containing processed model input.
-   */
-  OpReturnType get_model_input_data_variable(const std::vector<std::string>& groups) override;
-
   /**
    * @brief Generates model input data variable from JSON data.
    *
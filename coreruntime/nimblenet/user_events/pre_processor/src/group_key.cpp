@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "group_key.hpp"
+
+#include <algorithm>
+
+#include "core_utils/fmt.hpp"
+
+namespace {
+
+constexpr size_t kInitialSlots = 16;
+
+// Finalizer of splitmix64, spreads consecutive interned ids over the whole table
+inline uint64_t mix(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+}  // namespace
+
+GroupKeyIndex::GroupKeyIndex(int numColumns)
+    : _numColumns(numColumns), _slots(kInitialSlots, kEmptySlot) {}
+
+uint64_t GroupKeyIndex::hash_key(const uint32_t* ids) const {
+  uint64_t hash = 0x9e3779b97f4a7c15ULL;
+  for (int i = 0; i < _numColumns; i++) {
+    hash = mix(hash ^ ids[i]);
+  }
+  return hash;
+}
+
+size_t GroupKeyIndex::probe(const uint32_t* ids, uint64_t hash) const {
+  size_t mask = _slots.size() - 1;
+  size_t slot = hash & mask;
+  while (true) {
+    int32_t groupId = _slots[slot];
+    if (groupId == kEmptySlot) {
+      return slot;
+    }
+    if (_hashes[groupId] == hash &&
+        std::equal(ids, ids + _numColumns, _keys.data() + (size_t)groupId * _numColumns)) {
+      return slot;
+    }
+    slot = (slot + 1) & mask;
+  }
+}
+
+void GroupKeyIndex::grow() {
+  std::vector<int32_t> slots(_slots.size() * 2, kEmptySlot);
+  size_t mask = slots.size() - 1;
+  for (int32_t groupId = 0; groupId < _hashes.size(); groupId++) {
+    size_t slot = _hashes[groupId] & mask;
+    while (slots[slot] != kEmptySlot) {
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = groupId;
+  }
+  _slots = std::move(slots);
+}
+
+bool GroupKeyIndex::find_value_ids(const std::vector<std::string>& values, uint32_t* ids) const {
+  for (int i = 0; i < _numColumns; i++) {
+    auto it = _valueIds.find(values[i]);
+    if (it == _valueIds.end()) {
+      return false;
+    }
+    ids[i] = it->second;
+  }
+  return true;
+}
+
+int GroupKeyIndex::get_or_insert(const std::vector<std::string>& values) {
+  if (values.size() != _numColumns) {
+    THROW("Expected %d group values, got %d", _numColumns, values.size());
+  }
+  std::vector<uint32_t> ids(_numColumns);
+  for (int i = 0; i < _numColumns; i++) {
+    ids[i] = _valueIds.emplace(values[i], _valueIds.size()).first->second;
+  }
+  uint64_t hash = hash_key(ids.data());
+  size_t slot = probe(ids.data(), hash);
+  if (_slots[slot] != kEmptySlot) {
+    return _slots[slot];
+  }
+
+  int32_t groupId = _hashes.size();
+  _keys.insert(_keys.end(), ids.begin(), ids.end());
+  _hashes.push_back(hash);
+  _slots[slot] = groupId;
+  // Keeping the load factor at or below one half keeps probe sequences short
+  if (_hashes.size() * 2 > _slots.size()) {
+    grow();
+  }
+  return groupId;
+}
+
+int GroupKeyIndex::find(const std::vector<std::string>& values) const {
+  if (values.size() != _numColumns) {
+    return kNotFound;
+  }
+  std::vector<uint32_t> ids(_numColumns);
+  if (!find_value_ids(values, ids.data())) {
+    return kNotFound;
+  }
+  int32_t groupId = _slots[probe(ids.data(), hash_key(ids.data()))];
+  return groupId == kEmptySlot ? kNotFound : groupId;
+}
+
+void GroupKeyIndex::find_batch(const std::vector<std::vector<std::string>>& allValues,
+                               std::vector<int>& groupIds) const {
+  int numGroups = allValues.size();
+  groupIds.assign(numGroups, kNotFound);
+  std::vector<uint32_t> ids((size_t)numGroups * _numColumns);
+  std::vector<uint64_t> hashes(numGroups);
+  std::vector<bool> valid(numGroups, false);
+  size_t mask = _slots.size() - 1;
+
+  for (int i = 0; i < numGroups; i++) {
+    uint32_t* groupKey = ids.data() + (size_t)i * _numColumns;
+    if (allValues[i].size() != _numColumns || !find_value_ids(allValues[i], groupKey)) {
+      continue;
+    }
+    valid[i] = true;
+    hashes[i] = hash_key(groupKey);
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(&_slots[hashes[i] & mask]);
+#endif
+  }
+
+  for (int i = 0; i < numGroups; i++) {
+    if (!valid[i]) continue;
+    int32_t groupId = _slots[probe(ids.data() + (size_t)i * _numColumns, hashes[i])];
+    groupIds[i] = groupId == kEmptySlot ? kNotFound : groupId;
+  }
+}
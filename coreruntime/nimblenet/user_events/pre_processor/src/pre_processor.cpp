@@ -14,7 +14,7 @@ using namespace std;
 
 PreProcessor::PreProcessor(int id, const PreProcessorInfo& info, const std::vector<int>& groupIds,
                            const std::vector<int>& columnIds, std::shared_ptr<TableData> tableData)
-    : BasePreProcessor(id) {
+    : BasePreProcessor(id), _groupKeyIndex(groupIds.size()) {
   _tableData = tableData;
   _info = info;
   _groupIds = groupIds;
@@ -29,40 +29,35 @@ PreProcessor::PreProcessor(int id, const PreProcessorInfo& info, const std::vect
   }
 }
 
-string PreProcessor::get_group_from_event(const TableEvent& e) {
-  string group = "";
+int PreProcessor::get_group_from_event(int eventIndex) {
+  std::vector<std::string> group;
+  group.reserve(_groupIds.size());
   for (auto groupId : _groupIds) {
-    group += e.row[groupId]->print() + "+";
+    group.push_back(_tableData->columnValues[groupId].print(eventIndex));
   }
-  return group;
+  return _groupKeyIndex.get_or_insert(group);
 }
 
 bool PreProcessor::get_group_from_row(const std::vector<std::string>& row,
                                       const std::vector<bool>& columnsFilled,
-                                      std::string& retGroup) {
-  string group = "";
+                                      std::vector<std::string>& retGroup) {
+  std::vector<std::string> group;
+  group.reserve(_groupIds.size());
   for (auto groupId : _groupIds) {
     if (!columnsFilled[groupId]) {
       LOG_TO_CLIENT_ERROR("Could not form group for entity, groupId=%d is missing", groupId);
       return false;
     }
-    group += row[groupId] + "+";
+    group.push_back(row[groupId]);
   }
   retGroup = std::move(group);
   return true;
 }
 
-string PreProcessor::get_group_from_group_vector(const std::vector<std::string>& groupVec) {
-  string group = "";
-  for (auto groupVal : groupVec) {
-    group += groupVal + "+";
-  }
-  return group;
-}
-
-std::vector<std::string> PreProcessor::get_groups_from_json(
+std::vector<std::vector<std::string>> PreProcessor::get_groups_from_json(
     const nlohmann::json& preprocessorInput) {
-  std::vector<std::string> groups;
+  std::vector<std::vector<std::string>> groups;
+  groups.reserve(preprocessorInput.size());
   for (const auto& inputjson : preprocessorInput) {
     std::vector<std::string> row(_tableData->columns.size());
     std::vector<bool> columnFilled(_tableData->columns.size(), false);
@@ -80,15 +75,29 @@ std::vector<std::string> PreProcessor::get_groups_from_json(
         row[columnIndex] = value.dump();
       }
     }
-    std::string group;
+    std::vector<std::string> group;
     if (!get_group_from_row(row, columnFilled, group)) {
-      return std::vector<std::string>();
+      return std::vector<std::vector<std::string>>();
     }
-    groups.push_back(group);
+    groups.push_back(std::move(group));
   }
   return groups;
 }
 
+template <typename U>
+void PreProcessor::copy_features(const std::vector<int>& groupIds, U* out) const {
+  int featureSize = _defaultFeature.size();
+  for (int i = 0; i < groupIds.size(); i++) {
+    const auto& features = groupIds[i] == GroupKeyIndex::kNotFound
+                               ? _defaultFeature
+                               : _groupWiseFeatures[groupIds[i]];
+    U* row = out + (size_t)i * featureSize;
+    for (int j = 0; j < featureSize; j++) {
+      row[j] = features[j];
+    }
+  }
+}
+
 std::shared_ptr<ModelInput> PreProcessor::get_model_input(const nlohmann::json& preprocessorInput) {
   if (_isUseless) {
     LOG_TO_ERROR("%s", "Preprocessor get_model_input failed");
@@ -99,62 +108,30 @@ std::shared_ptr<ModelInput> PreProcessor::get_model_input(const nlohmann::json&
     return nullptr;
   }
   for (const auto& rollingwindow : _rollingWindows) {
-    rollingwindow->update_window(_tableData->allEvents);
+    rollingwindow->update_window(*_tableData);
   }
+  std::vector<int> groupIds;
+  _groupKeyIndex.find_batch(groups, groupIds);
 
-  auto func = [this, &groups](auto typeObj) -> std::shared_ptr<ModelInput> {
+  auto func = [this, &groupIds](auto typeObj) -> std::shared_ptr<ModelInput> {
     using T = decltype(typeObj);
 
-    T* inputData = new T[groups.size() * _defaultFeature.size()];
-    for (int i = 0; i < groups.size(); i++) {
-      string group = groups[i];
-      if (_groupWiseFeatureMap.find(group) == _groupWiseFeatureMap.end()) {
-        for (int j = 0; j < _defaultFeature.size(); j++) {
-          inputData[i * _defaultFeature.size() + j] = _defaultFeature[j];
-        }
-      } else {
-        auto& vec = _groupWiseFeatureMap[group];
-        for (int j = 0; j < _defaultFeature.size(); j++) {
-          inputData[i * _defaultFeature.size() + j] = vec[j];
-        }
-      }
-    }
-    int length = groups.size() * _defaultFeature.size();
+    T* inputData = new T[groupIds.size() * _defaultFeature.size()];
+    copy_features(groupIds, inputData);
+    int length = groupIds.size() * _defaultFeature.size();
     return std::make_shared<ModelInput>((void*)inputData, length);
   };
 
   return util::call_function_for_numeric_dataType(func, _info.dataType);
 }
 
-OpReturnType PreProcessor::get_model_input_data_variable(const std::vector<std::string>& groups) {
-  if (_isUseless) {
-    LOG_TO_ERROR("%s", "Preprocessor get_model_input failed");
-    return nullptr;
-  }
-  auto& allEvents = _tableData->allEvents;
-
-  for (const auto& rollingwindow : _rollingWindows) {
-    rollingwindow->update_window(allEvents);
-  }
-
-  auto func = [this, &groups](auto typeObj) -> OpReturnType {
+OpReturnType PreProcessor::get_features_data_variable(const std::vector<int>& groupIds) {
+  auto func = [this, &groupIds](auto typeObj) -> OpReturnType {
     using T = decltype(typeObj);
 
-    T* inputData = (T*)malloc(groups.size() * _defaultFeature.size() * sizeof(T));
-    for (int i = 0; i < groups.size(); i++) {
-      string group = groups[i];
-      if (_groupWiseFeatureMap.find(group) == _groupWiseFeatureMap.end()) {
-        for (int j = 0; j < _defaultFeature.size(); j++) {
-          inputData[i * _defaultFeature.size() + j] = _defaultFeature[j];
-        }
-      } else {
-        auto& vec = _groupWiseFeatureMap[group];
-        for (int j = 0; j < _defaultFeature.size(); j++) {
-          inputData[i * _defaultFeature.size() + j] = vec[j];
-        }
-      }
-    }
-    int length = groups.size() * _defaultFeature.size();
+    T* inputData = (T*)malloc(groupIds.size() * _defaultFeature.size() * sizeof(T));
+    copy_features(groupIds, inputData);
+    int length = groupIds.size() * _defaultFeature.size();
     return OpReturnType(
         new TensorVariable(inputData, _info.dataType, length, CreateTensorType::MOVE));
   };
@@ -164,19 +141,24 @@ OpReturnType PreProcessor::get_model_input_data_variable(const std::vector<std::
 
 OpReturnType PreProcessor::get_model_input_data_variable(
     const std::vector<std::vector<std::string>>& allGroups) {
-  std::vector<std::string> groups;
+  if (_isUseless) {
+    LOG_TO_ERROR("%s", "Preprocessor get_model_input failed");
+    return nullptr;
+  }
   int groupsSize = get_num_of_groupBys();
   for (int i = 0; i < allGroups.size(); i++) {
-    auto& groupVec = allGroups[i];
-    if (groupVec.size() != groupsSize) {
-      LOG_TO_CLIENT_ERROR("Expected group size=%d got %d at index %d", groupsSize, groupVec.size(),
-                          i);
+    if (allGroups[i].size() != groupsSize) {
+      LOG_TO_CLIENT_ERROR("Expected group size=%d got %d at index %d", groupsSize,
+                          allGroups[i].size(), i);
       return nullptr;
     }
-    auto group = get_group_from_group_vector(groupVec);
-    groups.push_back(group);
   }
-  return get_model_input_data_variable(groups);
+  for (const auto& rollingwindow : _rollingWindows) {
+    rollingwindow->update_window(*_tableData);
+  }
+  std::vector<int> groupIds;
+  _groupKeyIndex.find_batch(allGroups, groupIds);
+  return get_features_data_variable(groupIds);
 }
 
 OpReturnType PreProcessor::get_model_input_data_variable(const nlohmann::json& json) {
@@ -188,19 +170,19 @@ OpReturnType PreProcessor::get_model_input_data_variable(const nlohmann::json& j
 }
 
 void PreProcessor::add_event(int newEventIndex) {
-  auto& allEvents = _tableData->allEvents;
-  const auto& e = allEvents[newEventIndex];
-  const auto& group = e.groups[_id];
-  if (_groupWiseFeatureMap.find(group) == _groupWiseFeatureMap.end()) {
-    _groupWiseFeatureMap[group] = std::vector<T>(_defaultFeature.size());
-    _groupWiseFeatureMap[group] = _defaultFeature;
+  int group = _tableData->groups[_id][newEventIndex];
+  // Group ids are dense and assigned in order, so a group seen for the first time is the next id.
+  // Aggregate columns keep pointers into the feature vectors, which stay valid when the outer
+  // vector grows as the inner vectors are moved and not copied.
+  if (group == _groupWiseFeatures.size()) {
+    _groupWiseFeatures.push_back(_defaultFeature);
     for (int i = 0; i < _rollingWindows.size(); i++) {
       bool isSuccess = _rollingWindows[i]->create_aggregate_columns_for_group(
-          group, _columnIds, _groupWiseFeatureMap[group], i * _info.columnsToAggregate.size());
+          group, _columnIds, _groupWiseFeatures[group], i * _info.columnsToAggregate.size());
       if (!isSuccess) _isUseless = true;
     }
   }
   for (auto rollingWindow : _rollingWindows) {
-    rollingWindow->add_event(_tableData->allEvents, newEventIndex);
+    rollingWindow->add_event(*_tableData, newEventIndex);
   }
 }
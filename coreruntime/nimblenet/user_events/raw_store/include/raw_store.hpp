@@ -31,6 +31,7 @@ class RawStore {
   OpReturnType _functionDataVariable; /**< Function executed when events are added. */
   std::string _eventType; /**< Type of events managed by this store. */
   bool _eventHookSet = false; /**< Flag indicating whether an event hook has been set. */
+  int64_t _expiryTime = 0; /**< Events of files older than this are not replayed to the hook. */
 
  public:
   /**
@@ -56,15 +57,16 @@ class RawStore {
       LOG_TO_ERROR("Could not delete old rows from the table %s ", _eventType.c_str());
     }
     _tableStore = new TableStore(tableInfo.schema);
-    auto events = _database->get_events_from_db(_eventType);
-    for (auto& event : events) {
-      TableRow r;
-      for (const auto& column : event.items()) {
-        r.row[column.key()] = DataVariable::get_SingleVariableFrom_JSON(column.value());
-      }
-      r.timestamp = event[usereventconstants::TimestampField];
-      _tableStore->add_row(r);
-    }
+    // Events are streamed straight into the table, skipping files that expired
+    _database->for_each_event(
+        _eventType,
+        [this](int64_t timestamp, std::map<std::string, OpReturnType>&& event) {
+          TableRow r;
+          r.row = std::move(event);
+          r.timestamp = timestamp;
+          _tableStore->add_row(r);
+        },
+        Time::get_time() - tableInfo.expiryTimeInMins);
   }
 
   /**
@@ -91,6 +93,9 @@ class RawStore {
     if (!_database->delete_old_rows_from_table_in_db(_eventType, expiryType, expiryValue)) {
       LOG_TO_ERROR("Could not delete old rows from the table %s ", _eventType.c_str());
     }
+    if (expiryType == "time") {
+      _expiryTime = Time::get_time() - expiryValue;
+    }
     // reads events from database only on the add_event hook, as it is not required before that
   }
 
@@ -16,12 +16,16 @@ void RawStore::set_add_event_hook(OpReturnType functionDataVariable) {
   }
   _eventHookSet = true;
   _functionDataVariable = functionDataVariable;
-  auto events = _database->get_events_from_db(_eventType);
-  for (auto& event : events) {
-    _functionDataVariable->execute_function(
-        {OpReturnType(new SingleVariable<std::string>(_eventType)),
-         OpReturnType(DataVariable::get_map_from_json_object(std::move(event)))});
-  }
+  _database->for_each_event(
+      _eventType,
+      [this](int64_t timestamp, std::map<std::string, OpReturnType>&& event) {
+        event[usereventconstants::TimestampField] =
+            OpReturnType(new SingleVariable<int64_t>(timestamp));
+        _functionDataVariable->execute_function(
+            {OpReturnType(new SingleVariable<std::string>(_eventType)),
+             OpReturnType(new MapDataVariable(std::move(event)))});
+      },
+      _expiryTime);
 }
 
 bool RawStore::add_event(OpReturnType eventMapTable) {
@@ -6,7 +6,6 @@
 
 #pragma once
 
-#include <map>
 #include <vector>
 
 #include "aggregate_column.hpp"
@@ -18,15 +17,42 @@
  * This class provides the foundation for implementing time-based or count-based
  * rolling windows that maintain aggregated statistics over a sliding window of events.
  * It manages aggregate columns for different groups and provides virtual methods
- * for adding events and updating the window state.
+ * for adding events and updating the window state. Aggregate columns are updated as events enter
+ * and leave the window, but their values are only written to the feature vectors of the groups
+ * touched since the last update of the window.
  */
 class RollingWindow {
   using T = double; /**< Type alias for the data type used in aggregations. */
 
+  std::vector<int> _dirtyGroups; /**< Groups with events added or removed since the last store. */
+  std::vector<bool> _isGroupDirty; /**< Whether a group is present in _dirtyGroups. */
+
+ protected:
+  /**
+   * @brief Adds an event to the aggregate columns of its group.
+   *
+   * @param tableData Columns of all events in the table.
+   * @param eventIndex Index of the event entering the window.
+   */
+  void add_event_to_group(const TableData& tableData, int eventIndex);
+
+  /**
+   * @brief Removes an expired event from the aggregate columns of its group.
+   *
+   * @param tableData Columns of all events in the table.
+   * @param eventIndex Index of the event leaving the window.
+   */
+  void remove_event_from_group(const TableData& tableData, int eventIndex);
+
+  /**
+   * @brief Writes the values of the aggregate columns of all dirty groups to their feature vectors.
+   */
+  void store_dirty_groups();
+
  public:
   int _preprocessorId; /**< Identifier of the preprocessor this rolling window belongs to. */
   PreProcessorInfo _preprocessorInfo; /**< Configuration information for the preprocessor. */
-  std::map<std::string, std::vector<AggregateColumn*>> _groupWiseAggregatedColumnMap; /**< Map of group names to their aggregate columns for different operations. */
+  std::vector<std::vector<AggregateColumn*>> _groupWiseAggregatedColumns; /**< Aggregate columns for different operations, indexed by dense group id. */
 
   /**
    * @brief Creates aggregate columns for a specific group.
@@ -34,13 +60,13 @@ class RollingWindow {
    * This method initializes the appropriate aggregate columns (Sum, Count, Min, Max, Avg)
    * for each column that needs to be aggregated within the specified group.
    *
-   * @param group Group identifier for which to create aggregate columns.
+   * @param group Dense id of the group for which to create aggregate columns.
    * @param columnIds Vector of column indices to aggregate.
    * @param totalFeatureVector Reference to the feature vector where aggregated values will be stored.
    * @param rollingWindowFeatureStartIndex Starting index in the feature vector for this rolling window's features.
    * @return true if aggregate columns were created successfully, false otherwise.
    */
-  bool create_aggregate_columns_for_group(const std::string& group,
+  bool create_aggregate_columns_for_group(int group,
                                           const std::vector<int>& columnIds,
                                           std::vector<double>& totalFeatureVector,
                                           int rollingWindowFeatureStartIndex);
@@ -51,10 +77,10 @@ class RollingWindow {
    * This virtual method must be implemented by derived classes to handle
    * the addition of new events to the rolling window.
    *
-   * @param allEvents Vector containing all events in the table.
+   * @param tableData Columns of all events in the table.
    * @param newEventIndex Index of the new event to be added.
    */
-  virtual void add_event(const std::vector<TableEvent>& allEvents, int newEventIndex) = 0;
+  virtual void add_event(const TableData& tableData, int newEventIndex) = 0;
 
   /**
    * @brief Updates the rolling window state.
@@ -63,9 +89,9 @@ class RollingWindow {
    * the window state, typically by removing expired events and recalculating
    * aggregations.
    *
-   * @param allEvents Vector containing all events in the table.
+   * @param tableData Columns of all events in the table.
    */
-  virtual void update_window(const std::vector<TableEvent>& allEvents) = 0;
+  virtual void update_window(const TableData& tableData) = 0;
 
   /**
    * @brief Constructor for RollingWindow.
@@ -84,8 +110,8 @@ class RollingWindow {
    * Ensures proper cleanup of all aggregate column objects to prevent memory leaks.
    */
   virtual ~RollingWindow() {
-    for (auto it : _groupWiseAggregatedColumnMap) {
-      for (auto col : it.second) {
+    for (const auto& columns : _groupWiseAggregatedColumns) {
+      for (auto col : columns) {
         delete col;
       }
     }
@@ -13,11 +13,24 @@
  * over a fixed time period. Events older than the specified window time are
  * automatically removed from the aggregation, ensuring that only recent events
  * contribute to the computed features.
+ *
+ * Events of the table arrive in time order, so the events in the window are always the range
+ * [_windowStart, _windowEnd) of the table. The window start is a single expiry cursor shared by
+ * all groups and aggregate columns, and every event is added and removed exactly once.
  */
 class TimeBasedRollingWindow final : public RollingWindow {
-  int _oldestIndex; /**< Index of the oldest event currently in the rolling window. */
+  int _windowStart = 0; /**< Index of the oldest event currently in the rolling window. */
+  int _windowEnd = 0; /**< Index of the next event of the table to be added to the window. */
   float _windowTime = 0; /**< Time window duration in seconds for event retention. */
 
+  /**
+   * @brief Removes events from the front of the window while they are older than the window.
+   *
+   * @param tableData Columns of all events in the table.
+   * @param currentTime Current time in seconds.
+   */
+  void evict_expired_events(const TableData& tableData, int64_t currentTime);
+
  public:
   /**
    * @brief Constructor for TimeBasedRollingWindow.
@@ -32,21 +45,22 @@ class TimeBasedRollingWindow final : public RollingWindow {
    * @brief Adds a new event to the time-based rolling window.
    *
    * This method adds an event to the rolling window if it falls within the
-   * current time window. Events outside the window are ignored.
+   * current time window. An event outside the window is ignored, and as events arrive in time order
+   * every event before it has expired as well.
    *
-   * @param allEvents Vector containing all events in the table.
+   * @param tableData Columns of all events in the table.
    * @param newEventIndex Index of the new event to be added.
    */
-  void add_event(const std::vector<TableEvent>& allEvents, int newEventIndex) override;
+  void add_event(const TableData& tableData, int newEventIndex) override;
 
   /**
    * @brief Updates the time-based rolling window by removing expired events.
    *
    * This method removes events that have fallen outside the time window
-   * and updates the aggregate columns accordingly. It also updates the
-   * oldest event index to maintain the window boundaries.
+   * and updates the aggregate columns accordingly, then stores the aggregated
+   * values of the groups touched since the last update.
    *
-   * @param allEvents Vector containing all events in the table.
+   * @param tableData Columns of all events in the table.
    */
-  void update_window(const std::vector<TableEvent>& allEvents) override;
+  void update_window(const TableData& tableData) override;
 };
@@ -8,30 +8,36 @@
 
 using namespace std;
 
-bool RollingWindow::create_aggregate_columns_for_group(const std::string& group,
+bool RollingWindow::create_aggregate_columns_for_group(int group,
                                                        const std::vector<int>& columnIds,
                                                        std::vector<T>& totalFeatureVector,
                                                        int rollingWindowFeatureStartIndex) {
-  _groupWiseAggregatedColumnMap[group] = std::vector<AggregateColumn*>();
+  if (group >= _groupWiseAggregatedColumns.size()) {
+    _groupWiseAggregatedColumns.resize(group + 1);
+  }
+  if (group >= _isGroupDirty.size()) {
+    _isGroupDirty.resize(group + 1, false);
+  }
+  auto& aggregatedColumns = _groupWiseAggregatedColumns[group];
   for (int i = 0; i < _preprocessorInfo.columnsToAggregate.size(); i++) {
     if (_preprocessorInfo.aggregateOperators[i] == "Sum")
-      _groupWiseAggregatedColumnMap[group].push_back(
+      aggregatedColumns.push_back(
           new SumColumn(_preprocessorId, columnIds[i], group,
                         &totalFeatureVector[rollingWindowFeatureStartIndex + i]));
     else if (_preprocessorInfo.aggregateOperators[i] == "Count")
-      _groupWiseAggregatedColumnMap[group].push_back(
+      aggregatedColumns.push_back(
           new CountColumn(_preprocessorId, columnIds[i], group,
                           &totalFeatureVector[rollingWindowFeatureStartIndex + i]));
     else if (_preprocessorInfo.aggregateOperators[i] == "Min")
-      _groupWiseAggregatedColumnMap[group].push_back(
+      aggregatedColumns.push_back(
           new MinColumn(_preprocessorId, columnIds[i], group,
                         &totalFeatureVector[rollingWindowFeatureStartIndex + i]));
     else if (_preprocessorInfo.aggregateOperators[i] == "Max")
-      _groupWiseAggregatedColumnMap[group].push_back(
+      aggregatedColumns.push_back(
           new MaxColumn(_preprocessorId, columnIds[i], group,
                         &totalFeatureVector[rollingWindowFeatureStartIndex + i]));
     else if (_preprocessorInfo.aggregateOperators[i] == "Avg")
-      _groupWiseAggregatedColumnMap[group].push_back(
+      aggregatedColumns.push_back(
           new AverageColumn(_preprocessorId, columnIds[i], group,
                             &totalFeatureVector[rollingWindowFeatureStartIndex + i]));
     else {
@@ -44,3 +50,35 @@ bool RollingWindow::create_aggregate_columns_for_group(const std::string& group,
   }
   return true;
 }
+
+void RollingWindow::add_event_to_group(const TableData& tableData, int eventIndex) {
+  int group = tableData.groups[_preprocessorId][eventIndex];
+  for (auto aggregatedColumn : _groupWiseAggregatedColumns[group]) {
+    aggregatedColumn->add_event(tableData, eventIndex);
+  }
+  if (!_isGroupDirty[group]) {
+    _isGroupDirty[group] = true;
+    _dirtyGroups.push_back(group);
+  }
+}
+
+void RollingWindow::remove_event_from_group(const TableData& tableData, int eventIndex) {
+  int group = tableData.groups[_preprocessorId][eventIndex];
+  for (auto aggregatedColumn : _groupWiseAggregatedColumns[group]) {
+    aggregatedColumn->remove_event(tableData, eventIndex);
+  }
+  if (!_isGroupDirty[group]) {
+    _isGroupDirty[group] = true;
+    _dirtyGroups.push_back(group);
+  }
+}
+
+void RollingWindow::store_dirty_groups() {
+  for (auto group : _dirtyGroups) {
+    for (auto aggregatedColumn : _groupWiseAggregatedColumns[group]) {
+      aggregatedColumn->store_value();
+    }
+    _isGroupDirty[group] = false;
+  }
+  _dirtyGroups.clear();
+}
@@ -12,35 +12,31 @@ TimeBasedRollingWindow::TimeBasedRollingWindow(int preprocessorId, const PreProc
                                                float windowTime)
     : RollingWindow(preprocessorId, info) {
   _windowTime = windowTime;
-  _oldestIndex = -1;
 }
 
-void TimeBasedRollingWindow::add_event(const std::vector<TableEvent>& allEvents,
-                                       int newEventIndex) {
-  const auto& event = allEvents[newEventIndex];
-  if (Time::get_time() - event.timestamp > _windowTime) {
-    return;
-  }
-  if (_oldestIndex == -1) {
-    _oldestIndex = newEventIndex;
-  }
-  for (auto aggregatedColumn :
-       this->_groupWiseAggregatedColumnMap[event.groups[this->_preprocessorId]]) {
-    aggregatedColumn->add_event(allEvents, newEventIndex);
+void TimeBasedRollingWindow::evict_expired_events(const TableData& tableData,
+                                                  int64_t currentTime) {
+  while (_windowStart < _windowEnd &&
+         currentTime - tableData.timestamps[_windowStart] > _windowTime) {
+    remove_event_from_group(tableData, _windowStart);
+    _windowStart++;
   }
 }
 
-void TimeBasedRollingWindow::update_window(const std::vector<TableEvent>& allEvents) {
-  if (_oldestIndex == -1) return;
-  for (int i = _oldestIndex; i < allEvents.size(); i++) {
-    if (Time::get_time() - allEvents[i].timestamp > _windowTime) {
-      _oldestIndex++;
-    }
-  }
-  for (auto it = this->_groupWiseAggregatedColumnMap.begin();
-       it != this->_groupWiseAggregatedColumnMap.end(); it++) {
-    for (auto aggregatedColumn : it->second) {
-      aggregatedColumn->remove_events(allEvents, _oldestIndex);
+void TimeBasedRollingWindow::add_event(const TableData& tableData, int newEventIndex) {
+  _windowEnd = newEventIndex + 1;
+  if (Time::get_time() - tableData.timestamps[newEventIndex] > _windowTime) {
+    // Events arrive in time order, so every event still in the window has expired as well
+    for (; _windowStart < newEventIndex; _windowStart++) {
+      remove_event_from_group(tableData, _windowStart);
     }
+    _windowStart = _windowEnd;
+    return;
   }
+  add_event_to_group(tableData, newEventIndex);
+}
+
+void TimeBasedRollingWindow::update_window(const TableData& tableData) {
+  evict_expired_events(tableData, Time::get_time());
+  store_dirty_groups();
 }
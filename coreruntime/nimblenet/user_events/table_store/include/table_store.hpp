@@ -50,10 +50,10 @@ class TableStore {
    * @param preprocessorIndex Index of the preprocessor to use for group extraction.
    * @param preprocessorInput JSON input containing event data.
    *
-   * @return Vector of group identifiers extracted from the input.
+   * @return Values of the group columns for every entry of the input.
    */
-  std::vector<std::string> get_groups_from_json(int preprocessorIndex,
-                                                const nlohmann::json& preprocessorInput);
+  std::vector<std::vector<std::string>> get_groups_from_json(
+      int preprocessorIndex, const nlohmann::json& preprocessorInput);
 
  public:
   /**
@@ -68,7 +68,7 @@ class TableStore {
   /**
    * @brief Adds a new row to the table.
    *
-   * This method converts a TableRow to a TableEvent and adds it to the table.
+   * This method appends the values of a TableRow to the columns of the table.
    * It also triggers all associated preprocessors to update their aggregations.
    *
    * @param r TableRow containing the event data to add.
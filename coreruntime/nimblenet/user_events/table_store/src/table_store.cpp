@@ -13,12 +13,10 @@
 #include "time_manager.hpp"
 
 void TableStore::add_row(const TableRow& r) {
-  int newIndex = _tableData->allEvents.size();
-  TableEvent e;
-  e.timestamp = r.timestamp;
-  e.row = std::vector<OpReturnType>(_tableData->columns.size(), OpReturnType(new NoneVariable()));
+  // All columns are verified before appending so that a rejected event leaves no partial row
+  std::vector<const OpReturnType*> values(_tableData->columns.size());
   for (auto& requiredColumn : _tableData->columns) {
-    // Row might have extra fields which are not required by TableEvent
+    // Row might have extra fields which are not required by the table
     auto it = r.row.find(requiredColumn);
     if (it == r.row.end()) {
       LOG_TO_CLIENT_ERROR("Event Not added to dataframe as column=%s is missing",
@@ -28,12 +26,16 @@ void TableStore::add_row(const TableRow& r) {
     if (!verify_key(requiredColumn, it->second)) {
       return;
     }
-    e.row[_tableData->columnToIdMap[requiredColumn]] = it->second;
+    values[_tableData->columnToIdMap[requiredColumn]] = &it->second;
+  }
+  int newIndex = _tableData->num_events();
+  _tableData->timestamps.push_back(r.timestamp);
+  for (int i = 0; i < values.size(); i++) {
+    _tableData->columnValues[i].append(*values[i]);
   }
-  _tableData->allEvents.push_back(e);
   for (auto preprocessor : _preprocessors) {
-    _tableData->allEvents[newIndex].groups.push_back(preprocessor->get_group_from_event(e));
-    preprocessor->add_event(_tableData->allEvents.size() - 1);
+    _tableData->groups[preprocessor->_id].push_back(preprocessor->get_group_from_event(newIndex));
+    preprocessor->add_event(newIndex);
   }
 }
 
@@ -80,10 +82,11 @@ BasePreProcessor* TableStore::create_preprocessor(const PreProcessorInfo& info)
     return nullptr;
   }
 
-  // preprocessor object created, adding events to preprocessor from allEvents
-  for (int i = 0; i < _tableData->allEvents.size(); i++) {
-    _tableData->allEvents[i].groups.push_back(
-        bpreprocessor->get_group_from_event(_tableData->allEvents[i]));
+  // preprocessor object created, adding events already in the table to preprocessor
+  auto& groups = _tableData->groups.emplace_back();
+  groups.reserve(_tableData->num_events());
+  for (int i = 0; i < _tableData->num_events(); i++) {
+    groups.push_back(bpreprocessor->get_group_from_event(i));
     bpreprocessor->add_event(i);
   }
   _preprocessors.push_back(bpreprocessor);
@@ -91,19 +94,16 @@ BasePreProcessor* TableStore::create_preprocessor(const PreProcessorInfo& info)
 }
 
 TableStore::TableStore(const std::map<std::string, int>& schema) {
-  int id = 0;
   _tableData->schema = schema;
   for (const auto& it : _tableData->schema) {
-    _tableData->columnToIdMap[it.first] = id++;
-    _tableData->columns.push_back(it.first);
+    _tableData->add_column(it.first, it.second);
   }
 }
 
 void TableStore::update_column_meta_data(const std::string& columnName) {
   auto it1 = std::find(_tableData->columns.begin(), _tableData->columns.end(), columnName);
   if (it1 == _tableData->columns.end()) {
-    _tableData->columns.push_back(columnName);
-    _tableData->columnToIdMap[columnName] = _tableData->columns.size() - 1;
+    _tableData->add_column(columnName, _tableData->schema[columnName]);
   }
 }
 
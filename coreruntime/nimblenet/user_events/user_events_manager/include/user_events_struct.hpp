@@ -6,8 +6,12 @@
 
 #pragma once
 
+#include <cstring>
 #include <map>
 #include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 #include "util.hpp"
@@ -72,15 +76,121 @@ struct TableInfo {
 };
 
 /**
- * @brief Represents a single event stored in a table.
+ * @brief Values of a single table column, stored contiguously by type.
  *
- * This struct contains the data for one event, including its timestamp,
- * grouping information, and the actual event data as a vector of data variables.
+ * Numeric columns are kept in an array of their own type, booleans as bytes and strings as codes
+ * into a per column dictionary, so storing an event does not allocate a DataVariable per cell.
+ * Array columns and any other data type keep the DataVariable itself.
  */
-struct TableEvent {
-  std::vector<std::string> groups; /**< Group identifiers for this event from different preprocessors. */
-  int64_t timestamp; /**< Timestamp when the event occurred. */
-  std::vector<OpReturnType> row; /**< Event data as a vector of data variables. */
+class TableColumn {
+ public:
+  /**
+   * @brief Physical layout used for the values of a column.
+   */
+  enum class Storage { INT32, INT64, FLOAT, DOUBLE, BOOLEAN, STRING, BOXED };
+
+ private:
+  int _dataType; /**< Data type of the column as given in the schema. */
+  Storage _storage; /**< Array in which the values of the column are kept. */
+  std::vector<int32_t> _int32s; /**< Values of INT32 columns. */
+  std::vector<int64_t> _int64s; /**< Values of INT64 columns. */
+  std::vector<float> _floats; /**< Values of FLOAT columns. */
+  std::vector<double> _doubles; /**< Values of DOUBLE columns. */
+  std::vector<uint8_t> _bools; /**< Values of BOOLEAN columns. */
+  std::vector<int32_t> _stringCodes; /**< Dictionary code of every value of STRING columns. */
+  std::vector<std::string> _dictionary; /**< Distinct values of STRING columns. */
+  /** Dictionary code of every distinct value of STRING columns. */
+  std::unordered_map<std::string, int32_t> _dictionaryCodes;
+  std::vector<OpReturnType> _boxed; /**< Values of columns without a typed layout. */
+
+  // Whether the rows are consecutive events in increasing order
+  static bool is_contiguous(const std::vector<int>& rows);
+
+ public:
+  /**
+   * @brief Constructor for TableColumn.
+   *
+   * @param dataType Data type of the column from the table schema.
+   */
+  explicit TableColumn(int dataType);
+
+  /**
+   * @brief Appends the value of a new event, the value must already be verified against the schema.
+   *
+   * @param value Value of the column for the event.
+   */
+  void append(const OpReturnType& value);
+
+  int get_dataType() const { return _dataType; }
+
+  Storage get_storage() const { return _storage; }
+
+  /**
+   * @brief Gets the value of an event converted to a numeric type.
+   *
+   * @tparam T Numeric type to convert to.
+   * @param row Index of the event in the table.
+   * @return The converted value.
+   */
+  template <typename T>
+  T get(int row) const {
+    switch (_storage) {
+      case Storage::INT32:
+        return T(_int32s[row]);
+      case Storage::INT64:
+        return T(_int64s[row]);
+      case Storage::FLOAT:
+        return T(_floats[row]);
+      case Storage::DOUBLE:
+        return T(_doubles[row]);
+      case Storage::BOOLEAN:
+        return T(_bools[row]);
+      case Storage::STRING:
+        if constexpr (std::is_same_v<T, bool>) {
+          return !_dictionary[_stringCodes[row]].empty();
+        }
+        THROW("Cannot convert value of string column to %s", typeid(T).name());
+      case Storage::BOXED:
+        return _boxed[row]->template get<T>();
+    }
+    THROW("%s", "Invalid column storage");
+  }
+
+  /**
+   * @brief Gets the value of an event of a STRING column.
+   *
+   * @param row Index of the event in the table.
+   * @return The string value.
+   */
+  const std::string& get_string(int row) const;
+
+  /**
+   * @brief Creates a DataVariable holding the value of an event.
+   *
+   * @param row Index of the event in the table.
+   * @return Data variable of the column type, or the stored variable for boxed columns.
+   */
+  OpReturnType get_variable(int row) const;
+
+  /**
+   * @brief Gets the printed form of the value of an event, as DataVariable::print would.
+   *
+   * @param row Index of the event in the table.
+   * @return Printed value.
+   */
+  std::string print(int row) const;
+
+  /**
+   * @brief Copies the values of the given events into a dense array, converting them to T.
+   *
+   * When T matches the storage and the events are consecutive this is a single memcpy.
+   *
+   * @tparam T Type of the output array.
+   * @param rows Indices of the events to copy.
+   * @param out Output array with space for rows.size() elements.
+   */
+  template <typename T>
+  void gather(const std::vector<int>& rows, T* out) const;
 };
 
 /**
@@ -97,12 +207,73 @@ struct TableRow {
 /**
  * @brief Complete table data structure containing all events and metadata.
  *
- * This struct holds all the data for a table, including the events themselves,
- * column metadata, schema information, and mappings for efficient access.
+ * Events are stored column wise: event i is made of timestamps[i] and the i-th value of every
+ * column in columnValues. Group identifiers of the events are stored per preprocessor.
  */
 struct TableData {
-  std::vector<TableEvent> allEvents; /**< All events stored in the table. */
+  std::vector<int64_t> timestamps; /**< Timestamp of every event in the table. */
+  std::vector<TableColumn> columnValues; /**< Values of every column, indexed by column id. */
+  /** Dense group id of every event, indexed by preprocessor id and event index. */
+  std::vector<std::vector<int>> groups;
   std::map<std::string, int> columnToIdMap; /**< Mapping from column names to their indices. */
   std::vector<std::string> columns; /**< Ordered list of column names. */
   std::map<std::string, int> schema; /**< Column name to data type mapping. */
+
+  /**
+   * @brief Gets the number of events stored in the table.
+   *
+   * @return Number of events.
+   */
+  int num_events() const { return timestamps.size(); }
+
+  /**
+   * @brief Adds an empty column, events must not have been added yet.
+   *
+   * @param columnName Name of the column.
+   * @param dataType Data type of the column.
+   */
+  void add_column(const std::string& columnName, int dataType) {
+    columnToIdMap[columnName] = columns.size();
+    columns.push_back(columnName);
+    columnValues.emplace_back(dataType);
+  }
 };
+
+template <typename T>
+void TableColumn::gather(const std::vector<int>& rows, T* out) const {
+  if (rows.empty()) return;
+  if constexpr (std::is_same_v<T, std::string>) {
+    for (int i = 0; i < rows.size(); i++) {
+      if (_storage == Storage::STRING) {
+        out[i] = get_string(rows[i]);
+      } else if (_storage == Storage::BOXED) {
+        out[i] = _boxed[rows[i]]->get_string();
+      } else {
+        THROW("Cannot convert value of column with type %s to string",
+              util::get_string_from_enum(_dataType));
+      }
+    }
+    return;
+  } else {
+    const void* values = nullptr;
+    if constexpr (std::is_same_v<T, int32_t>) {
+      if (_storage == Storage::INT32) values = _int32s.data();
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+      if (_storage == Storage::INT64) values = _int64s.data();
+    } else if constexpr (std::is_same_v<T, float>) {
+      if (_storage == Storage::FLOAT) values = _floats.data();
+    } else if constexpr (std::is_same_v<T, double>) {
+      if (_storage == Storage::DOUBLE) values = _doubles.data();
+    } else if constexpr (std::is_same_v<T, bool> && sizeof(bool) == sizeof(uint8_t)) {
+      // Stored bytes are always 0 or 1, so they are valid bools
+      if (_storage == Storage::BOOLEAN) values = _bools.data();
+    }
+    if (values != nullptr && is_contiguous(rows)) {
+      std::memcpy(out, static_cast<const T*>(values) + rows[0], rows.size() * sizeof(T));
+      return;
+    }
+    for (int i = 0; i < rows.size(); i++) {
+      out[i] = get<T>(rows[i]);
+    }
+  }
+}
@@ -6,6 +6,11 @@
 
 #include "user_events_struct.hpp"
 
+#include <algorithm>
+#include <sstream>
+
+#include "single_variable.hpp"
+
 using namespace std;
 
 void from_json(const json& j, PreProcessorInfo& preProcessorInfo) {
@@ -37,3 +42,117 @@ void from_json(const json& j, PreProcessorInfo& preProcessorInfo) {
   j.at("groupBy").get_to(preProcessorInfo.groupColumns);
   preProcessorInfo.valid = true;
 }
+
+TableColumn::TableColumn(int dataType) : _dataType(dataType) {
+  switch (dataType) {
+    case DATATYPE::INT32:
+      _storage = Storage::INT32;
+      break;
+    case DATATYPE::INT64:
+      _storage = Storage::INT64;
+      break;
+    case DATATYPE::FLOAT:
+      _storage = Storage::FLOAT;
+      break;
+    case DATATYPE::DOUBLE:
+      _storage = Storage::DOUBLE;
+      break;
+    case DATATYPE::BOOLEAN:
+      _storage = Storage::BOOLEAN;
+      break;
+    case DATATYPE::STRING:
+      _storage = Storage::STRING;
+      break;
+    default:
+      _storage = Storage::BOXED;
+  }
+}
+
+void TableColumn::append(const OpReturnType& value) {
+  switch (_storage) {
+    case Storage::INT32:
+      _int32s.push_back(value->get_int32());
+      return;
+    case Storage::INT64:
+      _int64s.push_back(value->get_int64());
+      return;
+    case Storage::FLOAT:
+      _floats.push_back(value->get_float());
+      return;
+    case Storage::DOUBLE:
+      _doubles.push_back(value->get_double());
+      return;
+    case Storage::BOOLEAN:
+      _bools.push_back(value->get_bool());
+      return;
+    case Storage::STRING: {
+      auto it = _dictionaryCodes.find(value->get_string());
+      if (it == _dictionaryCodes.end()) {
+        it = _dictionaryCodes.emplace(value->get_string(), _dictionary.size()).first;
+        _dictionary.push_back(it->first);
+      }
+      _stringCodes.push_back(it->second);
+      return;
+    }
+    case Storage::BOXED:
+      _boxed.push_back(value);
+      return;
+  }
+}
+
+const std::string& TableColumn::get_string(int row) const {
+  if (_storage != Storage::STRING) {
+    THROW("Cannot get string value of column with type %s", util::get_string_from_enum(_dataType));
+  }
+  return _dictionary[_stringCodes[row]];
+}
+
+OpReturnType TableColumn::get_variable(int row) const {
+  switch (_dataType) {
+    case DATATYPE::INT32:
+      return OpReturnType(new SingleVariable<int32_t>(_int32s[row]));
+    case DATATYPE::INT64:
+      return OpReturnType(new SingleVariable<int64_t>(_int64s[row]));
+    case DATATYPE::FLOAT:
+      return OpReturnType(new SingleVariable<float>(_floats[row]));
+    case DATATYPE::DOUBLE:
+      return OpReturnType(new SingleVariable<double>(_doubles[row]));
+    case DATATYPE::BOOLEAN:
+      return OpReturnType(new SingleVariable<bool>(_bools[row]));
+    case DATATYPE::STRING:
+      return OpReturnType(new SingleVariable<std::string>(get_string(row)));
+    default:
+      return _boxed[row];
+  }
+}
+
+std::string TableColumn::print(int row) const {
+  std::stringstream ss;
+  switch (_storage) {
+    case Storage::INT32:
+      ss << _int32s[row];
+      break;
+    case Storage::INT64:
+      ss << _int64s[row];
+      break;
+    case Storage::FLOAT:
+      ss << _floats[row];
+      break;
+    case Storage::DOUBLE:
+      ss << _doubles[row];
+      break;
+    case Storage::BOOLEAN:
+      ss << bool(_bools[row]);
+      break;
+    case Storage::STRING:
+      return get_string(row);
+    case Storage::BOXED:
+      return _boxed[row]->print();
+  }
+  return ss.str();
+}
+
+bool TableColumn::is_contiguous(const std::vector<int>& rows) {
+  return std::adjacent_find(rows.begin(), rows.end(), [](int a, int b) { return b != a + 1; }) ==
+         rows.end();
+}
@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ne_fwd.hpp"
+
+/**
+ * @brief Binary encoding of an event stored in the events store.
+ *
+ * A record holds a flags byte, the timestamp as a zigzag varint, the number of fields as a varint
+ * and then every field. A field starts with a varint reference to its column, followed by a type
+ * tag and the value in a typed encoding. Column names are only written the first time a column is
+ * used in a file and are referred to by id afterwards, so records carry the schema of the events
+ * without repeating it.
+ *
+ * The timestamp of a record is a delta from the timestamp of the previous record. The first
+ * record written by an encoder has the Reset flag set, its timestamp is absolute and it clears
+ * the column dictionary, so every file and every run of the writer can be decoded independently.
+ * Resetting the encoder before every record makes each record self-contained, as needed for the
+ * rows of the SQLite events table.
+ */
+namespace eventrecord {
+
+/**
+ * @brief Flags of a record.
+ */
+enum Flags : uint8_t {
+  Reset = 1, /**< Timestamp is absolute and column ids defined before are dropped. */
+};
+
+/**
+ * @brief Type tags of the value of a field.
+ */
+enum class FieldType : uint8_t {
+  NONE = 0,
+  INT64 = 1,   /**< Zigzag varint. */
+  DOUBLE = 2,  /**< 8 bytes, little endian IEEE 754. */
+  BOOLEAN = 3, /**< 1 byte. */
+  STRING = 4,  /**< Varint length followed by the bytes. */
+  JSON = 5,    /**< Varint length followed by the JSON dump, used for lists and maps. */
+};
+
+}  // namespace eventrecord
+
+/**
+ * @brief Encodes events into binary records for one file of the events store.
+ */
+class EventRecordEncoder {
+  std::unordered_map<std::string, uint32_t> _columnIds; /**< Columns defined in the file. */
+  int64_t _lastTimestamp = 0; /**< Timestamp of the previous record. */
+  bool _reset = true; /**< Whether the next record starts a new dictionary. */
+
+ public:
+  /**
+   * @brief Encodes an event.
+   *
+   * @param timestamp Time of the event in seconds.
+   * @param event Fields of the event.
+   * @return Bytes of the record.
+   */
+  std::string encode(int64_t timestamp, const std::map<std::string, OpReturnType>& event);
+
+  /**
+   * @brief Starts over with an empty dictionary, to be called when records go to a new file.
+   */
+  void reset();
+};
+
+/**
+ * @brief Decodes binary records of the events store, in the order they were written.
+ */
+class EventRecordDecoder {
+  std::vector<std::string> _columnNames; /**< Names of the columns, indexed by column id. */
+  int64_t _lastTimestamp = 0; /**< Timestamp of the previous record. */
+
+ public:
+  /**
+   * @brief Decodes a record.
+   *
+   * @param data Bytes of the record.
+   * @param size Number of bytes in the record.
+   * @param timestamp Output time of the event in seconds.
+   * @param event Output fields of the event.
+   * @return false if the record is corrupted, in which case it should be skipped.
+   */
+  bool decode(const char* data, size_t size, int64_t& timestamp,
+              std::map<std::string, OpReturnType>& event);
+};
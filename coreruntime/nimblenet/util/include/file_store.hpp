@@ -12,15 +12,22 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdio>
+#include <deque>
 #include <fstream>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <sstream>
+#include <thread>
 
 #include "client.h"
 #include "core_utils/fmt.hpp"
+#include "flush_timer.hpp"
 #include "json.hpp"
 #include "logger.hpp"
 #include "logger_constants.hpp"
@@ -36,10 +43,172 @@ struct LogConfig {
   int maxLogFileSizeKB = loggerconstants::MaxLogFileSizeKB; /**< Maximum log file size in KB. */
   bool toSend = true; /**< Whether logs should be sent. */
   int timeWindowToSave = 0; /**< Time window for saving logs. */
+  bool binaryRecords = false; /**< Whether entries are length-prefixed binary records. */
+  bool flushEveryRecord = false; /**< Whether every entry is written out instead of in groups. */
 };
 
 #define FIRST_FILE_NAME "latest.txt"
 
+/**
+ * @brief Framing of files made of binary records.
+ *
+ * Such a file starts with Magic followed by records, each one prefixed by its length as a varint.
+ * Files without the magic hold one text entry per line, as written by older versions.
+ */
+namespace recordformat {
+
+/**
+ * @brief Bytes at the start of every file of binary records.
+ */
+static inline const std::string Magic = std::string("DLEVLOG\x01", 8);
+
+/**
+ * @brief Appends an unsigned LEB128 varint.
+ *
+ * @param out String to append to.
+ * @param value Value to encode.
+ */
+inline void append_varint(std::string& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+/**
+ * @brief Reads an unsigned LEB128 varint.
+ *
+ * @param ptr Position to read from, advanced past the varint on success.
+ * @param end End of the buffer.
+ * @param value Output decoded value.
+ * @return false if the buffer ends before the varint does or the varint is too long.
+ */
+inline bool read_varint(const char*& ptr, const char* end, uint64_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 64 && ptr < end; shift += 7) {
+    uint8_t byte = static_cast<uint8_t>(*ptr++);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Splits the contents of a file, fed chunk by chunk, into its entries.
+ *
+ * The format of the file is detected from its first bytes. Only the bytes of an entry spanning
+ * two chunks are carried over, so memory use is bounded by the chunk size and the size of the
+ * largest entry instead of by the size of the file.
+ */
+class EntryReader {
+  enum class Format { UNKNOWN, RECORDS, TEXT };
+
+  Format _format = Format::UNKNOWN; /**< Format of the file, known once enough bytes are read. */
+  std::string _pending; /**< Bytes of an entry not complete yet. */
+  size_t _size = 0; /**< Number of bytes fed. */
+  size_t _validSize = 0; /**< Number of bytes up to the end of the last complete record. */
+  std::function<void(const char*, size_t)> _onRecord; /**< Called for every binary record. */
+  std::function<void(const std::string&)> _onLine; /**< Called for every text line. */
+
+  /**
+   * @brief Detects the format once enough bytes are pending.
+   */
+  void detect_format() {
+    size_t n = std::min(_pending.size(), Magic.size());
+    if (_pending.compare(0, n, Magic, 0, n) != 0) {
+      _format = Format::TEXT;
+    } else if (n == Magic.size()) {
+      _format = Format::RECORDS;
+      _pending.erase(0, Magic.size());
+      _validSize = Magic.size();
+    }
+  }
+
+  /**
+   * @brief Passes the complete entries among the pending bytes and drops them.
+   */
+  void consume_pending() {
+    const char* begin = _pending.data();
+    const char* end = begin + _pending.size();
+    const char* consumed = begin;
+    if (_format == Format::RECORDS) {
+      const char* ptr = begin;
+      uint64_t size;
+      while (read_varint(ptr, end, size) && size <= static_cast<uint64_t>(end - ptr)) {
+        _onRecord(ptr, size);
+        ptr += size;
+        _validSize += ptr - consumed;
+        consumed = ptr;
+      }
+    } else {
+      const char* newline;
+      while ((newline = static_cast<const char*>(memchr(consumed, '\n', end - consumed)))) {
+        _onLine(std::string(consumed, newline));
+        consumed = newline + 1;
+      }
+    }
+    _pending.erase(0, consumed - begin);
+  }
+
+ public:
+  /**
+   * @brief Constructs a reader passing entries to the given functions.
+   *
+   * @param onRecord Function called with the bytes of every record of a file of binary records.
+   * @param onLine Function called with every line of a text file.
+   */
+  EntryReader(std::function<void(const char*, size_t)> onRecord,
+              std::function<void(const std::string&)> onLine)
+      : _onRecord(std::move(onRecord)), _onLine(std::move(onLine)) {}
+
+  /**
+   * @brief Feeds the next chunk of the file.
+   */
+  void feed(const char* data, size_t size) {
+    _pending.append(data, size);
+    _size += size;
+    if (_format == Format::UNKNOWN) {
+      detect_format();
+    }
+    if (_format != Format::UNKNOWN) {
+      consume_pending();
+    }
+  }
+
+  /**
+   * @brief Ends the file, passing a last text line without a newline.
+   *
+   * A record cut short by a crash while writing is dropped. So is a file too short to tell its
+   * format, which can only be the start of the magic of a file of binary records.
+   */
+  void finish() {
+    if (_format == Format::TEXT && !_pending.empty()) {
+      _onLine(_pending);
+    }
+    _pending.clear();
+  }
+
+  /**
+   * @brief Whether the file holds text lines, as written by older versions.
+   */
+  bool is_text() const { return _format == Format::TEXT; }
+
+  /**
+   * @brief Number of bytes fed.
+   */
+  size_t size() const { return _size; }
+
+  /**
+   * @brief Number of bytes up to the end of the last complete record of a file of binary records.
+   */
+  size_t valid_size() const { return _validSize; }
+};
+
+}  // namespace recordformat
+
 /**
  * @brief Metadata for a log file in the file store.
  */
@@ -92,15 +261,73 @@ struct FileData {
   bool operator<(const FileData& other) const { return fileName < other.fileName; }
 };
 
+/**
+ * @brief Compresses rotated files on a background thread shared by all file stores.
+ *
+ * At most MaxPendingCompressions files wait to be compressed. A store rotating while the queue is
+ * full compresses its file on its own thread instead, so uncompressed files cannot pile up on disk.
+ */
+class RotatedFileCompressor {
+  std::mutex _mutex; /**< Guards the members below. */
+  std::condition_variable _condition; /**< Signals new jobs to the worker and finished jobs. */
+  std::deque<std::function<void()>> _jobs; /**< Compressions waiting for the worker. */
+  bool _isRunningJob = false; /**< Whether the worker is compressing a file. */
+  bool _stop = false; /**< Set on destruction to stop the worker. */
+  std::thread _worker; /**< Thread compressing the files, started with the first job. */
+
+  /**
+   * @brief Body of the worker thread.
+   */
+  void run();
+
+ public:
+  /**
+   * @brief Returns the compressor of the process.
+   */
+  static RotatedFileCompressor& instance();
+
+  /**
+   * @brief Queues a compression for the worker thread.
+   *
+   * @param job Function compressing a file.
+   * @return false if the queue is full, the caller runs the job itself then.
+   */
+  bool try_enqueue(std::function<void()> job);
+
+  /**
+   * @brief Waits for the queued compressions to finish.
+   */
+  void wait_idle();
+
+  /**
+   * @brief Runs the queued compressions and stops the worker.
+   */
+  ~RotatedFileCompressor();
+};
+
 /**
  * @brief Manages log file compression, storage, rotation and retrieval.
+ *
+ * Entries are group committed: they accumulate in memory and are written out together once
+ * MaxUnflushedRecords entries or MaxUnflushedBytes bytes are buffered, or on flush(). FlushTimer
+ * writes them out MaxRecordFlushDelayMicros after the oldest one, even if no other entry is
+ * written, and the destructor writes out what is left. With LogConfig::flushEveryRecord
+ * every entry is written out at once instead. A full file is renamed aside and compressed by
+ * RotatedFileCompressor, it stays readable uncompressed until then.
  */
 class FileStore {
   std::string _logDirectory; /**< Directory where log files are stored. */
-  FILE* _writeFilePtr = nullptr; /**< File pointer for writing logs. */
+  FILE* _writeFilePtr = nullptr; /**< File pointer for writing logs, unbuffered. */
   std::mutex _logMutex; /**< Mutex for thread-safe log writing. */
+  /** Guards renaming and removing files, shared with the compressions of rotated files. */
+  std::shared_ptr<std::mutex> _filesMutex = std::make_shared<std::mutex>();
   LogConfig _logConfig; /**< Log configuration. */
   FileData _currentFileData; /**< Metadata for the current log file. */
+  std::string _buffer; /**< Entries not written to the file yet. */
+  int64_t _fileSize = 0; /**< Bytes written to the current file. */
+  int _unflushedRecords = 0; /**< Entries in _buffer. */
+  int64_t _firstUnflushedTimeMicros = 0; /**< Time of the oldest entry in _buffer. */
+  int _flushTimerId = -1; /**< Id of the flush of this store in FlushTimer. */
 
   /**
    * @brief Retrieves metadata for all log files in the directory.
@@ -115,6 +342,10 @@ class FileStore {
       while ((entry = readdir(dir)) != NULL) {
         if (entry->d_type == DT_REG) {  // If it's a regular file
           std::string fileName = entry->d_name;
+          if (fileName[0] == '.') {
+            // Output of a compression in progress, see compress_rotated_file
+            continue;
+          }
           if (fileName == FIRST_FILE_NAME) {
             filesData.push_back(_currentFileData);
           } else
@@ -127,44 +358,184 @@ class FileStore {
   }
 
   /**
-   * @brief Reads all events from a file and appends them to a vector.
-   * 
-   * @param filePath Path to the file.
-   * @param eventsVector Vector to append parsed events to.
-   */
-  void read_lines_from_file(const std::string& filePath,
-                            std::vector<nlohmann::json>& eventsVector) const {
-    auto [readSuccess, fileData] =
-        nativeinterface::read_potentially_compressed_file(filePath, true);
-    if (!readSuccess) {
+   * @brief Parses an event written as a text line by older versions.
+   *
+   * @param line Line of the file.
+   * @param eventJson Output event, with the time of the line in its timestamp field.
+   * @return false if the line is corrupted.
+   */
+  static bool parse_text_event(const std::string& line, nlohmann::json& eventJson) {
+    try {
+      std::istringstream iss(line);
+      std::string prefix;
+      std::string date;
+      std::string time;
+      std::string eventType;
+      std::string eventJsonString;
+      iss >> prefix >> date >> time >> prefix >> eventType >> prefix >> eventJsonString;
+      eventJson = nlohmann::json::parse(eventJsonString);
+      auto t = Time::get_epoch_time_from_timestamp(date + " " + time);
+      if (iss.fail() || t == -1) {
+        return false;
+      }
+      eventJson[usereventconstants::TimestampField] = t;
+      return true;
+    } catch (...) {
+      return false;
+    }
+  }
+
+  /**
+   * @brief Compresses a rotated file in place.
+   *
+   * The compressed file is written under a hidden name and renamed over the rotated file, so
+   * readers see either of them whole. It is dropped if the rotated file was deleted meanwhile.
+   *
+   * @param directory Directory of the file.
+   * @param fileName Name of the rotated file.
+   * @param filesMutex Mutex guarding renaming and removing files of the directory.
+   */
+  static void compress_rotated_file(const std::string& directory, const std::string& fileName,
+                                    const std::shared_ptr<std::mutex>& filesMutex) {
+    std::string filePath = directory + "/" + fileName;
+    std::string compressedFilePath = directory + "/." + fileName + ".gz";
+    if (!nativeinterface::compress_file(filePath.c_str(), compressedFilePath.c_str())) {
+      LOG_TO_ERROR("FileStore: Compressing file %s failed, saving uncompressed", filePath.c_str());
+      remove(compressedFilePath.c_str());
       return;
     }
-    std::istringstream file(fileData);
-    // release memory ASAP. Have to do this since there's no move constructor for istringstream
-    fileData.clear();
-
-    std::string line;
-    while (std::getline(file, line)) {
-      try {
-        std::istringstream iss(line);
-        std::string prefix;
-        std::string date;
-        std::string time;
-        std::string eventType;
-        std::string eventJsonString;
-        iss >> prefix >> date >> time >> prefix >> eventType >> prefix >> eventJsonString;
-        auto eventJson = nlohmann::json::parse(eventJsonString);
-        auto t = Time::get_epoch_time_from_timestamp(date + " " + time);
-        if (iss.fail() || t == -1) {
-          // skip corrupted event
-          continue;
-        }
-        eventJson[usereventconstants::TimestampField] = t;
-        eventsVector.push_back(eventJson);
-      } catch (...) {
-        continue;
+    std::lock_guard<std::mutex> locker(*filesMutex);
+    struct stat st;
+    if (stat(filePath.c_str(), &st) == 0) {
+      rename(compressedFilePath.c_str(), filePath.c_str());
+    } else {
+      remove(compressedFilePath.c_str());
+    }
+  }
+
+  /**
+   * @brief Opens the current file for appending, without stdio buffering as entries are buffered
+   * in _buffer.
+   *
+   * @param fileName Path of the current file.
+   * @param mode Mode to open the file with.
+   */
+  void open_current_file(const std::string& fileName, const char* mode) {
+    _writeFilePtr = fopen(fileName.c_str(), mode);
+    _fileSize = 0;
+    if (_writeFilePtr == nullptr) {
+      LOG_TO_ERROR("FileStore: Could not open file %s", fileName.c_str());
+      return;
+    }
+    setvbuf(_writeFilePtr, NULL, _IONBF, 0);
+    fseek(_writeFilePtr, 0, SEEK_END);
+    _fileSize = ftell(_writeFilePtr);
+  }
+
+  /**
+   * @brief Moves the current file aside, to be compressed in the background, and starts a new
+   * current file.
+   */
+  void rotate_current_file() {
+    flush_records();
+    if (_writeFilePtr) {
+      fclose(_writeFilePtr);
+    }
+    std::string rotatedFileName = _currentFileData.get_filename_to_save();
+    auto fileName = _logDirectory + "/" + _currentFileData.fileName;
+    {
+      std::lock_guard<std::mutex> locker(*_filesMutex);
+      rename(fileName.c_str(), (_logDirectory + "/" + rotatedFileName).c_str());
+    }
+    auto compression = [directory = _logDirectory, rotatedFileName, filesMutex = _filesMutex]() {
+      compress_rotated_file(directory, rotatedFileName, filesMutex);
+    };
+    if (!RotatedFileCompressor::instance().try_enqueue(compression)) {
+      compression();
+    }
+
+    open_current_file(fileName, "a+");
+    _currentFileData = FileData();
+    if (_logConfig.binaryRecords && _writeFilePtr) {
+      fwrite(recordformat::Magic.data(), 1, recordformat::Magic.size(), _writeFilePtr);
+      _fileSize += recordformat::Magic.size();
+    }
+  }
+
+  /**
+   * @brief Opens the current file of a store of binary records.
+   *
+   * Counts the complete records of the file and truncates a record cut short by a crash, so that
+   * new records are appended at a record boundary. A current file in the text format of older
+   * versions is moved aside first, its events stay readable through the text path. A file too
+   * short to hold the magic is started over.
+   *
+   * @param fileName Path of the current file.
+   */
+  void open_record_file(const std::string& fileName) {
+    recordformat::EntryReader reader(
+        [this](const char*, size_t) { _currentFileData.totalEvents++; },
+        [this](const std::string&) { _currentFileData.totalEvents++; });
+    nativeinterface::read_potentially_compressed_file_in_chunks(
+        fileName, [&reader](const char* chunk, size_t size) { reader.feed(chunk, size); });
+    reader.finish();
+    if (reader.is_text()) {
+      rotate_current_file();
+      return;
+    }
+    if (reader.size() < recordformat::Magic.size()) {
+      open_current_file(fileName, "w+");
+      if (_writeFilePtr) {
+        fwrite(recordformat::Magic.data(), 1, recordformat::Magic.size(), _writeFilePtr);
+        _fileSize += recordformat::Magic.size();
       }
+      return;
+    }
+    if (reader.valid_size() < reader.size()) {
+      truncate(fileName.c_str(), reader.valid_size());
     }
+    open_current_file(fileName, "a+");
+  }
+
+  /**
+   * @brief Writes the entries buffered in memory to the file, in a single write.
+   */
+  void flush_records() {
+    if (_buffer.empty()) return;
+    if (_writeFilePtr) {
+      fwrite(_buffer.data(), 1, _buffer.size(), _writeFilePtr);
+      _fileSize += _buffer.size();
+    }
+    _buffer.clear();
+    _unflushedRecords = 0;
+  }
+
+  /**
+   * @brief Ends an entry appended to _buffer, writing out the buffered entries if a threshold is
+   * reached and rotating the file if it is full.
+   *
+   * @return true if the file was rotated.
+   */
+  bool commit_entry() {
+    _currentFileData.totalEvents++;
+    int64_t now = Time::get_time_in_micro();
+    if (_unflushedRecords++ == 0) {
+      _firstUnflushedTimeMicros = now;
+    }
+    if (_logConfig.flushEveryRecord || _unflushedRecords >= loggerconstants::MaxUnflushedRecords ||
+        _buffer.size() >= loggerconstants::MaxUnflushedBytes ||
+        now - _firstUnflushedTimeMicros >= loggerconstants::MaxRecordFlushDelayMicros) {
+      flush_records();
+    } else if (_unflushedRecords == 1) {
+      FlushTimer::instance().schedule(_flushTimerId, loggerconstants::MaxRecordFlushDelayMicros);
+    }
+
+    int64_t size = _fileSize + _buffer.size();
+    if ((float)size / (loggerconstants::MaxBytesInKB) > _logConfig.maxLogFileSizeKB) {
+      rotate_current_file();
+      return true;
+    }
+    return false;
   }
 
  public:
@@ -176,8 +547,14 @@ class FileStore {
    */
   FileStore(const std::string& directory, const LogConfig& logConfig) : _currentFileData() {
     _logDirectory = directory;
+    _logConfig = logConfig;
+    _flushTimerId = FlushTimer::instance().add([this]() { flush(); });
     mkdir(_logDirectory.c_str(), S_IRUSR | S_IWUSR | S_IXUSR);
     auto fileName = _logDirectory + "/" + _currentFileData.fileName;
+    if (_logConfig.binaryRecords) {
+      open_record_file(fileName);
+      return;
+    }
     {
       // just to count number of events
       // NOTE: Using fstream here, since FIRST_FILE_NAME (default file) is not compressed
@@ -190,58 +567,88 @@ class FileStore {
       }
       file.close();
     }
-    _writeFilePtr = fopen(fileName.c_str(), "a+");
-    _logConfig = logConfig;
+    open_current_file(fileName, "a+");
   }
 
   /**
-   * @brief Destructor, closes the log file pointer.
+   * @brief Destructor, cancels the delayed flush, writes out the buffered entries and closes the
+   * log file pointer.
    */
-  ~FileStore() { fclose(_writeFilePtr); }
+  ~FileStore() {
+    FlushTimer::instance().remove(_flushTimerId);
+    flush_records();
+    if (_writeFilePtr) {
+      fclose(_writeFilePtr);
+    }
+  }
 
   /**
-   * @brief Writes a log message to the current file, rotating if needed.
-   * 
+   * @brief Appends a log message to the current file, rotating if needed.
+   *
    * @param message Log message to write.
    */
   void write(const char* message) {
     std::lock_guard<std::mutex> locker(_logMutex);
-    fputs(message, _writeFilePtr);
-    fflush(_writeFilePtr);
-    long size = ftell(_writeFilePtr);
-    _currentFileData.totalEvents++;
-    if ((float)size / (loggerconstants::MaxBytesInKB) > _logConfig.maxLogFileSizeKB) {
-      fclose(_writeFilePtr);
-      std::string newFileName = _logDirectory + "/" + _currentFileData.get_filename_to_save();
-      auto fileName = _logDirectory + "/" + _currentFileData.fileName;
-      if (!nativeinterface::compress_file(fileName.c_str(), newFileName.c_str())) {
-        LOG_TO_ERROR("FileStore: Compressing file %s to %s failed, saving uncompressed",
-                     fileName.c_str(), newFileName.c_str());
-        rename(fileName.c_str(), newFileName.c_str());
-      }
-      remove(fileName.c_str());
+    _buffer += message;
+    commit_entry();
+  }
 
-      _writeFilePtr = fopen(fileName.c_str(), "a+");
-      _currentFileData = FileData();
-    }
+  /**
+   * @brief Appends a binary record to the current file, rotating if needed.
+   *
+   * @param record Bytes of the record.
+   * @return true if the file was rotated after this record, so the next record starts a new file.
+   */
+  bool write_record(const std::string& record) {
+    std::lock_guard<std::mutex> locker(_logMutex);
+    recordformat::append_varint(_buffer, record.size());
+    _buffer += record;
+    return commit_entry();
   }
 
   /**
-   * @brief Reads all events from all log files.
-   * 
-   * @return Vector of parsed event JSON objects.
+   * @brief Writes out the buffered entries before returning.
    */
-  std::vector<nlohmann::json> read() const {
-    DIR* dir;
-    struct dirent* entry;
-    std::vector<nlohmann::json> eventsVector;
+  void flush() {
+    std::lock_guard<std::mutex> locker(_logMutex);
+    flush_records();
+  }
+
+  /**
+   * @brief Streams all entries of all files, oldest file first.
+   *
+   * Files are decompressed and split into entries chunk by chunk, so memory use does not grow with
+   * the size of the history. Files of binary records are passed record by record without parsing
+   * them, files written as text lines by older versions are parsed into JSON events.
+   *
+   * @param onRecord Function called with the bytes of every binary record.
+   * @param onTextEvent Function called with every event of a text file.
+   * @param expiryTime Files whose last event is older than this timestamp are skipped unread.
+   */
+  void read_records(const std::function<void(const char*, size_t)>& onRecord,
+                    const std::function<void(nlohmann::json&&)>& onTextEvent,
+                    int64_t expiryTime = 0) {
+    {
+      std::lock_guard<std::mutex> locker(_logMutex);
+      flush_records();
+    }
     std::vector<FileData> filesData = get_all_files_data();
     sort(filesData.begin(), filesData.end());
+    nlohmann::json eventJson;
     for (auto& fileData : filesData) {
+      if (fileData.valid && fileData.lastTimestamp < expiryTime) {
+        continue;
+      }
       std::string filePath = _logDirectory + "/" + fileData.fileName;
-      read_lines_from_file(filePath, eventsVector);
+      recordformat::EntryReader reader(onRecord, [&](const std::string& line) {
+        if (parse_text_event(line, eventJson)) {
+          onTextEvent(std::move(eventJson));
+        }
+      });
+      nativeinterface::read_potentially_compressed_file_in_chunks(
+          filePath, [&reader](const char* chunk, size_t size) { reader.feed(chunk, size); });
+      reader.finish();
     }
-    return eventsVector;
   }
 
   /**
@@ -251,6 +658,7 @@ class FileStore {
    * @return True if operation succeeded.
    */
   bool delete_old_events(int64_t expiryTime) const {
+    std::lock_guard<std::mutex> locker(*_filesMutex);
     std::vector<FileData> filesData = get_all_files_data();
     for (auto& fileData : filesData) {
       if (fileData.valid && fileData.lastTimestamp < expiryTime) {
@@ -270,6 +678,7 @@ class FileStore {
    */
   bool delete_old_events_by_count(int maxEvents) const {
     if (maxEvents < 0) return false;
+    std::lock_guard<std::mutex> locker(*_filesMutex);
     std::vector<FileData> filesData = get_all_files_data();
     sort(filesData.rbegin(), filesData.rend());
     int numEvents = 0;
@@ -341,7 +750,16 @@ template <StoreType storeType>
 class Store {
   std::string _directory; /**< Directory for storing types. */
   std::map<std::string, FileStore> _type2FileStoreMap; /**< Map from type to FileStore. */
-  LogConfig _defaultConfig; /**< Default log configuration. */
+  LogConfig _defaultConfig = default_config(); /**< Default log configuration. */
+
+  /**
+   * @brief Default configuration of the files of a type, metrics are written as binary records.
+   */
+  static LogConfig default_config() {
+    LogConfig config;
+    config.binaryRecords = storeType == StoreType::METRICS;
+    return config;
+  }
 
  public:
   /**
@@ -358,9 +776,11 @@ class Store {
    * @brief Initializes the store by scanning the directory for existing types.
    * 
    * @param directory Directory to scan and initialize.
+   * @param flushEveryRecord Whether entries are written out one by one, see LogConfig.
    */
-  void init(const std::string& directory) {
+  void init(const std::string& directory, bool flushEveryRecord = false) {
     _directory = directory;
+    _defaultConfig.flushEveryRecord = flushEveryRecord;
     mkdir(_directory.c_str(), S_IRUSR | S_IWUSR | S_IXUSR);
     DIR* dir = opendir(_directory.c_str());
     if (dir == nullptr) {
@@ -409,17 +829,42 @@ class Store {
   }
 
   /**
-   * @brief Reads all events for a given type.
-   * 
+   * @brief Appends a binary record for a given type.
+   *
    * @param type Type string.
-   * @return Vector of parsed event JSON objects.
+   * @param record Bytes of the record.
+   * @return true if the file of the type was rotated after this record.
    */
-  std::vector<nlohmann::json> read(const char* type) const {
+  bool write_record(const char* type, const std::string& record) {
+    add_type(type);
+    return _type2FileStoreMap.at(type).write_record(record);
+  }
+
+  /**
+   * @brief Writes out the buffered entries of all types, see FileStore::flush.
+   */
+  void flush() {
+    for (auto& [type, fileStore] : _type2FileStoreMap) {
+      fileStore.flush();
+    }
+  }
+
+  /**
+   * @brief Streams all entries for a given type, see FileStore::read_records.
+   *
+   * @param type Type string.
+   * @param onRecord Function called with the bytes of every binary record.
+   * @param onTextEvent Function called with every event written as a text line.
+   * @param expiryTime Files whose last event is older than this timestamp are skipped unread.
+   */
+  void read_records(const char* type, const std::function<void(const char*, size_t)>& onRecord,
+                    const std::function<void(nlohmann::json&&)>& onTextEvent,
+                    int64_t expiryTime = 0) {
     auto it = _type2FileStoreMap.find(type);
     if (it == _type2FileStoreMap.end()) {
-      return {};
+      return;
     }
-    return it->second.read();
+    it->second.read_records(onRecord, onTextEvent, expiryTime);
   }
 
   /**
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Runs delayed flushes of buffered writes on a background thread shared by the process.
+ *
+ * A writer registers its flush function once and schedules it whenever it starts buffering, the
+ * flush then runs after the delay even if nothing else is written. So buffered data is held at
+ * most for the delay, instead of until the next write.
+ */
+class FlushTimer {
+  using Clock = std::chrono::steady_clock;
+
+  std::mutex _mutex; /**< Guards the members below. */
+  std::condition_variable _condition; /**< Signals new deadlines and finished flushes. */
+  std::map<int, std::function<void()>> _flushes; /**< Registered flush functions by id. */
+  std::multimap<Clock::time_point, int> _deadlines; /**< Scheduled flushes by deadline. */
+  /** Deadline of every scheduled flush by id. */
+  std::map<int, std::multimap<Clock::time_point, int>::iterator> _scheduled;
+  int _nextId = 0; /**< Id of the next registered flush function. */
+  int _runningId = -1; /**< Id of the flush being run by the worker, -1 if none. */
+  bool _stop = false; /**< Set on destruction to stop the worker. */
+  std::thread _worker; /**< Thread running the flushes, started with the first schedule. */
+
+  /**
+   * @brief Body of the worker thread.
+   */
+  void run();
+
+ public:
+  /**
+   * @brief Returns the timer of the process.
+   */
+  static FlushTimer& instance();
+
+  /**
+   * @brief Registers a flush function.
+   *
+   * @param flush Function writing out buffered data, called on the worker thread. It must take
+   * the locks of the writer itself.
+   * @return Id to schedule and remove the function with.
+   */
+  int add(std::function<void()> flush);
+
+  /**
+   * @brief Runs a flush function after a delay, does nothing if it is already scheduled.
+   *
+   * @param id Id returned by add.
+   * @param delayMicros Delay before the flush in microseconds.
+   */
+  void schedule(int id, int64_t delayMicros);
+
+  /**
+   * @brief Removes a flush function, waiting for it to finish if it is running.
+   *
+   * Must be called before the writer is destroyed, without holding the locks its flush takes.
+   *
+   * @param id Id returned by add.
+   */
+  void remove(int id);
+
+  /**
+   * @brief Stops the worker, flushes still scheduled are not run.
+   */
+  ~FlushTimer();
+};
@@ -11,14 +11,18 @@
 #include <sys/time.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdarg>
 #include <mutex>
 #include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
 
 #include "client.h"
 #include "core_utils/atomic_ptr.hpp"
 #include "core_utils/fmt.hpp"
 #include "logger_constants.hpp"
+#include "mpsc_ring_buffer.hpp"
 #include "time_manager.hpp"
 
 /**
@@ -98,9 +102,18 @@ static inline int64_t get_file_size(const std::string& fullFilePath) {
 class Logger {
   std::string _writeFile; /**< Current log file name. */
   std::string _logDirectory; /**< Directory for log files. */
-  FILE* _writeFilePtr = NULL; /**< File pointer for writing logs. */
+  FILE* _writeFilePtr = NULL; /**< File pointer for writing logs, unbuffered. */
   ne::AtomicPtr<LogWritingConfig> _atomicLogConfig; /**< Atomic pointer to log config. */
-  std::mutex _logMutex; /**< Mutex for thread-safe logging. */
+  std::mutex _logMutex; /**< Guards the file and consuming _pendingLines. */
+  MPSCRingBuffer<std::string> _pendingLines{
+      loggerconstants::LogRingBufferSize}; /**< Lines waiting to be written by the flusher. */
+  std::atomic<bool> _isWriting = false; /**< Whether lines are accepted, once the file is open. */
+  std::atomic<uint64_t> _droppedLines = 0; /**< Lines dropped as _pendingLines was full. */
+  uint64_t _reportedDroppedLines = 0; /**< Dropped lines already noted in the file. */
+  std::thread _flusher; /**< Writes _pendingLines to the file in batches. */
+  std::mutex _flusherMutex; /**< Guards _stopFlusher. */
+  std::condition_variable _flusherCondition; /**< Wakes the flusher early. */
+  bool _stopFlusher = false; /**< Set on destruction to stop the flusher. */
   bool _isClientDebug = false; /**< Enable client debug logging. */
   std::atomic<int64_t> _dirSize = 0; /**< Current directory size in bytes. */
   int64_t _maxDirSize = loggerconstants::MaxEventsSizeKBs * 1024; /**< Max allowed directory size. */
@@ -173,7 +186,9 @@ class Logger {
   }
 
   /**
-   * @brief Writes a log message to the log file, with log rotation if size limit is reached.
+   * @brief Queues a log message for the flusher thread, which writes queued messages in batches
+   * and rotates the log file when its size limit is reached. The message is dropped, and counted
+   * in dropped_log_count(), if the queue is full.
    *
    * @param message The log message.
    * @param type The log type (e.g., INFO, ERROR).
@@ -182,6 +197,16 @@ class Logger {
   void write_log(const char* message, const char* type,
                  const std::string& currentDate = Time::get_date_UTC());
 
+  /**
+   * @brief Writes the queued log messages to the log file before returning.
+   */
+  void flush();
+
+  /**
+   * @brief Returns the number of log messages dropped so far as the queue was full.
+   */
+  uint64_t dropped_log_count() const noexcept { return _droppedLines.load(); }
+
   /**
    * @brief Updates the log configuration atomically.
    *
@@ -377,15 +402,24 @@ class Logger {
   }
 
   /**
-   * @brief Destructor for Logger. Closes the log file if open.
+   * @brief Destructor for Logger. Stops the flusher, writes the queued messages and closes the log
+   * file if open.
    */
-  ~Logger() {
-    if (_writeFilePtr) {
-      fclose(_writeFilePtr);
-    }
-  }
+  ~Logger();
 
  private:
+  /**
+   * @brief Writes the queued messages in a single write, with a note of newly dropped messages.
+   * Expects _logMutex to be held.
+   */
+  void write_pending_lines();
+
+  /**
+   * @brief Body of the flusher thread, writing queued messages every LogFlushIntervalMillis or
+   * sooner when the queue fills up.
+   */
+  void run_flusher();
+
   /**
    * @brief Breaks the current log file and returns the new file name (internal).
    * 
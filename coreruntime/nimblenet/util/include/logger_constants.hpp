@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace loggerconstants {
@@ -22,4 +24,10 @@ static inline const int InferenceMetricLogInterval = 1;
 static inline const float LogSendProbability = 1;
 static inline const int MaxFilesToSend = 5;
 static inline float MaxEventsSizeKBs = 5000;  // 5 MB
+static inline const int MaxUnflushedRecords = 64;
+static inline const std::size_t MaxUnflushedBytes = 64 * 1024;
+static inline const int MaxPendingCompressions = 4;
+static inline const int64_t MaxRecordFlushDelayMicros = 1000000;  // 1 second
+static inline const std::size_t LogRingBufferSize = 4096;  // Lines queued before dropping
+static inline const int LogFlushIntervalMillis = 100;
 }  // namespace loggerconstants
@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief Map holding at most capacity entries, evicting the least recently used one when full.
+ *
+ * Not thread safe.
+ */
+template <typename Key, typename Value>
+class LRUCache {
+  using Entries = std::list<std::pair<Key, Value>>;
+
+  std::size_t _capacity;
+  Entries _entries; /**< Most recently used first. */
+  std::unordered_map<Key, typename Entries::iterator> _index;
+
+ public:
+  explicit LRUCache(std::size_t capacity) : _capacity(capacity) {}
+
+  /**
+   * @brief Looks up a key and marks it as the most recently used.
+   *
+   * @return The value, or nullptr if the key is not cached. The pointer is invalidated by the next
+   * put().
+   */
+  const Value* get(const Key& key) {
+    auto it = _index.find(key);
+    if (it == _index.end()) return nullptr;
+    _entries.splice(_entries.begin(), _entries, it->second);
+    return &it->second->second;
+  }
+
+  /**
+   * @brief Inserts or replaces the value of a key as the most recently used.
+   */
+  void put(const Key& key, Value value) {
+    if (_capacity == 0) return;
+    auto it = _index.find(key);
+    if (it != _index.end()) {
+      it->second->second = std::move(value);
+      _entries.splice(_entries.begin(), _entries, it->second);
+      return;
+    }
+    if (_entries.size() == _capacity) {
+      _index.erase(_entries.back().first);
+      _entries.pop_back();
+    }
+    _entries.emplace_front(key, std::move(value));
+    _index[key] = _entries.begin();
+  }
+
+  std::size_t size() const noexcept { return _entries.size(); }
+
+  void clear() {
+    _entries.clear();
+    _index.clear();
+  }
+};
@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Pages are loaded from the file on first access and shared through the page cache, so mapping a
+ * model does not copy it into the heap and the kernel can drop clean pages under memory pressure.
+ * The mapping is released when the object is destroyed.
+ */
+class MappedFile {
+  void* _data = nullptr;
+  std::size_t _size = 0;
+
+  MappedFile(void* data, std::size_t size) : _data(data), _size(size) {}
+
+ public:
+  /**
+   * @brief How a mapping is going to be read, advised to the kernel to choose what to read ahead.
+   */
+  enum class Access {
+    WHOLE,  /**< Read whole soon after mapping, the file is read ahead. */
+    RANDOM, /**< Read in scattered pieces, only the pages accessed are loaded. */
+  };
+
+  /**
+   * @brief Maps a file and advises the kernel of how it is going to be read.
+   *
+   * @param filePath Path to the file.
+   * @param access How the mapping is going to be read.
+   * @return The mapping, or nullptr if the file could not be opened or mapped. An empty file is
+   * mapped with a null data pointer.
+   */
+  static std::unique_ptr<MappedFile> open(const std::string& filePath,
+                                          Access access = Access::WHOLE);
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile();
+
+  const char* data() const noexcept { return static_cast<const char*>(_data); }
+
+  std::size_t size() const noexcept { return _size; }
+};
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Bounded lock-free queue for many producers and a single consumer.
+ *
+ * Every cell carries a sequence number telling whether it is free for the producer claiming its
+ * position or filled for the consumer, so producers only contend on a compare-and-swap of the
+ * enqueue position and never wait for each other. A push fails instead of blocking when the queue
+ * is full.
+ *
+ * try_pop() must not be called concurrently, the owner serializes consumers.
+ */
+template <typename T>
+class MPSCRingBuffer {
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Cell[]> _cells;
+  std::size_t _mask;
+  alignas(64) std::atomic<std::size_t> _enqueuePos{0};
+  alignas(64) std::atomic<std::size_t> _dequeuePos{0}; /**< Only written by the consumer. */
+
+ public:
+  /**
+   * @param capacity Maximum number of elements, rounded up to a power of two.
+   */
+  explicit MPSCRingBuffer(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity) size <<= 1;
+    _cells.reset(new Cell[size]);
+    _mask = size - 1;
+    for (std::size_t i = 0; i < size; i++) {
+      _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Adds an element, from any thread.
+   *
+   * @return false, leaving value untouched, if the queue is full.
+   */
+  bool try_push(T&& value) {
+    std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &_cells[pos & _mask];
+      std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        // The cell still holds the element pushed one lap earlier
+        return false;
+      } else {
+        pos = _enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::move(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest element, from the single consumer.
+   *
+   * @return false if the queue is empty, or if the oldest element is still being pushed.
+   */
+  bool try_pop(T& value) {
+    std::size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+    Cell& cell = _cells[pos & _mask];
+    if (cell.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+    value = std::move(cell.value);
+    cell.sequence.store(pos + _mask + 1, std::memory_order_release);
+    _dequeuePos.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Approximate number of elements, exact when no push or pop is in progress.
+   */
+  std::size_t size() const noexcept {
+    std::size_t dequeuePos = _dequeuePos.load(std::memory_order_relaxed);
+    std::size_t enqueuePos = _enqueuePos.load(std::memory_order_relaxed);
+    return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+  }
+
+  std::size_t capacity() const noexcept { return _mask + 1; }
+};
@@ -8,10 +8,12 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <type_traits>
 #include <vector>
@@ -22,16 +24,20 @@
 static int DEFAULT_THREAD_SPIN_TIME_IN_MS = 50;
 
 /**
- * @brief A thread pool for managing and executing tasks concurrently using multiple worker threads.
+ * @brief A work-stealing thread pool for managing and executing tasks concurrently using multiple
+ * worker threads.
  *
- * The ThreadPool class allows enqueuing tasks to be executed asynchronously by a pool of worker threads.
- * Tasks are processed in FIFO order.
+ * Every worker owns a deque of tasks. A task enqueued from a worker goes to the back of its own
+ * deque, other tasks are spread over the deques round robin. Workers take tasks from the back of
+ * their own deque and, once it is empty, steal from the front of the deques of other workers, so
+ * that no single lock is shared by all threads. Idle workers spin on an atomic count of pending
+ * tasks for spinTimeInMs and then sleep on a condition variable until a task is enqueued.
  */
 class ThreadPool {
  public:
   /**
    * @brief Constructs a ThreadPool with a specified number of worker threads.
-   * 
+   *
    * @param numThreads Number of worker threads to create.
    */
   explicit ThreadPool(size_t numThreads);
@@ -67,36 +73,74 @@ class ThreadPool {
         std::bind(std::forward<F>(f), std::forward<Args>(args)...));
 
     std::future<return_type> res = task->get_future();
-    {
-      std::unique_lock<std::mutex> lock(queueMutex);
-      if (stop) throw std::runtime_error("ThreadPool is stopped");
-
-      tasks.emplace([task]() { (*task)(); });
-    }
-    condition.notify_one();
+    push_task([task]() { (*task)(); });
     return res;
   }
 
   /**
-   * @brief Runs a single task from the thread pool queue in the current thread, if available.
+   * @brief Runs a single task from the thread pool queues in the current thread, if available.
    */
   void run_threadpool_task();
 
+  /**
+   * @brief Calls body over consecutive chunks covering [begin, end), in parallel.
+   *
+   * Chunks are claimed from a shared cursor by the calling thread and by at most one helper task
+   * per worker. Their size adapts to the work left, starting large and shrinking towards
+   * minChunkSize, so that threads finishing early pick up the tail. Returns once every chunk is
+   * done. If body throws, chunks not claimed yet are skipped and the first exception is rethrown.
+   *
+   * @param begin First index.
+   * @param end Index past the last one.
+   * @param body Function called with the bounds [chunkBegin, chunkEnd) of every chunk.
+   * @param minChunkSize Smallest number of indices in a chunk.
+   */
+  void parallel_for(int begin, int end, const std::function<void(int, int)>& body,
+                    int minChunkSize = 1);
+
  private:
   /**
-   * @brief Worker threads that execute tasks from the queue.
+   * @brief Tasks of a worker, taken from the back by the worker and stolen from the front.
+   */
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  /**
+   * @brief Progress of a parallel_for, shared by the threads running its chunks.
+   */
+  struct ParallelForState;
+
+  /**
+   * @brief Worker threads that execute tasks from the queues.
    */
   std::vector<std::thread> workers;
 
   /**
-   * @brief Queue of tasks to be executed by the worker threads.
+   * @brief Queue of tasks of every worker thread.
+   */
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+  /**
+   * @brief Number of tasks enqueued and not taken yet, checked by idle workers without locking.
    */
-  std::queue<std::function<void()>> tasks;
+  std::atomic<int> pendingTasks;
 
   /**
-   * @brief Mutex for synchronizing access to the task queue.
+   * @brief Number of workers waiting on the condition variable.
    */
-  std::mutex queueMutex;
+  std::atomic<int> sleepingWorkers;
+
+  /**
+   * @brief Queue the next task from outside the pool is pushed to.
+   */
+  std::atomic<unsigned int> nextQueue;
+
+  /**
+   * @brief Mutex for the condition variable of sleeping workers.
+   */
+  std::mutex sleepMutex;
 
   /**
    * @brief Condition variable for notifying worker threads of new tasks or shutdown.
@@ -108,8 +152,26 @@ class ThreadPool {
    */
   std::atomic<bool> stop;
 
+  /**
+   * @brief Pushes a task to a queue and wakes up a sleeping worker if any.
+   *
+   * @throws std::runtime_error if the thread pool is stopped.
+   */
+  void push_task(std::function<void()>&& task);
+
+  /**
+   * @brief Takes a task, from the back of the queue at index or else from the front of another.
+   *
+   * @param index Queue to look at first.
+   * @param task Output task.
+   * @return false if there is no task to run.
+   */
+  bool pop_task(size_t index, std::function<void()>& task);
+
   /**
    * @brief Function executed by each worker thread to process tasks.
+   *
+   * @param index Index of the worker and of its queue.
    */
-  void workerThread();
+  void workerThread(size_t index);
 };
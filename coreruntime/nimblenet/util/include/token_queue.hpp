@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Single producer single consumer queue of generated text, passed one token at a time.
+ *
+ * The producer, typically an LLM inference thread, appends every decoded token with push(). The
+ * consumer sleeps in wait_for_output() until there is something to read, and takes everything
+ * pushed since its last call with consume(), as a single slice of text along with the ids of the
+ * tokens it is made of. Text is double buffered: the consumer swaps the pending buffer with the one
+ * it has read, so the capacity of both buffers is reused across batches and no character is copied
+ * one by one.
+ *
+ * The producer is blocked while more than capacity bytes are waiting to be consumed. Several
+ * threads can wait for output, but calls to consume() must not overlap.
+ */
+class TokenQueue {
+ public:
+  /**
+   * @brief Called by consume() with the text of a batch of tokens and the id of every token, which
+   * is NoTokenId for producers which don't have them.
+   */
+  using BatchFunction = std::function<void(std::string_view text, const std::vector<int32_t>&)>;
+
+  /**
+   * @brief Id pushed along with text that does not come from a single token.
+   */
+  static constexpr int32_t NoTokenId = -1;
+
+ private:
+  std::mutex _mutex;
+  std::condition_variable _outputAvailable; /**< Signalled on push, close and detach. */
+  std::condition_variable _spaceAvailable;  /**< Signalled on consume and detach. */
+  std::string _pendingText;                 /**< Text pushed and not consumed yet. */
+  std::vector<int32_t> _pendingTokenIds;    /**< Ids of the tokens in _pendingText. */
+  std::string _consumedText;                /**< Buffer of the last batch, swapped on consume. */
+  std::vector<int32_t> _consumedTokenIds;   /**< Ids of the tokens of the last batch. */
+  std::size_t _capacity;
+  bool _closed = false;   /**< The producer has pushed everything. */
+  bool _detached = false; /**< The consumer does not read anymore. */
+
+ public:
+  /**
+   * @brief Constructs a queue.
+   *
+   * @param capacity Number of bytes pending after which push() blocks.
+   */
+  explicit TokenQueue(std::size_t capacity);
+
+  /**
+   * @brief Appends the text of a token, waiting while the queue is full.
+   *
+   * @param text Decoded text of the token.
+   * @param tokenId Id of the token, or NoTokenId.
+   * @return false if the queue is closed or the consumer has detached, the text is dropped.
+   */
+  bool push(std::string_view text, int32_t tokenId = NoTokenId);
+
+  /**
+   * @brief Marks the end of the output. Can be called more than once.
+   */
+  void close();
+
+  /**
+   * @brief Called by the consumer when it stops reading. Wakes up and drops further pushes, so that
+   * the producer never blocks on a full queue, and wakes up threads in wait_for_output().
+   */
+  void detach();
+
+  /**
+   * @brief Waits until there is output to consume, the queue is closed or the consumer detached.
+   */
+  void wait_for_output();
+
+  /**
+   * @brief Calls batchFunction once with everything pushed since the last call, if anything.
+   *
+   * @param batchFunction Function called with the batch, while no lock is held.
+   * @return true if the queue is closed and everything pushed has been consumed.
+   */
+  bool consume(const BatchFunction& batchFunction);
+};
@@ -0,0 +1,216 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "event_record.hpp"
+
+#include <cstring>
+
+#include "data_variable.hpp"
+#include "file_store.hpp"
+#include "logger.hpp"
+#include "single_variable.hpp"
+
+using namespace eventrecord;
+using recordformat::append_varint;
+using recordformat::read_varint;
+
+namespace {
+
+inline uint64_t zigzag_encode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzag_decode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void append_bytes(std::string& out, const std::string& bytes) {
+  append_varint(out, bytes.size());
+  out.append(bytes);
+}
+
+bool read_bytes(const char*& ptr, const char* end, std::string& bytes) {
+  uint64_t size;
+  if (!read_varint(ptr, end, size) || size > static_cast<uint64_t>(end - ptr)) {
+    return false;
+  }
+  bytes.assign(ptr, size);
+  ptr += size;
+  return true;
+}
+
+void append_value(std::string& out, const OpReturnType& value) {
+  if (value->is_single()) {
+    switch (value->get_dataType_enum()) {
+      case DATATYPE::NONE:
+        out.push_back(static_cast<char>(FieldType::NONE));
+        return;
+      case DATATYPE::INT32:
+      case DATATYPE::INT64:
+        out.push_back(static_cast<char>(FieldType::INT64));
+        append_varint(out, zigzag_encode(value->get_int64()));
+        return;
+      case DATATYPE::FLOAT:
+      case DATATYPE::DOUBLE: {
+        out.push_back(static_cast<char>(FieldType::DOUBLE));
+        double val = value->get_double();
+        char bytes[sizeof(double)];
+        std::memcpy(bytes, &val, sizeof(double));
+        out.append(bytes, sizeof(double));
+        return;
+      }
+      case DATATYPE::BOOLEAN:
+        out.push_back(static_cast<char>(FieldType::BOOLEAN));
+        out.push_back(value->get_bool() ? 1 : 0);
+        return;
+      case DATATYPE::STRING:
+        out.push_back(static_cast<char>(FieldType::STRING));
+        append_bytes(out, value->get_string());
+        return;
+      default:
+        break;
+    }
+  }
+  out.push_back(static_cast<char>(FieldType::JSON));
+  append_bytes(out, value->to_json_str());
+}
+
+bool read_value(const char*& ptr, const char* end, OpReturnType& value) {
+  if (ptr >= end) {
+    return false;
+  }
+  auto type = static_cast<FieldType>(*ptr++);
+  switch (type) {
+    case FieldType::NONE:
+      value = std::make_shared<NoneVariable>();
+      return true;
+    case FieldType::INT64: {
+      uint64_t val;
+      if (!read_varint(ptr, end, val)) return false;
+      value = std::make_shared<SingleVariable<int64_t>>(zigzag_decode(val));
+      return true;
+    }
+    case FieldType::DOUBLE: {
+      if (end - ptr < static_cast<ptrdiff_t>(sizeof(double))) return false;
+      double val;
+      std::memcpy(&val, ptr, sizeof(double));
+      ptr += sizeof(double);
+      value = std::make_shared<SingleVariable<double>>(val);
+      return true;
+    }
+    case FieldType::BOOLEAN:
+      if (ptr >= end) return false;
+      value = std::make_shared<SingleVariable<bool>>(*ptr++ != 0);
+      return true;
+    case FieldType::STRING: {
+      std::string val;
+      if (!read_bytes(ptr, end, val)) return false;
+      value = std::make_shared<SingleVariable<std::string>>(std::move(val));
+      return true;
+    }
+    case FieldType::JSON: {
+      std::string val;
+      if (!read_bytes(ptr, end, val)) return false;
+      nlohmann::json parsed;
+      try {
+        parsed = nlohmann::json::parse(val);
+      } catch (nlohmann::json::exception& e) {
+        LOG_TO_ERROR("Field=%s of event record is not a valid json. error=%s", val.c_str(),
+                     e.what());
+        return false;
+      }
+      value = DataVariable::get_SingleVariableFrom_JSON(parsed);
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+std::string EventRecordEncoder::encode(int64_t timestamp,
+                                       const std::map<std::string, OpReturnType>& event) {
+  std::string record;
+  record.push_back(_reset ? Flags::Reset : 0);
+  append_varint(record, zigzag_encode(_reset ? timestamp : timestamp - _lastTimestamp));
+  _reset = false;
+  _lastTimestamp = timestamp;
+
+  append_varint(record, event.size());
+  for (const auto& [name, value] : event) {
+    auto it = _columnIds.find(name);
+    if (it == _columnIds.end()) {
+      // The lowest bit marks the first use of a column, which carries its name
+      uint32_t id = _columnIds.size();
+      _columnIds.emplace(name, id);
+      append_varint(record, (static_cast<uint64_t>(id) << 1) | 1);
+      append_bytes(record, name);
+    } else {
+      append_varint(record, static_cast<uint64_t>(it->second) << 1);
+    }
+    append_value(record, value);
+  }
+  return record;
+}
+
+void EventRecordEncoder::reset() {
+  _columnIds.clear();
+  _reset = true;
+}
+
+bool EventRecordDecoder::decode(const char* data, size_t size, int64_t& timestamp,
+                                std::map<std::string, OpReturnType>& event) {
+  const char* ptr = data;
+  const char* end = data + size;
+  if (ptr >= end) {
+    return false;
+  }
+  uint8_t flags = static_cast<uint8_t>(*ptr++);
+  uint64_t encodedTimestamp;
+  if (!read_varint(ptr, end, encodedTimestamp)) {
+    return false;
+  }
+  if (flags & Flags::Reset) {
+    _columnNames.clear();
+    _lastTimestamp = 0;
+  }
+  timestamp = _lastTimestamp + zigzag_decode(encodedTimestamp);
+  _lastTimestamp = timestamp;
+
+  uint64_t numFields;
+  if (!read_varint(ptr, end, numFields)) {
+    return false;
+  }
+  event.clear();
+  try {
+    for (uint64_t i = 0; i < numFields; i++) {
+      uint64_t columnRef;
+      if (!read_varint(ptr, end, columnRef)) {
+        return false;
+      }
+      uint64_t id = columnRef >> 1;
+      if (columnRef & 1) {
+        if (id != _columnNames.size()) {
+          return false;
+        }
+        _columnNames.emplace_back();
+        if (!read_bytes(ptr, end, _columnNames.back())) {
+          return false;
+        }
+      } else if (id >= _columnNames.size()) {
+        return false;
+      }
+      OpReturnType value;
+      if (!read_value(ptr, end, value)) {
+        return false;
+      }
+      event[_columnNames[id]] = std::move(value);
+    }
+  } catch (...) {
+    return false;
+  }
+  return true;
+}
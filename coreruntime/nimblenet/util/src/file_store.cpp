@@ -15,3 +15,55 @@ template <>
 char* Store<StoreType::METRICS>::format(const char* type, const char* timestamp, const char* log) {
   return ne::fmt_to_raw("METRICS::: %s ::: %s ::: %s\n", timestamp, type, log);
 }
+
+RotatedFileCompressor& RotatedFileCompressor::instance() {
+  static RotatedFileCompressor compressor;
+  return compressor;
+}
+
+bool RotatedFileCompressor::try_enqueue(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_stop || _jobs.size() >= loggerconstants::MaxPendingCompressions) {
+      return false;
+    }
+    _jobs.push_back(std::move(job));
+    if (!_worker.joinable()) {
+      _worker = std::thread(&RotatedFileCompressor::run, this);
+    }
+  }
+  _condition.notify_all();
+  return true;
+}
+
+void RotatedFileCompressor::run() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    _condition.wait(lock, [this]() { return _stop || !_jobs.empty(); });
+    if (_jobs.empty()) return;
+    auto job = std::move(_jobs.front());
+    _jobs.pop_front();
+    _isRunningJob = true;
+    lock.unlock();
+    job();
+    lock.lock();
+    _isRunningJob = false;
+    _condition.notify_all();
+  }
+}
+
+void RotatedFileCompressor::wait_idle() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _condition.wait(lock, [this]() { return _jobs.empty() && !_isRunningJob; });
+}
+
+RotatedFileCompressor::~RotatedFileCompressor() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _condition.notify_all();
+  if (_worker.joinable()) {
+    _worker.join();
+  }
+}
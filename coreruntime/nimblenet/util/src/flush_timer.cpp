@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "flush_timer.hpp"
+
+FlushTimer& FlushTimer::instance() {
+  static FlushTimer timer;
+  return timer;
+}
+
+int FlushTimer::add(std::function<void()> flush) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  int id = _nextId++;
+  _flushes.emplace(id, std::move(flush));
+  return id;
+}
+
+void FlushTimer::schedule(int id, int64_t delayMicros) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_stop || _scheduled.count(id) || !_flushes.count(id)) {
+      return;
+    }
+    auto deadline = Clock::now() + std::chrono::microseconds(delayMicros);
+    _scheduled.emplace(id, _deadlines.emplace(deadline, id));
+    if (!_worker.joinable()) {
+      _worker = std::thread(&FlushTimer::run, this);
+    }
+  }
+  _condition.notify_all();
+}
+
+void FlushTimer::remove(int id) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _flushes.erase(id);
+  auto it = _scheduled.find(id);
+  if (it != _scheduled.end()) {
+    _deadlines.erase(it->second);
+    _scheduled.erase(it);
+  }
+  _condition.wait(lock, [this, id]() { return _runningId != id; });
+}
+
+void FlushTimer::run() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (!_stop) {
+    if (_deadlines.empty()) {
+      _condition.wait(lock);
+      continue;
+    }
+    auto next = _deadlines.begin();
+    // Copied since the deadline can be removed while waiting
+    auto deadline = next->first;
+    if (Clock::now() < deadline) {
+      _condition.wait_until(lock, deadline);
+      continue;
+    }
+    int id = next->second;
+    _deadlines.erase(next);
+    _scheduled.erase(id);
+    auto flush = _flushes.at(id);
+    _runningId = id;
+    lock.unlock();
+    flush();
+    lock.lock();
+    _runningId = -1;
+    _condition.notify_all();
+  }
+}
+
+FlushTimer::~FlushTimer() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _condition.notify_all();
+  if (_worker.joinable()) {
+    _worker.join();
+  }
+}
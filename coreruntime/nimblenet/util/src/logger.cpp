@@ -6,6 +6,7 @@
 
 #include "logger.hpp"
 
+#include <chrono>
 #include <string>
 
 #include "client.h"
@@ -19,20 +20,79 @@ void Logger::write_log(const char* message, const char* type, const std::string&
 #ifdef SIMULATION_MODE
   return;
 #endif
+  if (!_isWriting.load(std::memory_order_relaxed)) return;
   // Log type should always come first
   auto logLine = ne::fmt("%s::: %s ::: %s\n", type, currentDate.c_str(), message);
-  util::encrypt_data(logLine.str, strlen(logLine.str));
+  if (!_pendingLines.try_push(std::string(logLine.str))) {
+    _droppedLines++;
+    _flusherCondition.notify_one();
+    return;
+  }
+  // Wake the flusher before the queue is full rather than waiting for its next interval
+  if (_pendingLines.size() == _pendingLines.capacity() / 2) {
+    _flusherCondition.notify_one();
+  }
+}
 
-  std::unique_lock<std::mutex> lock(_logMutex);
+void Logger::write_pending_lines() {
   if (_writeFilePtr == NULL) return;
+  std::string batch;
+  uint64_t droppedLines = _droppedLines.load();
+  if (droppedLines > _reportedDroppedLines) {
+    auto note = ne::fmt("WARN::: %s ::: Dropped %llu log lines as the log queue was full\n",
+                        Time::get_date_UTC().c_str(),
+                        (unsigned long long)(droppedLines - _reportedDroppedLines));
+    batch += note.str;
+    _reportedDroppedLines = droppedLines;
+  }
+  std::string line;
+  while (_pendingLines.try_pop(line)) {
+    batch += line;
+  }
+  if (batch.empty()) return;
+
+  util::encrypt_data(batch.data(), batch.size());
+  // The file is unbuffered, so that the batch goes out in a single write
+  fwrite(batch.data(), 1, batch.size(), _writeFilePtr);
+}
+
+void Logger::flush() {
+  std::lock_guard<std::mutex> lock(_logMutex);
+  write_pending_lines();
+}
 
-  fprintf(_writeFilePtr, "%s", logLine.str);
-  fflush(_writeFilePtr);
-  long size = ftell(_writeFilePtr);
+void Logger::run_flusher() {
+  std::unique_lock<std::mutex> flusherLock(_flusherMutex);
+  while (!_stopFlusher) {
+    _flusherCondition.wait_for(flusherLock,
+                               std::chrono::milliseconds(loggerconstants::LogFlushIntervalMillis));
+    flusherLock.unlock();
+
+    std::unique_lock<std::mutex> lock(_logMutex);
+    write_pending_lines();
+    // Rotation compresses the full file, which is kept off the threads writing logs
+    if (_writeFilePtr != NULL && (float)ftell(_writeFilePtr) / loggerconstants::MaxBytesInKB >
+                                     _atomicLogConfig.load()->maxLogFileSizeKB) {
+      std::string newFileName = _logDirectory + "/log" + Time::get_date_UTC() + ".txt";
+      break_current_file(newFileName, std::move(lock));
+    }
+    flusherLock.lock();
+  }
+}
 
-  if ((float)size / (loggerconstants::MaxBytesInKB) > _atomicLogConfig.load()->maxLogFileSizeKB) {
-    std::string newFileName = _logDirectory + "/log" + currentDate + ".txt";
-    break_current_file(newFileName, std::move(lock));
+Logger::~Logger() {
+  if (_flusher.joinable()) {
+    {
+      std::lock_guard<std::mutex> flusherLock(_flusherMutex);
+      _stopFlusher = true;
+    }
+    _flusherCondition.notify_one();
+    _flusher.join();
+  }
+  std::lock_guard<std::mutex> lock(_logMutex);
+  write_pending_lines();
+  if (_writeFilePtr) {
+    fclose(_writeFilePtr);
   }
 }
 
@@ -79,7 +139,12 @@ bool Logger::init_logger(const std::string& logDir) {
     // Unable to open a new file to write logs
     return false;
   }
+  setvbuf(_writeFilePtr, NULL, _IONBF, 0);
   fseek(_writeFilePtr, 0, SEEK_END);
+  _isWriting = true;
+  if (!_flusher.joinable()) {
+    _flusher = std::thread(&Logger::run_flusher, this);
+  }
   return true;
 }
 
@@ -101,6 +166,7 @@ void Logger::update_log_config(const LogWritingConfig& config) {
 
 std::string Logger::take_lock_and_break_current_file() {
   std::unique_lock<std::mutex> uniqueLock(_logMutex);
+  write_pending_lines();
   std::string currentDate = Time::get_date_UTC();
   currentDate.erase(std::remove(currentDate.begin(), currentDate.end(), ' '), currentDate.end());
   return break_current_file(_logDirectory + "/log" + currentDate, std::move(uniqueLock));
@@ -119,7 +185,10 @@ std::string Logger::break_current_file(std::string newFileName,
   std::string tmpFileName = newFileName + ".txt";
   rename(_writeFile.c_str(), tmpFileName.c_str());
   _writeFilePtr = fopen(_writeFile.c_str(), "a+");
-  fseek(_writeFilePtr, 0, SEEK_END);
+  if (_writeFilePtr != NULL) {
+    setvbuf(_writeFilePtr, NULL, _IONBF, 0);
+    fseek(_writeFilePtr, 0, SEEK_END);
+  }
 
   logMutexUniqueLock.unlock();
 
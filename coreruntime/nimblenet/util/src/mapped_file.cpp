@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "logger.hpp"
+
+std::unique_ptr<MappedFile> MappedFile::open(const std::string& filePath, Access access) {
+  int fd = ::open(filePath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG_TO_ERROR("Could not open file=%s to map it, error=%s", filePath.c_str(), strerror(errno));
+    return nullptr;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0) {
+    LOG_TO_ERROR("Could not stat file=%s to map it, error=%s", filePath.c_str(), strerror(errno));
+    close(fd);
+    return nullptr;
+  }
+  std::size_t size = fileStat.st_size;
+  if (size == 0) {
+    close(fd);
+    return std::unique_ptr<MappedFile>(new MappedFile(nullptr, 0));
+  }
+
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping holds its own reference to the file
+  close(fd);
+  if (data == MAP_FAILED) {
+    LOG_TO_ERROR("Could not map file=%s, error=%s", filePath.c_str(), strerror(errno));
+    return nullptr;
+  }
+  // Only a hint, failing to apply it does not affect the mapping
+  madvise(data, size, access == Access::RANDOM ? MADV_RANDOM : MADV_WILLNEED);
+  return std::unique_ptr<MappedFile>(new MappedFile(data, size));
+}
+
+MappedFile::~MappedFile() {
+  if (_data) {
+    munmap(_data, _size);
+  }
+}
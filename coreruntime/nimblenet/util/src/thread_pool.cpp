@@ -6,55 +6,172 @@
 
 #include "thread_pool.hpp"
 
+#include <algorithm>
+
 #include "client.h"
 #include "logger.hpp"
 
 std::atomic<int> ThreadPool::spinTimeInMs = DEFAULT_THREAD_SPIN_TIME_IN_MS;
 
+// Pool and queue index of the worker running on this thread, if any
+static thread_local ThreadPool* currentPool = nullptr;
+static thread_local size_t currentWorkerIndex = 0;
+
+struct ThreadPool::ParallelForState {
+  std::atomic<int> next;       // First index not claimed yet
+  std::atomic<int> remaining;  // Indices not done yet
+  int end;
+  int minChunkSize;
+  int numParticipants;
+  const std::function<void(int, int)>* body;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool done = false;
+  std::exception_ptr error;
+
+  bool claim(int& chunkBegin, int& chunkEnd) {
+    int current = next.load();
+    while (current < end) {
+      // Guided chunking: large chunks first, then smaller ones to balance the tail
+      int chunkSize = std::max(minChunkSize, (end - current) / (2 * numParticipants));
+      int claimedEnd = current + std::min(chunkSize, end - current);
+      if (next.compare_exchange_weak(current, claimedEnd)) {
+        chunkBegin = current;
+        chunkEnd = claimedEnd;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void finish(int count) {
+    if (remaining.fetch_sub(count) == count) {
+      std::lock_guard<std::mutex> lock(mutex);
+      done = true;
+      condition.notify_all();
+    }
+  }
+
+  void run() {
+    int chunkBegin, chunkEnd;
+    while (claim(chunkBegin, chunkEnd)) {
+      try {
+        (*body)(chunkBegin, chunkEnd);
+      } catch (...) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!error) error = std::current_exception();
+        }
+        // Skip the chunks not claimed yet
+        int skippedBegin = next.exchange(end);
+        if (skippedBegin < end) finish(end - skippedBegin);
+      }
+      finish(chunkEnd - chunkBegin);
+    }
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this] { return done; });
+  }
+};
+
 // Constructor: Create worker threads
-ThreadPool::ThreadPool(size_t numThreads) : stop(false) {
+ThreadPool::ThreadPool(size_t numThreads)
+    : pendingTasks(0), sleepingWorkers(0), nextQueue(0), stop(false) {
+  for (size_t i = 0; i < numThreads; ++i) {
+    queues.emplace_back(std::make_unique<WorkerQueue>());
+  }
   for (size_t i = 0; i < numThreads; ++i) {
-    workers.emplace_back(&ThreadPool::workerThread, this);
+    workers.emplace_back(&ThreadPool::workerThread, this, i);
   }
 }
 
 // Destructor: Join all threads
 ThreadPool::~ThreadPool() {
   stop.store(true);
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+  }
   condition.notify_all();  // Wake up all threads to finish execution
   for (std::thread& worker : workers) {
     if (worker.joinable()) worker.join();
   }
 }
 
+void ThreadPool::push_task(std::function<void()>&& task) {
+  if (stop) throw std::runtime_error("ThreadPool is stopped");
+  size_t index = currentPool == this ? currentWorkerIndex : nextQueue++ % queues.size();
+  pendingTasks++;
+  {
+    std::lock_guard<std::mutex> lock(queues[index]->mutex);
+    queues[index]->tasks.emplace_back(std::move(task));
+  }
+  // A worker going to sleep registers itself under sleepMutex before checking pendingTasks, so
+  // either it sees this task or it is waiting by the time the lock is acquired here
+  if (sleepingWorkers > 0) {
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    condition.notify_one();
+  }
+}
+
+bool ThreadPool::pop_task(size_t index, std::function<void()>& task) {
+  if (pendingTasks.load() == 0) return false;
+  {
+    auto& own = *queues[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      pendingTasks--;
+      return true;
+    }
+  }
+  for (size_t i = 1; i < queues.size(); i++) {
+    auto& victim = *queues[(index + i) % queues.size()];
+    std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+    if (lock.owns_lock() && !victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      pendingTasks--;
+      return true;
+    }
+  }
+  return false;
+}
+
 // Worker function that processes tasks
-void ThreadPool::workerThread() {
+void ThreadPool::workerThread(size_t index) {
+  currentPool = this;
+  currentWorkerIndex = index;
   bool attached = false;
   auto spinEndTime = Time::get_high_resolution_clock_time();
-  while (true) {
+  while (!stop) {
     std::function<void()> task;
-    {
-      std::unique_lock<std::mutex> lock(queueMutex);
-
-      if (tasks.empty() && (Time::get_high_resolution_clock_time() > spinEndTime)) {
+    if (!pop_task(index, task)) {
+      if (Time::get_high_resolution_clock_time() <= spinEndTime) {
+        std::this_thread::yield();
+        continue;
+      }
 #ifdef ANDROID_ABI
-        // detach before sleeping
-        if (attached) {
-          globalJvm->DetachCurrentThread();
-          attached = false;
-        }
-#endif
-
-        // sleep
-        condition.wait(lock, [this] { return stop || !tasks.empty(); });
-        spinEndTime = Time::get_high_resolution_clock_time() +
-                      std::chrono::milliseconds(ThreadPool::spinTimeInMs);
+      // detach before sleeping
+      if (attached) {
+        globalJvm->DetachCurrentThread();
+        attached = false;
       }
+#endif
 
-      if (stop) return;  // Exit thread if stopping and no tasks left
-      if (tasks.empty()) continue;
-      task = std::move(tasks.front());
-      tasks.pop();
+      // sleep
+      std::unique_lock<std::mutex> lock(sleepMutex);
+      sleepingWorkers++;
+      condition.wait(lock, [this] { return stop || pendingTasks > 0; });
+      sleepingWorkers--;
+      spinEndTime = Time::get_high_resolution_clock_time() +
+                    std::chrono::milliseconds(ThreadPool::spinTimeInMs);
+      continue;
     }
 #ifdef ANDROID_ABI
     // attach before doing tasks
@@ -70,13 +187,33 @@ void ThreadPool::workerThread() {
 }
 
 void ThreadPool::run_threadpool_task() {
+  if (stop || queues.empty()) return;
   std::function<void()> task;
-  {
-    std::unique_lock<std::mutex> lock(queueMutex);
-    if (stop) return;  // Exit thread if stopping and no tasks left
-    if (tasks.empty()) return;
-    task = std::move(tasks.front());
-    tasks.pop();
+  size_t index = currentPool == this ? currentWorkerIndex : nextQueue % queues.size();
+  if (pop_task(index, task)) {
+    task();  // Execute task outside lock
+  }
+}
+
+void ThreadPool::parallel_for(int begin, int end, const std::function<void(int, int)>& body,
+                              int minChunkSize) {
+  if (begin >= end) return;
+  auto state = std::make_shared<ParallelForState>();
+  state->next = begin;
+  state->remaining = end - begin;
+  state->end = end;
+  state->minChunkSize = std::max(minChunkSize, 1);
+  int maxChunks = (end - begin + state->minChunkSize - 1) / state->minChunkSize;
+  state->numParticipants = std::min<int>(workers.size() + 1, maxChunks);
+  state->body = &body;
+
+  // Helpers that start after all chunks are claimed return right away, the state outlives them
+  for (int i = 1; i < state->numParticipants; i++) {
+    push_task([state]() { state->run(); });
+  }
+  state->run();
+  state->wait();
+  if (state->error) {
+    std::rethrow_exception(state->error);
   }
-  task();  // Execute task outside lock
 }
@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "token_queue.hpp"
+
+TokenQueue::TokenQueue(std::size_t capacity) : _capacity(capacity) {
+  _pendingText.reserve(capacity);
+  _consumedText.reserve(capacity);
+}
+
+bool TokenQueue::push(std::string_view text, int32_t tokenId) {
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    // A token longer than the capacity is still accepted once the queue is empty
+    _spaceAvailable.wait(lock, [&] {
+      return _detached || _pendingText.empty() || _pendingText.size() + text.size() <= _capacity;
+    });
+    if (_closed || _detached) return false;
+    _pendingText.append(text);
+    _pendingTokenIds.push_back(tokenId);
+  }
+  _outputAvailable.notify_all();
+  return true;
+}
+
+void TokenQueue::close() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _closed = true;
+  }
+  _outputAvailable.notify_all();
+}
+
+void TokenQueue::detach() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _detached = true;
+  }
+  _outputAvailable.notify_all();
+  _spaceAvailable.notify_all();
+}
+
+void TokenQueue::wait_for_output() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _outputAvailable.wait(lock, [this] { return !_pendingText.empty() || _closed || _detached; });
+}
+
+bool TokenQueue::consume(const BatchFunction& batchFunction) {
+  bool closed;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _consumedText.clear();
+    _consumedTokenIds.clear();
+    _consumedText.swap(_pendingText);
+    _consumedTokenIds.swap(_pendingTokenIds);
+    closed = _closed;
+  }
+  if (_consumedText.empty()) return closed;
+  _spaceAvailable.notify_one();
+  batchFunction(_consumedText, _consumedTokenIds);
+  return closed;
+}
@@ -15,14 +15,18 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
+#include <cerrno>
 #include <fstream>
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <vector>
 
 #include "logger.hpp"
 #include "time_manager.hpp"
@@ -113,10 +117,7 @@ std::string decompress_string(const std::string &compressed_string) {
   return std::string(decompressed_data.begin(), decompressed_data.end());
 }
 
-CNetworkResponse send_request(const char *body, const char *headers_c, const char *url,
-                              const char *method, int length) {
-  CURL *curl;
-  CURLcode res;
+static struct curl_slist *parse_headers(const char *headers_c) {
   struct curl_slist *headers = NULL;
   // try catch since empty headers leads to json errors and we send empty headers on Register calls
   try {
@@ -134,6 +135,14 @@ CNetworkResponse send_request(const char *body, const char *headers_c, const cha
   } catch (std::exception &e) {
     std::cout << "Exception :" << e.what() << std::endl;
   }
+  return headers;
+}
+
+CNetworkResponse send_request(const char *body, const char *headers_c, const char *url,
+                              const char *method, int length) {
+  CURL *curl;
+  CURLcode res;
+  struct curl_slist *headers = parse_headers(headers_c);
 
   curl = curl_easy_init();
   std::string URL = url;
@@ -239,27 +248,414 @@ int decompress_one_file(const char *infilename, const char *outfilename) {
   return 0;
 }
 
+// Downloads are written through buffers of this size, aligned to pages
+static const size_t DownloadBufferSize = 1 << 20;
+static const size_t DownloadBufferAlignment = 4096;
+
+/**
+ * @brief Appends to a file through a page aligned buffer of DownloadBufferSize bytes, so that the
+ * file is written in large blocks whatever the size of the chunks given.
+ */
+class BufferedFileWriter {
+  int _fd = -1;
+  char *_buffer = nullptr;
+  size_t _size = 0;
+  bool _failed = false;
+
+  void write_all(const char *data, size_t size) {
+    while (size > 0 && !_failed) {
+      ssize_t written = ::write(_fd, data, size);
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        _failed = true;
+        return;
+      }
+      data += written;
+      size -= written;
+    }
+  }
+
+ public:
+  BufferedFileWriter() = default;
+  BufferedFileWriter(const BufferedFileWriter &) = delete;
+  BufferedFileWriter &operator=(const BufferedFileWriter &) = delete;
+
+  ~BufferedFileWriter() {
+    if (_fd >= 0) ::close(_fd);
+    free(_buffer);
+  }
+
+  bool open(const std::string &path, bool append) {
+    if (_fd >= 0) ::close(_fd);
+    _size = 0;
+    _failed = false;
+    _fd = ::open(path.c_str(), O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC), 0644);
+    if (_buffer == nullptr &&
+        posix_memalign((void **)&_buffer, DownloadBufferAlignment, DownloadBufferSize) != 0) {
+      _buffer = nullptr;
+    }
+    _failed = _fd < 0 || _buffer == nullptr;
+    return !_failed;
+  }
+
+  void write(const char *data, size_t size) {
+    if (_size == 0 && size >= DownloadBufferSize) {
+      // Nothing buffered, a large chunk is written as is
+      write_all(data, size);
+      return;
+    }
+    while (size > 0 && !_failed) {
+      size_t n = std::min(size, DownloadBufferSize - _size);
+      memcpy(_buffer + _size, data, n);
+      _size += n;
+      data += n;
+      size -= n;
+      if (_size == DownloadBufferSize) {
+        write_all(_buffer, _size);
+        _size = 0;
+      }
+    }
+  }
+
+  bool close() {
+    if (_fd < 0) return !_failed;
+    write_all(_buffer, _size);
+    _size = 0;
+    if (::close(_fd) != 0) _failed = true;
+    _fd = -1;
+    return !_failed;
+  }
+
+  bool failed() const { return _failed; }
+};
+
+/**
+ * @brief Download of a file streamed to disk.
+ *
+ * The bytes received are appended to "<path>.part", so that an interrupted download resumes from
+ * where it stopped with a range request. The ETag or Last-Modified of the response is kept in
+ * "<path>.validator" and sent as If-Range, so that a file changed on the server is downloaded
+ * again from the start instead of being resumed, a download without one is never resumed. A gzip
+ * body is also inflated on the fly into
+ * "<path>.tmp", which replaces the file once the gzip trailer, holding the CRC32 and length of the
+ * content, is checked. Other bodies are renamed to the file as they are. Memory use is bounded by
+ * the buffers whatever the size of the file.
+ */
+class FileDownload {
+  enum class Format { UNKNOWN, PLAIN, GZIP };
+
+  std::string _path;
+  std::string _partPath;
+  std::string _inflatedPath;
+  std::string _validatorPath;
+  BufferedFileWriter _part;
+  BufferedFileWriter _inflated;
+  Format _format = Format::UNKNOWN;
+  std::string _head; /**< First bytes, until there are enough to tell the format. */
+  z_stream _stream = {};
+  bool _isStreamInitialized = false;
+  bool _isStreamEnded = false;
+  std::vector<char> _inflateBuffer;
+  bool _failed = false;
+
+  void inflate_chunk(const char *data, size_t size) {
+    _stream.next_in = (Bytef *)data;
+    _stream.avail_in = size;
+    do {
+      if (_isStreamEnded) {
+        // Bytes after the end of a gzip member start another member, or are ignored as by gzread
+        if (_stream.avail_in == 0 || *_stream.next_in != 0x1f) return;
+        inflateReset(&_stream);
+        _isStreamEnded = false;
+      }
+      _stream.next_out = (Bytef *)_inflateBuffer.data();
+      _stream.avail_out = _inflateBuffer.size();
+      int ret = inflate(&_stream, Z_NO_FLUSH);
+      if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+        LOG_TO_ERROR("Could not inflate download of %s: %s", _path.c_str(),
+                     _stream.msg ? _stream.msg : "corrupted data");
+        _failed = true;
+        return;
+      }
+      _inflated.write(_inflateBuffer.data(), _inflateBuffer.size() - _stream.avail_out);
+      _isStreamEnded = ret == Z_STREAM_END;
+    } while (_stream.avail_in > 0 || _stream.avail_out == 0);
+  }
+
+  void decode(const char *data, size_t size) {
+    if (_format == Format::UNKNOWN) {
+      _head.append(data, size);
+      if (_head.size() < 2) return;
+      bool isGzip = (unsigned char)_head[0] == 0x1f && (unsigned char)_head[1] == 0x8b;
+      _format = isGzip ? Format::GZIP : Format::PLAIN;
+      if (isGzip) {
+        // 16 + MAX_WBITS to read the gzip header and check the trailer
+        _isStreamInitialized = inflateInit2(&_stream, 16 + MAX_WBITS) == Z_OK;
+        _inflateBuffer.resize(DownloadBufferSize);
+        _failed = !_isStreamInitialized || !_inflated.open(_inflatedPath, false);
+        if (!_failed) inflate_chunk(_head.data(), _head.size());
+      }
+      _head.clear();
+      return;
+    }
+    if (_format == Format::GZIP && !_failed) {
+      inflate_chunk(data, size);
+    }
+  }
+
+  void reset_decoding() {
+    if (_isStreamInitialized) inflateEnd(&_stream);
+    _stream = {};
+    _isStreamInitialized = false;
+    _isStreamEnded = false;
+    _format = Format::UNKNOWN;
+    _head.clear();
+    _failed = false;
+  }
+
+ public:
+  explicit FileDownload(const std::string &path)
+      : _path(path),
+        _partPath(path + ".part"),
+        _inflatedPath(path + ".tmp"),
+        _validatorPath(path + ".validator") {}
+
+  ~FileDownload() {
+    if (_isStreamInitialized) inflateEnd(&_stream);
+  }
+
+  /**
+   * @brief ETag or Last-Modified of the response the kept bytes were received from, empty if none.
+   */
+  std::string validator() const {
+    std::ifstream file(_validatorPath);
+    std::string value;
+    std::getline(file, value);
+    return value;
+  }
+
+  /**
+   * @brief Number of bytes received by an earlier download, to be requested from.
+   *
+   * 0 if the bytes cannot be checked against the file on the server with If-Range.
+   */
+  int64_t resume_offset() const {
+    struct stat st;
+    if (stat(_partPath.c_str(), &st) != 0 || validator().empty()) return 0;
+    return st.st_size;
+  }
+
+  /**
+   * @brief Starts writing the body, after the bytes of an earlier download if resuming.
+   *
+   * @param resume Whether the body continues the bytes of an earlier download.
+   * @param validator ETag or Last-Modified of the response, kept for a later resume.
+   */
+  bool start(bool resume, const std::string &validator) {
+    reset_decoding();
+    if (!resume) {
+      remove(_validatorPath.c_str());
+      if (!validator.empty()) {
+        std::ofstream file(_validatorPath, std::ios::trunc);
+        file << validator;
+      }
+    }
+    if (resume) {
+      // Bytes of the earlier download go through the decoder again, as only the bytes received
+      // are kept. Plain bodies are detected from the first chunk and not read further.
+      FILE *partFile = fopen(_partPath.c_str(), "rb");
+      if (partFile == nullptr) return false;
+      std::vector<char> buffer(DownloadBufferSize);
+      size_t numRead;
+      while (_format != Format::PLAIN && !_failed &&
+             (numRead = fread(buffer.data(), 1, buffer.size(), partFile)) > 0) {
+        decode(buffer.data(), numRead);
+      }
+      fclose(partFile);
+    }
+    return _part.open(_partPath, resume) && !_failed;
+  }
+
+  /**
+   * @brief Writes the next bytes of the body.
+   *
+   * @return false if writing or decoding failed.
+   */
+  bool write(const char *data, size_t size) {
+    _part.write(data, size);
+    decode(data, size);
+    return !_failed && !_part.failed() && !_inflated.failed();
+  }
+
+  /**
+   * @brief Writes out the buffered bytes, keeping them for a later resume.
+   */
+  void suspend() {
+    _part.close();
+    _inflated.close();
+  }
+
+  /**
+   * @brief Completes the download, replacing the file.
+   *
+   * @return false if the body is corrupted or could not be written, the download is discarded.
+   */
+  bool finish() {
+    bool written = _part.close() && !_failed;
+    if (_format == Format::GZIP) {
+      if (!_isStreamEnded) {
+        LOG_TO_ERROR("Download of %s ended in the middle of the gzip stream", _path.c_str());
+        written = false;
+      }
+      written = _inflated.close() && written;
+      if (written && rename(_inflatedPath.c_str(), _path.c_str()) == 0) {
+        remove(_partPath.c_str());
+        remove(_validatorPath.c_str());
+        return true;
+      }
+    } else if (written && rename(_partPath.c_str(), _path.c_str()) == 0) {
+      remove(_validatorPath.c_str());
+      return true;
+    }
+    discard();
+    return false;
+  }
+
+  /**
+   * @brief Removes the bytes received, the next download starts over.
+   */
+  void discard() {
+    _part.close();
+    _inflated.close();
+    remove(_partPath.c_str());
+    remove(_inflatedPath.c_str());
+    remove(_validatorPath.c_str());
+  }
+};
+
+/**
+ * @brief State of the curl header and write callbacks of download_to_file_async.
+ */
+struct DownloadWriteContext {
+  CURL *curl;
+  FileDownload *download;
+  bool resumed;
+  bool started = false;
+  bool failed = false;
+  std::string etag; /**< Strong ETag of the current response, empty if none. */
+  std::string lastModified; /**< Last-Modified of the current response, empty if none. */
+};
+
+static size_t read_download_header(char *header, size_t size, size_t nitems, void *userData) {
+  auto context = static_cast<DownloadWriteContext *>(userData);
+  size_t numBytes = size * nitems;
+  std::string headerString(header, numBytes);
+  if (headerString.rfind("HTTP/", 0) == 0) {
+    // Status line of a new response, after a redirect
+    context->etag.clear();
+    context->lastModified.clear();
+    return numBytes;
+  }
+  auto location = headerString.find(':');
+  if (location == std::string::npos) return numBytes;
+  std::string key = headerString.substr(0, location);
+  std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+  auto begin = headerString.find_first_not_of(" \t", location + 1);
+  auto end = headerString.find_last_not_of(" \t\r\n");
+  std::string value =
+      begin == std::string::npos || end < begin ? "" : headerString.substr(begin, end - begin + 1);
+  // Weak ETags cannot be used with If-Range
+  if (key == "etag" && value.rfind("W/", 0) != 0) {
+    context->etag = value;
+  } else if (key == "last-modified") {
+    context->lastModified = value;
+  }
+  return numBytes;
+}
+
+static size_t write_download(char *ptr, size_t size, size_t nmemb, void *userData) {
+  auto context = static_cast<DownloadWriteContext *>(userData);
+  size_t numBytes = size * nmemb;
+  if (!context->started) {
+    long httpCode = 0;
+    curl_easy_getinfo(context->curl, CURLINFO_RESPONSE_CODE, &httpCode);
+    if (httpCode != 200 && httpCode != 206) {
+      // Body of an error response, not written
+      return numBytes;
+    }
+    context->started = true;
+    // A server ignoring the range sends the whole body again
+    const std::string &validator = context->etag.empty() ? context->lastModified : context->etag;
+    if (!context->download->start(context->resumed && httpCode == 206, validator)) {
+      context->failed = true;
+      return 0;
+    }
+  }
+  if (!context->download->write(ptr, numBytes)) {
+    context->failed = true;
+    return 0;
+  }
+  return numBytes;
+}
+
 FileDownloadInfo download_to_file_async(const char *url, const char *headers, const char *filePath,
                                         const char *nimbleSdkDir) {
   auto startTime = Time::get_high_resolution_clock_time();
-  CNetworkResponse r = send_request("", headers, url, "GET", 0);
+  std::string fullPath = std::string(nimbleSdkDir) + filePath;
+  FileDownload download(fullPath);
+  int64_t resumeOffset = download.resume_offset();
+
+  CURL *curl = curl_easy_init();
+  if (!curl) abort();
+  struct curl_slist *headerList = parse_headers(headers);
+  if (resumeOffset > 0) {
+    // The server sends the whole file again if it no longer matches the bytes kept
+    headerList = curl_slist_append(headerList, ("If-Range: " + download.validator()).c_str());
+  }
+  DownloadWriteContext context{curl, &download, resumeOffset > 0};
+  curl_easy_setopt(curl, CURLOPT_URL, url);
+  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headerList);
+  // No Accept-Encoding, ranges then apply to the bytes of the file itself and gzip files are
+  // inflated by FileDownload
+  curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+  curl_easy_setopt(curl, CURLOPT_BUFFERSIZE, 512L * 1024);
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &write_download);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &context);
+  curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, &read_download_header);
+  curl_easy_setopt(curl, CURLOPT_HEADERDATA, &context);
+  if (resumeOffset > 0) {
+    curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, (curl_off_t)resumeOffset);
+  }
+#ifdef SIMULATION_MODE
+  curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+#endif
+  CURLcode res = curl_easy_perform(curl);
+  long httpCode = 0;
+  curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
+  curl_slist_free_all(headerList);
+  curl_easy_cleanup(curl);
   int timeElapsed = Time::get_elapsed_time_in_micro(startTime);
-  LOG_VERBOSE("Async download to url %s: response body %s, status %d", url, r.body, r.statusCode);
-  FileDownloadInfo fileDownloadInfo;
-  if (r.statusCode != 200) {
-    fileDownloadInfo.currentStatus = DOWNLOAD_FAILURE;
-    fileDownloadInfo.timeElapsedInMicro = -1;
-  } else {
-    std::string dataBuffer = std::string(r.body, r.bodyLength);
-    std::string fullPath = std::string(nimbleSdkDir) + filePath;
+  LOG_VERBOSE("Async download of url %s from byte %lld: curl code %d, status %ld", url,
+              (long long)resumeOffset, res, httpCode);
 
-    {
-      std::ofstream outFile(fullPath, std::ios::out | std::ios::binary);
-      outFile.write(dataBuffer.c_str(), dataBuffer.size());
-    }
+  if (res == CURLE_RANGE_ERROR && resumeOffset > 0) {
+    // The server does not support ranges, the download starts over
+    download.discard();
+    return download_to_file_async(url, headers, filePath, nimbleSdkDir);
+  }
 
+  FileDownloadInfo fileDownloadInfo;
+  fileDownloadInfo.currentStatus = DOWNLOAD_FAILURE;
+  fileDownloadInfo.timeElapsedInMicro = -1;
+  if (res == CURLE_OK && context.started && download.finish()) {
     fileDownloadInfo.currentStatus = DOWNLOAD_SUCCESS;
     fileDownloadInfo.timeElapsedInMicro = timeElapsed;
+  } else if (context.failed || httpCode == 416) {
+    // Corrupted body, or bytes kept from an earlier download no longer match the file
+    download.discard();
+  } else if (context.started) {
+    // Interrupted, the next download resumes from the bytes received
+    download.suspend();
   }
   return fileDownloadInfo;
 }
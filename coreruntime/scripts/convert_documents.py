@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Convert a JSON list of retriever documents to the DocumentStore format.
+
+The SDK converts a JSON document asset on its first load, shipping the converted file saves that
+step on device. The format is described in nimblenet/retriever/include/document_store.hpp.
+"""
+
+import json
+import struct
+import sys
+
+FILE_MAGIC = b"NEDS"
+FILE_VERSION = 1
+DOCUMENT_TYPE_STRING = 0
+DOCUMENT_TYPE_JSON = 1
+
+
+def convert_documents(input_file: str, output_file: str) -> None:
+    with open(input_file, encoding="utf-8") as f:
+        documents = json.load(f)
+    if not isinstance(documents, list):
+        raise ValueError(f"Expected a JSON list of documents in {input_file}")
+
+    payloads = bytearray()
+    offsets = []
+    for document in documents:
+        offsets.append(len(payloads))
+        if isinstance(document, str):
+            payloads.append(DOCUMENT_TYPE_STRING)
+            payloads += document.encode("utf-8")
+        else:
+            payloads.append(DOCUMENT_TYPE_JSON)
+            payloads += json.dumps(document, ensure_ascii=False, separators=(",", ":")).encode(
+                "utf-8"
+            )
+    offsets.append(len(payloads))
+
+    with open(output_file, "wb") as f:
+        f.write(struct.pack("<4sIQ16x", FILE_MAGIC, FILE_VERSION, len(documents)))
+        f.write(struct.pack(f"<{len(offsets)}Q", *offsets))
+        f.write(payloads)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print("Usage: convert_documents.py <documents.json> <output file>")
+        sys.exit(1)
+    convert_documents(sys.argv[1], sys.argv[2])
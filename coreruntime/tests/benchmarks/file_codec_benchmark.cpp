@@ -0,0 +1,197 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Benchmark of the gzip compression levels of filecodec, on files like those the SDK compresses.
+ *
+ * Two files are generated: an events log, with lines as written by Logger::LogEvents, and a log
+ * file with lines as written by Logger. Each is compressed and decompressed with every gzip level.
+ * The previous implementation, copying through 128 byte gzread and gzwrite calls at the default
+ * level, is replayed as the baseline.
+ *
+ * Usage: ./file_codec_benchmark [sizeMB], defaults to 32 MB per file.
+ */
+
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "file_codec.hpp"
+#include "zlib.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Timings {
+  double compressMillis = 0;
+  double decompressMillis = 0;
+  int64_t compressedSize = 0;
+};
+
+double millis_since(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int64_t file_size(const std::string& filePath) {
+  struct stat st;
+  if (stat(filePath.c_str(), &st) != 0) return -1;
+  return st.st_size;
+}
+
+const char* const EventTypes[] = {"click", "view", "addToCart", "purchase"};
+const char* const Categories[] = {"shoes", "shirts", "watches", "bags", "jackets"};
+const char* const LogTypes[] = {"INFO", "DEBUG", "WARN", "METRICS"};
+
+std::string date(int i) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "2025-03-%02d %02d:%02d:%02d.%03d", 1 + i / 864000 % 28,
+           i / 36000 % 24, i / 600 % 60, i / 10 % 60, i * 97 % 1000);
+  return buf;
+}
+
+std::string event_line(int i) {
+  char buf[512];
+  snprintf(buf, sizeof(buf),
+           "EVENTS::: %s ::: 5f2c81d6-%04x-4e1b-9a7c-2b61e0d4%04x ::: %s ::: "
+           "{\"itemId\":%d,\"price\":%.2f,\"category\":\"%s\",\"quantity\":%d,"
+           "\"position\":%d,\"liked\":%s}\n",
+           date(i).c_str(), i / 5000 % 0x10000, i / 5000 % 0x10000, EventTypes[i * 7 % 4],
+           i * 7919 % 100000, (i * 31 % 50000) / 100.0, Categories[i * 13 % 5], 1 + i % 3,
+           i % 50, i % 2 == 0 ? "true" : "false");
+  return buf;
+}
+
+std::string log_line(int i) {
+  char buf[512];
+  const char* type = LogTypes[i * 11 % 4];
+  if (type[0] == 'M') {
+    snprintf(buf, sizeof(buf),
+             "METRICS::: %s ::: inference ::: {\"modelId\":\"ranker\",\"version\":\"1.0.%d\","
+             "\"timeUsecs\":%d,\"status\":0}\n",
+             date(i).c_str(), i / 100000, 800 + i * 37 % 4000);
+  } else {
+    snprintf(buf, sizeof(buf), "%s::: %s ::: Job %d of task workflow_script ran in %d ms\n", type,
+             date(i).c_str(), i % 1000, i * 17 % 250);
+  }
+  return buf;
+}
+
+void generate(const std::string& filePath, int64_t size, std::string (*line)(int)) {
+  auto writer = filecodec::open_writer(filePath, filecodec::Codec::NONE);
+  std::string chunk;
+  int64_t written = 0;
+  for (int i = 0; written < size; i++) {
+    chunk += line(i);
+    if (chunk.size() >= 1 << 20) {
+      writer->write(chunk.data(), chunk.size());
+      written += chunk.size();
+      chunk.clear();
+    }
+  }
+  writer->close();
+}
+
+bool copy(filecodec::FileReader& reader, filecodec::FileWriter* writer) {
+  std::vector<char> buffer(1 << 20);
+  while (true) {
+    int64_t numRead = reader.read(buffer.data(), buffer.size());
+    if (numRead < 0) return false;
+    if (numRead == 0) break;
+    if (writer != nullptr && !writer->write(buffer.data(), numRead)) return false;
+  }
+  return writer == nullptr || writer->close();
+}
+
+Timings run_filecodec(const std::string& source, int level) {
+  std::string compressed = source + "." + std::to_string(level) + ".gz";
+  Timings timings;
+  auto start = Clock::now();
+  auto reader = filecodec::open_reader(source);
+  auto writer = filecodec::open_writer(compressed, filecodec::Codec::GZIP, level);
+  if (reader == nullptr || writer == nullptr || !copy(*reader, writer.get())) {
+    fprintf(stderr, "Could not compress %s\n", source.c_str());
+    exit(1);
+  }
+  timings.compressMillis = millis_since(start);
+  timings.compressedSize = file_size(compressed);
+
+  start = Clock::now();
+  reader = filecodec::open_reader(compressed);
+  if (reader == nullptr || !copy(*reader, nullptr)) {
+    fprintf(stderr, "Could not decompress %s\n", compressed.c_str());
+    exit(1);
+  }
+  timings.decompressMillis = millis_since(start);
+  remove(compressed.c_str());
+  return timings;
+}
+
+Timings run_legacy(const std::string& source) {
+  std::string compressed = source + ".legacy.gz";
+  Timings timings;
+  char buf[128];
+  auto start = Clock::now();
+  FILE* in = fopen(source.c_str(), "rb");
+  gzFile out = gzopen(compressed.c_str(), "wb");
+  size_t numRead;
+  while ((numRead = fread(buf, 1, sizeof(buf), in)) > 0) {
+    gzwrite(out, buf, numRead);
+  }
+  fclose(in);
+  gzclose(out);
+  timings.compressMillis = millis_since(start);
+  timings.compressedSize = file_size(compressed);
+
+  start = Clock::now();
+  gzFile gzin = gzopen(compressed.c_str(), "rb");
+  std::string content;
+  int numBytes;
+  while ((numBytes = gzread(gzin, buf, sizeof(buf))) > 0) {
+    content.append(buf, numBytes);
+  }
+  gzclose(gzin);
+  timings.decompressMillis = millis_since(start);
+  remove(compressed.c_str());
+  return timings;
+}
+
+void print_row(const char* name, int64_t size, const Timings& timings) {
+  double sizeMB = size / 1e6;
+  printf("%-8s %10.1f %12.1f %12.1f %8.2f\n", name, sizeMB * 1000 / timings.compressMillis,
+         sizeMB * 1000 / timings.decompressMillis, timings.compressedSize / 1e6,
+         double(size) / timings.compressedSize);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int64_t size = int64_t(argc > 1 ? atoi(argv[1]) : 32) << 20;
+  mkdir("./benchmarkrun/", S_IRWXU);
+  struct {
+    const char* name;
+    std::string (*line)(int);
+  } files[] = {{"events", event_line}, {"logs", log_line}};
+
+  for (const auto& file : files) {
+    std::string source = std::string("./benchmarkrun/") + file.name + ".txt";
+    generate(source, size, file.line);
+    int64_t sourceSize = file_size(source);
+    printf("%s, %.1f MB\n", file.name, sourceSize / 1e6);
+    printf("%-8s %10s %12s %12s %8s\n", "level", "comp_MB/s", "decomp_MB/s", "size_MB", "ratio");
+    print_row("legacy", sourceSize, run_legacy(source));
+    for (int level = 1; level <= 9; level++) {
+      print_row(std::to_string(level).c_str(), sourceSize, run_filecodec(source, level));
+    }
+    printf("\n");
+    remove(source.c_str());
+  }
+  return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Benchmark of the SQLite events backend, inserting events and reading those of one type back.
+ *
+ * The previous backend is replayed on a raw connection as the baseline: every event is inserted
+ * with its own formatted statement in autocommit mode with a rollback journal, stored as JSON text
+ * and read back through sqlite3_exec without an index. Events have 4 fields, 90% of them are of
+ * the type that is read.
+ *
+ * Usage: ./sqlite_database_benchmark [numEvents ...], defaults to 10000 and 100000 events.
+ */
+
+#include <sqlite3.h>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "core_sdk_structs.hpp"
+#include "database.hpp"
+#include "native_interface.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Timings {
+  double insertMillis = 0;
+  double readMillis = 0;
+  int numRead = 0;
+};
+
+double millis_since(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+const char* event_type(int i) { return i % 10 == 9 ? "view" : "click"; }
+
+OpReturnType make_event(int i) {
+  return DataVariable::get_map_from_json_object(
+      {{"itemId", i}, {"price", i * 0.25}, {"category", "shoes"}, {"liked", i % 2 == 0}});
+}
+
+std::string fresh_folder(const std::string& name) {
+  std::string folder = "./benchmarkrun/" + name + "/";
+  int returnCode = system(("rm -rf " + folder).c_str());
+  mkdir("./benchmarkrun/", S_IRWXU);
+  mkdir(folder.c_str(), S_IRWXU);
+  return folder;
+}
+
+Timings run_database(int numEvents) {
+  nativeinterface::HOMEDIR = fresh_folder("database_" + std::to_string(numEvents));
+  MetricsAgent metricsAgent;
+  Timings timings;
+  {
+    Database database(&metricsAgent);
+    database.update_eventsType_table("click");
+    database.update_eventsType_table("view");
+    auto start = Clock::now();
+    for (int i = 0; i < numEvents; i++) {
+      database.add_event_in_db(event_type(i), make_event(i));
+    }
+    // Counting commits the last transaction
+    database.get_rows_in_events_table();
+    timings.insertMillis = millis_since(start);
+
+    start = Clock::now();
+    database.for_each_event("click", [&](int64_t, std::map<std::string, OpReturnType>&& event) {
+      timings.numRead++;
+    });
+    timings.readMillis = millis_since(start);
+  }
+  return timings;
+}
+
+int count_legacy_row(void* data, int numColumns, char** values, char** columns) {
+  auto json = nlohmann::json::parse(values[0]);
+  std::map<std::string, OpReturnType> event;
+  for (const auto& column : json.items()) {
+    event[column.key()] = DataVariable::get_SingleVariableFrom_JSON(column.value());
+  }
+  (*static_cast<int*>(data))++;
+  return 0;
+}
+
+Timings run_legacy(int numEvents) {
+  std::string folder = fresh_folder("legacy_" + std::to_string(numEvents));
+  sqlite3* db = nullptr;
+  Timings timings;
+  if (sqlite3_open((folder + DEFAULT_SQLITE_DB_NAME).c_str(), &db) != SQLITE_OK) {
+    fprintf(stderr, "Could not open the legacy db\n");
+    exit(1);
+  }
+  sqlite3_exec(db,
+               "CREATE TABLE IF NOT EXISTS EventsType (eventType TEXT UNIQUE);"
+               "CREATE TABLE IF NOT EXISTS Events "
+               "(event TEXT, TIMESTAMP INTEGER, eventType TEXT);",
+               nullptr, nullptr, nullptr);
+  auto start = Clock::now();
+  for (int i = 0; i < numEvents; i++) {
+    char* sql;
+    std::string eventDump = make_event(i)->to_json_str();
+    asprintf(&sql, "INSERT INTO Events (TIMESTAMP, eventType, event) VALUES (%ld, '%s', '%s');",
+             long(Time::get_time()), event_type(i), eventDump.c_str());
+    sqlite3_exec(db, sql, nullptr, nullptr, nullptr);
+    free(sql);
+  }
+  timings.insertMillis = millis_since(start);
+
+  start = Clock::now();
+  sqlite3_exec(db, "SELECT * FROM Events WHERE eventType='click' ORDER BY TIMESTAMP;",
+               count_legacy_row, &timings.numRead, nullptr);
+  timings.readMillis = millis_since(start);
+  sqlite3_close(db);
+  return timings;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::vector<int> sizes;
+  for (int i = 1; i < argc; i++) {
+    sizes.push_back(atoi(argv[i]));
+  }
+  if (sizes.empty()) {
+    sizes = {10000, 100000};
+  }
+
+  printf("%10s %12s %14s %12s %14s\n", "events", "insert_ms", "legacy_insert", "read_ms",
+         "legacy_read");
+  for (int numEvents : sizes) {
+    auto timings = run_database(numEvents);
+    auto legacy = run_legacy(numEvents);
+    if (timings.numRead != legacy.numRead) {
+      fprintf(stderr, "Read %d events, legacy read %d\n", timings.numRead, legacy.numRead);
+      return 1;
+    }
+    printf("%10d %12.1f %14.1f %12.1f %14.1f\n", numEvents, timings.insertMillis,
+           legacy.insertMillis, timings.readMillis, legacy.readMillis);
+  }
+  return 0;
+}
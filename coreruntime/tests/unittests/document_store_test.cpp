@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+
+#include "document_store.hpp"
+#include "document_store_data_variable.hpp"
+#include "nlohmann/json.hpp"
+
+namespace {
+
+const nlohmann::json Documents = {
+    "Onion (Loose), 2 kg",
+    {{"text", "Paneer, 200 g"}, {"metadata", {{"category", "Dairy"}, {"price", 95.5}}}},
+    nlohmann::json::array({"milk", "eggs"}),
+    42,
+};
+
+std::shared_ptr<const MappedFile> map(const std::string& filePath) {
+  return MappedFile::open(filePath, MappedFile::Access::RANDOM);
+}
+
+}  // namespace
+
+TEST(DocumentStoreTest, ConvertsJsonAndDecodesDocumentsOnAccess) {
+  std::string filePath = "document_store_test.bin";
+  DocumentStore::write(Documents, filePath);
+  auto file = map(filePath);
+  ASSERT_TRUE(file != nullptr);
+  ASSERT_TRUE(DocumentStore::is_document_store(*file));
+
+  auto store = DocumentStore::open(file);
+  ASSERT_EQ(store->size(), Documents.size());
+  EXPECT_EQ(store->get(0).type, DocumentStore::DocumentType::STRING);
+  EXPECT_EQ(store->get(0).data, "Onion (Loose), 2 kg");
+  EXPECT_EQ(store->get(1).type, DocumentStore::DocumentType::JSON);
+  EXPECT_EQ(nlohmann::json::parse(store->get(1).data), Documents[1]);
+  EXPECT_THROW(store->get(Documents.size()), std::exception);
+
+  OpReturnType documents = std::make_shared<DocumentStoreDataVariable>(std::move(store));
+  EXPECT_EQ(documents->get_containerType(), CONTAINERTYPE::LIST);
+  EXPECT_EQ(documents->get_size(), Documents.size());
+  EXPECT_EQ(documents->get_int_subscript(0)->get_string(), "Onion (Loose), 2 kg");
+  EXPECT_EQ(documents->get_int_subscript(1)->get_string_subscript("text")->get_string(),
+            "Paneer, 200 g");
+  EXPECT_EQ(documents->get_int_subscript(2)->get_size(), 2);
+  EXPECT_EQ(documents->get_int_subscript(-1)->get_int64(), 42);
+  EXPECT_THROW(documents->get_int_subscript(Documents.size()), std::exception);
+  EXPECT_EQ(documents->to_json(), Documents);
+  std::remove(filePath.c_str());
+}
+
+TEST(DocumentStoreTest, RejectsOtherAndTruncatedFiles) {
+  std::string filePath = "document_store_test.bin";
+  {
+    FILE* f = fopen(filePath.c_str(), "w");
+    fputs(Documents.dump().c_str(), f);
+    fclose(f);
+  }
+  EXPECT_FALSE(DocumentStore::is_document_store(*map(filePath)));
+
+  DocumentStore::write(Documents, filePath);
+  auto size = std::filesystem::file_size(filePath);
+  // Cut in the payloads, then in the offset table
+  std::filesystem::resize_file(filePath, size - 4);
+  EXPECT_THROW(DocumentStore::open(map(filePath)), std::exception);
+  std::filesystem::resize_file(filePath, 40);
+  EXPECT_THROW(DocumentStore::open(map(filePath)), std::exception);
+
+  DocumentStore::write(nlohmann::json::array(), filePath);
+  EXPECT_EQ(DocumentStore::open(map(filePath))->size(), 0);
+  EXPECT_THROW(DocumentStore::write(nlohmann::json::object(), filePath), std::exception);
+  std::remove(filePath.c_str());
+}
@@ -0,0 +1,156 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <set>
+#include <thread>
+
+#include "job.hpp"
+#include "job_scheduler.hpp"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Job running the given function.
+ */
+class FunctionJob : public Job<void> {
+  std::function<Status()> _process;
+
+ public:
+  FunctionJob(const std::string& name, std::function<Status()> process)
+      : Job<void>(name), _process(std::move(process)) {}
+
+  Status process() override { return _process(); }
+};
+
+std::shared_ptr<Job<void>> make_job(const std::string& name, std::function<void()> process) {
+  return std::make_shared<FunctionJob>(name, [process = std::move(process)]() {
+    process();
+    return BaseJob::Status::COMPLETE;
+  });
+}
+
+bool is_ready(const std::future<void>& future) {
+  return future.wait_for(5s) == std::future_status::ready;
+}
+
+}  // namespace
+
+class JobSchedulerTest : public ::testing::Test {
+ protected:
+  std::shared_ptr<JobScheduler> _scheduler = std::make_shared<JobScheduler>();
+
+  virtual void TearDown() override { _scheduler->stop_workers(); };
+};
+
+TEST_F(JobSchedulerTest, WorkersRunReadyJobsInParallel) {
+  constexpr int numJobs = 4;
+  _scheduler->start_workers(numJobs);
+  std::atomic<int> numStarted = 0;
+  std::mutex threadIdsMutex;
+  std::set<std::thread::id> threadIds;
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < numJobs; i++) {
+    futures.push_back(_scheduler->add_job(make_job("job" + std::to_string(i), [&]() {
+      {
+        std::lock_guard lock{threadIdsMutex};
+        threadIds.insert(std::this_thread::get_id());
+      }
+      // Every job waits for all of them to be started, which only happens on separate workers
+      numStarted++;
+      auto deadline = std::chrono::steady_clock::now() + 5s;
+      while (numStarted < numJobs && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+      }
+    })));
+  }
+  for (auto& future : futures) {
+    ASSERT_TRUE(is_ready(future));
+  }
+  EXPECT_EQ(numStarted, numJobs);
+  EXPECT_EQ(threadIds.size(), numJobs);
+  EXPECT_EQ(threadIds.count(std::this_thread::get_id()), 0);
+}
+
+TEST_F(JobSchedulerTest, ParentRunsAfterAllChildrenOnWorkers) {
+  constexpr int numChildren = 8;
+  _scheduler->start_workers(4);
+  for (int round = 0; round < 20; round++) {
+    std::atomic<int> numChildrenDone = 0;
+    int numChildrenDoneInParent = -1;
+    auto parent =
+        make_job("parent", [&]() { numChildrenDoneInParent = numChildrenDone.load(); });
+    std::vector<std::shared_ptr<Job<void>>> children;
+    for (int i = 0; i < numChildren; i++) {
+      children.push_back(make_job("child" + std::to_string(i), [&numChildrenDone, i]() {
+        std::this_thread::sleep_for(std::chrono::microseconds(100 * (i % 3)));
+        numChildrenDone++;
+      }));
+      parent->add_child_job(children.back());
+    }
+    // The parent is added first, so that it waits for children already running on the workers
+    auto parentFuture = _scheduler->add_job(parent);
+    for (auto& child : children) {
+      static_cast<void>(_scheduler->add_job(child));
+    }
+    ASSERT_TRUE(is_ready(parentFuture));
+    ASSERT_EQ(numChildrenDoneInParent, numChildren);
+  }
+}
+
+TEST_F(JobSchedulerTest, PausedWorkersLetCommandCenterBeReplaced) {
+  // Stands for the command center swapped by CoreSDK::replace_command_center
+  auto commandCenter = std::make_shared<int>(1);
+  _scheduler->start_workers(2);
+
+  std::atomic<bool> runningJobStarted = false;
+  std::atomic<bool> runningJobDone = false;
+  auto runningFuture = _scheduler->add_job(make_job("running", [&]() {
+    runningJobStarted = true;
+    std::this_thread::sleep_for(50ms);
+    runningJobDone = true;
+  }));
+  while (!runningJobStarted) {
+    std::this_thread::sleep_for(1ms);
+  }
+
+  // Waits for the job already taken by a worker
+  _scheduler->pause_workers();
+  EXPECT_TRUE(runningJobDone);
+
+  int seenCommandCenter = 0;
+  auto pausedFuture = _scheduler->add_job(
+      make_job("paused", [&]() { seenCommandCenter = *std::atomic_load(&commandCenter); }));
+  EXPECT_EQ(pausedFuture.wait_for(100ms), std::future_status::timeout);
+  std::atomic_store(&commandCenter, std::make_shared<int>(2));
+  _scheduler->resume_workers();
+
+  ASSERT_TRUE(is_ready(pausedFuture));
+  EXPECT_EQ(seenCommandCenter, 2);
+  ASSERT_TRUE(is_ready(runningFuture));
+}
+
+TEST_F(JobSchedulerTest, NestedPausesKeepWorkersPaused) {
+  _scheduler->start_workers(2);
+  _scheduler->pause_workers();
+  _scheduler->pause_workers();
+
+  std::atomic<bool> done = false;
+  auto future = _scheduler->add_job(make_job("job", [&]() { done = true; }));
+  _scheduler->resume_workers();
+  EXPECT_EQ(future.wait_for(100ms), std::future_status::timeout);
+  EXPECT_FALSE(done);
+
+  _scheduler->resume_workers();
+  ASSERT_TRUE(is_ready(future));
+  EXPECT_TRUE(done);
+}
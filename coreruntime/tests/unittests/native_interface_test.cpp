@@ -6,6 +6,7 @@
 
 #include <gtest/gtest.h>
 
+#include "file_codec.hpp"
 #include "nimbletest.hpp"
 #include "tests_util.hpp"
 
@@ -42,3 +43,167 @@ TEST_F(NativeInterfaceTest, UnzipArchiveTest) {
   ASSERT_STREQ(jsonFileContent.c_str(), "{\n    \"key\": 1,\n    \"value\": \"val\"\n}");
 }
 #endif  // GENAI
+
+TEST_F(NativeInterfaceTest, MapCompressedFileDecompressesOnce) {
+  std::string content = "model bytes " + std::string(100000, 'x');
+  ASSERT_TRUE(nativeinterface::compress_and_save_file_on_device(content, "model.bin"));
+  std::string fullFilePath = nativeinterface::HOMEDIR + "model.bin";
+  ASSERT_LT(fs::file_size(fullFilePath), content.size());
+
+  auto mappedFile = nativeinterface::map_potentially_compressed_file("model.bin");
+  ASSERT_NE(mappedFile, nullptr);
+  ASSERT_EQ(std::string(mappedFile->data(), mappedFile->size()), content);
+  // The compressed file is replaced by its content, which later calls map directly
+  ASSERT_EQ(fs::file_size(fullFilePath), content.size());
+  auto remappedFile = nativeinterface::map_potentially_compressed_file("model.bin");
+  ASSERT_EQ(std::string(remappedFile->data(), remappedFile->size()), content);
+  ASSERT_EQ(nativeinterface::map_potentially_compressed_file("missing.bin"), nullptr);
+}
+
+TEST_F(NativeInterfaceTest, CompressedFilesAreReadWhateverTheirCodec) {
+  std::string content;
+  for (int i = 0; i < 20000; i++) {
+    content += "METRICS::: event " + std::to_string(i) + "\n";
+  }
+  std::string plainFilePath = nativeinterface::HOMEDIR + "events.txt";
+  std::string compressedFilePath = nativeinterface::HOMEDIR + "events.gz";
+  nativeinterface::write_data_to_file(std::string(content), plainFilePath);
+  ASSERT_TRUE(nativeinterface::compress_file(plainFilePath.c_str(), compressedFilePath.c_str()));
+  ASSERT_EQ(filecodec::detect_codec(plainFilePath), filecodec::Codec::NONE);
+  ASSERT_EQ(filecodec::detect_codec(compressedFilePath), filecodec::Codec::GZIP);
+  ASSERT_LT(fs::file_size(compressedFilePath), content.size() / 4);
+
+  for (const auto& fileName : {"events.txt", "events.gz"}) {
+    auto [success, readContent] = nativeinterface::read_potentially_compressed_file(fileName);
+    ASSERT_TRUE(success);
+    ASSERT_EQ(readContent, content);
+    std::string chunkedContent;
+    ASSERT_TRUE(nativeinterface::read_potentially_compressed_file_in_chunks(
+        nativeinterface::HOMEDIR + fileName,
+        [&](const char* chunk, size_t size) { chunkedContent.append(chunk, size); }));
+    ASSERT_EQ(chunkedContent, content);
+  }
+
+  // A truncated file is reported as such rather than read as complete
+  fs::resize_file(compressedFilePath, fs::file_size(compressedFilePath) / 2);
+  ASSERT_FALSE(nativeinterface::read_potentially_compressed_file("events.gz").first);
+}
+
+class FileDownloadTest : public NativeInterfaceTest {
+ protected:
+  const std::string _fileUrl = "http://localhost:8080/files/model.bin";
+  std::string _content;
+  std::string _gzipContent;
+
+  virtual void SetUp() override {
+    NativeInterfaceTest::SetUp();
+    ASSERT_TRUE(TestsUtil::reset_expectations());
+    for (int i = 0; i < 50000; i++) {
+      _content += "model weight " + std::to_string(i * 7919 % 10007) + "\n";
+    }
+    std::string plainFilePath = nativeinterface::HOMEDIR + "content.bin";
+    std::string gzipFilePath = nativeinterface::HOMEDIR + "content.gz";
+    nativeinterface::write_data_to_file(std::string(_content), plainFilePath);
+    ASSERT_TRUE(nativeinterface::compress_file(plainFilePath.c_str(), gzipFilePath.c_str()));
+    std::ifstream gzipFile(gzipFilePath, std::ios::binary);
+    _gzipContent = std::string(std::istreambuf_iterator<char>(gzipFile), {});
+  };
+
+  FileDownloadStatus download() {
+    return nativeinterface::download_to_file_async(_fileUrl, "[]", "model.bin").currentStatus;
+  }
+
+  std::string downloaded_content() {
+    std::ifstream file(nativeinterface::HOMEDIR + "model.bin", std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), {});
+  }
+
+  bool exists(const std::string& fileName) {
+    return fs::exists(nativeinterface::HOMEDIR + fileName);
+  }
+};
+
+TEST_F(FileDownloadTest, PlainFileIsWrittenAsIs) {
+  ASSERT_TRUE(TestsUtil::set_file_expectation(_fileUrl, _content, "\"v1\""));
+  ASSERT_EQ(download(), DOWNLOAD_SUCCESS);
+  ASSERT_EQ(downloaded_content(), _content);
+  ASSERT_FALSE(exists("model.bin.part"));
+  ASSERT_FALSE(exists("model.bin.validator"));
+}
+
+TEST_F(FileDownloadTest, GzipFileIsInflated) {
+  ASSERT_TRUE(TestsUtil::set_file_expectation(_fileUrl, _gzipContent, "\"v1\""));
+  ASSERT_EQ(download(), DOWNLOAD_SUCCESS);
+  ASSERT_EQ(downloaded_content(), _content);
+  ASSERT_FALSE(exists("model.bin.part"));
+  ASSERT_FALSE(exists("model.bin.tmp"));
+}
+
+TEST_F(FileDownloadTest, InterruptedDownloadResumesWithRange) {
+  for (const auto& body : {_content, _gzipContent}) {
+    int truncateAt = body.size() / 2;
+    ASSERT_TRUE(TestsUtil::reset_expectations());
+    ASSERT_TRUE(TestsUtil::set_file_expectation(_fileUrl, body, "\"v1\"", false, truncateAt));
+    ASSERT_EQ(download(), DOWNLOAD_FAILURE);
+    ASSERT_EQ(fs::file_size(nativeinterface::HOMEDIR + "model.bin.part"), truncateAt);
+
+    ASSERT_EQ(download(), DOWNLOAD_SUCCESS);
+    ASSERT_EQ(downloaded_content(), _content);
+    auto requests = TestsUtil::get_file_requests(_fileUrl);
+    ASSERT_EQ(requests.size(), 2);
+    ASSERT_EQ(requests[1]["range"], "bytes=" + std::to_string(truncateAt) + "-");
+    ASSERT_EQ(requests[1]["if_range"], "\"v1\"");
+    ASSERT_EQ(requests[1]["status_code"], 206);
+    ASSERT_FALSE(exists("model.bin.part"));
+  }
+}
+
+TEST_F(FileDownloadTest, DownloadStartsOverWhenServerIgnoresRange) {
+  ASSERT_TRUE(TestsUtil::set_file_expectation(_fileUrl, _gzipContent, "\"v1\"", true,
+                                              _gzipContent.size() / 2));
+  ASSERT_EQ(download(), DOWNLOAD_FAILURE);
+  ASSERT_EQ(download(), DOWNLOAD_SUCCESS);
+  ASSERT_EQ(downloaded_content(), _content);
+  ASSERT_EQ(TestsUtil::get_file_requests(_fileUrl)[1]["status_code"], 200);
+}
+
+TEST_F(FileDownloadTest, DownloadStartsOverWhenFileChanged) {
+  ASSERT_TRUE(TestsUtil::set_file_expectation(_fileUrl, _content, "\"v1\"", false,
+                                              _content.size() / 2));
+  ASSERT_EQ(download(), DOWNLOAD_FAILURE);
+
+  // If-Range no longer matches, the whole new file is sent instead of the rest of the old one
+  std::string newContent = "new " + _content;
+  ASSERT_TRUE(TestsUtil::set_file_expectation(_fileUrl, newContent, "\"v2\""));
+  ASSERT_EQ(download(), DOWNLOAD_SUCCESS);
+  ASSERT_EQ(downloaded_content(), newContent);
+  auto requests = TestsUtil::get_file_requests(_fileUrl);
+  ASSERT_EQ(requests[0]["if_range"], "\"v1\"");
+  ASSERT_EQ(requests[0]["status_code"], 200);
+}
+
+TEST_F(FileDownloadTest, RangeNotSatisfiableDiscardsKeptBytes) {
+  ASSERT_TRUE(TestsUtil::set_file_expectation(_fileUrl, _content, "\"v1\"", false,
+                                              _content.size() / 2));
+  ASSERT_EQ(download(), DOWNLOAD_FAILURE);
+
+  std::string shortContent = _content.substr(0, 100);
+  ASSERT_TRUE(TestsUtil::set_file_expectation(_fileUrl, shortContent, "\"v1\""));
+  ASSERT_EQ(download(), DOWNLOAD_FAILURE);
+  ASSERT_EQ(TestsUtil::get_file_requests(_fileUrl)[0]["status_code"], 416);
+  ASSERT_FALSE(exists("model.bin.part"));
+
+  ASSERT_EQ(download(), DOWNLOAD_SUCCESS);
+  ASSERT_EQ(downloaded_content(), shortContent);
+}
+
+TEST_F(FileDownloadTest, CorruptedGzipTrailerFailsDownload) {
+  // The trailer holds the CRC32 and the length of the content
+  std::string corrupted = _gzipContent;
+  corrupted[corrupted.size() - 8] ^= 0xff;
+  ASSERT_TRUE(TestsUtil::set_file_expectation(_fileUrl, corrupted, "\"v1\""));
+  ASSERT_EQ(download(), DOWNLOAD_FAILURE);
+  ASSERT_FALSE(exists("model.bin"));
+  ASSERT_FALSE(exists("model.bin.part"));
+  ASSERT_FALSE(exists("model.bin.tmp"));
+}
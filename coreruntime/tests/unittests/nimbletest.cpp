@@ -107,7 +107,7 @@ TEST(SanityTest, CommandCenterInitializes) {
   std::shared_ptr<ServerAPI> serverAPI = std::make_shared<ServerAPI>(&metricsAgent, config);
   Database *database = new Database(&metricsAgent);
   metricsAgent.initialize(logger);
-  auto scheduler = std::make_shared<JobScheduler>(coresdkconstants::JobSchedulerCapacity);
+  auto scheduler = std::make_shared<JobScheduler>();
   CommandCenter commandCenter(serverAPI, config, &metricsAgent, database, scheduler, nullptr);
   ResourceManager &resourceManager = commandCenter.get_resource_manager();
   UserEventsManager &userEventsManager = commandCenter.get_userEventsManager();
@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef ONNX_EXECUTOR
+
+#include <gtest/gtest.h>
+
+#include "nimbletest.hpp"
+#include "task_onnx_model.hpp"
+#include "tests_util.hpp"
+
+class ONNXModelTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() override {
+    const char* testName = testing::UnitTest::GetInstance()->current_test_info()->name();
+    std::string testFolder = "./testrun/" + std::string(testName) + "/";
+    ASSERT_TRUE(ServerHelpers::create_folder(testFolder));
+    nativeinterface::HOMEDIR = testFolder;
+  };
+
+  std::unique_ptr<TaskONNXModel> load_model(const std::string& assetName) {
+    std::string sourceFilePath;
+    EXPECT_TRUE(ServerHelpers::get_full_file_path_from_assets(assetName, sourceFilePath));
+    std::string fileName = assetName.substr(assetName.find_last_of('/') + 1);
+    EXPECT_TRUE(TestsUtil::copy_file(sourceFilePath, nativeinterface::HOMEDIR + fileName));
+    return std::make_unique<TaskONNXModel>(fileName, "1.0.0", fileName, nlohmann::json::object(),
+                                           0, nullptr, false);
+  }
+
+  static OpReturnType int64_tensor(int64_t value) {
+    auto tensor = OpReturnType(new TensorVariable({1}, DATATYPE::INT64));
+    *(int64_t*)tensor->get_raw_ptr() = value;
+    return tensor;
+  }
+
+  static OpReturnType run(TaskONNXModel& model, const std::vector<OpReturnType>& inputs) {
+    OpReturnType ret;
+    EXPECT_EQ(model.get_inference("test", inputs, ret), SUCCESS);
+    return ret->get_int_subscript(0);
+  }
+};
+
+TEST_F(ONNXModelTest, HeldOutputsAreNotOverwritten) {
+  auto model = load_model("onnx_model_test/add_three_model.onnx");
+  ASSERT_TRUE(model->binds_outputs_to_arenas());
+
+  auto first = run(*model, {int64_tensor(5)});
+  auto second = run(*model, {int64_tensor(10)});
+  // The first arena is still referenced, so the second run is bound to another one
+  EXPECT_NE(first->get_raw_ptr(), second->get_raw_ptr());
+  EXPECT_EQ(first->get_int_subscript(0)->get_int64(), 8);
+  EXPECT_EQ(second->get_int_subscript(0)->get_int64(), 13);
+}
+
+TEST_F(ONNXModelTest, ReleasedArenaIsReused) {
+  auto model = load_model("onnx_model_test/add_three_model.onnx");
+  ASSERT_TRUE(model->binds_outputs_to_arenas());
+
+  auto output = run(*model, {int64_tensor(1)});
+  void* arenaData = output->get_raw_ptr();
+  EXPECT_EQ(output->get_int_subscript(0)->get_int64(), 4);
+  output.reset();
+
+  output = run(*model, {int64_tensor(2)});
+  EXPECT_EQ(output->get_raw_ptr(), arenaData);
+  EXPECT_EQ(output->get_int_subscript(0)->get_int64(), 5);
+}
+
+TEST_F(ONNXModelTest, DynamicShapeOutputsAreNotPooled) {
+  auto model = load_model("end_to_end_test/add_two_model.onnx");
+  EXPECT_FALSE(model->binds_outputs_to_arenas());
+
+  auto first = run(*model, {int64_tensor(5)});
+  auto second = run(*model, {int64_tensor(10)});
+  EXPECT_EQ(first->get_int_subscript(0)->get_int64(), 7);
+  EXPECT_EQ(second->get_int_subscript(0)->get_int64(), 12);
+}
+
+TEST_F(ONNXModelTest, StringOutputsAreNotPooled) {
+  // Fixed shape, but strings can not be written into a preallocated buffer
+  auto model = load_model("onnx_model_test/string_identity_model.onnx");
+  EXPECT_FALSE(model->binds_outputs_to_arenas());
+
+  auto input = OpReturnType(new StringTensorVariable({"first", "second"}, {2}, 1));
+  auto output = run(*model, {input});
+  ASSERT_NE(dynamic_cast<StringTensorVariable*>(output.get()), nullptr);
+  EXPECT_EQ(output->get_int_subscript(0)->get_string(), "first");
+  EXPECT_EQ(output->get_int_subscript(1)->get_string(), "second");
+}
+
+#endif  // ONNX_EXECUTOR
@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "list_data_variable.hpp"
+#include "retriever.hpp"
+#include "single_variable.hpp"
+#include "tensor_data_variable.hpp"
+#include "tuple_data_variable.hpp"
+#include "variable_scope.hpp"
+#include "vector_index_data_variable.hpp"
+
+namespace {
+
+constexpr int Dim = 4;
+
+/**
+ * @brief Embedding model mapping the query "i" to the i-th unit vector, recording the queries of
+ * every run.
+ */
+class FakeEmbeddingModel final : public DataVariable {
+  int get_containerType() const override { return CONTAINERTYPE::SINGLE; }
+
+  bool get_bool() override { return true; }
+
+  int get_dataType_enum() const override { return DATATYPE::NIMBLENET; }
+
+  nlohmann::json to_json() const override { return "[FakeEmbeddingModel]"; }
+
+ public:
+  std::vector<std::vector<std::string>> runs;
+
+  std::string print() override { return fallback_print(); }
+
+  OpReturnType call_function(int memberFuncIndex, const std::vector<OpReturnType>& arguments,
+                             CallStack& stack) override {
+    EXPECT_EQ(memberFuncIndex, MemberFuncType::RUNMODEL);
+    int numQueries = arguments[0]->get_size();
+    auto embeddings = OpReturnType(new TensorVariable({numQueries, Dim}, DATATYPE::FLOAT));
+    auto data = static_cast<float*>(embeddings->get_raw_ptr());
+    std::fill(data, data + numQueries * Dim, 0.0f);
+    std::vector<std::string> queries;
+    for (int i = 0; i < numQueries; i++) {
+      queries.push_back(arguments[0]->get_int_subscript(i)->get_string());
+      data[i * Dim + std::stoi(queries.back())] = 1;
+    }
+    runs.push_back(std::move(queries));
+    return OpReturnType(new TupleDataVariable({embeddings}));
+  }
+};
+
+OpReturnType string_list(const std::vector<std::string>& strings) {
+  std::vector<OpReturnType> members;
+  for (const auto& string : strings) {
+    members.push_back(OpReturnType(new SingleVariable<std::string>(string)));
+  }
+  return OpReturnType(new ListDataVariable(std::move(members)));
+}
+
+std::vector<std::string> strings(const OpReturnType& list) {
+  std::vector<std::string> values;
+  for (int i = 0; i < list->get_size(); i++) {
+    values.push_back(list->get_int_subscript(i)->get_string());
+  }
+  return values;
+}
+
+}  // namespace
+
+class RetrieverTest : public ::testing::Test {
+ protected:
+  CallStack _stack{nullptr};
+  std::shared_ptr<FakeEmbeddingModel> _embeddingModel = std::make_shared<FakeEmbeddingModel>();
+  OpReturnType _retriever;
+
+  virtual void SetUp() override {
+    auto config = DataVariable::get_map_from_json_object({{"dim", Dim}});
+    auto index = OpReturnType(new VectorIndexDataVariable({config}));
+    // Document i is stored with id i
+    float vectors[][Dim] = {{1, 0, 0, 0}, {0.8, 0.6, 0, 0}, {0, 1, 0, 0}, {0, 0, 0.6, 0.8}};
+    std::vector<OpReturnType> ids;
+    for (int64_t id = 0; id < 4; id++) {
+      ids.push_back(OpReturnType(new SingleVariable<int64_t>(id)));
+    }
+    auto tensor = OpReturnType(new TensorVariable({4, Dim}, DATATYPE::FLOAT));
+    memcpy(tensor->get_raw_ptr(), vectors, sizeof(vectors));
+    index->call_function(MemberFuncType::ADD,
+                         {OpReturnType(new ListDataVariable(std::move(ids))), tensor}, _stack);
+
+    auto documents = string_list({"a", "b", "c", "d"});
+    _retriever =
+        OpReturnType(new RetrieverDataVariable(nullptr, {_embeddingModel, index, documents}));
+  };
+
+  OpReturnType topk(const OpReturnType& query, int k) {
+    return _retriever->call_function(
+        MemberFuncType::TOPK, {query, OpReturnType(new SingleVariable<int32_t>(k))}, _stack);
+  }
+};
+
+TEST_F(RetrieverTest, ListOfQueriesReturnsResultsPerQueryInOrder) {
+  auto results = topk(string_list({"0", "1", "0"}), 2);
+  ASSERT_EQ(results->get_size(), 3);
+  // Duplicate queries are embedded once, in a single run of the model
+  ASSERT_EQ(_embeddingModel->runs, std::vector<std::vector<std::string>>({{"0", "1"}}));
+
+  std::vector<std::vector<std::string>> expectedDocuments = {{"a", "b"}, {"c", "b"}, {"a", "b"}};
+  std::vector<std::vector<float>> expectedScores = {{1, 0.8}, {1, 0.6}, {1, 0.8}};
+  for (int i = 0; i < 3; i++) {
+    auto result = results->get_int_subscript(i);
+    auto scores = result->get_int_subscript(0);
+    EXPECT_EQ(strings(result->get_int_subscript(1)), expectedDocuments[i]) << "query " << i;
+    ASSERT_EQ(scores->get_size(), 2);
+    for (int j = 0; j < 2; j++) {
+      EXPECT_NEAR(scores->get_int_subscript(j)->get_float(), expectedScores[i][j], 1e-5);
+    }
+  }
+
+  // A single query gives the same result as in a list
+  auto single = topk(OpReturnType(new SingleVariable<std::string>("1")), 2);
+  EXPECT_EQ(strings(single->get_int_subscript(1)), expectedDocuments[1]);
+}
+
+TEST_F(RetrieverTest, EmbeddingsAreCachedAcrossCalls) {
+  static_cast<void>(topk(string_list({"0", "1"}), 1));
+  // Only the query not embedded before is run through the model
+  auto results = topk(string_list({"1", "3", "0"}), 1);
+  ASSERT_EQ(_embeddingModel->runs, std::vector<std::vector<std::string>>({{"0", "1"}, {"3"}}));
+  std::vector<std::string> expectedDocuments = {"c", "d", "a"};
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(strings(results->get_int_subscript(i)->get_int_subscript(1)),
+              std::vector<std::string>({expectedDocuments[i]}));
+  }
+
+  // Single queries use the same cache
+  static_cast<void>(topk(OpReturnType(new SingleVariable<std::string>("3")), 1));
+  ASSERT_EQ(_embeddingModel->runs.size(), 2);
+}
@@ -0,0 +1,186 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "rolling_window.hpp"
+#include "single_variable.hpp"
+#include "time_based_rolling_window.hpp"
+#include "time_manager.hpp"
+
+namespace {
+
+const std::vector<std::string> kOperators = {"Sum", "Count", "Min", "Max", "Avg"};
+constexpr double kDefault = -1;
+
+/**
+ * Keeps the last windowSize events of the table, so that expiry can be driven by the test
+ * without waiting for the clock.
+ */
+class LastEventsRollingWindow final : public RollingWindow {
+  int _windowSize;
+  int _windowStart = 0;
+
+ public:
+  LastEventsRollingWindow(const PreProcessorInfo& info, int windowSize)
+      : RollingWindow(0, info), _windowSize(windowSize) {}
+
+  void add_event(const TableData& tableData, int newEventIndex) override {
+    add_event_to_group(tableData, newEventIndex);
+    while (newEventIndex + 1 - _windowStart > _windowSize) {
+      remove_event_from_group(tableData, _windowStart++);
+    }
+  }
+
+  void update_window(const TableData& tableData) override { store_dirty_groups(); }
+
+  int window_start() const { return _windowStart; }
+};
+
+class RollingWindowTest : public ::testing::Test {
+ protected:
+  TableData _tableData;
+  PreProcessorInfo _info;
+  std::vector<std::vector<double>> _features;
+
+  void SetUp() override {
+    _tableData.add_column("value", DATATYPE::DOUBLE);
+    _tableData.groups.resize(1);
+    _info.dataType = DATATYPE::DOUBLE;
+    for (const auto& op : kOperators) {
+      _info.columnsToAggregate.push_back("value");
+      _info.aggregateOperators.push_back(op);
+      _info.defaultVector.push_back(kDefault);
+    }
+  }
+
+  void create_groups(RollingWindow& window, int numGroups) {
+    // Sized once, the aggregate columns keep pointers into the feature vectors
+    _features.assign(numGroups, std::vector<double>(kOperators.size(), kDefault));
+    std::vector<int> columnIds(kOperators.size(), 0);
+    for (int group = 0; group < numGroups; group++) {
+      ASSERT_TRUE(window.create_aggregate_columns_for_group(group, columnIds, _features[group], 0));
+    }
+  }
+
+  int append_event(int64_t timestamp, int group, double value) {
+    _tableData.timestamps.push_back(timestamp);
+    _tableData.columnValues[0].append(OpReturnType(new SingleVariable<double>(value)));
+    _tableData.groups[0].push_back(group);
+    return _tableData.num_events() - 1;
+  }
+
+  // Recomputes the features of a group over the events [windowStart, windowEnd) of the table
+  std::vector<double> brute_force(int group, int windowStart, int windowEnd) const {
+    std::vector<double> values;
+    for (int i = windowStart; i < windowEnd; i++) {
+      if (_tableData.groups[0][i] == group) {
+        values.push_back(_tableData.columnValues[0].get<double>(i));
+      }
+    }
+    if (values.empty()) {
+      return std::vector<double>(kOperators.size(), kDefault);
+    }
+    double sum = 0;
+    for (auto v : values) sum += v;
+    return {sum, double(values.size()), *std::min_element(values.begin(), values.end()),
+            *std::max_element(values.begin(), values.end()), sum / values.size()};
+  }
+
+  void expect_features(int group, const std::vector<double>& expected) const {
+    for (int i = 0; i < kOperators.size(); i++) {
+      EXPECT_NEAR(_features[group][i], expected[i], 1e-9)
+          << kOperators[i] << " of group " << group;
+    }
+  }
+};
+
+}  // namespace
+
+TEST_F(RollingWindowTest, MinMaxRecoverAfterExpiry) {
+  LastEventsRollingWindow window(_info, 3);
+  create_groups(window, 1);
+
+  for (double value : {1, 5, 3}) {
+    window.add_event(_tableData, append_event(0, 0, value));
+  }
+  window.update_window(_tableData);
+  expect_features(0, {9, 3, 1, 5, 3});
+
+  // The minimum expires, the next one comes from the candidates
+  window.add_event(_tableData, append_event(0, 0, 4));
+  window.update_window(_tableData);
+  expect_features(0, {12, 3, 3, 5, 4});
+
+  // The maximum expires, the next one comes from the candidates
+  window.add_event(_tableData, append_event(0, 0, 2));
+  window.update_window(_tableData);
+  expect_features(0, {9, 3, 2, 4, 3});
+}
+
+TEST_F(RollingWindowTest, EmptyGroupFallsBackToDefault) {
+  LastEventsRollingWindow window(_info, 2);
+  create_groups(window, 2);
+
+  window.add_event(_tableData, append_event(0, 0, 7));
+  window.update_window(_tableData);
+  expect_features(0, {7, 1, 7, 7, 7});
+
+  // Every event of group 0 expires
+  window.add_event(_tableData, append_event(0, 1, 2));
+  window.add_event(_tableData, append_event(0, 1, 4));
+  window.update_window(_tableData);
+  expect_features(0, brute_force(0, 1, 3));
+  expect_features(1, {6, 2, 2, 4, 3});
+}
+
+TEST_F(RollingWindowTest, MatchesBruteForceWithSeveralDirtyGroups) {
+  constexpr int numGroups = 4;
+  constexpr int windowSize = 7;
+  LastEventsRollingWindow window(_info, windowSize);
+  create_groups(window, numGroups);
+
+  std::mt19937 rng(42);
+  // Few distinct values so that the candidates see ties
+  std::uniform_int_distribution<int> valueDist(-5, 5);
+  std::uniform_int_distribution<int> groupDist(0, numGroups - 1);
+  std::uniform_int_distribution<int> batchDist(1, 5);
+  for (int step = 0; step < 200; step++) {
+    // Several events, possibly of different groups, are added between two reads
+    int batch = batchDist(rng);
+    for (int i = 0; i < batch; i++) {
+      window.add_event(_tableData, append_event(0, groupDist(rng), valueDist(rng)));
+    }
+    window.update_window(_tableData);
+    for (int group = 0; group < numGroups; group++) {
+      expect_features(group,
+                      brute_force(group, window.window_start(), _tableData.num_events()));
+    }
+  }
+}
+
+TEST_F(RollingWindowTest, TimeBasedWindowExpiresEvents) {
+  TimeBasedRollingWindow window(0, _info, 1);
+  create_groups(window, 2);
+
+  int64_t now = Time::get_time();
+  // Already outside of the window when added
+  window.add_event(_tableData, append_event(now - 100, 0, 10));
+  window.add_event(_tableData, append_event(now, 0, 1));
+  window.add_event(_tableData, append_event(now, 1, 2));
+  window.add_event(_tableData, append_event(now, 0, 3));
+  window.update_window(_tableData);
+  expect_features(0, {4, 2, 1, 3, 2});
+  expect_features(1, {2, 1, 2, 2, 2});
+
+  Time::sleep_until(2);
+  window.update_window(_tableData);
+  expect_features(0, std::vector<double>(kOperators.size(), kDefault));
+  expect_features(1, std::vector<double>(kOperators.size(), kDefault));
+}
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#ifdef SCRIPTING
+#include <cstdio>
+#include <filesystem>
+
+#include "nlohmann/json.hpp"
+#include "script_snapshot.hpp"
+
+namespace {
+
+// x = -1.5 if flag else 4, in module helper of a script with a main module
+const nlohmann::json Ast = nlohmann::json::parse(R"({
+  "main": {"_type": "Module", "body": [], "type_ignores": []},
+  "helper": {"_type": "Module", "type_ignores": [], "body": [{
+    "_type": "Assign", "lineno": 1, "col_offset": 0, "end_lineno": 1, "end_col_offset": 24,
+    "type_comment": null,
+    "targets": [{"_type": "Name", "id": "x", "ctx": {"_type": "Store"}, "lineno": 1}],
+    "value": {"_type": "IfExp", "lineno": 1,
+      "test": {"_type": "Name", "id": "flag", "ctx": {"_type": "Load"}, "lineno": 1},
+      "body": {"_type": "Constant", "value": -1.5, "kind": null, "lineno": 1},
+      "orelse": {"_type": "Constant", "value": 4, "kind": null, "n": 4, "s": 4, "lineno": 1}}
+  }]}
+})");
+
+}  // namespace
+
+TEST(ScriptSnapshotTest, DecodesModulesWithoutSourcePositions) {
+  auto snapshot = ScriptSnapshot::create(Ast);
+  ASSERT_TRUE(snapshot->has_module("main"));
+  ASSERT_TRUE(snapshot->has_module("helper"));
+  EXPECT_FALSE(snapshot->has_module("body"));
+  EXPECT_THROW(snapshot->get_module("other"), std::exception);
+
+  auto helper = snapshot->get_module("helper");
+  EXPECT_FALSE(helper.contains("type_ignores"));
+  const auto& assign = helper.at("body").at(0);
+  EXPECT_EQ(assign.at("lineno"), 1);
+  EXPECT_FALSE(assign.contains("col_offset"));
+  EXPECT_FALSE(assign.contains("type_comment"));
+  EXPECT_EQ(assign.at("targets").at(0).at("id"), "x");
+  const auto& orelse = assign.at("value").at("orelse");
+  EXPECT_EQ(orelse, nlohmann::json::parse(R"({"_type": "Constant", "value": 4, "lineno": 1})"));
+  EXPECT_TRUE(orelse.at("value").is_number_unsigned());
+  EXPECT_EQ(assign.at("value").at("body").at("value"), -1.5);
+
+  // A script without modules is its main module
+  auto single = ScriptSnapshot::create(Ast.at("helper"));
+  EXPECT_TRUE(single->has_module(ScriptSnapshot::MainModule));
+  EXPECT_FALSE(single->has_module("helper"));
+  EXPECT_EQ(single->get_module(ScriptSnapshot::MainModule), helper);
+}
+
+TEST(ScriptSnapshotTest, LoadsOnlySnapshotsOfTheSameScript) {
+  std::string filePath = "script_snapshot_test" + ScriptSnapshot::FileSuffix;
+  std::string source = Ast.dump();
+  uint64_t sourceHash = ScriptSnapshot::hash(source);
+  EXPECT_NE(sourceHash, ScriptSnapshot::hash(source + " "));
+
+  EXPECT_EQ(ScriptSnapshot::load(filePath, sourceHash), nullptr);
+  auto snapshot = ScriptSnapshot::create(Ast, sourceHash);
+  ASSERT_TRUE(snapshot->save(filePath));
+  auto loaded = ScriptSnapshot::load(filePath, sourceHash);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(loaded->source_hash(), sourceHash);
+  EXPECT_EQ(loaded->get_module("helper"), snapshot->get_module("helper"));
+  EXPECT_EQ(ScriptSnapshot::load(filePath, sourceHash + 1), nullptr);
+
+  std::filesystem::resize_file(filePath, snapshot->size() - 1);
+  EXPECT_EQ(ScriptSnapshot::load(filePath, sourceHash), nullptr);
+  std::remove(filePath.c_str());
+}
+#endif  // SCRIPTING
@@ -38,7 +38,7 @@ class ScriptingTest : public ::testing::Test {
     std::shared_ptr<ServerAPI> serverAPI = std::make_shared<ServerAPI>(&metricsAgent, config);
     database = new Database(&metricsAgent);
     auto externalLogger = std::make_shared<Logger>();
-    auto scheduler = std::make_shared<JobScheduler>(coresdkconstants::JobSchedulerCapacity);
+    auto scheduler = std::make_shared<JobScheduler>();
     auto deployment = jsonparser::get<Deployment>(scriptDeploymentJson);
     commandCenter = new CommandCenter(serverAPI, config, &metricsAgent, database, scheduler,
                                       externalLogger, true, deployment);
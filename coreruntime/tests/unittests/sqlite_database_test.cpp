@@ -0,0 +1,254 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <sqlite3.h>
+
+#include <thread>
+
+#include "config_manager.hpp"
+#include "core_sdk_structs.hpp"
+#include "database.hpp"
+#include "event_record.hpp"
+#include "nimbletest.hpp"
+#include "time_manager.hpp"
+
+/**
+ * Tests of the SQLite events backend, only built when NOSQL is off.
+ */
+class SqliteDatabaseTest : public ::testing::Test {
+ protected:
+  MetricsAgent _metricsAgent;
+  std::unique_ptr<Database> _database;
+
+  struct StoredEvent {
+    int64_t timestamp;
+    std::map<std::string, OpReturnType> fields;
+  };
+
+  virtual void SetUp() override {
+    const char* testName = testing::UnitTest::GetInstance()->current_test_info()->name();
+    std::string testFolder = "./testrun/" + std::string(testName) + "/";
+    ASSERT_TRUE(ServerHelpers::create_folder(testFolder));
+    nativeinterface::HOMEDIR = testFolder;
+  };
+
+  virtual void TearDown() override { _database.reset(); };
+
+  void open_database() { _database = std::make_unique<Database>(&_metricsAgent); }
+
+  static OpReturnType make_event(nlohmann::json&& event) {
+    return DataVariable::get_map_from_json_object(std::move(event));
+  }
+
+  std::vector<StoredEvent> read_events(const std::string& eventType, int64_t expiryTime = 0) {
+    std::vector<StoredEvent> events;
+    _database->for_each_event(
+        eventType,
+        [&](int64_t timestamp, std::map<std::string, OpReturnType>&& event) {
+          events.push_back({timestamp, std::move(event)});
+        },
+        expiryTime);
+    return events;
+  }
+
+  // Runs statements on a second connection, as another process or an older version would
+  static void execute_raw(const std::string& sql) {
+    sqlite3* db = nullptr;
+    std::string path = nativeinterface::HOMEDIR + DEFAULT_SQLITE_DB_NAME;
+    ASSERT_EQ(sqlite3_open(path.c_str(), &db), SQLITE_OK);
+    char* errMsg = nullptr;
+    int rc = sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errMsg);
+    EXPECT_EQ(rc, SQLITE_OK) << (errMsg ? errMsg : "");
+    sqlite3_free(errMsg);
+    sqlite3_close(db);
+  }
+
+  // Counts committed rows from a second connection
+  static int count_committed_rows() {
+    sqlite3* db = nullptr;
+    std::string path = nativeinterface::HOMEDIR + DEFAULT_SQLITE_DB_NAME;
+    if (sqlite3_open(path.c_str(), &db) != SQLITE_OK) return -1;
+    sqlite3_stmt* stmt = nullptr;
+    int count = -1;
+    if (sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM Events;", -1, &stmt, nullptr) == SQLITE_OK &&
+        sqlite3_step(stmt) == SQLITE_ROW) {
+      count = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+    return count;
+  }
+
+  // Inserts a row in the binary format with a chosen timestamp
+  static void insert_record_row(const std::string& eventType, int64_t timestamp,
+                                nlohmann::json&& event) {
+    EventRecordEncoder encoder;
+    auto record = encoder.encode(timestamp, make_event(std::move(event))->get_map());
+    sqlite3* db = nullptr;
+    std::string path = nativeinterface::HOMEDIR + DEFAULT_SQLITE_DB_NAME;
+    ASSERT_EQ(sqlite3_open(path.c_str(), &db), SQLITE_OK);
+    sqlite3_stmt* stmt = nullptr;
+    ASSERT_EQ(sqlite3_prepare_v2(db,
+                                 "INSERT INTO Events (TIMESTAMP, eventType, event) "
+                                 "VALUES (?1, ?2, ?3);",
+                                 -1, &stmt, nullptr),
+              SQLITE_OK);
+    sqlite3_bind_int64(stmt, 1, timestamp);
+    sqlite3_bind_text(stmt, 2, eventType.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_blob(stmt, 3, record.data(), record.size(), SQLITE_TRANSIENT);
+    EXPECT_EQ(sqlite3_step(stmt), SQLITE_DONE);
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+  }
+};
+
+TEST_F(SqliteDatabaseTest, AddedEventsAreReadBack) {
+  open_database();
+  ASSERT_TRUE(_database->update_eventsType_table("click"));
+  int64_t before = Time::get_time();
+  ASSERT_TRUE(_database->add_event_in_db(
+      "click", make_event({{"item", 1}, {"price", 2.5}, {"name", "it's"}, {"liked", true}})));
+  ASSERT_TRUE(_database->add_event_in_db("click", make_event({{"item", 2}, {"name", "b"}})));
+  // Events of a type not in the EventsType table are dropped
+  ASSERT_TRUE(_database->add_event_in_db("view", make_event({{"item", 3}})));
+
+  auto events = read_events("click");
+  ASSERT_EQ(events.size(), 2);
+  EXPECT_GE(events[0].timestamp, before);
+  EXPECT_LE(events[0].timestamp, Time::get_time());
+  EXPECT_EQ(events[0].fields.size(), 4);
+  EXPECT_EQ(events[0].fields["item"]->get_int64(), 1);
+  EXPECT_EQ(events[0].fields["price"]->get_double(), 2.5);
+  EXPECT_EQ(events[0].fields["name"]->get_string(), "it's");
+  EXPECT_TRUE(events[0].fields["liked"]->get_bool());
+  EXPECT_EQ(events[1].fields["item"]->get_int64(), 2);
+  EXPECT_EQ(events[1].fields["name"]->get_string(), "b");
+  EXPECT_TRUE(read_events("view").empty());
+  EXPECT_EQ(_database->get_count_from_eventsTable("click"), 2);
+  EXPECT_EQ(_database->get_rows_in_events_table(), 2);
+}
+
+TEST_F(SqliteDatabaseTest, EventsSurviveReopening) {
+  open_database();
+  ASSERT_TRUE(_database->update_eventsType_table("click"));
+  for (int i = 0; i < 5; i++) {
+    ASSERT_TRUE(_database->add_event_in_db("click", make_event({{"index", i}})));
+  }
+  // The destructor commits the open transaction
+  _database.reset();
+  EXPECT_EQ(count_committed_rows(), 5);
+
+  open_database();
+  auto events = read_events("click");
+  ASSERT_EQ(events.size(), 5);
+  for (int i = 0; i < 5; i++) {
+    EXPECT_EQ(events[i].fields["index"]->get_int64(), i);
+  }
+}
+
+TEST_F(SqliteDatabaseTest, AddedEventsAreCommittedByTimer) {
+  open_database();
+  ASSERT_TRUE(_database->update_eventsType_table("click"));
+  ASSERT_TRUE(_database->add_event_in_db("click", make_event({{"item", 1}})));
+  // Still in the open transaction, not visible to other connections
+  EXPECT_EQ(count_committed_rows(), 0);
+
+  std::this_thread::sleep_for(
+      std::chrono::microseconds(dbconstants::MaxUncommittedDelayMicros + 500000));
+  EXPECT_EQ(count_committed_rows(), 1);
+}
+
+TEST_F(SqliteDatabaseTest, FlushEveryRecordCommitsEachEvent) {
+  auto config = Config(nlohmann::json{{"online", false}, {"flushEveryRecord", true}});
+  _database = std::make_unique<Database>(&_metricsAgent, config.flushEveryRecord);
+  ASSERT_TRUE(_database->update_eventsType_table("click"));
+  ASSERT_TRUE(_database->add_event_in_db("click", make_event({{"item", 1}})));
+  EXPECT_EQ(count_committed_rows(), 1);
+  ASSERT_TRUE(_database->add_event_in_db("click", make_event({{"item", 2}})));
+  EXPECT_EQ(count_committed_rows(), 2);
+}
+
+TEST_F(SqliteDatabaseTest, ExpiryByCountKeepsNewestEvents) {
+  open_database();
+  ASSERT_TRUE(_database->update_eventsType_table("click"));
+  ASSERT_TRUE(_database->update_eventsType_table("view"));
+  // Added within the same second, so rows share their timestamp
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(_database->add_event_in_db("click", make_event({{"index", i}})));
+  }
+  ASSERT_TRUE(_database->add_event_in_db("view", make_event({{"index", 0}})));
+
+  ASSERT_TRUE(_database->delete_old_rows_from_table_in_db("click", "count", 3));
+  auto events = read_events("click");
+  ASSERT_EQ(events.size(), 3);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(events[i].fields["index"]->get_int64(), 7 + i);
+  }
+  // Other event types are untouched
+  EXPECT_EQ(read_events("view").size(), 1);
+}
+
+TEST_F(SqliteDatabaseTest, ExpiryByTimeDeletesOldEvents) {
+  open_database();
+  ASSERT_TRUE(_database->update_eventsType_table("click"));
+  int64_t now = Time::get_time();
+  insert_record_row("click", now - 3600, {{"index", 0}});
+  execute_raw("INSERT INTO Events (TIMESTAMP, eventType, event) VALUES (" +
+              std::to_string(now - 1800) + ", 'click', '{\"index\":1}');");
+  ASSERT_TRUE(_database->add_event_in_db("click", make_event({{"index", 2}})));
+
+  // Reads skip expired events without deleting them
+  auto events = read_events("click", now - 2400);
+  ASSERT_EQ(events.size(), 2);
+  EXPECT_EQ(events[0].fields["index"]->get_int64(), 1);
+  EXPECT_EQ(events[1].fields["index"]->get_int64(), 2);
+  EXPECT_EQ(read_events("click").size(), 3);
+
+  // Deletes events older than 20 minutes
+  ASSERT_TRUE(_database->delete_old_rows_from_table_in_db("click", "time", 20));
+  events = read_events("click");
+  ASSERT_EQ(events.size(), 1);
+  EXPECT_EQ(events[0].fields["index"]->get_int64(), 2);
+  EXPECT_EQ(_database->get_count_from_eventsTable("click"), 1);
+}
+
+TEST_F(SqliteDatabaseTest, LegacyRowsAreRead) {
+  // Schema and rows as written by versions storing events as JSON text
+  execute_raw(
+      "CREATE TABLE IF NOT EXISTS EventsType (eventType TEXT UNIQUE);"
+      "CREATE TABLE IF NOT EXISTS Events (event TEXT, TIMESTAMP INTEGER, eventType TEXT);"
+      "INSERT OR IGNORE INTO EventsType (eventType) VALUES ('click');"
+      "INSERT INTO Events (TIMESTAMP, eventType, event) VALUES "
+      "(1700000000, 'click', '{\"item\":1,\"price\":2.5,\"name\":\"a\"}');"
+      "INSERT INTO Events (TIMESTAMP, eventType, event) VALUES "
+      "(1700000005, 'click', 'not a json');"
+      "INSERT INTO Events (TIMESTAMP, eventType, event) VALUES "
+      "(1700000010, 'click', '{\"item\":2,\"price\":3.5,\"name\":\"b\"}');");
+
+  open_database();
+  // The event type is known from the legacy EventsType table
+  ASSERT_TRUE(_database->add_event_in_db("click", make_event({{"item", 3}, {"name", "c"}})));
+
+  auto events = read_events("click");
+  // The corrupted legacy row is skipped
+  ASSERT_EQ(events.size(), 3);
+  EXPECT_EQ(events[0].timestamp, 1700000000);
+  EXPECT_EQ(events[0].fields["item"]->get_int64(), 1);
+  EXPECT_EQ(events[0].fields["price"]->get_double(), 2.5);
+  EXPECT_EQ(events[0].fields["name"]->get_string(), "a");
+  EXPECT_EQ(events[1].timestamp, 1700000010);
+  EXPECT_EQ(events[1].fields["item"]->get_int64(), 2);
+  EXPECT_EQ(events[2].fields["item"]->get_int64(), 3);
+  EXPECT_EQ(events[2].fields["name"]->get_string(), "c");
+  EXPECT_EQ(_database->get_count_from_eventsTable("click"), 4);
+
+  ASSERT_TRUE(_database->delete_old_rows_from_table_in_db("click", "count", 2));
+  events = read_events("click");
+  ASSERT_EQ(events.size(), 2);
+  EXPECT_EQ(events[0].fields["item"]->get_int64(), 2);
+  EXPECT_EQ(events[1].fields["item"]->get_int64(), 3);
+}
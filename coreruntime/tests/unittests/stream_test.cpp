@@ -8,9 +8,11 @@
 
 #include <cstdio>
 #include <functional>
+#include <thread>
 
 #include "char_stream.hpp"
 #include "json_stream.hpp"
+#include "token_queue.hpp"
 
 TEST(StreamTest, JSONStringStreamTest) {
   auto charStream = CharStream::construct();
@@ -115,3 +117,43 @@ TEST(StreamTest, JSONArrayStreamTest) {
     "w": "x",
 }, ])");
 }
+
+TEST(StreamTest, TokenQueueBatchesTokens) {
+  TokenQueue queue(8);
+  std::thread producer([&] {
+    for (int i = 0; i < 100; i++) {
+      ASSERT_TRUE(queue.push(std::to_string(i % 10), i));
+    }
+    queue.close();
+  });
+
+  std::string text;
+  std::vector<int32_t> tokenIds;
+  bool finished = false;
+  while (!finished) {
+    queue.wait_for_output();
+    finished = queue.consume([&](std::string_view batch, const std::vector<int32_t>& ids) {
+      ASSERT_EQ(batch.size(), ids.size());
+      text.append(batch);
+      tokenIds.insert(tokenIds.end(), ids.begin(), ids.end());
+    });
+  }
+  producer.join();
+
+  ASSERT_EQ(tokenIds.size(), 100);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(tokenIds[i], i);
+    ASSERT_EQ(text[i], '0' + i % 10);
+  }
+  ASSERT_FALSE(queue.push("late"));
+}
+
+TEST(StreamTest, TokenQueueDetachUnblocksProducer) {
+  TokenQueue queue(4);
+  ASSERT_TRUE(queue.push("full"));
+  std::thread producer([&] { ASSERT_FALSE(queue.push("blocked")); });
+  queue.detach();
+  producer.join();
+  // Waiting returns right away once detached
+  queue.wait_for_output();
+}
@@ -188,6 +188,61 @@ bool TestsUtil::reset_expectations() {
   return true;
 }
 
+static std::string base64_encode(const std::string& data) {
+  static const char alphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string encoded;
+  encoded.reserve((data.size() + 2) / 3 * 4);
+  for (size_t i = 0; i < data.size(); i += 3) {
+    uint32_t chunk = (uint8_t)data[i] << 16;
+    if (i + 1 < data.size()) chunk |= (uint8_t)data[i + 1] << 8;
+    if (i + 2 < data.size()) chunk |= (uint8_t)data[i + 2];
+    encoded += alphabet[(chunk >> 18) & 63];
+    encoded += alphabet[(chunk >> 12) & 63];
+    encoded += i + 1 < data.size() ? alphabet[(chunk >> 6) & 63] : '=';
+    encoded += i + 2 < data.size() ? alphabet[chunk & 63] : '=';
+  }
+  return encoded;
+}
+
+bool TestsUtil::set_file_expectation(const std::string& path, const std::string& content,
+                                     const std::string& etag, bool ignoreRange, int truncateAt) {
+  nlohmann::json requestBody;
+  requestBody["path"] = path.substr(_mockServerHost.size());  // Remove http://localhost:8080
+  requestBody["content"] = base64_encode(content);
+  requestBody["etag"] = etag;
+  requestBody["ignore_range"] = ignoreRange;
+  if (truncateAt >= 0) {
+    requestBody["truncate_at"] = truncateAt;
+  }
+  auto bodyString = requestBody.dump();
+  std::string expMethod = "POST";
+  std::string header = "[{\"Content-Type\": \"application/json\"}]";
+  auto response = send_request(bodyString.c_str(), header.c_str(), _fileExpectationURL.c_str(),
+                               expMethod.c_str(), -1);
+  if (response.statusCode != 201) {
+    auto responseString = std::string(response.body, response.bodyLength);
+    THROW("Failed to set file expectation with status code %d, message, %s",
+          response.statusCode, responseString.c_str());
+  }
+  return true;
+}
+
+nlohmann::json TestsUtil::get_file_requests(const std::string& path) {
+  std::string bodyString = nlohmann::json::object().dump();
+  std::string headersString = nlohmann::json::array().dump();
+  std::string apiMethod = "GET";
+  std::string url = _fileExpectationURL + "?path=" + path.substr(_mockServerHost.size());
+  auto response = send_request(bodyString.c_str(), headersString.c_str(), url.c_str(),
+                               apiMethod.c_str(), -1);
+  std::string responseString(response.body, response.bodyLength);
+  if (response.statusCode != 200) {
+    THROW("Failed to get requests of file from mock server with status code %d, message, %s",
+          response.statusCode, responseString.c_str());
+  }
+  return nlohmann::json::parse(responseString)["requests"];
+}
+
 void TestsUtil::assert_deployment(const std::string& functionName, int expectedValue) {
   auto map = std::make_shared<MapDataVariable>();
   std::vector<int64_t> tensorShape = {1};
@@ -19,6 +19,7 @@ class TestsUtil final {
   static inline const std::string _setExpectationURL = _mockServerHost + "/mocker/expectation";
   static inline const std::string _resetExpectationURL = _mockServerHost + "/mocker/reset";
   static inline const std::string _historicalAPIsURL = _mockServerHost + "/mocker/history";
+  static inline const std::string _fileExpectationURL = _mockServerHost + "/mocker/file";
 
   TestsUtil() = delete;
   static HistoricalAPIs get_historical_api_calls();
@@ -51,6 +52,14 @@ class TestsUtil final {
       const nlohmann::json& expected_headers = nlohmann::json::object(),
       const nlohmann::json& expected_response_body = nlohmann::json::object());
   static bool reset_expectations();
+  // Serves content at path with range requests, truncateAt drops the first connection at that
+  // offset of the file
+  static bool set_file_expectation(const std::string& path, const std::string& content,
+                                   const std::string& etag, bool ignoreRange = false,
+                                   int truncateAt = -1);
+  // Range, If-Range and status code of every request made for a file set with
+  // set_file_expectation
+  static nlohmann::json get_file_requests(const std::string& path);
 
   // Assertions functions
   static void assert_deployment(const std::string& functionName, int expectedValue);
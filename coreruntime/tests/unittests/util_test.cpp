@@ -6,7 +6,17 @@
 
 #include <gtest/gtest.h>
 
+#include "config_manager.hpp"
 #include "core_utils/atomic_ptr.hpp"
+#include "event_record.hpp"
+#include "file_store.hpp"
+#include "group_key.hpp"
+#include "lru_cache.hpp"
+#include "mpsc_ring_buffer.hpp"
+#include "prefix_context_cache.hpp"
+#include "single_variable.hpp"
+#include "thread_pool.hpp"
+#include "timer_wheel.hpp"
 
 class UtilTest : public ::testing::Test {
  protected:
@@ -37,4 +47,356 @@ TEST(UtilTest, AtomicPtrIsNullable) {
   ne::AtomicPtr<A> atomicPtr;
   ne::NullableAtomicPtr<A>& nullablePtr = atomicPtr;
   ASSERT_EQ(nullablePtr.load()->num, 2);
-}
\ No newline at end of file
+}
+
+TEST(UtilTest, GroupKeyIndexAssignsDenseIds) {
+  GroupKeyIndex index(2);
+  ASSERT_EQ(index.get_or_insert({"user1", "US"}), 0);
+  ASSERT_EQ(index.get_or_insert({"user2", "US"}), 1);
+  ASSERT_EQ(index.get_or_insert({"user1", "US"}), 0);
+  // Same values in a different order form a different group
+  ASSERT_EQ(index.get_or_insert({"US", "user1"}), 2);
+  ASSERT_EQ(index.find({"user2", "US"}), 1);
+  ASSERT_EQ(index.find({"user2", "IN"}), GroupKeyIndex::kNotFound);
+  ASSERT_EQ(index.find({"user2"}), GroupKeyIndex::kNotFound);
+}
+
+TEST(UtilTest, GroupKeyIndexBatchLookupAfterGrowth) {
+  GroupKeyIndex index(1);
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_EQ(index.get_or_insert({std::to_string(i)}), i);
+  }
+  std::vector<std::vector<std::string>> groups;
+  for (int i = 999; i >= -10; i--) {
+    groups.push_back({std::to_string(i)});
+  }
+  std::vector<int> groupIds;
+  index.find_batch(groups, groupIds);
+  ASSERT_EQ(groupIds.size(), groups.size());
+  for (int i = 0; i < groups.size(); i++) {
+    int expected = 999 - i;
+    ASSERT_EQ(groupIds[i], expected >= 0 ? expected : GroupKeyIndex::kNotFound);
+  }
+}
+
+TEST(UtilTest, EventRecordRoundTrip) {
+  EventRecordEncoder encoder;
+  EventRecordDecoder decoder;
+  std::map<std::string, OpReturnType> event = {
+      {"itemId", std::make_shared<SingleVariable<int64_t>>(-42)},
+      {"price", std::make_shared<SingleVariable<double>>(10.5)},
+      {"category", std::make_shared<SingleVariable<std::string>>("shoes")},
+      {"liked", std::make_shared<SingleVariable<bool>>(true)}};
+
+  std::vector<std::string> records = {encoder.encode(1700000000, event),
+                                      encoder.encode(1700000005, event)};
+  encoder.reset();
+  records.push_back(encoder.encode(1700000003, event));
+
+  std::vector<int64_t> expectedTimestamps = {1700000000, 1700000005, 1700000003};
+  for (int i = 0; i < records.size(); i++) {
+    int64_t timestamp;
+    std::map<std::string, OpReturnType> decoded;
+    ASSERT_TRUE(decoder.decode(records[i].data(), records[i].size(), timestamp, decoded));
+    ASSERT_EQ(timestamp, expectedTimestamps[i]);
+    ASSERT_EQ(decoded.size(), event.size());
+    ASSERT_EQ(decoded["itemId"]->get_int64(), -42);
+    ASSERT_EQ(decoded["price"]->get_double(), 10.5);
+    ASSERT_EQ(decoded["category"]->get_string(), "shoes");
+    ASSERT_TRUE(decoded["liked"]->get_bool());
+  }
+  // Column names are only written in the first record after a reset
+  ASSERT_LT(records[1].size(), records[0].size());
+
+  int64_t timestamp;
+  std::map<std::string, OpReturnType> decoded;
+  ASSERT_FALSE(decoder.decode(records[0].data(), records[0].size() - 1, timestamp, decoded));
+}
+
+TEST(UtilTest, EventRecordWithCorruptedJsonIsSkipped) {
+  EventRecordEncoder encoder;
+  std::map<std::string, OpReturnType> event = {
+      {"items", DataVariable::get_SingleVariableFrom_JSON(nlohmann::json::parse("[1,2]"))}};
+  std::string record = encoder.encode(1700000000, event);
+  auto jsonStart = record.find("[1,2]");
+  ASSERT_NE(jsonStart, std::string::npos);
+  record[jsonStart] = '{';
+
+  EventRecordDecoder decoder;
+  int64_t timestamp;
+  std::map<std::string, OpReturnType> decoded;
+  ASSERT_FALSE(decoder.decode(record.data(), record.size(), timestamp, decoded));
+}
+
+TEST(UtilTest, EntryReaderSplitsChunkedRecords) {
+  std::vector<std::string> records = {"first", "", std::string(300, 'x'), "last"};
+  std::string file = recordformat::Magic;
+  for (const auto& record : records) {
+    recordformat::append_varint(file, record.size());
+    file += record;
+  }
+  size_t completeSize = file.size();
+  // A record cut short by a crash while writing
+  file += std::string("\x05" "ab");
+
+  for (size_t chunkSize : {1, 3, 64, 4096}) {
+    std::vector<std::string> readRecords;
+    recordformat::EntryReader reader(
+        [&](const char* record, size_t size) { readRecords.emplace_back(record, size); },
+        [](const std::string&) { FAIL() << "binary records read as text"; });
+    for (size_t i = 0; i < file.size(); i += chunkSize) {
+      reader.feed(file.data() + i, std::min(chunkSize, file.size() - i));
+    }
+    reader.finish();
+    ASSERT_FALSE(reader.is_text());
+    ASSERT_EQ(readRecords, records);
+    ASSERT_EQ(reader.valid_size(), completeSize);
+    ASSERT_EQ(reader.size(), file.size());
+  }
+}
+
+TEST(UtilTest, EntryReaderSplitsChunkedTextLines) {
+  std::string file = "first\nsecond\nlast";
+  for (size_t chunkSize : {1, 4, 4096}) {
+    std::vector<std::string> lines;
+    recordformat::EntryReader reader(
+        [](const char*, size_t) { FAIL() << "text read as binary records"; },
+        [&](const std::string& line) { lines.push_back(line); });
+    for (size_t i = 0; i < file.size(); i += chunkSize) {
+      reader.feed(file.data() + i, std::min(chunkSize, file.size() - i));
+    }
+    reader.finish();
+    ASSERT_TRUE(reader.is_text());
+    ASSERT_EQ(lines, std::vector<std::string>({"first", "second", "last"}));
+  }
+}
+
+TEST(UtilTest, ThreadPoolParallelForCoversRangeOnce) {
+  ThreadPool pool(3);
+  for (int n : {0, 1, 7, 10000}) {
+    std::vector<std::atomic<int>> visits(n);
+    pool.parallel_for(0, n, [&](int begin, int end) {
+      for (int i = begin; i < end; i++) visits[i]++;
+    });
+    for (int i = 0; i < n; i++) {
+      ASSERT_EQ(visits[i], 1);
+    }
+  }
+  ASSERT_THROW(pool.parallel_for(0, 100,
+                                 [](int begin, int end) {
+                                   if (begin <= 50 && 50 < end) throw std::runtime_error("failed");
+                                 }),
+               std::runtime_error);
+}
+
+TEST(UtilTest, TimerWheelExpiresItemsAfterDeadline) {
+  ne::TimerWheel<int> wheel(10, 4);
+  std::vector<int> expired;
+  wheel.schedule(1, 15);
+  wheel.schedule(2, 25);
+  // More than a turn of the wheel away
+  wheel.schedule(3, 95);
+  // Deadlines are rounded up to the tick granularity
+  wheel.expire(26, expired);
+  ASSERT_EQ(expired, std::vector<int>({1}));
+  wheel.expire(30, expired);
+  ASSERT_EQ(expired, std::vector<int>({1, 2}));
+  // Deadline already passed goes to the next tick
+  wheel.schedule(4, 5);
+  wheel.expire(60, expired);
+  ASSERT_EQ(expired, std::vector<int>({1, 2, 4}));
+  ASSERT_EQ(wheel.size(), 1);
+  wheel.expire(100, expired);
+  ASSERT_EQ(expired, std::vector<int>({1, 2, 4, 3}));
+  ASSERT_TRUE(wheel.empty());
+}
+
+TEST(UtilTest, PrefixContextCacheReusesLongestPrefix) {
+  PrefixContextCache<int> cache(2);
+  auto [first, prefix] = cache.acquire({1, 2, 3});
+  ASSERT_EQ(prefix, 0);
+  first->context = 1;
+  first->tokens = {1, 2, 3};
+  // Nothing shared, a second context is added
+  auto [second, secondPrefix] = cache.acquire({7, 8});
+  ASSERT_EQ(secondPrefix, 0);
+  ASSERT_NE(second, first);
+  second->context = 2;
+  second->tokens = {7, 8};
+
+  auto [longest, longestPrefix] = cache.acquire({1, 2, 4, 5});
+  ASSERT_EQ(longest, first);
+  ASSERT_EQ(longestPrefix, 2);
+  longest->tokens = {1, 2, 4, 5};
+
+  // Pool is full, the least recently used context is recycled
+  auto [recycled, recycledPrefix] = cache.acquire({9});
+  ASSERT_EQ(recycled, second);
+  ASSERT_EQ(recycledPrefix, 0);
+  ASSERT_EQ(recycled->context, 2);
+  ASSERT_EQ(cache.size(), 2);
+}
+
+TEST(UtilTest, LRUCacheEvictsLeastRecentlyUsed) {
+  LRUCache<std::string, int> cache(2);
+  cache.put("a", 1);
+  cache.put("b", 2);
+  ASSERT_EQ(*cache.get("a"), 1);
+
+  // "b" was used least recently
+  cache.put("c", 3);
+  ASSERT_EQ(cache.get("b"), nullptr);
+  ASSERT_EQ(*cache.get("a"), 1);
+  ASSERT_EQ(*cache.get("c"), 3);
+
+  cache.put("a", 4);
+  cache.put("d", 5);
+  ASSERT_EQ(*cache.get("a"), 4);
+  ASSERT_EQ(cache.get("c"), nullptr);
+  ASSERT_EQ(cache.size(), 2);
+}
+
+TEST(UtilTest, MPSCRingBufferKeepsOrderOfEachProducer) {
+  MPSCRingBuffer<std::pair<int, int>> queue(3);
+  ASSERT_EQ(queue.capacity(), 4);
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(queue.try_push({0, i}));
+  }
+  // Full, pushes fail instead of waiting
+  ASSERT_FALSE(queue.try_push({0, 4}));
+  std::pair<int, int> value;
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(queue.try_pop(value));
+    ASSERT_EQ(value.second, i);
+  }
+  ASSERT_FALSE(queue.try_pop(value));
+
+  MPSCRingBuffer<std::pair<int, int>> sharedQueue(256);
+  constexpr int numProducers = 4;
+  constexpr int numValues = 20000;
+  std::vector<std::thread> producers;
+  for (int producer = 0; producer < numProducers; producer++) {
+    producers.emplace_back([&sharedQueue, producer] {
+      for (int i = 0; i < numValues; i++) {
+        while (!sharedQueue.try_push({producer, i})) std::this_thread::yield();
+      }
+    });
+  }
+  std::vector<int> next(numProducers, 0);
+  for (int popped = 0; popped < numProducers * numValues;) {
+    if (!sharedQueue.try_pop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(value.second, next[value.first]++);
+    popped++;
+  }
+  for (auto& producer : producers) producer.join();
+  ASSERT_EQ(sharedQueue.size(), 0);
+}
+
+TEST(UtilTest, FileStoreGroupCommitsAndCompressesRotatedFiles) {
+  std::string directory = "./file_store_test";
+  util::delete_folder_recursively(directory);
+  LogConfig config;
+  config.binaryRecords = true;
+  config.maxLogFileSizeKB = 1;
+  std::vector<std::string> written;
+  {
+    FileStore store(directory, config);
+    struct stat st;
+    store.write_record("first");
+    written.push_back("first");
+    // The record is buffered until the next flush
+    ASSERT_EQ(stat((directory + "/" FIRST_FILE_NAME).c_str(), &st), 0);
+    ASSERT_EQ(st.st_size, recordformat::Magic.size());
+    store.flush();
+    ASSERT_EQ(stat((directory + "/" FIRST_FILE_NAME).c_str(), &st), 0);
+    ASSERT_EQ(st.st_size, recordformat::Magic.size() + 1 + written[0].size());
+
+    int rotations = 0;
+    for (int i = 0; i < 40; i++) {
+      written.push_back(std::string(100, 'a' + i % 26));
+      rotations += store.write_record(written.back());
+    }
+    ASSERT_GE(rotations, 3);
+    RotatedFileCompressor::instance().wait_idle();
+
+    // Rotated files are compressed, the current file is not
+    int compressedFiles = 0;
+    DIR* dir = opendir(directory.c_str());
+    while (struct dirent* entry = readdir(dir)) {
+      std::string fileName = entry->d_name;
+      if (fileName == "." || fileName == ".." || fileName == FIRST_FILE_NAME) continue;
+      ASSERT_NE(fileName[0], '.');
+      std::ifstream file(directory + "/" + fileName, std::ios::binary);
+      unsigned char magic[2] = {0, 0};
+      file.read(reinterpret_cast<char*>(magic), 2);
+      ASSERT_EQ(magic[0], 0x1f);
+      ASSERT_EQ(magic[1], 0x8b);
+      compressedFiles++;
+    }
+    closedir(dir);
+    ASSERT_EQ(compressedFiles, rotations);
+
+    std::vector<std::string> read;
+    store.read_records([&](const char* record, size_t size) { read.emplace_back(record, size); },
+                       [](nlohmann::json&&) {});
+    ASSERT_EQ(read, written);
+  }
+  util::delete_folder_recursively(directory);
+}
+
+TEST(UtilTest, FileStoreFlushesEveryRecordWhenConfigured) {
+  std::string directory = "./file_store_flush_test";
+  util::delete_folder_recursively(directory);
+  auto config = Config(nlohmann::json{{"online", false}, {"flushEveryRecord", true}});
+  {
+    Store<StoreType::METRICS> store;
+    store.init(directory, config.flushEveryRecord);
+    store.write_record("click", "first");
+    // On disk without a flush
+    struct stat st;
+    ASSERT_EQ(stat((directory + "/click/" FIRST_FILE_NAME).c_str(), &st), 0);
+    ASSERT_EQ(st.st_size, recordformat::Magic.size() + 1 + strlen("first"));
+    store.write_record("click", "second");
+    ASSERT_EQ(stat((directory + "/click/" FIRST_FILE_NAME).c_str(), &st), 0);
+    ASSERT_EQ(st.st_size, recordformat::Magic.size() + 2 + strlen("first") + strlen("second"));
+  }
+  util::delete_folder_recursively(directory);
+}
+
+TEST(UtilTest, FileStoreFlushesBufferedRecordsAfterDelay) {
+  std::string directory = "./file_store_delay_test";
+  util::delete_folder_recursively(directory);
+  LogConfig config;
+  config.binaryRecords = true;
+  {
+    FileStore store(directory, config);
+    std::string filePath = directory + "/" FIRST_FILE_NAME;
+    struct stat st;
+    store.write_record("first");
+    store.write_record("second");
+    ASSERT_EQ(stat(filePath.c_str(), &st), 0);
+    ASSERT_EQ(st.st_size, recordformat::Magic.size());
+
+    // Written out by FlushTimer without another write or flush
+    auto expectedSize = recordformat::Magic.size() + 2 + strlen("first") + strlen("second");
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::microseconds(loggerconstants::MaxRecordFlushDelayMicros) +
+                    std::chrono::seconds(2);
+    while (stat(filePath.c_str(), &st) == 0 && st.st_size != expectedSize &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(st.st_size, expectedSize);
+
+    // A record written after the delayed flush schedules another one
+    store.write_record("third");
+    std::vector<std::string> read;
+    store.read_records([&](const char* record, size_t size) { read.emplace_back(record, size); },
+                       [](nlohmann::json&&) {});
+    ASSERT_EQ(read, std::vector<std::string>({"first", "second", "third"}));
+  }
+  util::delete_folder_recursively(directory);
+}
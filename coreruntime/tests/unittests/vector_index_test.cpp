@@ -0,0 +1,171 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <set>
+
+#include "nlohmann/json.hpp"
+#include "vector_index.hpp"
+
+namespace {
+
+std::vector<std::vector<float>> random_vectors(int count, int dim, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<float> distribution;
+  std::vector<std::vector<float>> vectors(count, std::vector<float>(dim));
+  for (auto& vector : vectors) {
+    for (auto& value : vector) {
+      value = distribution(rng);
+    }
+  }
+  return vectors;
+}
+
+std::unique_ptr<VectorIndex> create_index(const nlohmann::json& config,
+                                          const std::vector<std::vector<float>>& vectors) {
+  auto index = VectorIndex::create(config.get<VectorIndexConfig>());
+  for (int i = 0; i < vectors.size(); i++) {
+    index->add(i, vectors[i].data());
+  }
+  return index;
+}
+
+std::vector<int64_t> ids(const std::vector<VectorSearchResult>& results) {
+  std::vector<int64_t> resultIds;
+  for (const auto& result : results) {
+    resultIds.push_back(result.id);
+  }
+  return resultIds;
+}
+
+}  // namespace
+
+TEST(VectorIndexTest, FlatSearchIsExact) {
+  std::vector<std::vector<float>> vectors = {{1, 0, 0}, {0, 1.5, 0}, {1, 1, 0}, {0, 0, -3}};
+  auto cosine = create_index({{"dim", 3}}, vectors);
+  auto dot = create_index({{"dim", 3}, {"metric", "dot"}}, vectors);
+
+  float query[] = {1, 0.5, 0};
+  auto results = cosine->search(query, 3);
+  ASSERT_EQ(ids(results), std::vector<int64_t>({2, 0, 1}));
+  ASSERT_NEAR(results[0].score, 1.5 / std::sqrt(2 * 1.25), 1e-5);
+  ASSERT_EQ(ids(dot->search(query, 2)), std::vector<int64_t>({2, 0}));
+  ASSERT_EQ(dot->search(query, 10).size(), 4);
+
+  // Replacing keeps a single vector per id, removing moves the last vector into the hole
+  float replacement[] = {0, 0, 1};
+  dot->add(3, replacement);
+  ASSERT_EQ(dot->size(), 4);
+  ASSERT_TRUE(dot->remove(0));
+  ASSERT_FALSE(dot->remove(0));
+  ASSERT_EQ(ids(dot->search(replacement, 1)), std::vector<int64_t>({3}));
+  ASSERT_EQ(ids(dot->search(query, 10)), std::vector<int64_t>({2, 1, 3}));
+}
+
+TEST(VectorIndexTest, Int8MatchesFp32Ranking) {
+  auto vectors = random_vectors(500, 48, 1);
+  auto fp32 = create_index({{"dim", 48}}, vectors);
+  auto int8 = create_index({{"dim", 48}, {"quantization", "int8"}}, vectors);
+  auto queries = random_vectors(20, 48, 2);
+  for (const auto& query : queries) {
+    auto expected = fp32->search(query.data(), 1);
+    auto results = int8->search(query.data(), 5);
+    auto resultIds = ids(results);
+    ASSERT_NE(std::find(resultIds.begin(), resultIds.end(), expected[0].id), resultIds.end());
+    ASSERT_NEAR(results[0].score, expected[0].score, 0.02);
+  }
+}
+
+TEST(VectorIndexTest, HNSWRecallAndRemove) {
+  auto vectors = random_vectors(2000, 32, 3);
+  auto flat = create_index({{"dim", 32}}, vectors);
+  auto hnsw = create_index({{"dim", 32}, {"type", "hnsw"}}, vectors);
+  auto queries = random_vectors(50, 32, 4);
+
+  int found = 0;
+  for (const auto& query : queries) {
+    auto expected = ids(flat->search(query.data(), 10));
+    auto results = ids(hnsw->search(query.data(), 10));
+    std::set<int64_t> expectedSet(expected.begin(), expected.end());
+    for (auto id : results) {
+      found += expectedSet.count(id);
+    }
+  }
+  ASSERT_GE(found, 0.95 * queries.size() * 10);
+
+  // Removing most vectors rebuilds the graph from the ones left
+  for (int i = 0; i < 1500; i++) {
+    ASSERT_TRUE(hnsw->remove(i));
+  }
+  ASSERT_EQ(hnsw->size(), 500);
+  for (const auto& result : hnsw->search(queries[0].data(), 50)) {
+    ASSERT_GE(result.id, 1500);
+  }
+  ASSERT_EQ(hnsw->search(vectors[1700].data(), 1)[0].id, 1700);
+}
+
+TEST(VectorIndexTest, HNSWReturnsKResultsAroundTombstones) {
+  auto vectors = random_vectors(2000, 32, 6);
+  auto flat = create_index({{"dim", 32}}, vectors);
+  auto hnsw = create_index({{"dim", 32}, {"type", "hnsw"}}, vectors);
+  auto queries = random_vectors(20, 32, 7);
+
+  // Removes the nearest vectors of every query, leaving tombstones where the searches start. Less
+  // than half of the vectors are removed, so that the graph is not rebuilt.
+  for (const auto& query : queries) {
+    for (auto id : ids(flat->search(query.data(), 40))) {
+      ASSERT_TRUE(flat->remove(id));
+      ASSERT_TRUE(hnsw->remove(id));
+    }
+  }
+  ASSERT_EQ(hnsw->size(), 1200);
+
+  int found = 0;
+  for (const auto& query : queries) {
+    auto expected = ids(flat->search(query.data(), 10));
+    auto results = ids(hnsw->search(query.data(), 10));
+    ASSERT_EQ(results.size(), 10);
+    std::set<int64_t> expectedSet(expected.begin(), expected.end());
+    for (auto id : results) {
+      found += expectedSet.count(id);
+    }
+  }
+  ASSERT_GE(found, 0.9 * queries.size() * 10);
+  // As many results as live vectors when k is larger
+  ASSERT_EQ(hnsw->search(queries[0].data(), 1500).size(), 1200);
+}
+
+TEST(VectorIndexTest, SaveAndLoadMappedFile) {
+  auto vectors = random_vectors(300, 20, 5);
+  auto queries = random_vectors(5, 20, 6);
+  std::string filePath = "./vector_index_test.bin";
+  for (const char* type : {"flat", "hnsw"}) {
+    auto index = create_index({{"dim", 20}, {"type", type}, {"quantization", "int8"}}, vectors);
+    index->remove(7);
+    index->save(filePath);
+
+    auto loaded = VectorIndex::load(filePath);
+    ASSERT_EQ(loaded->size(), 299);
+    ASSERT_EQ(loaded->config().type, index->config().type);
+    for (const auto& query : queries) {
+      ASSERT_EQ(ids(loaded->search(query.data(), 5)), ids(index->search(query.data(), 5)));
+    }
+
+    // Modifying a loaded index copies the mapped vectors
+    loaded->add(7, vectors[7].data());
+    ASSERT_EQ(loaded->search(vectors[7].data(), 1)[0].id, 7);
+  }
+
+  FILE* file = fopen(filePath.c_str(), "r+");
+  fputs("XXXX", file);
+  fclose(file);
+  ASSERT_THROW(VectorIndex::load(filePath), std::runtime_error);
+  std::remove(filePath.c_str());
+}
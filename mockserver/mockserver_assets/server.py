@@ -2,13 +2,15 @@
 #
 # SPDX-License-Identifier: Apache-2.0
 
-from flask import Flask, request, jsonify, make_response
+from flask import Flask, Response, request, jsonify, make_response
 import urllib3
 from threading import Lock
 import requests
 import yaml
 import argparse
+import base64
 import os
+import socket
 from time import sleep
 from urllib.parse import urlparse, urlunparse
 import json
@@ -35,6 +37,9 @@ mock_lock = Lock()
 # History of API call
 historical_api_calls = []
 
+# Files served with range requests, to test resumable downloads
+mock_files = {}
+
 # Endpoint to set mock responses
 @app.route('/mocker/expectation', methods=['POST'])
 def set_mock_response():
@@ -69,6 +74,71 @@ def delete_mock_response():
         else:
             return jsonify({"error": "Mock response not found."}), 404
 
+# Endpoint to serve a file with range requests
+@app.route('/mocker/file', methods=['POST'])
+def set_mock_file():
+    data = request.json
+    if "path" not in data or "content" not in data:
+        return jsonify({"error": "Missing required fields 'path' and 'content' in request body."}), 400
+
+    path = data["path"].split("?")[0]
+    with mock_lock:
+        mock_files[path] = {
+            "content": base64.b64decode(data["content"]),  # base64 encoded bytes of the file
+            "etag": data.get("etag", None),
+            "ignore_range": data.get("ignore_range", False),  # Always send the whole file with 200
+            "truncate_at": data.get("truncate_at", None),  # Drop the connection at this offset, once
+            "requests": []
+        }
+
+    return jsonify({"message": "Mock file set successfully."}), 201
+
+# Endpoint to fetch the range requests made for a file
+@app.route('/mocker/file', methods=['GET'])
+def list_mock_file_requests():
+    path = request.args.get("path", "").split("?")[0]
+    with mock_lock:
+        if path not in mock_files:
+            return jsonify({"error": "Mock file not found."}), 404
+        return jsonify({"requests": mock_files[path]["requests"]}), 200
+
+def serve_mock_file(mock):
+    content = mock["content"]
+    start = 0
+    status_code = 200
+    range_header = request.headers.get("Range")
+    if_range = request.headers.get("If-Range")
+    use_range = range_header is not None and not mock["ignore_range"] and \
+        (if_range is None or if_range == mock["etag"])
+    if use_range:
+        start = int(range_header.split("=")[1].split("-")[0])
+        status_code = 416 if start >= len(content) else 206
+    mock["requests"].append({"range": range_header, "if_range": if_range, "status_code": status_code})
+
+    headers = {}
+    if mock["etag"]:
+        headers["ETag"] = mock["etag"]
+    if status_code == 416:
+        headers["Content-Range"] = f"bytes */{len(content)}"
+        return Response(b"", status_code, headers)
+    if status_code == 206:
+        headers["Content-Range"] = f"bytes {start}-{len(content) - 1}/{len(content)}"
+    headers["Content-Length"] = str(len(content) - start)
+
+    truncate_at = mock["truncate_at"]
+    mock["truncate_at"] = None
+    if truncate_at is None or not start < truncate_at < len(content):
+        return Response(content[start:], status_code, headers)
+
+    # Sends the first bytes and closes the connection, the client gets less than Content-Length
+    sock = request.environ.get("werkzeug.socket")
+    def interrupted_body():
+        yield content[start:truncate_at]
+        if sock is not None:
+            sock.shutdown(socket.SHUT_RDWR)
+        raise ConnectionAbortedError("Download interrupted by mock")
+    return Response(interrupted_body(), status_code, headers)
+
 # Endpoint to fetch all mock responses
 @app.route('/mocker/expectations', methods=['GET'])
 def list_mock_responses():
@@ -86,6 +156,7 @@ def reset_mock_responses():
     with mock_lock:
         mock_responses.clear()
         historical_api_calls.clear() # Clear the history on mock server reset
+        mock_files.clear()
         clear_file(CONFIG["external_logger_events_file"]) # Clear events file, only if it is present
         clear_file(CONFIG["external_logger_scriptlogs_file"]) # Clear scriptlogs file, only if present
         clear_file(CONFIG["external_logger_unauthenticated_file"]) # Clear unauthenticated external events/script logs file, only if present
@@ -119,6 +190,11 @@ def list_history_api_calls():
 def proxy_request(path):
     full_path = f"/{path}".split("?")[0]
 
+    # Check for a matching mock file
+    with mock_lock:
+        if full_path in mock_files:
+            return serve_mock_file(mock_files[full_path])
+
     # Check for a matching mock response
     with mock_lock:
         mock = mock_responses.get(full_path)
@@ -0,0 +1,104 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Interpreter Test Script
+Exercises control flow, calls and error reporting so that the bytecode interpreter can be compared
+against the AST walker, and provides a loop heavy function for benchmarking script overhead.
+"""
+
+def fib(n):
+    if n < 2:
+        return n
+    return fib(n - 1) + fib(n - 2)
+
+
+class Counter:
+    def __init__(self):
+        self.count = 0
+
+    def add(self, value):
+        self.count = self.count + value
+        return self.count
+
+
+def control_flow(input):
+    evens = []
+    odds = 0
+    for i in range(20):
+        if i % 2 == 0:
+            evens.append(i)
+            continue
+        if i > 15:
+            break
+        odds = odds + i
+
+    total = 0
+    n = 0
+    while True:
+        n = n + 1
+        if n > 10:
+            break
+        total = total + n * n
+
+    pairs = {}
+    for key, value in [("a", 1), ("b", 2), ("c", 3)]:
+        pairs[key] = value * 10
+
+    counter = Counter()
+    for i in range(5):
+        counter.add(i)
+
+    nested = []
+    for i in range(3):
+        for j in range(3):
+            if j > i:
+                break
+            nested.append([i, j])
+
+    def find_first_negative(values):
+        for value in values:
+            try:
+                if value < 0:
+                    return value
+            except Exception as err:
+                print(err)
+        return None
+
+    return {
+        "evens": evens,
+        "odds": odds,
+        "total": total,
+        "pairs": pairs,
+        "count": counter.count,
+        "nested": nested,
+        "fib": fib(15),
+        "negative": -odds,
+        "bounded": 1 < odds and odds < 100,
+        "firstNegative": find_first_negative([3, 1, -4, -1]),
+    }
+
+
+def nested_error(input):
+    values = [1, 2, 3]
+    for i in range(3):
+        if i == 2:
+            values[i + 5]
+    return {}
+
+
+def loop_benchmark(input):
+    n = input["n"]
+    total = 0
+    squares = []
+    for i in range(n):
+        if i % 3 == 0:
+            total = total + i * 2
+        else:
+            total = total - 1
+        squares.append(i * i)
+    j = 0
+    while j < n:
+        j = j + 1
+    return {"total": total, "count": len(squares) + j}
@@ -0,0 +1,40 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Run Parallel Benchmark Script
+Runs small and large function bodies over a range with ConcurrentExecutor.run_parallel, used to
+benchmark the thread pool at different numbers of threads.
+"""
+
+from delitepy import nimblenet as nm
+
+executor = nm.ConcurrentExecutor()
+
+
+@concurrent
+def small_body(index, output):
+    output[index] = index * 2
+
+
+@concurrent
+def large_body(index, output):
+    total = 0
+    for i in range(200):
+        total = total + (index + i) % 7
+    output[index] = total
+
+
+def run_small(input):
+    n = input["n"]
+    output = nm.zeros([n], "int64")
+    executor.run_parallel(small_body, range(n), output)
+    return {"output": output}
+
+
+def run_large(input):
+    n = input["n"]
+    output = nm.zeros([n], "int64")
+    executor.run_parallel(large_body, range(n), output)
+    return {"output": output}
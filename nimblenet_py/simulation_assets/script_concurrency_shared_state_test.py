@@ -0,0 +1,34 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Script Concurrency Shared State Test Script
+Functions mutating a module level list and dict, used to check that run_method calls from multiple
+threads do not lose updates with scriptConcurrency enabled.
+"""
+
+items = []
+counts = {"calls": 0}
+pushed = []
+
+
+def add_items(input):
+    for i in range(input["n"]):
+        items.append(i)
+    counts["calls"] = counts["calls"] + 1
+    return {"calls": counts["calls"]}
+
+
+def get_counts(input):
+    return {"items": len(items), "calls": counts["calls"]}
+
+
+def push(input):
+    # Only modified through a member function
+    pushed.append(input["value"])
+    return {"value": pushed[len(pushed) - 1]}
+
+
+def get_pushed(input):
+    return {"pushed": len(pushed)}
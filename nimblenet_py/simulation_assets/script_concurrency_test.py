@@ -0,0 +1,27 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Script Concurrency Test Script
+Read mostly functions over module globals, used to check that run_method calls from multiple threads
+give the same results with scriptConcurrency enabled and to benchmark their throughput.
+"""
+
+weights = {"0": 1, "1": 2, "2": 3, "3": 4}
+offset = 7
+
+
+def score(values):
+    total = 0
+    for value in values:
+        total = total + value * weights[str(value % 4)]
+    return total
+
+
+def read_mostly(input):
+    n = input["n"]
+    total = 0
+    for i in range(n):
+        total = total + score([i, i + 1, i + 2]) + offset
+    return {"total": total}
@@ -0,0 +1,110 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Tensor Operations Test Script
+This script tests the element-wise tensor arithmetic implemented in the nimbleSDK C++ runtime
+"""
+
+from delitepy import nimblenet as nm
+
+def test_same_shape(input):
+    """Test element-wise operations between tensors of the same shape"""
+    a = nm.tensor([1.0, 2.0, 3.0, 4.0], "float")
+    b = nm.tensor([4.0, 3.0, 2.0, 1.0], "float")
+
+    return {
+        "add": a + b,
+        "sub": a - b,
+        "mult": a * b,
+        "div": a / b,
+        "pow": a ** b,
+        "mod": a % b
+    }
+
+def test_scalar_mixing(input):
+    """Test operations between a tensor and a single numeric variable"""
+    a = nm.tensor([1, 2, 3, 4], "int64")
+    f = nm.tensor([0.5, 1.5, 2.5], "double")
+
+    return {
+        "int_add": a + 10,
+        "int_rsub": 10 - a,
+        "int_mult_float": a * 0.5,
+        "double_mult": f * 2.0,
+        "double_rdiv": 3.0 / f
+    }
+
+def test_broadcasting(input):
+    """Test NumPy style broadcasting between tensors of different shapes"""
+    matrix = nm.tensor([1, 2, 3, 4, 5, 6], "int32").reshape([2, 3])
+    row = nm.tensor([10, 20, 30], "int32")
+    column = nm.tensor([100, 200], "int32").reshape([2, 1])
+
+    return {
+        "matrix_plus_row": matrix + row,
+        "matrix_plus_column": matrix + column,
+        "column_times_row": column * row
+    }
+
+def test_type_promotion(input):
+    """Test that mixing tensor data types promotes to the wider type"""
+    a = nm.tensor([1, 2, 3], "int32")
+    b = nm.tensor([0.5, 0.5, 0.5], "float")
+    return {"promoted": a + b}
+
+def test_empty_operands(input):
+    """Zero sized operands should give an empty tensor of the broadcast shape"""
+    empty = nm.tensor([], "float")
+    one = nm.tensor([2.0], "float")
+    return {
+        "empty_plus_scalar": empty + 1.0,
+        "empty_times_one": empty * one
+    }
+
+def test_division_by_zero(input):
+    """Division by a tensor containing zero should raise"""
+    a = nm.tensor([1, 2, 3], "int32")
+    b = nm.tensor([1, 0, 1], "int32")
+    return {"div": a / b}
+
+def test_shape_mismatch(input):
+    """Operands that cannot be broadcast should raise"""
+    a = nm.tensor([1, 2, 3], "int32")
+    b = nm.tensor([1, 2], "int32")
+    return {"add": a + b}
+
+def test_reductions(input):
+    """Test reductions over all elements and along an axis"""
+    matrix = nm.tensor([1.0, 5.0, 3.0, 4.0, 2.0, 6.0], "float").reshape([2, 3])
+
+    return {
+        "min_all": nm.min(matrix),
+        "max_all": nm.max(matrix),
+        "sum_all": nm.sum(matrix),
+        "mean_all": nm.mean(matrix),
+        "min_axis0": nm.min(matrix, 0),
+        "max_axis1": nm.max(matrix, 1),
+        "sum_axis0": nm.sum(matrix, 0),
+        "mean_axis_neg1": nm.mean(matrix, -1),
+        "argmax_all": nm.argmax(matrix),
+        "argmin_axis1": nm.argmin(matrix, 1),
+        "softmax": nm.softmax(matrix),
+        "log_softmax_axis0": nm.log_softmax(matrix, 0)
+    }
+
+def test_string_reductions(input):
+    """Test min and max over all elements of a string tensor"""
+    words = nm.tensor(["pear", "apple", "fig", "banana"], "string")
+    return {"min": nm.min(words), "max": nm.max(words)}
+
+def test_string_sum(input):
+    """Sum is not defined on strings and should raise"""
+    words = nm.tensor(["pear", "apple"], "string")
+    return {"sum": nm.sum(words)}
+
+def test_string_min_axis(input):
+    """Min along an axis is only supported on numeric tensors and should raise"""
+    words = nm.tensor(["pear", "apple", "fig", "banana"], "string").reshape([2, 2])
+    return {"min": nm.min(words, 0)}
@@ -0,0 +1,80 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Benchmark of ConcurrentExecutor.run_parallel over small and large function bodies, at 1 to N
+threads in the thread pool.
+
+Usage: python benchmark_run_parallel.py [--repeats R] [--max-threads T] [--n N]
+"""
+
+from deliteai import simulator
+import argparse
+import json
+import os
+import shutil
+import time
+
+ASSET = "../simulation_assets/run_parallel_benchmark.py"
+
+
+def measure_items_per_second(threads, method, repeats, n, scratchDir):
+    # The number of threads is fixed when the script creates its executor, so every measurement
+    # loads a copy of the script that sets it first
+    scriptPath = os.path.join(scratchDir, f"run_parallel_benchmark_{threads}.py")
+    with open(ASSET) as asset, open(scriptPath, "w") as script:
+        script.write(asset.read().replace(
+            "executor = nm.ConcurrentExecutor()",
+            f"nm.set_threadpool_threads({threads})\nexecutor = nm.ConcurrentExecutor()"))
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": scriptPath
+            }
+        }
+    ]
+    assert simulator.initialize(json.dumps({"online": False}), modules)
+    input = {"n": n}
+    # Warm up the workers before timing
+    simulator.run_method(method, input)
+
+    start = time.perf_counter()
+    for _ in range(repeats):
+        simulator.run_method(method, input)
+    elapsed = time.perf_counter() - start
+    simulator.cleanup()
+    return repeats * n / elapsed
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--repeats", type=int, default=20)
+    parser.add_argument("--max-threads", type=int, default=os.cpu_count())
+    parser.add_argument("--n", type=int, default=10000)
+    args = parser.parse_args()
+
+    scratchDir = "run_parallel_benchmark_scripts"
+    os.makedirs(scratchDir, exist_ok=True)
+    try:
+        print(f"{'threads':<10}{'small body (items/s)':>24}{'large body (items/s)':>24}"
+              f"{'scaling':>10}")
+        baseline = None
+        threads = 1
+        while threads <= args.max_threads:
+            small = measure_items_per_second(threads, "run_small", args.repeats, args.n,
+                                             scratchDir)
+            large = measure_items_per_second(threads, "run_large", args.repeats, args.n // 10,
+                                             scratchDir)
+            baseline = baseline or large
+            print(f"{threads:<10}{small:>24.1f}{large:>24.1f}{large / baseline:>9.2f}x")
+            threads *= 2
+    finally:
+        shutil.rmtree(scratchDir)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,64 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Benchmark of run_method throughput when called from multiple threads, with the task wide script
+lock and with scriptConcurrency enabled.
+
+Usage: python benchmark_script_concurrency.py [--calls N] [--max-threads T] [--n N]
+"""
+
+from deliteai import simulator
+from concurrent.futures import ThreadPoolExecutor
+import argparse
+import json
+import time
+
+
+def measure_throughput(scriptConcurrency, threads, calls, n):
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/script_concurrency_test.py"
+            }
+        }
+    ]
+    assert simulator.initialize(
+        json.dumps({"online": False, "scriptConcurrency": scriptConcurrency}), modules)
+    input = {"n": n}
+    # Warm up allocators and caches before timing
+    for _ in range(10):
+        simulator.run_method("read_mostly", input)
+
+    with ThreadPoolExecutor(max_workers=threads) as executor:
+        start = time.perf_counter()
+        list(executor.map(lambda _: simulator.run_method("read_mostly", input), range(calls)))
+        elapsed = time.perf_counter() - start
+    simulator.cleanup()
+    return calls / elapsed
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--calls", type=int, default=400)
+    parser.add_argument("--max-threads", type=int, default=8)
+    parser.add_argument("--n", type=int, default=500)
+    args = parser.parse_args()
+
+    print(f"{'threads':<10}{'script lock (calls/s)':>24}{'concurrent (calls/s)':>24}{'scaling':>10}")
+    baseline = None
+    threads = 1
+    while threads <= args.max_threads:
+        locked = measure_throughput(False, threads, args.calls, args.n)
+        concurrent = measure_throughput(True, threads, args.calls, args.n)
+        baseline = baseline or concurrent
+        print(f"{threads:<10}{locked:>24.1f}{concurrent:>24.1f}{concurrent / baseline:>9.2f}x")
+        threads *= 2
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,69 @@
+# SPDX-FileCopyrightText: (C) 2025 DeliteAI Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Micro-benchmark of script execution overhead, comparing the bytecode interpreter against the AST
+walker on the scripts in simulation_assets.
+
+Usage: python benchmark_script_interpreter.py [--iterations N]
+"""
+
+from deliteai import simulator
+import argparse
+import json
+import time
+
+import numpy as np
+
+# (script, method, input) triples, restricted to methods that do not need models or callbacks
+CASES = [
+    ("interpreter_test.py", "loop_benchmark", {"n": 2000}),
+    ("interpreter_test.py", "control_flow", {}),
+    ("workflow_script.py", "main", {"singleString": "singleString", "singleFloat": 10.10,
+                                    "boolTensor": np.full((3), True, dtype=bool)}),
+    ("list_ops_test.py", "test_slicing", {}),
+    ("list_ops_test.py", "test_comprehension", {}),
+    ("string_slicing_test.py", "test_ascii_string_slicing", {"s": "Hello, World!"}),
+    ("tensor_ops_test.py", "test_broadcasting", {}),
+]
+
+
+def time_method(script, method, input, bytecode, iterations):
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/" + script
+            }
+        }
+    ]
+    assert simulator.initialize(json.dumps({"online": False, "bytecodeInterpreter": bytecode}), modules)
+    # Warm up allocators and caches before timing
+    for _ in range(min(10, iterations)):
+        simulator.run_method(method, input)
+    start = time.perf_counter()
+    for _ in range(iterations):
+        simulator.run_method(method, input)
+    elapsed = time.perf_counter() - start
+    simulator.cleanup()
+    return elapsed / iterations * 1e6
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--iterations", type=int, default=200)
+    args = parser.parse_args()
+
+    print(f"{'script':<24}{'method':<28}{'ast (us)':>12}{'bytecode (us)':>16}{'speedup':>10}")
+    for script, method, input in CASES:
+        astTime = time_method(script, method, input, False, args.iterations)
+        bytecodeTime = time_method(script, method, input, True, args.iterations)
+        print(f"{script:<24}{method:<28}{astTime:>12.1f}{bytecodeTime:>16.1f}"
+              f"{astTime / bytecodeTime:>9.2f}x")
+
+
+if __name__ == "__main__":
+    main()
@@ -620,6 +620,217 @@ def test_python_modules():
 
     print("All python modules test passed!")
     
+def test_tensor_operations():
+    """Test element-wise tensor arithmetic implemented in the C++ runtime."""
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/tensor_ops_test.py"
+            }
+        }
+    ]
+
+    assert simulator.initialize('''{"online": false}''', modules)
+
+    a = np.array([1.0, 2.0, 3.0, 4.0], dtype=np.float32)
+    b = np.array([4.0, 3.0, 2.0, 1.0], dtype=np.float32)
+    same_shape = simulator.run_method("test_same_shape", {})
+    assert np.allclose(same_shape["add"], a + b)
+    assert np.allclose(same_shape["sub"], a - b)
+    assert np.allclose(same_shape["mult"], a * b)
+    assert np.allclose(same_shape["div"], a / b)
+    assert np.allclose(same_shape["pow"], a ** b)
+    assert np.allclose(same_shape["mod"], a % b)
+
+    scalar = simulator.run_method("test_scalar_mixing", {})
+    assert np.all(np.array(scalar["int_add"]) == np.array([11, 12, 13, 14]))
+    assert np.all(np.array(scalar["int_rsub"]) == np.array([9, 8, 7, 6]))
+    assert np.allclose(scalar["int_mult_float"], [0.5, 1.0, 1.5, 2.0])
+    assert np.allclose(scalar["double_mult"], [1.0, 3.0, 5.0])
+    assert np.allclose(scalar["double_rdiv"], [6.0, 2.0, 1.2])
+
+    broadcast = simulator.run_method("test_broadcasting", {})
+    assert np.all(np.array(broadcast["matrix_plus_row"]) == np.array([[11, 22, 33], [14, 25, 36]]))
+    assert np.all(np.array(broadcast["matrix_plus_column"]) == np.array([[101, 102, 103], [204, 205, 206]]))
+    assert np.all(np.array(broadcast["column_times_row"]) == np.array([[1000, 2000, 3000], [2000, 4000, 6000]]))
+
+    promotion = simulator.run_method("test_type_promotion", {})
+    assert np.allclose(promotion["promoted"], [1.5, 2.5, 3.5])
+
+    empty = simulator.run_method("test_empty_operands", {})
+    assert np.array(empty["empty_plus_scalar"]).shape == (0,)
+    assert np.array(empty["empty_times_one"]).shape == (0,)
+
+    with pytest.raises(RuntimeError, match="Division by zero"):
+        simulator.run_method("test_division_by_zero", {})
+
+    with pytest.raises(RuntimeError, match="could not be broadcast"):
+        simulator.run_method("test_shape_mismatch", {})
+
+def test_tensor_reductions():
+    """Test tensor reductions with and without axis implemented in the C++ runtime."""
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/tensor_ops_test.py"
+            }
+        }
+    ]
+
+    assert simulator.initialize('''{"online": false}''', modules)
+
+    matrix = np.array([[1.0, 5.0, 3.0], [4.0, 2.0, 6.0]], dtype=np.float32)
+    output = simulator.run_method("test_reductions", {})
+    assert np.isclose(output["min_all"], 1.0)
+    assert np.isclose(output["max_all"], 6.0)
+    assert np.isclose(output["sum_all"], 21.0)
+    assert np.isclose(output["mean_all"], 3.5)
+    assert np.allclose(output["min_axis0"], matrix.min(axis=0))
+    assert np.allclose(output["max_axis1"], matrix.max(axis=1))
+    assert np.allclose(output["sum_axis0"], matrix.sum(axis=0))
+    assert np.allclose(output["mean_axis_neg1"], matrix.mean(axis=-1))
+    assert output["argmax_all"] == 5
+    assert np.all(np.array(output["argmin_axis1"]) == matrix.argmin(axis=1))
+
+    exp = np.exp(matrix - matrix.max(axis=-1, keepdims=True))
+    assert np.allclose(output["softmax"], exp / exp.sum(axis=-1, keepdims=True), rtol=1e-5)
+    log_softmax = matrix - matrix.max(axis=0) - np.log(np.exp(matrix - matrix.max(axis=0)).sum(axis=0))
+    assert np.allclose(output["log_softmax_axis0"], log_softmax, rtol=1e-5)
+
+    strings = simulator.run_method("test_string_reductions", {})
+    assert strings["min"] == "apple"
+    assert strings["max"] == "pear"
+    with pytest.raises(RuntimeError, match="sum only supports integral and floating point tensors"):
+        simulator.run_method("test_string_sum", {})
+    with pytest.raises(RuntimeError, match="min only supports integral and floating point tensors along an axis"):
+        simulator.run_method("test_string_min_axis", {})
+
+def test_bytecode_interpreter():
+    """Test that the bytecode interpreter matches the AST walker on outputs and errors."""
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/interpreter_test.py"
+            }
+        }
+    ]
+
+    outputs = {}
+    errors = {}
+    for bytecode in [False, True]:
+        assert simulator.initialize(json.dumps({"online": False, "bytecodeInterpreter": bytecode}), modules)
+        outputs[bytecode] = simulator.run_method("control_flow", {})
+        with pytest.raises(RuntimeError) as err:
+            simulator.run_method("nested_error", {})
+        errors[bytecode] = str(err.value)
+        simulator.cleanup()
+
+    output = outputs[True]
+    assert np.all(np.array(output["evens"]) == np.arange(0, 20, 2))
+    assert output["odds"] == 1 + 3 + 5 + 7 + 9 + 11 + 13 + 15
+    assert output["total"] == sum(n * n for n in range(1, 11))
+    assert output["pairs"] == {"a": 10, "b": 20, "c": 30}
+    assert output["count"] == 10
+    assert np.all(np.array(output["nested"]) == np.array([[0, 0], [1, 0], [1, 1], [2, 0], [2, 1], [2, 2]]))
+    assert output["fib"] == 610
+    assert output["negative"] == -64
+    assert output["bounded"] == True
+    assert output["firstNegative"] == -4
+    assert json.dumps(outputs[False], sort_keys=True, default=str) == json.dumps(output, sort_keys=True, default=str)
+
+    # Errors should carry the same chain of line numbers with both interpreters
+    assert "lineNo=" in errors[True]
+    assert errors[False] == errors[True]
+
+
+def test_script_concurrency():
+    """Test that run_method calls from multiple threads run correctly without the script lock."""
+    from concurrent.futures import ThreadPoolExecutor
+
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/script_concurrency_test.py"
+            }
+        }
+    ]
+
+    n = 200
+    weights = [1, 2, 3, 4]
+    expected = sum(sum(v * weights[v % 4] for v in [i, i + 1, i + 2]) + 7 for i in range(n))
+
+    assert simulator.initialize(json.dumps({"online": False, "scriptConcurrency": True}), modules)
+    with ThreadPoolExecutor(max_workers=8) as executor:
+        totals = list(executor.map(lambda _: simulator.run_method("read_mostly", {"n": n})["total"],
+                                   range(64)))
+    simulator.cleanup()
+    assert totals == [expected] * 64
+
+def test_script_concurrency_shared_state():
+    """Test that functions mutating module level lists and dicts keep the script lock."""
+    from concurrent.futures import ThreadPoolExecutor
+
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/script_concurrency_shared_state_test.py"
+            }
+        }
+    ]
+
+    n = 100
+    calls = 64
+    assert simulator.initialize(json.dumps({"online": False, "scriptConcurrency": True}), modules)
+    with ThreadPoolExecutor(max_workers=8) as executor:
+        results = list(executor.map(lambda _: simulator.run_method("add_items", {"n": n})["calls"],
+                                    range(calls)))
+    counts = simulator.run_method("get_counts", {})
+    simulator.cleanup()
+    assert sorted(results) == list(range(1, calls + 1))
+    assert counts == {"items": n * calls, "calls": calls}
+
+def test_script_concurrency_member_writes():
+    """Test that functions mutating module level state only through member functions keep the
+    script lock, also on their first calls."""
+    from concurrent.futures import ThreadPoolExecutor
+
+    modules = [
+        {
+            "name": "workflow_script",
+            "version": "1.0.0",
+            "type": "script",
+            "location": {
+                "path": "../simulation_assets/script_concurrency_shared_state_test.py"
+            }
+        }
+    ]
+
+    calls = 256
+    assert simulator.initialize(json.dumps({"online": False, "scriptConcurrency": True}), modules)
+    with ThreadPoolExecutor(max_workers=8) as executor:
+        values = list(executor.map(lambda i: simulator.run_method("push", {"value": i})["value"],
+                                   range(calls)))
+        pushed = list(executor.map(lambda _: simulator.run_method("get_pushed", {})["pushed"],
+                                   range(calls)))
+    simulator.cleanup()
+    assert values == list(range(calls))
+    assert pushed == [calls] * calls
+
 if __name__ == "__main__":
     test_simulator()
     test_python_modules()
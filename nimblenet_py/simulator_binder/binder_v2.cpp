@@ -281,6 +281,8 @@ CTensor construct_singleVariable_input(const std::string& name, py::object item)
     // Context should store info related to running the frontend function, or the function itself
     FrontendFunctionPtr myLambda = [](void* context, const CTensors input,
                                       CTensors* output) -> NimbleNetStatus* {
+      // Scripts can call back into Python from any thread, run_method runs without the GIL
+      py::gil_scoped_acquire acquire;
       auto pythonFunction = py::cast<py::function>(*(py::handle*)context);
       auto inputForPythonFunction = convert_CTensors_to_pymap(input);
       auto returnObject = pythonFunction(inputForPythonFunction);
@@ -360,7 +362,12 @@ std::map<std::string, py::object> run_task_upto_timestamp_in_simulator(const cha
   CTensors output;
 
   if (timestampArg.is_none()) {
-    auto t = run_method(functionName, input.t, &output);
+    NimbleNetStatus* t;
+    {
+      // Release the GIL so that run_method calls from different Python threads run in parallel
+      py::gil_scoped_release release;
+      t = run_method(functionName, input.t, &output);
+    }
     if (t != nullptr) {
       throw std::runtime_error(std::string(t->message) + "\nError running workflow script.");
     }
@@ -368,7 +375,12 @@ std::map<std::string, py::object> run_task_upto_timestamp_in_simulator(const cha
     return ret;
   }
   int64_t timestamp = timestampArg.cast<int64_t>();
-  if (!run_task_upto_timestamp(functionName, input.t, &output, timestamp)) {
+  bool success;
+  {
+    py::gil_scoped_release release;
+    success = run_task_upto_timestamp(functionName, input.t, &output, timestamp);
+  }
+  if (!success) {
     throw std::runtime_error("Error running workflow script.");
   }
   return convert_CTensors_to_pymap_and_free_tensors(output);